@@ -0,0 +1,152 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpps/logical/algorithms/assignment/bid_index.h"
+
+/**
+ * Measures the winner determination of the AuctionInitiatorState for one iteration of an auction
+ * in which every AMR bids on every task: collecting the bids, selecting the best bid of each task
+ * in the order of these bids, and removing the bids of the winners rejecting their win.
+ * Compares repeatedly sorting a vector of all bids, as done before, and the BidIndex.
+ */
+
+using namespace daisi::cpps;
+using namespace daisi::cpps::logical;
+
+using Winners = std::vector<std::pair<std::string, std::string>>;
+
+std::vector<BidSubmission> createBids(int number_of_amrs, int number_of_tasks, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> cost(10, 1000);
+  amr::AmrStaticAbility ability(amr::LoadCarrier(amr::LoadCarrier::Types::kPackage), 20);
+
+  std::vector<BidSubmission> bids;
+  bids.reserve(static_cast<size_t>(number_of_amrs) * number_of_tasks);
+  for (int amr = 0; amr < number_of_amrs; amr++) {
+    for (int task = 0; task < number_of_tasks; task++) {
+      double c = cost(gen);
+      bids.emplace_back("task" + std::to_string(task), "amr" + std::to_string(amr), ability,
+                        MetricsComposition(Metrics(c, c, c, c, c)));
+    }
+  }
+  return bids;
+}
+
+/// Winner selection as done by the AuctionInitiatorState before the BidIndex
+Winners selectWinnersBySorting(const std::vector<BidSubmission> &bids) {
+  std::vector<BidSubmission> bid_submissions;
+  for (const auto &bid : bids) {
+    bid_submissions.push_back(bid);
+  }
+
+  Winners winners;
+  auto temp_bids = bid_submissions;
+  while (!temp_bids.empty()) {
+    std::sort(temp_bids.begin(), temp_bids.end(),
+              [](const auto &b1, const auto &b2) { return b1 > b2; });
+
+    auto best_bid = temp_bids.front();
+    const std::string &task_uuid = best_bid.getTaskUuid();
+    winners.emplace_back(task_uuid, best_bid.getParticipantConnection());
+
+    temp_bids.erase(
+        std::remove_if(temp_bids.begin(), temp_bids.end(),
+                       [&task_uuid](const auto &bid) { return bid.getTaskUuid() == task_uuid; }),
+        temp_bids.end());
+  }
+
+  // every winner rejects, so that the bids remain for the next iteration except the winning ones
+  for (const auto &winner : winners) {
+    bid_submissions.erase(std::remove_if(bid_submissions.begin(), bid_submissions.end(),
+                                         [&winner](const auto &bid) {
+                                           return bid.getTaskUuid() == winner.first &&
+                                                  bid.getParticipantConnection() == winner.second;
+                                         }),
+                          bid_submissions.end());
+  }
+
+  return winners;
+}
+
+Winners selectWinnersByIndex(const std::vector<BidSubmission> &bids) {
+  BidIndex bid_submissions;
+  for (const auto &bid : bids) {
+    bid_submissions.add(bid);
+  }
+
+  Winners winners;
+  for (const BidSubmission *best_bid : bid_submissions.getBestBidPerTask()) {
+    winners.emplace_back(best_bid->getTaskUuid(), best_bid->getParticipantConnection());
+  }
+
+  for (const auto &[task_uuid, participant] : winners) {
+    bid_submissions.removeBid(task_uuid, participant);
+  }
+
+  return winners;
+}
+
+template <typename Fct>
+double measure(Fct &&fct, const std::vector<BidSubmission> &bids, int iterations,
+               Winners &winners) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    winners = fct(bids);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+  const int iterations = argc > 1 ? std::stoi(argv[1]) : 1;
+
+  std::mt19937 gen(42);
+
+  std::cout << std::setw(6) << "amrs" << std::setw(7) << "tasks" << std::setw(8) << "bids"
+            << std::setw(14) << "sorting" << std::setw(14) << "bid index" << std::setw(10)
+            << "speedup" << std::endl;
+  std::cout << std::setw(21) << "" << std::setw(14) << "ms/iteration" << std::setw(14)
+            << "ms/iteration" << std::endl;
+  std::cout << std::fixed;
+
+  for (auto [number_of_amrs, number_of_tasks] :
+       std::vector<std::pair<int, int>>{{10, 10}, {50, 30}, {100, 100}, {500, 300}}) {
+    auto bids = createBids(number_of_amrs, number_of_tasks, gen);
+
+    Winners sorting_winners, index_winners;
+    double sorting = measure(selectWinnersBySorting, bids, iterations, sorting_winners);
+    double index = measure(selectWinnersByIndex, bids, iterations, index_winners);
+
+    if (sorting_winners != index_winners) {
+      throw std::logic_error("Winners must not depend on the winner determination");
+    }
+
+    std::cout << std::setw(6) << number_of_amrs << std::setw(7) << number_of_tasks
+              << std::setw(8) << bids.size() << std::setw(14) << std::setprecision(3) << sorting
+              << std::setw(14) << index << std::setw(9) << std::setprecision(1)
+              << sorting / index << "x" << std::endl;
+  }
+}
@@ -0,0 +1,166 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "path_planning/consensus/route_calculation_helper.h"
+
+/**
+ * Measures the calculation of conflict free start times as done by the consensus servers for every
+ * route request. AGVs request routes over a grid of intersections one after another, each accepted
+ * route occupies its intersections. Compares probing start times in 1 ms steps (as done before)
+ * with the interval based search on the occupancy maps and on the interval index.
+ */
+
+using namespace daisi::path_planning;
+using namespace daisi::path_planning::consensus;
+
+constexpr double kTimeBetweenIntersections = 1;
+constexpr double kMaxPreplanningTime = 60;
+
+double calculatePossibleStartTimeBruteForce(const PointTimePairs &points,
+                                            double initial_start_time,
+                                            const IntersectionOccupancy &intersection_occupancy) {
+  const double delta_s = 0.001;
+  const int retries = static_cast<int>(kMaxPreplanningTime) / delta_s;
+  for (int i = 0; i < retries; i++) {
+    const double start_time = initial_start_time + delta_s * i;
+    bool possible = true;
+    for (const auto &[position, relative_time] : points) {
+      auto it = intersection_occupancy.find({position.x, position.y});
+      if (it == intersection_occupancy.end()) continue;
+
+      const auto &entry = it->second;
+      const double time_at_point = start_time + relative_time;
+      auto next = entry.lower_bound(time_at_point - kTimeBetweenIntersections);
+      if (next != entry.end() && next->first <= time_at_point + kTimeBetweenIntersections) {
+        possible = false;
+        break;
+      }
+    }
+    if (possible) return start_time;
+  }
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+/// Route along one row and one column of the intersection grid
+PointTimePairs createRoute(int grid_size, std::mt19937 &gen) {
+  std::uniform_int_distribution<int> coordinate(0, grid_size - 1);
+  const int row = coordinate(gen);
+  const int column = coordinate(gen);
+
+  PointTimePairs points;
+  double time = 0;
+  for (int x = 0; x <= column; x++, time += 2) {
+    points.push_back({{x * 10.0, row * 10.0}, time});
+  }
+  for (int y = row + 1; y < grid_size; y++, time += 2) {
+    points.push_back({{column * 10.0, y * 10.0}, time});
+  }
+  return points;
+}
+
+struct Result {
+  double us_per_request = 0;
+  int accepted = 0;
+};
+
+/// Every AGV requests a route, requests arrive every request_interval_s
+template <typename Function>
+Result measure(const std::vector<PointTimePairs> &routes, double request_interval_s,
+               Function &&calculate) {
+  IntersectionOccupancy occupancy;
+  OccupancyIntervalIndex index(kTimeBetweenIntersections);
+
+  Result result;
+  std::chrono::duration<double, std::micro> duration{0};
+  for (size_t i = 0; i < routes.size(); i++) {
+    const double initial_start_time = request_interval_s * i;
+
+    auto start = std::chrono::steady_clock::now();
+    const double start_time = calculate(routes[i], initial_start_time, occupancy, index);
+    duration += std::chrono::steady_clock::now() - start;
+
+    if (std::isnan(start_time)) continue;
+    result.accepted++;
+    for (const auto &[position, relative_time] : routes[i]) {
+      occupancy[{position.x, position.y}][start_time + relative_time] = i;
+      index.addOccupancy({position.x, position.y}, start_time + relative_time);
+    }
+  }
+
+  result.us_per_request = duration.count() / routes.size();
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  const int max_brute_force_agvs = argc > 1 ? std::stoi(argv[1]) : 200;
+  const int grid_size = 8;
+
+  std::cout << std::setw(6) << "agvs" << std::setw(10) << "interval" << std::setw(14)
+            << "brute force" << std::setw(14) << "occupancy" << std::setw(14) << "index"
+            << std::setw(10) << "accepted" << std::endl;
+  std::cout << std::setw(6) << "" << std::setw(10) << "s" << std::setw(14) << "us/request"
+            << std::setw(14) << "us/request" << std::setw(14) << "us/request" << std::endl;
+  std::cout << std::fixed;
+
+  for (int agvs : {100, 200, 500, 1000}) {
+    for (double request_interval_s : {1.0, 0.1}) {
+      std::mt19937 gen(42);
+      std::vector<PointTimePairs> routes;
+      for (int i = 0; i < agvs; i++) {
+        routes.push_back(createRoute(grid_size, gen));
+      }
+
+      auto occupancy_result =
+          measure(routes, request_interval_s,
+                  [](const auto &points, double initial, const auto &occupancy, const auto &) {
+                    return RouteCalculationHelper::calculatePossibleStartTime(
+                        points, initial, kMaxPreplanningTime, kTimeBetweenIntersections,
+                        occupancy);
+                  });
+      auto index_result = measure(
+          routes, request_interval_s,
+          [](const auto &points, double initial, const auto &, const auto &index) {
+            return RouteCalculationHelper::calculatePossibleStartTime(points, initial,
+                                                                      kMaxPreplanningTime, index);
+          });
+
+      std::cout << std::setw(6) << agvs << std::setw(10) << std::setprecision(1)
+                << request_interval_s << std::setw(14) << std::setprecision(1);
+      if (agvs <= max_brute_force_agvs) {
+        auto brute_force_result =
+            measure(routes, request_interval_s,
+                    [](const auto &points, double initial, const auto &occupancy, const auto &) {
+                      return calculatePossibleStartTimeBruteForce(points, initial, occupancy);
+                    });
+        std::cout << brute_force_result.us_per_request;
+      } else {
+        std::cout << "-";
+      }
+      std::cout << std::setw(14) << occupancy_result.us_per_request << std::setw(14)
+                << index_result.us_per_request << std::setw(10) << index_result.accepted
+                << std::endl;
+    }
+  }
+}
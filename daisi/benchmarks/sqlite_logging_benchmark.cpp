@@ -0,0 +1,140 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <sqlite3.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "logging/definitions.h"
+#include "logging/sqlite/sqlite_helper.h"
+
+/**
+ * Measures the rows/sec of logging traffic like MinhtonLoggerNs3::logTraffic. Compares executing a
+ * formatted statement per row (as done before), formatted statements which are written by the
+ * writer thread of the SQLiteHelper and rows which are inserted with prepared statements.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static const DatabaseTable kNode("Node", {DatabaseColumnInfo{"Id"},
+                                          {"Uuid", "%s", true},
+                                          {"Level", "%u"},
+                                          {"Number", "%u"}});
+
+static const DatabaseTable kTraffic("Traffic",
+                                    {DatabaseColumnInfo{"Id"},
+                                     {"Timestamp_ms", "%lu", true},
+                                     {"MsgType", "%u", true},
+                                     {"EventId", "%lu", true},
+                                     {"SenderNodeId", "sql%u", true, "Node(Id)", false, "Uuid"},
+                                     {"TargetNodeId", "sql%u", true, "Node(Id)", false, "Uuid"},
+                                     {"Load", "%f", true},
+                                     {"Content", "%s"}});
+
+constexpr uint32_t kNodes = 1000;
+
+std::string nodeUuid(uint32_t node) { return "3f2a9c1e-0000-4000-8000-" + std::to_string(node); }
+
+/// Formatted statements of the nodes and of the traffic in the same way as the loggers did before
+template <typename Function> void formatStatements(uint32_t rows, Function &&execute) {
+  execute(getCreateTableStatement(kNode));
+  execute(getCreateTableStatement(kTraffic));
+  for (uint32_t node = 0; node < kNodes; node++) {
+    std::string uuid = nodeUuid(node);
+    auto t = std::make_tuple(uuid.c_str(), node / 32, node % 32);
+    execute(getInsertStatement(kNode, t));
+  }
+
+  for (uint32_t row = 0; row < rows; row++) {
+    std::string sender_id = "(SELECT Id FROM Node WHERE Uuid='" + nodeUuid(row % kNodes) + "')";
+    std::string target_id =
+        "(SELECT Id FROM Node WHERE Uuid='" + nodeUuid((row * 7) % kNodes) + "')";
+    auto t = std::make_tuple(row / 10, row % 32, row, sender_id.c_str(), target_id.c_str(),
+                             0.001 * row, "FindQueryRequest");
+    execute(getInsertStatement(kTraffic, t));
+  }
+}
+
+double measureAutocommit(const std::string &file, uint32_t rows) {
+  sqlite3 *db = nullptr;
+  sqlite3_open(file.c_str(), &db);
+  sqlite3_exec(db, "PRAGMA synchronous = OFF", nullptr, nullptr, nullptr);
+  sqlite3_exec(db, "PRAGMA journal_mode = MEMORY", nullptr, nullptr, nullptr);
+  sqlite3_exec(db, "PRAGMA page_size = 65536", nullptr, nullptr, nullptr);
+
+  auto start = Clock::now();
+  formatStatements(rows, [db](const std::string &statement) {
+    sqlite3_exec(db, statement.c_str(), nullptr, nullptr, nullptr);
+  });
+  auto end = Clock::now();
+
+  sqlite3_close(db);
+  return std::chrono::duration<double>(end - start).count();
+}
+
+double measureStatements(const std::string &path, const std::string &name, uint32_t rows) {
+  daisi::SQLiteHelper helper(path, name);
+
+  auto start = Clock::now();
+  formatStatements(rows, [&helper](const std::string &statement) { helper.execute(statement); });
+  helper.flush();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double measurePrepared(const std::string &path, const std::string &name, uint32_t rows) {
+  daisi::SQLiteHelper helper(path, name);
+
+  auto start = Clock::now();
+  helper.execute(getCreateTableStatement(kNode));
+  helper.execute(getCreateTableStatement(kTraffic));
+  for (uint32_t node = 0; node < kNodes; node++) {
+    helper.insert(kNode, toDatabaseRow(std::make_tuple(nodeUuid(node), node / 32, node % 32)));
+  }
+
+  for (uint32_t row = 0; row < rows; row++) {
+    auto t = std::make_tuple(row / 10, row % 32, row, nodeUuid(row % kNodes),
+                             nodeUuid((row * 7) % kNodes), 0.001 * row, "FindQueryRequest");
+    helper.insert(kTraffic, toDatabaseRow(t));
+  }
+  helper.flush();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void printRow(const std::string &name, uint32_t rows, double seconds) {
+  std::cout << std::left << std::setw(28) << name << std::right << std::setw(10) << rows
+            << std::setw(12) << std::fixed << std::setprecision(3) << seconds << std::setw(14)
+            << std::setprecision(0) << rows / seconds << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t rows = argc > 1 ? std::stoul(argv[1]) : 100000;
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "daisi_sqlite_benchmark/").string();
+  std::filesystem::create_directory(path);
+
+  std::cout << std::left << std::setw(28) << "mode" << std::right << std::setw(10) << "rows"
+            << std::setw(12) << "seconds" << std::setw(14) << "rows/sec" << std::endl;
+
+  printRow("autocommit statements", rows, measureAutocommit(path + "autocommit.db", rows));
+  printRow("batched statements", rows, measureStatements(path, "statements.db", rows));
+  printRow("prepared columnar batches", rows, measurePrepared(path, "prepared.db", rows));
+
+  std::filesystem::remove_all(path);
+}
@@ -0,0 +1,180 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "datastructure/simple_temporal_network.tpp"
+
+/**
+ * Measures the time of a trial insertion of a task into a queue of tasks, as done by the
+ * StnTaskManagement for every insertion point during bid calculation: copying the network, adding
+ * the vertices and constraints of the new task, and solving. Compares the Floyd-Warshall and the
+ * incremental solver for different queue lengths.
+ */
+
+using namespace daisi::datastructure;
+
+struct BenchmarkVertex {
+  explicit BenchmarkVertex(int id) : id_(id) {}
+
+  static BenchmarkVertex createOrigin() { return BenchmarkVertex(-1); }
+
+  friend bool operator==(const BenchmarkVertex &v1, const BenchmarkVertex &v2) {
+    return v1.id_ == v2.id_;
+  }
+
+  int getId() const { return id_; }
+
+private:
+  int id_;
+};
+
+namespace std {
+
+template <> struct hash<BenchmarkVertex> {
+  std::size_t operator()(const BenchmarkVertex &v) const { return hash<int>()(v.getId()); }
+};
+
+}  // namespace std
+
+struct BenchmarkEdge {
+  explicit BenchmarkEdge(const bool all_positive) : all_positive_(all_positive) {}
+
+  void addWeight(double weight) { weights_.push_back(weight); }
+
+  double getWeight() const {
+    if (all_positive_) {
+      return *std::max_element(weights_.begin(), weights_.end());
+    }
+    return *std::min_element(weights_.begin(), weights_.end());
+  }
+
+  void removeLastWeight() { weights_.pop_back(); }
+
+private:
+  std::vector<double> weights_;
+  bool all_positive_;
+};
+
+using BenchmarkSTN = SimpleTemporalNetwork<BenchmarkVertex, BenchmarkEdge>;
+
+struct Task {
+  BenchmarkVertex start;
+  BenchmarkVertex finish;
+  double duration;
+  double earliest_start;
+  double latest_finish;
+};
+
+void addTask(BenchmarkSTN &stn, const Task &task) {
+  stn.addVertex(task.start);
+  stn.addVertex(task.finish);
+  stn.addBinaryConstraint(task.start, task.finish, task.duration, std::nullopt);
+  stn.addUnaryConstraint(task.start, task.earliest_start, std::nullopt);
+  stn.addUnaryConstraint(task.finish, std::nullopt, task.latest_finish);
+}
+
+std::vector<Task> createTasks(int number_of_tasks, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> duration(30, 120);
+  std::uniform_real_distribution<double> slack(1000, 100000);
+
+  std::vector<Task> tasks;
+  double time = 0;
+  for (int i = 0; i < number_of_tasks; i++) {
+    double task_duration = duration(gen);
+    tasks.push_back({BenchmarkVertex(2 * i), BenchmarkVertex(2 * i + 1), task_duration, time,
+                     time + task_duration + slack(gen)});
+    time += task_duration + 10;
+  }
+  return tasks;
+}
+
+/// Network with the tasks queued in the given order, each task after the previous one
+BenchmarkSTN createQueue(const std::vector<Task> &tasks, StnSolverMode mode) {
+  BenchmarkSTN stn(mode);
+  for (size_t i = 0; i < tasks.size(); i++) {
+    addTask(stn, tasks[i]);
+    if (i > 0) {
+      stn.addBinaryConstraint(tasks[i - 1].finish, tasks[i].start, 10, std::nullopt);
+    }
+  }
+
+  if (!stn.solve()) {
+    throw std::logic_error("Queue must be consistent");
+  }
+  return stn;
+}
+
+/// Trial insertion of a new task between the tasks at index position - 1 and position
+bool insertTask(BenchmarkSTN queue, const std::vector<Task> &tasks, const Task &new_task,
+                size_t position) {
+  addTask(queue, new_task);
+  if (position > 0) {
+    queue.addBinaryConstraint(tasks[position - 1].finish, new_task.start, 10, std::nullopt);
+  }
+  if (position < tasks.size()) {
+    queue.addBinaryConstraint(new_task.finish, tasks[position].start, 10, std::nullopt);
+  }
+  return queue.solve();
+}
+
+double measureInsertion(const std::vector<Task> &tasks, const Task &new_task, StnSolverMode mode,
+                        int insertions) {
+  BenchmarkSTN queue = createQueue(tasks, mode);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < insertions; i++) {
+    // insertion points spread over the queue
+    insertTask(queue, tasks, new_task, tasks.size() * i / std::max(insertions - 1, 1));
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / insertions;
+}
+
+int main(int argc, char *argv[]) {
+  const int insertions = argc > 1 ? std::stoi(argv[1]) : 5;
+
+  std::mt19937 gen(42);
+
+  std::cout << std::setw(8) << "tasks" << std::setw(10) << "vertices" << std::setw(18)
+            << "floyd-warshall" << std::setw(18) << "incremental" << std::setw(10) << "speedup"
+            << std::endl;
+  std::cout << std::setw(18) << "" << std::setw(18) << "ms/insertion" << std::setw(18)
+            << "ms/insertion" << std::endl;
+  std::cout << std::fixed;
+
+  for (int number_of_tasks : {10, 20, 50, 100, 200, 500}) {
+    auto tasks = createTasks(number_of_tasks, gen);
+    Task new_task{BenchmarkVertex(-2), BenchmarkVertex(-3), 60, 0, 1e9};
+
+    double floyd_warshall =
+        measureInsertion(tasks, new_task, StnSolverMode::kFloydWarshall, insertions);
+    double incremental = measureInsertion(tasks, new_task, StnSolverMode::kIncremental, insertions);
+
+    std::cout << std::setw(8) << number_of_tasks << std::setw(10) << 2 * number_of_tasks + 1
+              << std::setw(18) << std::setprecision(3) << floyd_warshall << std::setw(18)
+              << incremental << std::setw(9) << std::setprecision(1)
+              << floyd_warshall / incremental << "x" << std::endl;
+  }
+}
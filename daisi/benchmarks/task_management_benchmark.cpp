@@ -0,0 +1,101 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cpps/logical/task_management/stn_task_management.h"
+
+/**
+ * Measures the bid computation latency of the StnTaskManagement (canAddTask) for different queue
+ * lengths.
+ */
+
+using namespace daisi::material_flow;
+using namespace daisi::cpps;
+using namespace daisi::cpps::logical;
+using namespace daisi::cpps::amr;
+
+AmrDescription createAmrDescription() {
+  AmrKinematics kinematics{1, 0, 1, 1};
+  AmrProperties properties{};
+  AmrPhysicalProperties physical_properties{50, {0.5, 0.5, 0.5}};
+  AmrLoadHandlingUnit load_handling_unit{
+      7, 8, amr::AmrStaticAbility(LoadCarrier(LoadCarrier::kEuroBox), 50)};
+
+  return AmrDescription{42, kinematics, properties, physical_properties, load_handling_unit};
+}
+
+Task createTask(const std::string &name, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> coordinate(0, 100);
+  daisi::util::Position pickup_position(coordinate(gen), coordinate(gen));
+  daisi::util::Position delivery_position(coordinate(gen), coordinate(gen));
+
+  TransportOrderStep pickup(name + "_pickup", {}, Location(name + "_0", "type", pickup_position));
+  TransportOrderStep delivery(name + "_delivery", {},
+                              Location(name + "_1", "type", delivery_position));
+  TransportOrder order(name + "_order", {pickup}, delivery);
+  return Task(name, "127.0.0.1:5000", {order}, {});
+}
+
+StnTaskManagement createQueue(int number_of_tasks, std::mt19937 &gen) {
+  StnTaskManagement management(createAmrDescription(), Topology{{100, 100, 0}},
+                               daisi::util::Pose(daisi::util::Position(0, 0)));
+  for (int i = 0; i < number_of_tasks; i++) {
+    if (!management.addTask(createTask("task_" + std::to_string(i), gen))) {
+      throw std::logic_error("Task must be insertable");
+    }
+  }
+  return management;
+}
+
+double measureBid(StnTaskManagement &management, const std::vector<Task> &tasks) {
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &task : tasks) {
+    if (!management.canAddTask(task)) {
+      throw std::logic_error("Task must be insertable");
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / tasks.size();
+}
+
+int main(int argc, char *argv[]) {
+  const int bids = argc > 1 ? std::stoi(argv[1]) : 5;
+
+  std::mt19937 gen(42);
+
+  std::cout << std::setw(8) << "tasks" << std::setw(14) << "ms/bid" << std::endl;
+  std::cout << std::fixed << std::setprecision(3);
+
+  for (int number_of_tasks : {5, 10, 20, 50, 100}) {
+    StnTaskManagement management = createQueue(number_of_tasks, gen);
+
+    std::vector<Task> tasks;
+    for (int i = 0; i < bids; i++) {
+      tasks.push_back(createTask("bid_" + std::to_string(i), gen));
+    }
+
+    std::cout << std::setw(8) << number_of_tasks << std::setw(14) << measureBid(management, tasks)
+              << std::endl;
+  }
+}
@@ -24,7 +24,7 @@ using ViewDefinition = const std::unordered_map<std::string, std::string>;
 namespace daisi::cpps {
 
 // Refer to DatabaseTable and DatabaseColumnInfo definitions in ../logging/definitions.h
-//! Don't forget to use .c_str() to convert std::string into a char array
+// Rows are inserted with prepared statements, see getPreparedInsertStatement and toDatabaseRow
 
 // * CppsExecutedOrderUtility
 static TableDefinition kExecutedOrderUtility("CppsExecutedOrderUtility",
@@ -79,7 +79,7 @@ void CppsLoggerNs3::logExecutedOrderCost(const ExecutedOrderUtilityLoggingInfo &
       /* Quality */ logging_info.quality,
       /* Costs */ logging_info.costs,
       /* Utility */ logging_info.utility);
-  log_(getInsertStatement(kExecutedOrderUtility, t));
+  log_insert_(kExecutedOrderUtility, toDatabaseRow(t));
 }
 
 // * CppsMaterialFlow
@@ -105,13 +105,14 @@ void CppsLoggerNs3::logMaterialFlow(const std::string &mf_uuid, const std::strin
       /* IpLogicalCore */ ip.c_str(),
       /* PortLogicalCore */ port,
       /* State */ state);
-  log_(getInsertStatement(kMaterialFlow, t));
+  log_insert_(kMaterialFlow, toDatabaseRow(t));
 }
 
 // * CppsNegotiationTraffic
 static TableDefinition kNegotiationTraffic("CppsNegotiationTraffic", {DatabaseColumnInfo{"Id"},
                                                                       {"TransportOrderId", "sql%u",
-                                                                       true, "TransportOrder(Id)"},
+                                                                       true, "TransportOrder(Id)",
+                                                                       false, "OrderUuid"},
                                                                       {"Timestamp_ms", "%u", true},
                                                                       {"SenderIp", "%s", true},
                                                                       {"SenderPort", "%u", true},
@@ -154,7 +155,7 @@ void CppsLoggerNs3::logCppsMessage(solanet::UUID msg_uuid, const std::string &ms
   auto t = std::make_tuple(
       /* MessageUuid */ msg_uuid_str.c_str(),
       /* MessageContent */ msg_content.c_str());
-  log_(getInsertStatement(kCppsMessage, t));
+  log_insert_(kCppsMessage, toDatabaseRow(t));
 }
 
 static ViewDefinition kNegotiationTrafficReplacements = {
@@ -175,13 +176,11 @@ void CppsLoggerNs3::logNegotiationTraffic(const NegotiationTrafficLoggingInfo &l
     log_(kCreateViewNegotiationTraffic);
   }
 
-  std::string transport_order_id =
-      "(SELECT Id FROM TransportOrder WHERE OrderUuid='" + logging_info.order + "')";
   std::string sender_ip = logging_info.sender_ip;
   std::string target_ip = logging_info.target_ip;
   std::string content = logging_info.content;
   auto t = std::make_tuple(
-      /* TransportOrderId */ transport_order_id.c_str(),
+      /* TransportOrderId */ logging_info.order.c_str(),
       /* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
       /* SenderIp */ sender_ip.c_str(),
       /* SenderPort */ logging_info.sender_port,
@@ -189,7 +188,7 @@ void CppsLoggerNs3::logNegotiationTraffic(const NegotiationTrafficLoggingInfo &l
       /* TargetPort */ logging_info.sender_port,
       /* MsgType */ logging_info.message_type,
       /* Content */ content.c_str());
-  log_(getInsertStatement(kNegotiationTraffic, t));
+  log_insert_(kNegotiationTraffic, toDatabaseRow(t));
 }
 
 // * CppsStation
@@ -220,13 +219,16 @@ void CppsLoggerNs3::logStation(const std::string &name, const std::string &type,
       /* Type */ type.c_str(),
       /* PosX_m */ position.x,
       /* PosY_m */ position.y);
-  log_(getInsertStatement(kStation, t));
+  log_insert_(kStation, toDatabaseRow(t));
   // additionalPositions.empty() ? "" : stream.str().c_str()
 }
 
 // * Constructor & Other methods
-CppsLoggerNs3::CppsLoggerNs3(LogDeviceApp log_device_application, LogFunction log)
-    : log_device_application_(std::move(log_device_application)), log_(std::move(log)) {}
+CppsLoggerNs3::CppsLoggerNs3(LogDeviceApp log_device_application, LogFunction log,
+                             LogInsert log_insert)
+    : log_device_application_(std::move(log_device_application)),
+      log_(std::move(log)),
+      log_insert_(std::move(log_insert)) {}
 
 CppsLoggerNs3::~CppsLoggerNs3() {
   auto current_time = ns3::Simulator::Now().GetMilliSeconds();
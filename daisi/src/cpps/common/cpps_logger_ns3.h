@@ -96,7 +96,8 @@ struct ExecutedOrderUtilityLoggingInfo {
 class CppsLoggerNs3 {
 public:
   CppsLoggerNs3() = delete;
-  explicit CppsLoggerNs3(LogDeviceApp log_device_application, LogFunction log);
+  explicit CppsLoggerNs3(LogDeviceApp log_device_application, LogFunction log,
+                         LogInsert log_insert);
   ~CppsLoggerNs3();
 
   CppsLoggerNs3(CppsLoggerNs3 &) = delete;
@@ -133,6 +134,7 @@ private:
   // TODO Refactor to other class
   const LogDeviceApp log_device_application_;
   const LogFunction log_;
+  const LogInsert log_insert_;
 
   std::string uuid_ = "NOT-KNOWN-YET";
 };
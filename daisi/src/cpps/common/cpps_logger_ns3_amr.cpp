@@ -25,7 +25,8 @@ namespace daisi::cpps {
 static TableDefinition kAmrHistory("CppsAMRHistory",
                                    {DatabaseColumnInfo{"Id"},
                                     {"Timestamp_ms", "%u", true},
-                                    {"AmrId", "sql%u", true, "CppsAutonomousMobileRobot(Id)"},
+                                    {"AmrId", "sql%u", true, "CppsAutonomousMobileRobot(Id)",
+                                     false, "ApplicationUuid"},
                                     {"PosX_m", "%f", true},
                                     {"PosY_m", "%f", true},
                                     {"State", "%u", true}});
@@ -38,15 +39,13 @@ void CppsLoggerNs3::logPositionUpdate(const AmrPositionLoggingInfo &logging_info
     amr_history_exists = true;
   }
 
-  std::string amr_id = "(SELECT Id FROM CppsAutonomousMobileRobot WHERE ApplicationUuid='" +
-                       logging_info.uuid + "')";
   auto t = std::make_tuple(
       /* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
-      /* AmrId */ amr_id.c_str(),
+      /* AmrId */ logging_info.uuid.c_str(),
       /* PosX_m */ logging_info.x,
       /* PosY_m */ logging_info.y,
       /* State */ logging_info.state);
-  log_(getInsertStatement(kAmrHistory, t));
+  log_insert_(kAmrHistory, toDatabaseRow(t));
   // logging_info.z_
 }
 
@@ -98,7 +97,7 @@ void CppsLoggerNs3::logAMR(const AmrLoggingInfo &amr_info) {
       /* MinVelocity_mps */ amr_info.min_velocity,
       /* MaxAcceleration_mpss */ amr_info.max_acceleration,
       /* MaxDeceleration_mpss */ amr_info.min_acceleration);
-  log_(getInsertStatement(kAutonomousMobileRobot, t));
+  log_insert_(kAutonomousMobileRobot, toDatabaseRow(t));
 }
 
 // * CppsService
@@ -118,14 +117,15 @@ void CppsLoggerNs3::logService(const std::string &uuid, uint8_t type) {
       /* Uuid */ uuid.c_str(),
       /* StartTime_ms */ ns3::Simulator::Now().GetMilliSeconds(),
       /* Type */ type);
-  log_(getInsertStatement(kService, t));
+  log_insert_(kService, toDatabaseRow(t));
 }
 
 // * CppsServiceTransport
 static TableDefinition kServiceTransport("CppsServiceTransport",
                                          {DatabaseColumnInfo{"Id"},
                                           {"Uuid", "%s", true},
-                                          {"AmrId", "sql%u", true, "CppsAutonomousMobileRobot(Id)"},
+                                          {"AmrId", "sql%u", true, "CppsAutonomousMobileRobot(Id)",
+                                           false, "ApplicationUuid"},
                                           {"LoadCarrierType", "%s", true},
                                           {"MaxWeightPayload_kg", "%f", true}});
 static const std::string kCreateServiceTransport = getCreateTableStatement(kServiceTransport);
@@ -143,14 +143,12 @@ void CppsLoggerNs3::logTransportService(const sola::Service &service, bool /*act
 
   logService(service.uuid, 0);
   std::string uuid = service.uuid;
-  std::string amr_id =
-      "(SELECT Id FROM CppsAutonomousMobileRobot WHERE ApplicationUuid='" + amr_uuid + "')";
   auto t = std::make_tuple(
       /* Uuid */ uuid.c_str(),
-      /* AmrId */ amr_id.c_str(),
+      /* AmrId */ amr_uuid.c_str(),
       /* LoadCarrierType */ type.c_str(),  // TODO: Change to id based field?
       /* MaxWeightPayload_kg */ max_payload);
-  log_(getInsertStatement(kServiceTransport, t));
+  log_insert_(kServiceTransport, toDatabaseRow(t));
 }
 
 }  // namespace daisi::cpps
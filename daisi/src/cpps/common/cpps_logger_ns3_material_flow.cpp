@@ -28,7 +28,8 @@ TableDefinition kMaterialFlowTask("CppsMaterialFlowTask",
                                       DatabaseColumnInfo{"Id"},
                                       {"TaskUuid", "%s", true},
                                       {"TaskName", "%s", true},
-                                      {"MaterialFlowId", "sql%u", true, "CppsMaterialFlow(Id)"},
+                                      {"MaterialFlowId", "sql%u", true, "CppsMaterialFlow(Id)",
+                                       false, "Uuid"},
                                       {"FollowUpTaskUuids", "%s", true},
                                       {"LoadCarrierRequirement", "%s", true},
                                       {"PayloadRequirement_kg", "%f", true},
@@ -43,9 +44,6 @@ void CppsLoggerNs3::logMaterialFlowTask(const material_flow::Task &task,
     material_flow_task_exists = true;
   }
 
-  std::string material_flow_id =
-      "(SELECT Id FROM CppsMaterialFlow WHERE Uuid='" + material_flow_uuid + "')";
-
   std::string follow_up_tasks = "";
   for (const auto &follow_up : task.getFollowUpTaskUuids()) {
     follow_up_tasks += follow_up + ",";
@@ -57,11 +55,11 @@ void CppsLoggerNs3::logMaterialFlowTask(const material_flow::Task &task,
   auto t = std::make_tuple(
       /* TaskUuid */ task.getUuid().c_str(),
       /* TaskName */ task.getName().c_str(),
-      /* MaterialFlowId */ material_flow_id.c_str(),
+      /* MaterialFlowId */ material_flow_uuid.c_str(),
       /* FollowUpTaskUuids */ follow_up_tasks.c_str(),
       /* LoadCarrierRequirement */ load_carrier_type.c_str(),
       /* PayloadRequirement_kg */ ability.getMaxPayloadWeight());
-  log_(getInsertStatement(kMaterialFlowTask, t));
+  log_insert_(kMaterialFlowTask, toDatabaseRow(t));
 }
 
 // * CppsMaterialFlow Orders
@@ -69,7 +67,8 @@ TableDefinition kMaterialFlowOrder("CppsMaterialFlowOrder",
                                    {
                                        DatabaseColumnInfo{"Id"},
                                        {"OrderUuid", "%s", true},
-                                       {"TaskId", "sql%u", true, "CppsMaterialFlowTask(Id)"},
+                                       {"TaskId", "sql%u", true, "CppsMaterialFlowTask(Id)", false,
+                                        "TaskUuid"},
                                        {"Type", "%s", true},
                                        {"Step1_Name", "%s", true},
                                        {"Step1_Parameters", "%s", false},
@@ -101,8 +100,6 @@ void CppsLoggerNs3::logMaterialFlowOrder(const material_flow::Order &order,
     material_flow_order_exists = true;
   }
 
-  std::string task_id = "(SELECT Id FROM CppsMaterialFlowTask WHERE TaskUuid='" + task_uuid + "')";
-
   std::string order_uuid = "";
   std::string type = "";
   std::string step1_name = "";
@@ -142,13 +139,13 @@ void CppsLoggerNs3::logMaterialFlowOrder(const material_flow::Order &order,
 
   auto t = std::make_tuple(
       /* OrderUuid */ order_uuid.c_str(),
-      /* TaskId */ task_id.c_str(),
+      /* TaskId */ task_uuid.c_str(),
       /* Type */ type.c_str(),
       /* Step1_Name */ step1_name.c_str(),
       /* Step1_Parameters */ step1_parameter.c_str(),
       /* Step2_Name */ step2_name.c_str(),
       /* Step2_Parameters*/ step2_parameter.c_str());
-  log_(getInsertStatement(kMaterialFlowOrder, t));
+  log_insert_(kMaterialFlowOrder, toDatabaseRow(t));
 }
 
 // * CppsMaterialFlowOrderHistory
@@ -156,9 +153,9 @@ TableDefinition kMaterialFlowOrderHistory(
     "CppsMaterialFlowOrderHistory",
     {
         DatabaseColumnInfo{"Id"},
-        {"MaterialFlowOrderId", "sql%u", true, "CppsMaterialFlowOrder(Id)"},
-        {"MaterialFlowTaskId", "sql%u", true, "CppsMaterialFlowTask(Id)"},
-        {"AmrId", "sql%u", false, "CppsAutonomousMobileRobot(Id)"},
+        {"MaterialFlowOrderId", "sql%u", true, "CppsMaterialFlowOrder(Id)", false, "OrderUuid"},
+        {"MaterialFlowTaskId", "sql%u", true, "CppsMaterialFlowTask(Id)", false, "TaskUuid"},
+        {"AmrId", "sql%u", false, "CppsAutonomousMobileRobot(Id)", false, "ApplicationUuid"},
         {"Timestamp_ms", "%u", true},
         {"State", "%u", true},
         {"PosX_m", "%f", true},
@@ -176,28 +173,19 @@ void CppsLoggerNs3::logMaterialFlowOrderUpdate(
     material_flow_order_history_exists = true;
   }
 
-  std::string amr_id = "(SELECT Id FROM CppsAutonomousMobileRobot WHERE ApplicationUuid='" +
-                       logging_info.amr_uuid + "')";
-
-  std::string task_id =
-      "(SELECT Id FROM CppsMaterialFlowTask WHERE TaskUuid='" + logging_info.task.getUuid() + "')";
-
   std::string order_uuid;
   std::visit([&order_uuid](const auto &order) { order_uuid = order.getUuid(); },
              logging_info.task.getOrders()[logging_info.order_index]);
 
-  std::string order_id =
-      "(SELECT Id FROM CppsMaterialFlowOrder WHERE OrderUuid='" + order_uuid + "')";
-
   auto t = std::make_tuple(
-      /* MaterialFlowOrderId */ order_id.c_str(),
-      /* MaterialFlowTaskId */ task_id.c_str(),
-      /* AmrId */ amr_id.c_str(),
+      /* MaterialFlowOrderId */ order_uuid.c_str(),
+      /* MaterialFlowTaskId */ logging_info.task.getUuid(),
+      /* AmrId */ logging_info.amr_uuid.c_str(),
       /* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
       /* State */ logging_info.order_state,
       /* PosX_m */ logging_info.position.x,
       /* PosY_m */ logging_info.position.y);
-  log_(getInsertStatement(kMaterialFlowOrderHistory, t));
+  log_insert_(kMaterialFlowOrderHistory, toDatabaseRow(t));
 }
 
 }  // namespace daisi::cpps
@@ -23,46 +23,18 @@ AuctionInitiatorState::AuctionInitiatorState(
     : layered_precedence_graph_(std::move(layered_precedence_graph)) {}
 
 void AuctionInitiatorState::addBidSubmission(const BidSubmission &bid_submission) {
-  bid_submissions_.push_back(bid_submission);
+  bid_submissions_.add(bid_submission);
 }
 
 void AuctionInitiatorState::addWinnerResponse(const WinnerResponse &winner_response) {
   if (winner_response.doesAccept()) {
     winner_acceptions_.push_back(winner_response);
   } else {
-    removeBidsForWinner(bid_submissions_, winner_response.getTaskUuid(),
-                        winner_response.getParticipantConnection());
+    bid_submissions_.removeBid(winner_response.getTaskUuid(),
+                               winner_response.getParticipantConnection());
   }
 }
 
-void AuctionInitiatorState::removeBidsForTask(std::vector<BidSubmission> &bid_submissions,
-                                              const std::string &task_uuid) {
-  bid_submissions.erase(
-      std::remove_if(bid_submissions.begin(), bid_submissions.end(),
-                     [&task_uuid](const auto &bid) { return bid.getTaskUuid() == task_uuid; }),
-      bid_submissions.end());
-}
-
-void AuctionInitiatorState::removeBidsForWinner(std::vector<BidSubmission> &bid_submissions,
-                                                const std::string &task_uuid,
-                                                const std::string &winner_connection) {
-  bid_submissions.erase(std::remove_if(bid_submissions.begin(), bid_submissions.end(),
-                                       [&task_uuid, &winner_connection](const auto &bid) {
-                                         return bid.getTaskUuid() == task_uuid &&
-                                                bid.getParticipantConnection() == winner_connection;
-                                       }),
-                        bid_submissions.end());
-}
-
-void AuctionInitiatorState::removeBidsWhichMeetAbilityRequirement(
-    std::vector<BidSubmission> &bid_submissions, const amr::AmrStaticAbility &ability_requirement) {
-  bid_submissions.erase(std::remove_if(bid_submissions.begin(), bid_submissions.end(),
-                                       [&ability_requirement](const auto &bid) {
-                                         return ability_requirement <= bid.getParticipantAbility();
-                                       }),
-                        bid_submissions.end());
-}
-
 std::vector<daisi::material_flow::Task> AuctionInitiatorState::processWinnerAcceptions() {
   std::vector<daisi::material_flow::Task> auctioned_tasks;
 
@@ -70,7 +42,7 @@ std::vector<daisi::material_flow::Task> AuctionInitiatorState::processWinnerAcce
     auto auctioned_task = layered_precedence_graph_->getTask(winner.getTaskUuid());
     auctioned_tasks.push_back(auctioned_task);
 
-    removeBidsForTask(bid_submissions_, winner.getTaskUuid());
+    bid_submissions_.removeTask(winner.getTaskUuid());
   }
 
   winner_acceptions_.clear();
@@ -103,26 +75,21 @@ std::vector<AuctionInitiatorState::Winner> AuctionInitiatorState::selectWinner()
   }
 
   std::vector<AuctionInitiatorState::Winner> winners;
-  auto temp_bids = bid_submissions_;
-
-  while (!temp_bids.empty()) {
-    std::sort(temp_bids.begin(), temp_bids.end(),
-              [](const auto &b1, const auto &b2) { return b1 > b2; });
-
-    auto best_bid = temp_bids.front();
-    const std::string &task_uuid = best_bid.getTaskUuid();
 
-    removeBidsForTask(temp_bids, task_uuid);
+  // Taking the overall best bid and dropping the other bids for its task until no bids are left
+  // is the same as taking the best bid of each task, in the order of these bids
+  for (const BidSubmission *best_bid : bid_submissions_.getBestBidPerTask()) {
+    const std::string &task_uuid = best_bid->getTaskUuid();
 
     if (layered_precedence_graph_->isTaskFree(task_uuid) &&
         !layered_precedence_graph_->isFreeTaskScheduled(task_uuid)) {
       daisi::util::Duration latest_finish_time =
-          best_bid.getMetricsComposition().getCurrentMetrics().getMakespan();
+          best_bid->getMetricsComposition().getCurrentMetrics().getMakespan();
       layered_precedence_graph_->setLatestFinishTime(task_uuid, latest_finish_time);
 
       layered_precedence_graph_->setTaskScheduled(task_uuid);
 
-      winners.push_back({task_uuid, best_bid.getParticipantConnection(), latest_finish_time});
+      winners.push_back({task_uuid, best_bid->getParticipantConnection(), latest_finish_time});
     }
   }
 
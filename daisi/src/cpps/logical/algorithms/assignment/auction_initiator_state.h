@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "bid_index.h"
 #include "cpps/amr/model/amr_static_ability.h"
 #include "cpps/logical/message/auction_based/bid_submission.h"
 #include "cpps/logical/message/auction_based/winner_response.h"
@@ -71,32 +72,9 @@ public:
   void clearWinnerAcceptions();
 
 private:
-  /// @brief Helper method for winner selection to remove bids for a given task from the vector of
-  /// bid submissions.
-  /// @param bid_submissions Vector to remove bids from.
-  /// @param task_uuid Uuid of task that bids should get removed from.
-  static void removeBidsForTask(std::vector<BidSubmission> &bid_submissions,
-                                const std::string &task_uuid);
-
-  /// @brief Helper method for winner selection to remove bids of a given winner from the vector of
-  /// bid submissions.
-  /// @param bid_submissions Vector to remove bids from.
-  /// @param task_uuid Uuid of task that bids should get removed from.
-  /// @param winner_connection Relevant connection string of the winner.
-  static void removeBidsForWinner(std::vector<BidSubmission> &bid_submissions,
-                                  const std::string &task_uuid,
-                                  const std::string &winner_connection);
-
-  /// @brief Helper method for winner selection to remove bids of winners that could also bid on the
-  /// same task due to ability dependencies.
-  /// @param bid_submissions Vector to remove bids from.
-  /// @param ability_requirement Relevant ability
-  static void removeBidsWhichMeetAbilityRequirement(
-      std::vector<BidSubmission> &bid_submissions,
-      const amr::AmrStaticAbility &ability_requirement);
-
-  /// @brief Vector of all open and still valid BidSubmissions in this iteration.
-  std::vector<BidSubmission> bid_submissions_;
+  /// @brief All open and still valid BidSubmissions in this iteration, indexed by task and
+  /// participant.
+  BidIndex bid_submissions_;
 
   /// @brief Vector of all successful WinnerResponse messages that are still relevant in this
   /// iteration.
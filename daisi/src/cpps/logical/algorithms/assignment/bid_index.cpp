@@ -0,0 +1,122 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "bid_index.h"
+
+#include <algorithm>
+
+namespace daisi::cpps::logical {
+
+void BidIndex::add(const BidSubmission &bid_submission) {
+  const auto index = static_cast<uint32_t>(bids_.size());
+  bids_.emplace_back(bid_submission);
+  bids_per_task_[bid_submission.getTaskUuid()].push_back(index);
+  bids_per_participant_[bid_submission.getParticipantConnection()].push_back(index);
+  size_++;
+}
+
+void BidIndex::removeTask(const std::string &task_uuid) {
+  auto it = bids_per_task_.find(task_uuid);
+  if (it == bids_per_task_.end()) {
+    return;
+  }
+
+  for (auto index : it->second) {
+    invalidate(index);
+  }
+  bids_per_task_.erase(it);
+  compact();
+}
+
+void BidIndex::removeParticipant(const std::string &participant_connection) {
+  auto it = bids_per_participant_.find(participant_connection);
+  if (it == bids_per_participant_.end()) {
+    return;
+  }
+
+  for (auto index : it->second) {
+    invalidate(index);
+  }
+  bids_per_participant_.erase(it);
+  compact();
+}
+
+void BidIndex::removeBid(const std::string &task_uuid, const std::string &participant_connection) {
+  auto it = bids_per_task_.find(task_uuid);
+  if (it == bids_per_task_.end()) {
+    return;
+  }
+
+  for (auto index : it->second) {
+    if (bids_[index] && bids_[index]->getParticipantConnection() == participant_connection) {
+      invalidate(index);
+    }
+  }
+  compact();
+}
+
+void BidIndex::clear() {
+  bids_.clear();
+  bids_per_task_.clear();
+  bids_per_participant_.clear();
+  size_ = 0;
+}
+
+std::vector<const BidSubmission *> BidIndex::getBestBidPerTask() const {
+  std::vector<const BidSubmission *> best_bids;
+  best_bids.reserve(bids_per_task_.size());
+
+  for (const auto &[task_uuid, indices] : bids_per_task_) {
+    const BidSubmission *best_bid = nullptr;
+    for (auto index : indices) {
+      const auto &bid = bids_[index];
+      if (bid && (best_bid == nullptr || *bid > *best_bid)) {
+        best_bid = &*bid;
+      }
+    }
+
+    if (best_bid != nullptr) {
+      best_bids.push_back(best_bid);
+    }
+  }
+
+  std::sort(best_bids.begin(), best_bids.end(),
+            [](const auto *b1, const auto *b2) { return *b1 > *b2; });
+  return best_bids;
+}
+
+void BidIndex::invalidate(uint32_t index) {
+  if (bids_[index]) {
+    bids_[index].reset();
+    size_--;
+  }
+}
+
+void BidIndex::compact() {
+  if (bids_.size() < 2 * size_ + 64) {
+    return;
+  }
+
+  auto bids = std::move(bids_);
+  clear();
+  for (auto &bid : bids) {
+    if (bid) {
+      add(*bid);
+    }
+  }
+}
+
+}  // namespace daisi::cpps::logical
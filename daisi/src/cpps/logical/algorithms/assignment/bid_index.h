@@ -0,0 +1,76 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_CPPS_LOGICAL_ALGORITHMS_ASSIGNMENT_BID_INDEX_H_
+#define DAISI_CPPS_LOGICAL_ALGORITHMS_ASSIGNMENT_BID_INDEX_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cpps/logical/message/auction_based/bid_submission.h"
+
+namespace daisi::cpps::logical {
+
+/// @brief Open bid submissions of an auction, indexed by task and by participant.
+///
+/// Removed bids are only invalidated, so that removing all bids of a task or of a participant
+/// only touches these bids. The storage is compacted once most of the bids are invalid.
+class BidIndex {
+public:
+  /// @brief Adding a bid submission.
+  void add(const BidSubmission &bid_submission);
+
+  /// @brief Removing all bids for a task.
+  void removeTask(const std::string &task_uuid);
+
+  /// @brief Removing all bids of a participant.
+  void removeParticipant(const std::string &participant_connection);
+
+  /// @brief Removing the bids of a participant for a task.
+  void removeBid(const std::string &task_uuid, const std::string &participant_connection);
+
+  void clear();
+
+  bool empty() const { return size_ == 0; }
+
+  std::size_t size() const { return size_; }
+
+  /// @brief Determining the best bid for each task.
+  /// @return Best bid of each task, sorted from the best to the worst of these bids.
+  std::vector<const BidSubmission *> getBestBidPerTask() const;
+
+private:
+  void invalidate(uint32_t index);
+
+  /// @brief Removing invalid bids from the storage and the buckets.
+  void compact();
+
+  std::vector<std::optional<BidSubmission>> bids_;
+
+  /// @brief Indices of the bids per task and per participant, including invalidated bids.
+  std::unordered_map<std::string, std::vector<uint32_t>> bids_per_task_;
+  std::unordered_map<std::string, std::vector<uint32_t>> bids_per_participant_;
+
+  /// @brief Number of valid bids.
+  std::size_t size_ = 0;
+};
+
+}  // namespace daisi::cpps::logical
+
+#endif
@@ -37,7 +37,9 @@ namespace daisi::cpps::logical {
 /// McIntire, Mitchell, Ernesto Nunes, and Maria Gini. "Iterated multi-robot auctions for
 /// precedence-constrained task scheduling." Proceedings of the 2016 international conference on
 /// autonomous agents & multiagent systems. 2016.
-class LayeredPrecedenceGraph : private datastructure::DirectedGraph<LPCVertex, std::monostate> {
+class LayeredPrecedenceGraph
+    : private datastructure::DirectedGraph<LPCVertex, std::monostate,
+                                           datastructure::SparseEdgeStorage<std::monostate>> {
 public:
   explicit LayeredPrecedenceGraph(std::shared_ptr<material_flow::MFDLScheduler> scheduler,
                                   const std::string &connection_string);
@@ -63,4 +63,15 @@ struct LPCVertex {
 
 }  // namespace daisi::cpps::logical
 
+namespace std {
+
+template <> struct hash<daisi::cpps::logical::LPCVertex> {
+  std::size_t operator()(const daisi::cpps::logical::LPCVertex &v) const {
+    // consistent with operator==, which compares the task uuids
+    return hash<string>()(v.task.getUuid());
+  }
+};
+
+}  // namespace std
+
 #endif
@@ -31,7 +31,8 @@ template <class> inline constexpr bool kAlwaysFalseV = false;
 
 StnTaskManagement::StnTaskManagement(const AmrDescription &amr_description,
                                      const Topology &topology, const daisi::util::Pose &pose)
-    : AuctionBasedTaskManagement(amr_description, topology, pose) {
+    : AuctionBasedTaskManagement(amr_description, topology, pose),
+      SimpleTemporalNetwork(daisi::datastructure::StnSolverMode::kIncremental) {
   current_total_metrics_.setStartTime(0);
 }
 
@@ -51,17 +52,18 @@ void StnTaskManagement::updateOriginConstraints(const daisi::util::Duration &tim
 
   assert(vertices_[0].isOrigin());
 
+  // latest start/finish constraints are loosened
+  invalidateSolution();
+
   // outgoing edges are
   // [0] origin ---- ( + latest start/finish ) ----> vertex
-  for (auto &edge : adjacency_matrix_[0]) {
-    if (edge.has_value()) {
-      assert(edge->getNumberOfWeights() == 1);
-      auto weight = edge->getWeight();
+  forEachOutgoingEdge(0, [time_difference](size_t /*end_index*/, StnTaskManagementEdge &edge) {
+    assert(edge.getNumberOfWeights() == 1);
+    auto weight = edge.getWeight();
 
-      assert(weight >= 0);
-      edge->updateWeight(0, weight + time_difference);
-    }
-  }
+    assert(weight >= 0);
+    edge.updateWeight(0, weight + time_difference);
+  });
 
   // incoming edges are
   // [0] origin <---- ( - earliest start/finish ) ---- vertex
@@ -69,16 +71,13 @@ void StnTaskManagement::updateOriginConstraints(const daisi::util::Duration &tim
 
   // update [0] with offset_difference
   // update [1] with travel time of new position
-  for (size_t i = 0; i < adjacency_matrix_.size(); ++i) {  // NOLINT(modernize-loop-convert)
-    auto &edge = adjacency_matrix_[i][0];
-    if (edge.has_value()) {
-      auto weight = edge->getWeight();
-      assert(weight <= 0);
-      edge->updateWeight(0, weight - time_difference);
-
-      // TODO: update travel constraints with new position
-    }
-  }
+  forEachIncomingEdge(0, [time_difference](size_t /*start_index*/, StnTaskManagementEdge &edge) {
+    auto weight = edge.getWeight();
+    assert(weight <= 0);
+    edge.updateWeight(0, weight - time_difference);
+
+    // TODO: update travel constraints with new position
+  });
 }
 
 bool StnTaskManagement::hasTasks() const { return current_task_.has_value(); }
@@ -195,7 +194,7 @@ bool StnTaskManagement::addTask(
 
     // double check if its still valid
     if (solve()) {
-      MetricsComposition metrics = newest_task_insert_info_->metrics_composition;
+      MetricsComposition metrics = current_ordering_[newest_task_insert_index_].metrics_composition;
       latest_calculated_insertion_info_ = std::make_pair(metrics, insertion_point);
       added = true;
     }
@@ -350,25 +349,26 @@ void StnTaskManagement::updateCurrentOrdering() {
   Metrics diff_metrics_for_new_task = current_total_metrics_ - previous_total_metrics;
   new_task_it->metrics_composition.setDiffInsertionMetrics(diff_metrics_for_new_task);
   new_task_it->metrics_composition.fixInsertionMetrics();
-  newest_task_insert_info_ = new_task_it;
+  newest_task_insert_index_ = new_task_it - current_ordering_.begin();
 }
 
 std::optional<std::pair<MetricsComposition, std::shared_ptr<StnTaskManagement::StnInsertionPoint>>>
 StnTaskManagement::addBestOrdering(StnTaskManagement::TaskInsertInfo &task_insert_info) {
+  // Insertions only add constraints, so none of them is possible if the network without the
+  // ordering constraints of the new task is inconsistent already
+  if (!SimpleTemporalNetwork::solve()) {
+    return std::nullopt;
+  }
+
   auto insertion_points = calcInsertionPoints();
+  auto results = evaluateInsertionPoints(insertion_points, task_insert_info);
 
   int best_index = -1;
   std::optional<MetricsComposition> best_metrics = std::nullopt;
 
   for (auto i = 0; i < insertion_points.size(); i++) {
-    const auto &point = insertion_points[i];
-
-    StnTaskManagement copy(*this);
-    copy.addOrderingConstraintBetweenTasks(point, task_insert_info);
-    bool success = copy.solve();
-
-    if (success) {
-      MetricsComposition current_metrics = copy.newest_task_insert_info_->metrics_composition;
+    if (results[i].has_value()) {
+      const MetricsComposition &current_metrics = results[i].value();
 
       if (!best_metrics.has_value() || best_metrics.value() < current_metrics) {
         best_metrics = current_metrics;
@@ -380,17 +380,53 @@ StnTaskManagement::addBestOrdering(StnTaskManagement::TaskInsertInfo &task_inser
   if (best_index >= 0) {
     addOrderingConstraintBetweenTasks(insertion_points[best_index], task_insert_info);
     if (bool success = solve(); !success) {
-      throw std::logic_error("failed to solve although it was solvable on the copy");
+      throw std::logic_error("failed to solve although it was solvable during evaluation");
     }
 
     return std::make_pair(
-        newest_task_insert_info_->metrics_composition,
+        current_ordering_[newest_task_insert_index_].metrics_composition,
         std::make_shared<StnTaskManagement::StnInsertionPoint>(insertion_points[best_index]));
   }
 
   return std::nullopt;
 }
 
+std::vector<std::optional<MetricsComposition>> StnTaskManagement::evaluateInsertionPoints(
+    const std::vector<StnInsertionPoint> &insertion_points,
+    StnTaskManagement::TaskInsertInfo &task_insert_info) {
+  std::vector<std::optional<MetricsComposition>> results(insertion_points.size());
+
+  // the ordering is updated and re-sorted when solving, so it is restored as a whole
+  const auto ordering = current_ordering_;
+  const auto total_metrics = current_total_metrics_;
+  const auto newest_task_insert_index = newest_task_insert_index_;
+
+  auto restore = [&]() {
+    rollback();
+    current_ordering_ = ordering;
+    current_total_metrics_ = total_metrics;
+    newest_task_insert_index_ = newest_task_insert_index;
+  };
+
+  for (size_t i = 0; i < insertion_points.size(); i++) {
+    checkpoint();
+
+    try {
+      addOrderingConstraintBetweenTasks(insertion_points[i], task_insert_info);
+      if (solve()) {
+        results[i] = current_ordering_[newest_task_insert_index_].metrics_composition;
+      }
+    } catch (...) {
+      restore();
+      throw;
+    }
+
+    restore();
+  }
+
+  return results;
+}
+
 void StnTaskManagement::addOrderingConstraintBetweenTasks(
     StnTaskManagement::StnInsertionPoint insertion_point,
     StnTaskManagement::TaskInsertInfo &task_insert_info) {
@@ -547,20 +583,16 @@ util::Duration StnTaskManagement::calcGetToStartDuration(const int task_index_to
 
 StnTaskManagement::VertexIterator StnTaskManagement::getVertexIteratorOfOrder(const Order &order,
                                                                               const bool start) {
-  auto it = std::find_if(vertices_.begin(), vertices_.end(),
-                         [&start, &order](const StnTaskManagementVertex &v) {
-                           return v.isStart() == start && order == v.getOrder();
-                         });
+  return vertices_.begin() + getVertexIndexOfOrder(order, start);
+}
 
-  if (it == vertices_.end()) {
+int StnTaskManagement::getVertexIndexOfOrder(const Order &order, const bool start) {
+  const size_t index = getVertexIndex(StnTaskManagementVertex(order, start));
+  if (index == kNoIndex) {
     throw std::runtime_error("Order not part of STN");
   }
 
-  return it;
-}
-
-int StnTaskManagement::getVertexIndexOfOrder(const Order &order, const bool start) {
-  return std::distance(vertices_.begin(), getVertexIteratorOfOrder(order, start));
+  return index;
 }
 
 const StnTaskManagementVertex &StnTaskManagement::getVertexOfOrder(const Order &order,
@@ -102,7 +102,9 @@ protected:
 
   Metrics current_total_metrics_;
 
-  std::vector<TaskInsertInfo>::iterator newest_task_insert_info_;
+  /// Index of the task inserted last in current_ordering_, which stays valid when the ordering is
+  /// copied or restored
+  size_t newest_task_insert_index_ = 0;
 
   daisi::util::Duration time_now_ = 0;
 
@@ -131,6 +133,12 @@ protected:
 
   std::vector<StnInsertionPoint> calcInsertionPoints();
 
+  /// @brief tentatively insert the task at each insertion point and roll back all changes
+  /// afterwards
+  /// @return for each insertion point the metrics of the inserted task if the insertion is possible
+  std::vector<std::optional<MetricsComposition>> evaluateInsertionPoints(
+      const std::vector<StnInsertionPoint> &insertion_points, TaskInsertInfo &task_insert_info);
+
   /// @brief update the metrics compositions of all currently queued tasks as well as the total
   /// metrics. sort the current ordering by start time. method is called after inserting a new task.
   void updateCurrentOrdering();
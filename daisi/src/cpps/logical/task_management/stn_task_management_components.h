@@ -100,22 +100,23 @@ namespace std {
 
 template <> struct hash<daisi::cpps::logical::StnTaskManagementVertex> {
   std::size_t operator()(const daisi::cpps::logical::StnTaskManagementVertex &v) const {
-    std::string repr;
+    const std::string *uuid = nullptr;
 
     if (auto move_order_pval = std::get_if<daisi::material_flow::MoveOrder>(&v.getOrder())) {
-      repr = move_order_pval->getUuid();
+      uuid = &move_order_pval->getUuid();
     } else if (auto action_order_pval =
                    std::get_if<daisi::material_flow::ActionOrder>(&v.getOrder())) {
-      repr = action_order_pval->getUuid();
+      uuid = &action_order_pval->getUuid();
     } else if (auto transport_order_pval =
                    std::get_if<daisi::material_flow::TransportOrder>(&v.getOrder())) {
-      repr = transport_order_pval->getUuid();
+      uuid = &transport_order_pval->getUuid();
     } else {
       throw std::runtime_error("Order type not supported");
     }
 
-    repr += v.isStart() ? "start" : "finish";
-    return hash<string>()(repr);
+    // called for every vertex lookup in the STN, therefore without building a string
+    const std::size_t uuid_hash = hash<string>()(*uuid);
+    return v.isStart() ? uuid_hash : ~uuid_hash;
   }
 };
 
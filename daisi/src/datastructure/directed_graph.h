@@ -17,20 +17,44 @@
 #ifndef DAISI_DATASTRUCTURE_DIRECTED_GRAPH_H_
 #define DAISI_DATASTRUCTURE_DIRECTED_GRAPH_H_
 
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <optional>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "edge_storage.tpp"
+
 namespace daisi::datastructure {
 
-template <typename Vertex, typename Edge> class DirectedGraph {
+template <typename Vertex, typename = void> struct IsHashableVertex : std::false_type {};
+
+template <typename Vertex>
+struct IsHashableVertex<
+    Vertex, std::void_t<decltype(std::hash<Vertex>{}(std::declval<const Vertex &>()))>>
+    : std::true_type {};
+
+/// Directed graph with at most one edge per ordered pair of vertices.
+/// Vertices are looked up via their std::hash specialization if there is one, otherwise by a linear
+/// search. Edges are stored by the slots of their vertices, which are reused after removal, so that
+/// removing a vertex does not reshape the edge storage. The edge storage is selected with
+/// EdgeStorage (see edge_storage.h).
+template <typename Vertex, typename Edge, typename EdgeStorage = DenseEdgeStorage<Edge>>
+class DirectedGraph {
 public:
   DirectedGraph() = default;
-  DirectedGraph(const DirectedGraph &other);
+  DirectedGraph(const DirectedGraph &) = default;
+  DirectedGraph(DirectedGraph &&) noexcept = default;
+  DirectedGraph &operator=(const DirectedGraph &) = default;
+  DirectedGraph &operator=(DirectedGraph &&) noexcept = default;
+  virtual ~DirectedGraph() = default;
 
-  void addVertex(const Vertex &vertex);
-  void removeVertex(const Vertex &vertex);
+  /// Derived graphs override these to keep data which depends on the vertices in sync
+  virtual void addVertex(const Vertex &vertex);
+  virtual void removeVertex(const Vertex &vertex);
   bool hasVertex(const Vertex &vertex) const;
 
   void addEdge(const Vertex &start, const Vertex &end, const Edge &edge);
@@ -44,8 +68,50 @@ public:
   std::vector<std::pair<Vertex, Edge>> getIncomingEdges(const Vertex &end) const;
 
 protected:
+  static constexpr size_t kNoIndex = std::numeric_limits<size_t>::max();
+
+  /// Index of the vertex in vertices_ or kNoIndex
+  size_t getVertexIndex(const Vertex &vertex) const;
+
+  // Access to the edges by the indices of their vertices in vertices_
+
+  Edge *findEdge(size_t start_index, size_t end_index);
+  const Edge *findEdge(size_t start_index, size_t end_index) const;
+
+  /// Adds, replaces, or removes (std::nullopt) the edge
+  void setEdge(size_t start_index, size_t end_index, const std::optional<Edge> &edge);
+
+  /// Calls function(end_index, edge) for every outgoing edge in an unspecified order
+  template <typename Function> void forEachOutgoingEdge(size_t start_index, Function &&function);
+  template <typename Function>
+  void forEachOutgoingEdge(size_t start_index, Function &&function) const;
+
+  /// Calls function(start_index, edge) for every incoming edge in an unspecified order
+  template <typename Function> void forEachIncomingEdge(size_t end_index, Function &&function);
+  template <typename Function>
+  void forEachIncomingEdge(size_t end_index, Function &&function) const;
+
+  /// Vertices in the order of insertion. Members which are compared by operator== must not be
+  /// changed, as the vertex would not be found anymore.
   std::vector<Vertex> vertices_;
-  std::vector<std::vector<std::optional<Edge>>> adjacency_matrix_;
+
+private:
+  static constexpr bool kHashableVertex = IsHashableVertex<Vertex>::value;
+
+  size_t findSlot(const Vertex &vertex) const;
+
+  EdgeStorage edges_;
+
+  /// Slot of the vertex at each index of vertices_
+  std::vector<size_t> slots_;
+
+  /// Index in vertices_ of the vertex in each slot, kNoIndex for free slots
+  std::vector<size_t> indices_;
+
+  std::vector<size_t> free_slots_;
+
+  /// Slots by vertex hash, only used for hashable vertices
+  std::unordered_multimap<size_t, size_t> slots_by_hash_;
 };
 
 }  // namespace daisi::datastructure
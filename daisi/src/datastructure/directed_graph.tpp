@@ -24,174 +24,251 @@
 
 namespace daisi::datastructure {
 
-template <typename Vertex, typename Edge>
-DirectedGraph<Vertex, Edge>::DirectedGraph(const DirectedGraph &other)
-    : vertices_(), adjacency_matrix_(other.adjacency_matrix_) {
-  for (const auto &vertex : other.vertices_) {
-    Vertex new_vertex(vertex);
-    vertices_.push_back(new_vertex);
-  }
-
-  for (size_t i = 0; i < adjacency_matrix_.size(); ++i) {
-    for (size_t j = 0; j < adjacency_matrix_[i].size(); ++j) {
-      if (other.adjacency_matrix_[i][j].has_value()) {
-        Edge new_edge(*other.adjacency_matrix_[i][j]);
-        adjacency_matrix_[i][j] = std::make_optional(new_edge);
-      }
-    }
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::addVertex(const Vertex &vertex) {
+  if (hasVertex(vertex)) {
+    return;
   }
-}
 
-template <typename Vertex, typename Edge>
-void DirectedGraph<Vertex, Edge>::addVertex(const Vertex &vertex) {
-  if (!hasVertex(vertex)) {
-    vertices_.push_back(vertex);
-
-    const int n = vertices_.size();
-    adjacency_matrix_.push_back({});
+  size_t slot = indices_.size();
+  if (free_slots_.empty()) {
+    indices_.push_back(kNoIndex);
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  }
 
-    for (int i = 0; i < n; i++) {
-      adjacency_matrix_[n - 1].push_back(std::nullopt);
-    }
+  edges_.addSlot(slot);
+  indices_[slot] = vertices_.size();
+  slots_.push_back(slot);
+  vertices_.push_back(vertex);
 
-    for (int i = 0; i < n - 1; i++) {
-      adjacency_matrix_[i].push_back(std::nullopt);
-    }
+  if constexpr (kHashableVertex) {
+    slots_by_hash_.emplace(std::hash<Vertex>{}(vertex), slot);
   }
 }
 
-template <typename Vertex, typename Edge>
-void DirectedGraph<Vertex, Edge>::removeVertex(const Vertex &vertex) {
-  auto it = std::find(vertices_.begin(), vertices_.end(), vertex);
-  if (it != vertices_.end()) {
-    const int index = it - vertices_.begin();
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::removeVertex(const Vertex &vertex) {
+  const size_t slot = findSlot(vertex);
+  if (slot == kNoIndex) {
+    return;
+  }
 
-    // removing from vertices
-    vertices_.erase(it);
+  if constexpr (kHashableVertex) {
+    auto [begin, end] = slots_by_hash_.equal_range(std::hash<Vertex>{}(vertex));
+    slots_by_hash_.erase(std::find_if(begin, end, [slot](const auto &pair) {
+      return pair.second == slot;
+    }));
+  }
 
-    // removing outgoing
-    auto it_outgoing = adjacency_matrix_.begin() + index;
-    adjacency_matrix_.erase(it_outgoing);
+  edges_.clearSlot(slot);
 
-    // removing incoming
-    for (auto &others_outgoing : adjacency_matrix_) {
-      auto it_other = others_outgoing.begin() + index;
-      others_outgoing.erase(it_other + index);
-    }
+  const size_t index = indices_[slot];
+  vertices_.erase(vertices_.begin() + index);
+  slots_.erase(slots_.begin() + index);
+  for (size_t i = index; i < slots_.size(); i++) {
+    indices_[slots_[i]] = i;
   }
+
+  indices_[slot] = kNoIndex;
+  free_slots_.push_back(slot);
 }
 
-template <typename Vertex, typename Edge>
-bool DirectedGraph<Vertex, Edge>::hasVertex(const Vertex &vertex) const {
-  auto it = std::find(vertices_.begin(), vertices_.end(), vertex);
-  return it != vertices_.end();
+template <typename Vertex, typename Edge, typename EdgeStorage>
+bool DirectedGraph<Vertex, Edge, EdgeStorage>::hasVertex(const Vertex &vertex) const {
+  return findSlot(vertex) != kNoIndex;
 }
 
-template <typename Vertex, typename Edge>
-void DirectedGraph<Vertex, Edge>::addEdge(const Vertex &start, const Vertex &end,
-                                          const Edge &edge) {
-  if (!hasVertex(start)) {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::addEdge(const Vertex &start, const Vertex &end,
+                                                       const Edge &edge) {
+  const size_t start_slot = findSlot(start);
+  if (start_slot == kNoIndex) {
     throw std::logic_error("Start Vertex does not exist");
   }
 
-  if (!hasVertex(end)) {
+  const size_t end_slot = findSlot(end);
+  if (end_slot == kNoIndex) {
     throw std::logic_error("End Vertex does not exist");
   }
 
-  const int start_index = std::find(vertices_.begin(), vertices_.end(), start) - vertices_.begin();
-  const int end_index = std::find(vertices_.begin(), vertices_.end(), end) - vertices_.begin();
-
-  adjacency_matrix_[start_index][end_index] = edge;
+  edges_.set(start_slot, end_slot, edge);
 }
 
-template <typename Vertex, typename Edge>
-void DirectedGraph<Vertex, Edge>::removeEdge(const Vertex &start, const Vertex &end) {
-  if (hasVertex(start) && hasVertex(end)) {
-    const int start_index =
-        std::find(vertices_.begin(), vertices_.end(), start) - vertices_.begin();
-    const int end_index = std::find(vertices_.begin(), vertices_.end(), end) - vertices_.begin();
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::removeEdge(const Vertex &start, const Vertex &end) {
+  const size_t start_slot = findSlot(start);
+  const size_t end_slot = findSlot(end);
 
-    adjacency_matrix_[start_index][end_index] = std::nullopt;
+  if (start_slot != kNoIndex && end_slot != kNoIndex) {
+    edges_.remove(start_slot, end_slot);
   }
 }
 
-template <typename Vertex, typename Edge>
-bool DirectedGraph<Vertex, Edge>::hasEdge(const Vertex &start, const Vertex &end) const {
-  if (!hasVertex(start) || !hasVertex(end)) {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+bool DirectedGraph<Vertex, Edge, EdgeStorage>::hasEdge(const Vertex &start,
+                                                       const Vertex &end) const {
+  const size_t start_slot = findSlot(start);
+  const size_t end_slot = findSlot(end);
+
+  if (start_slot == kNoIndex || end_slot == kNoIndex) {
     return false;
   }
 
-  const int start_index = std::find(vertices_.begin(), vertices_.end(), start) - vertices_.begin();
-  const int end_index = std::find(vertices_.begin(), vertices_.end(), end) - vertices_.begin();
-
-  return adjacency_matrix_[start_index][end_index].has_value();
+  return edges_.find(start_slot, end_slot) != nullptr;
 }
 
-template <typename Vertex, typename Edge>
-const std::vector<Vertex> &DirectedGraph<Vertex, Edge>::getVertices() const {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+const std::vector<Vertex> &DirectedGraph<Vertex, Edge, EdgeStorage>::getVertices() const {
   return vertices_;
 }
 
-template <typename Vertex, typename Edge>
-Edge &DirectedGraph<Vertex, Edge>::getEdge(const Vertex &start, const Vertex &end) {
-  const auto it_start = std::find(vertices_.begin(), vertices_.end(), start);
-  const auto it_end = std::find(vertices_.begin(), vertices_.end(), end);
+template <typename Vertex, typename Edge, typename EdgeStorage>
+Edge &DirectedGraph<Vertex, Edge, EdgeStorage>::getEdge(const Vertex &start, const Vertex &end) {
+  const size_t start_slot = findSlot(start);
+  const size_t end_slot = findSlot(end);
 
-  if (it_start == vertices_.end()) {
+  if (start_slot == kNoIndex) {
     throw std::logic_error("Start Vertex does not exist");
   }
 
-  if (it_end == vertices_.end()) {
+  if (end_slot == kNoIndex) {
     throw std::logic_error("End Vertex does not exist");
   }
 
-  return adjacency_matrix_[it_start - vertices_.begin()][it_end - vertices_.begin()].value();
+  Edge *edge = edges_.find(start_slot, end_slot);
+  if (edge == nullptr) {
+    throw std::logic_error("Edge does not exist");
+  }
+  return *edge;
 }
 
-template <typename Vertex, typename Edge>
-std::vector<std::pair<Vertex, Edge>> DirectedGraph<Vertex, Edge>::getOutgoingEdges(
-    const Vertex &start) const {
-  const auto it_start = std::find(vertices_.begin(), vertices_.end(), start);
-  if (it_start == vertices_.end()) {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+std::vector<std::pair<Vertex, Edge>>
+DirectedGraph<Vertex, Edge, EdgeStorage>::getOutgoingEdges(const Vertex &start) const {
+  const size_t start_index = getVertexIndex(start);
+  if (start_index == kNoIndex) {
     throw std::logic_error("Start Vertex does not exist");
   }
 
-  const int start_index = it_start - vertices_.begin();
+  std::vector<std::pair<size_t, const Edge *>> edges;
+  forEachOutgoingEdge(start_index,
+                      [&edges](size_t end_index, const Edge &edge) {
+                        edges.emplace_back(end_index, &edge);
+                      });
+  std::sort(edges.begin(), edges.end());
 
   std::vector<std::pair<Vertex, Edge>> outgoing;
-
-  for (size_t i = 0; i < vertices_.size(); i++) {
-    auto opt_edge = adjacency_matrix_[start_index][i];
-
-    if (opt_edge.has_value()) {
-      outgoing.push_back({vertices_[i], opt_edge.value()});
-    }
+  for (const auto &[end_index, edge] : edges) {
+    outgoing.push_back({vertices_[end_index], *edge});
   }
 
   return outgoing;
 }
 
-template <typename Vertex, typename Edge>
-std::vector<std::pair<Vertex, Edge>> DirectedGraph<Vertex, Edge>::getIncomingEdges(
-    const Vertex &end) const {
-  const auto it_end = std::find(vertices_.begin(), vertices_.end(), end);
-  if (it_end == vertices_.end()) {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+std::vector<std::pair<Vertex, Edge>>
+DirectedGraph<Vertex, Edge, EdgeStorage>::getIncomingEdges(const Vertex &end) const {
+  const size_t end_index = getVertexIndex(end);
+  if (end_index == kNoIndex) {
     throw std::logic_error("End Vertex does not exist");
   }
 
-  const int end_index = it_end - vertices_.begin();
+  std::vector<std::pair<size_t, const Edge *>> edges;
+  forEachIncomingEdge(end_index,
+                      [&edges](size_t start_index, const Edge &edge) {
+                        edges.emplace_back(start_index, &edge);
+                      });
+  std::sort(edges.begin(), edges.end());
 
   std::vector<std::pair<Vertex, Edge>> incoming;
+  for (const auto &[start_index, edge] : edges) {
+    incoming.push_back({vertices_[start_index], *edge});
+  }
 
-  for (size_t i = 0; i < vertices_.size(); i++) {
-    auto opt_edge = adjacency_matrix_[i][end_index];
+  return incoming;
+}
 
-    if (opt_edge.has_value()) {
-      incoming.push_back({vertices_[i], opt_edge.value()});
-    }
+template <typename Vertex, typename Edge, typename EdgeStorage>
+size_t DirectedGraph<Vertex, Edge, EdgeStorage>::getVertexIndex(const Vertex &vertex) const {
+  const size_t slot = findSlot(vertex);
+  return slot == kNoIndex ? kNoIndex : indices_[slot];
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+Edge *DirectedGraph<Vertex, Edge, EdgeStorage>::findEdge(size_t start_index, size_t end_index) {
+  return edges_.find(slots_[start_index], slots_[end_index]);
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+const Edge *DirectedGraph<Vertex, Edge, EdgeStorage>::findEdge(size_t start_index,
+                                                               size_t end_index) const {
+  return edges_.find(slots_[start_index], slots_[end_index]);
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::setEdge(size_t start_index, size_t end_index,
+                                                       const std::optional<Edge> &edge) {
+  if (edge.has_value()) {
+    edges_.set(slots_[start_index], slots_[end_index], edge.value());
+  } else {
+    edges_.remove(slots_[start_index], slots_[end_index]);
   }
+}
 
-  return incoming;
+template <typename Vertex, typename Edge, typename EdgeStorage>
+template <typename Function>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::forEachOutgoingEdge(size_t start_index,
+                                                                   Function &&function) {
+  edges_.forEachOutgoing(slots_[start_index], [this, &function](size_t end_slot, Edge &edge) {
+    function(indices_[end_slot], edge);
+  });
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+template <typename Function>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::forEachOutgoingEdge(size_t start_index,
+                                                                   Function &&function) const {
+  edges_.forEachOutgoing(slots_[start_index],
+                         [this, &function](size_t end_slot, const Edge &edge) {
+                           function(indices_[end_slot], edge);
+                         });
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+template <typename Function>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::forEachIncomingEdge(size_t end_index,
+                                                                   Function &&function) {
+  edges_.forEachIncoming(slots_[end_index], [this, &function](size_t start_slot, Edge &edge) {
+    function(indices_[start_slot], edge);
+  });
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+template <typename Function>
+void DirectedGraph<Vertex, Edge, EdgeStorage>::forEachIncomingEdge(size_t end_index,
+                                                                   Function &&function) const {
+  edges_.forEachIncoming(slots_[end_index],
+                         [this, &function](size_t start_slot, const Edge &edge) {
+                           function(indices_[start_slot], edge);
+                         });
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+size_t DirectedGraph<Vertex, Edge, EdgeStorage>::findSlot(const Vertex &vertex) const {
+  if constexpr (kHashableVertex) {
+    auto [begin, end] = slots_by_hash_.equal_range(std::hash<Vertex>{}(vertex));
+    for (auto it = begin; it != end; ++it) {
+      if (vertices_[indices_[it->second]] == vertex) {
+        return it->second;
+      }
+    }
+    return kNoIndex;
+  } else {
+    auto it = std::find(vertices_.begin(), vertices_.end(), vertex);
+    return it == vertices_.end() ? kNoIndex : slots_[it - vertices_.begin()];
+  }
 }
 
 }  // namespace daisi::datastructure
@@ -0,0 +1,88 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_DATASTRUCTURE_EDGE_STORAGE_H_
+#define DAISI_DATASTRUCTURE_EDGE_STORAGE_H_
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace daisi::datastructure {
+
+/// Edge storage policies of DirectedGraph. Edges are addressed by vertex slots, which stay the
+/// same for the lifetime of a vertex and are reused after the vertex was removed.
+/// All policies provide the same interface:
+///   addSlot(slot)          makes slot usable, slot is either reused or the next unused slot
+///   clearSlot(slot)        removes all edges from and to slot
+///   find(start, end)       edge or nullptr
+///   set(start, end, edge)  adds or replaces an edge
+///   remove(start, end)
+///   forEachOutgoing(start, function(end, edge))
+///   forEachIncoming(end, function(start, edge))
+
+/// Adjacency matrix over all slots. Edge lookup is O(1), iterating the edges of a vertex and
+/// clearing a slot is O(number of slots). Suited for dense graphs like simple temporal networks.
+template <typename Edge> class DenseEdgeStorage {
+public:
+  void addSlot(size_t slot);
+  void clearSlot(size_t slot);
+
+  Edge *find(size_t start, size_t end);
+  const Edge *find(size_t start, size_t end) const;
+
+  void set(size_t start, size_t end, const Edge &edge);
+  void remove(size_t start, size_t end);
+
+  template <typename Function> void forEachOutgoing(size_t start, Function &&function);
+  template <typename Function> void forEachOutgoing(size_t start, Function &&function) const;
+  template <typename Function> void forEachIncoming(size_t end, Function &&function);
+  template <typename Function> void forEachIncoming(size_t end, Function &&function) const;
+
+private:
+  std::vector<std::vector<std::optional<Edge>>> matrix_;
+};
+
+/// Adjacency lists per slot. Edge lookup is O(out-degree), iterating the edges of a vertex and
+/// clearing a slot is O(degree). Suited for sparse graphs like precedence graphs.
+template <typename Edge> class SparseEdgeStorage {
+public:
+  void addSlot(size_t slot);
+  void clearSlot(size_t slot);
+
+  Edge *find(size_t start, size_t end);
+  const Edge *find(size_t start, size_t end) const;
+
+  void set(size_t start, size_t end, const Edge &edge);
+  void remove(size_t start, size_t end);
+
+  template <typename Function> void forEachOutgoing(size_t start, Function &&function);
+  template <typename Function> void forEachOutgoing(size_t start, Function &&function) const;
+  template <typename Function> void forEachIncoming(size_t end, Function &&function);
+  template <typename Function> void forEachIncoming(size_t end, Function &&function) const;
+
+private:
+  /// End slot and edge for every edge starting at a slot
+  std::vector<std::vector<std::pair<size_t, Edge>>> outgoing_;
+
+  /// Start slots of all edges ending at a slot
+  std::vector<std::vector<size_t>> incoming_;
+};
+
+}  // namespace daisi::datastructure
+
+#endif
@@ -0,0 +1,209 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_DATASTRUCTURE_EDGE_STORAGE_IMPL_H_
+#define DAISI_DATASTRUCTURE_EDGE_STORAGE_IMPL_H_
+
+#include <algorithm>
+
+#include "edge_storage.h"
+
+namespace daisi::datastructure {
+
+template <typename Edge> void DenseEdgeStorage<Edge>::addSlot(size_t slot) {
+  if (slot < matrix_.size()) {
+    // reused slots were cleared on removal
+    return;
+  }
+
+  for (auto &row : matrix_) {
+    row.resize(slot + 1);
+  }
+  matrix_.resize(slot + 1, std::vector<std::optional<Edge>>(slot + 1));
+}
+
+template <typename Edge> void DenseEdgeStorage<Edge>::clearSlot(size_t slot) {
+  for (auto &edge : matrix_[slot]) {
+    edge = std::nullopt;
+  }
+  for (auto &row : matrix_) {
+    row[slot] = std::nullopt;
+  }
+}
+
+template <typename Edge> Edge *DenseEdgeStorage<Edge>::find(size_t start, size_t end) {
+  auto &edge = matrix_[start][end];
+  return edge.has_value() ? &edge.value() : nullptr;
+}
+
+template <typename Edge> const Edge *DenseEdgeStorage<Edge>::find(size_t start, size_t end) const {
+  const auto &edge = matrix_[start][end];
+  return edge.has_value() ? &edge.value() : nullptr;
+}
+
+template <typename Edge>
+void DenseEdgeStorage<Edge>::set(size_t start, size_t end, const Edge &edge) {
+  matrix_[start][end] = edge;
+}
+
+template <typename Edge> void DenseEdgeStorage<Edge>::remove(size_t start, size_t end) {
+  matrix_[start][end] = std::nullopt;
+}
+
+template <typename Edge>
+template <typename Function>
+void DenseEdgeStorage<Edge>::forEachOutgoing(size_t start, Function &&function) {
+  auto &row = matrix_[start];
+  for (size_t end = 0; end < row.size(); end++) {
+    if (row[end].has_value()) {
+      function(end, row[end].value());
+    }
+  }
+}
+
+template <typename Edge>
+template <typename Function>
+void DenseEdgeStorage<Edge>::forEachOutgoing(size_t start, Function &&function) const {
+  const auto &row = matrix_[start];
+  for (size_t end = 0; end < row.size(); end++) {
+    if (row[end].has_value()) {
+      function(end, row[end].value());
+    }
+  }
+}
+
+template <typename Edge>
+template <typename Function>
+void DenseEdgeStorage<Edge>::forEachIncoming(size_t end, Function &&function) {
+  for (size_t start = 0; start < matrix_.size(); start++) {
+    if (matrix_[start][end].has_value()) {
+      function(start, matrix_[start][end].value());
+    }
+  }
+}
+
+template <typename Edge>
+template <typename Function>
+void DenseEdgeStorage<Edge>::forEachIncoming(size_t end, Function &&function) const {
+  for (size_t start = 0; start < matrix_.size(); start++) {
+    if (matrix_[start][end].has_value()) {
+      function(start, matrix_[start][end].value());
+    }
+  }
+}
+
+template <typename Edge> void SparseEdgeStorage<Edge>::addSlot(size_t slot) {
+  if (slot >= outgoing_.size()) {
+    outgoing_.resize(slot + 1);
+    incoming_.resize(slot + 1);
+  }
+}
+
+template <typename Edge> void SparseEdgeStorage<Edge>::clearSlot(size_t slot) {
+  for (const auto &[end, edge] : outgoing_[slot]) {
+    auto &starts = incoming_[end];
+    starts.erase(std::remove(starts.begin(), starts.end(), slot), starts.end());
+  }
+
+  for (const size_t start : incoming_[slot]) {
+    auto &edges = outgoing_[start];
+    edges.erase(std::remove_if(edges.begin(), edges.end(),
+                               [slot](const auto &pair) { return pair.first == slot; }),
+                edges.end());
+  }
+
+  outgoing_[slot].clear();
+  incoming_[slot].clear();
+}
+
+template <typename Edge> Edge *SparseEdgeStorage<Edge>::find(size_t start, size_t end) {
+  for (auto &[other_end, edge] : outgoing_[start]) {
+    if (other_end == end) {
+      return &edge;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Edge>
+const Edge *SparseEdgeStorage<Edge>::find(size_t start, size_t end) const {
+  for (const auto &[other_end, edge] : outgoing_[start]) {
+    if (other_end == end) {
+      return &edge;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Edge>
+void SparseEdgeStorage<Edge>::set(size_t start, size_t end, const Edge &edge) {
+  if (Edge *existing = find(start, end)) {
+    *existing = edge;
+    return;
+  }
+
+  outgoing_[start].emplace_back(end, edge);
+  incoming_[end].push_back(start);
+}
+
+template <typename Edge> void SparseEdgeStorage<Edge>::remove(size_t start, size_t end) {
+  auto &edges = outgoing_[start];
+  auto it = std::find_if(edges.begin(), edges.end(),
+                         [end](const auto &pair) { return pair.first == end; });
+  if (it == edges.end()) {
+    return;
+  }
+  edges.erase(it);
+
+  auto &starts = incoming_[end];
+  starts.erase(std::find(starts.begin(), starts.end(), start));
+}
+
+template <typename Edge>
+template <typename Function>
+void SparseEdgeStorage<Edge>::forEachOutgoing(size_t start, Function &&function) {
+  for (auto &[end, edge] : outgoing_[start]) {
+    function(end, edge);
+  }
+}
+
+template <typename Edge>
+template <typename Function>
+void SparseEdgeStorage<Edge>::forEachOutgoing(size_t start, Function &&function) const {
+  for (const auto &[end, edge] : outgoing_[start]) {
+    function(end, edge);
+  }
+}
+
+template <typename Edge>
+template <typename Function>
+void SparseEdgeStorage<Edge>::forEachIncoming(size_t end, Function &&function) {
+  for (const size_t start : incoming_[end]) {
+    function(start, *find(start, end));
+  }
+}
+
+template <typename Edge>
+template <typename Function>
+void SparseEdgeStorage<Edge>::forEachIncoming(size_t end, Function &&function) const {
+  for (const size_t start : incoming_[end]) {
+    function(start, *find(start, end));
+  }
+}
+
+}  // namespace daisi::datastructure
+
+#endif
@@ -18,17 +18,32 @@
 #define DAISI_DATASTRUCTURE_SIMPLE_TEMPORAL_NETWORK_H_
 
 #include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "weighted_directed_graph.tpp"
 
 namespace daisi::datastructure {
 
-template <typename Vertex, typename Edge>
-class SimpleTemporalNetwork : public WeightedDirectedGraph<Vertex, Edge> {
+/// Algorithm used to compute the distance graph in SimpleTemporalNetwork::solve()
+enum class StnSolverMode {
+  /// Floyd-Warshall over the whole network on every solve, O(n^3)
+  kFloydWarshall,
+
+  /// Only propagates edges which were added or tightened since the last consistent solve, O(n^2)
+  /// per edge. Falls back to Floyd-Warshall after an edge was loosened or a vertex was removed.
+  kIncremental,
+};
+
+template <typename Vertex, typename Edge, typename EdgeStorage = DenseEdgeStorage<Edge>>
+class SimpleTemporalNetwork : public WeightedDirectedGraph<Vertex, Edge, EdgeStorage> {
 public:
-  SimpleTemporalNetwork();
+  explicit SimpleTemporalNetwork(StnSolverMode solver_mode = StnSolverMode::kFloydWarshall);
   virtual ~SimpleTemporalNetwork() = default;
 
+  void addVertex(const Vertex &vertex) override;
+
   void addBinaryConstraint(const Vertex &start, const Vertex &end,
                            const std::optional<double> &lower_bound,
                            const std::optional<double> &upper_bound);
@@ -40,7 +55,7 @@ public:
                                   const std::optional<double> &lower_bound,
                                   const std::optional<double> &upper_bound);
 
-  void removeVertex(const Vertex &vertex);
+  void removeVertex(const Vertex &vertex) override;
 
   Vertex &getOrigin();
   std::vector<std::pair<Vertex, double>> getEarliestSolution();
@@ -48,8 +63,67 @@ public:
 
   virtual bool solve();
 
+  StnSolverMode getSolverMode() const;
+
+  /// Starts recording changes, so that the network including its last solution can be restored
+  /// with rollback(). Only the rows of the distance graph changed by incremental solving are saved,
+  /// the distance graph is only kept as a whole if a Floyd-Warshall solve replaces it.
+  /// Vertices must not be removed until the checkpoint is rolled back or released.
+  void checkpoint();
+
+  /// Restores the network to the state of the last checkpoint and releases it
+  void rollback();
+
+  /// Keeps all changes since the last checkpoint and releases it
+  void releaseCheckpoint();
+
+  bool hasCheckpoint() const;
+
 protected:
+  /// Must be called if edge weights are changed without the methods of this class, so that the
+  /// next solve recomputes the distance graph from scratch
+  void invalidateSolution();
+
   std::vector<std::vector<double>> d_graph_;
+
+private:
+  struct Checkpoint {
+    size_t number_of_vertices;
+    size_t number_of_distances;
+    bool solution_valid;
+    std::vector<std::pair<size_t, size_t>> tightened_edges;
+
+    /// Previous state of changed edges in the order of the changes
+    std::vector<std::tuple<size_t, size_t, std::optional<Edge>>> edge_changes;
+
+    /// Rows of the distance graph changed by incremental solving, each saved before its first
+    /// change. The previous rows are stored one after another in previous_distances.
+    std::vector<size_t> changed_rows;
+    std::vector<double> previous_distances;
+    std::vector<bool> row_saved;
+
+    /// Distance graph at the checkpoint, only kept if Floyd-Warshall replaced it as a whole
+    std::optional<std::vector<std::vector<double>>> d_graph;
+  };
+
+  void recordEdgeForRollback(const Vertex &start, const Vertex &end);
+  void recordDistanceRowForRollback(size_t row);
+  double getWeightOrInfinity(const Vertex &start, const Vertex &end);
+  void recordWeightChange(const Vertex &start, const Vertex &end, double previous_weight);
+
+  bool solveFloydWarshall();
+  bool solveIncremental();
+
+  StnSolverMode solver_mode_;
+
+  /// Whether d_graph_ is the distance graph of the consistent network before the changes in
+  /// tightened_edges_
+  bool solution_valid_ = false;
+
+  /// Vertex indices of edges which were added or tightened since the last solve
+  std::vector<std::pair<size_t, size_t>> tightened_edges_;
+
+  std::optional<Checkpoint> checkpoint_;
 };
 
 }  // namespace daisi::datastructure
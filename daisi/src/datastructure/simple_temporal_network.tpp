@@ -17,29 +17,61 @@
 #ifndef DAISI_DATASTRUCTURE_SIMPLE_TEMPORAL_NETWORK_IMPL_H_
 #define DAISI_DATASTRUCTURE_SIMPLE_TEMPORAL_NETWORK_IMPL_H_
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 #include "simple_temporal_network.h"
 
 namespace daisi::datastructure {
-template <typename Vertex, typename Edge>
-SimpleTemporalNetwork<Vertex, Edge>::SimpleTemporalNetwork() {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::SimpleTemporalNetwork(StnSolverMode solver_mode)
+    : solver_mode_(solver_mode) {
   this->addVertex(Vertex::createOrigin());
 }
 
-template <typename Vertex, typename Edge>
-void SimpleTemporalNetwork<Vertex, Edge>::removeVertex(const Vertex &vertex) {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::addVertex(const Vertex &vertex) {
+  if (this->hasVertex(vertex)) {
+    return;
+  }
+
+  WeightedDirectedGraph<Vertex, Edge, EdgeStorage>::addVertex(vertex);
+
+  if (solution_valid_) {
+    // a vertex without edges is unconstrained
+    const double inf = std::numeric_limits<double>::infinity();
+    for (auto &row : d_graph_) {
+      row.push_back(inf);
+    }
+    d_graph_.emplace_back(this->vertices_.size(), inf);
+    d_graph_.back().back() = 0.0;
+  }
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::removeVertex(const Vertex &vertex) {
   if (vertex == this->vertices_[0]) {
     throw std::invalid_argument("Cannot remove origin from Simple Temporal Network");
   }
 
-  WeightedDirectedGraph<Vertex, Edge>::removeVertex(vertex);
+  if (checkpoint_.has_value()) {
+    throw std::logic_error("Cannot remove vertices while a checkpoint is active");
+  }
+
+  // shortest paths via the removed vertex get longer
+  invalidateSolution();
+
+  WeightedDirectedGraph<Vertex, Edge, EdgeStorage>::removeVertex(vertex);
 }
 
-template <typename Vertex, typename Edge> Vertex &SimpleTemporalNetwork<Vertex, Edge>::getOrigin() {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+Vertex &SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::getOrigin() {
   return this->vertices_.front();
 }
 
-template <typename Vertex, typename Edge>
-void SimpleTemporalNetwork<Vertex, Edge>::addBinaryConstraint(
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::addBinaryConstraint(
     const Vertex &start, const Vertex &end, const std::optional<double> &lower_bound,
     const std::optional<double> &upper_bound) {
   if (!this->hasVertex(start) || !this->hasVertex(end)) {
@@ -47,6 +79,8 @@ void SimpleTemporalNetwork<Vertex, Edge>::addBinaryConstraint(
   }
 
   if (upper_bound.has_value()) {
+    const double previous_weight = getWeightOrInfinity(start, end);
+    recordEdgeForRollback(start, end);
     if (this->hasEdge(start, end)) {
       this->getEdge(start, end).addWeight(upper_bound.value());
     } else {
@@ -54,9 +88,12 @@ void SimpleTemporalNetwork<Vertex, Edge>::addBinaryConstraint(
       edge.addWeight(upper_bound.value());
       this->addEdge(start, end, edge);
     }
+    recordWeightChange(start, end, previous_weight);
   }
 
   if (lower_bound.has_value()) {
+    const double previous_weight = getWeightOrInfinity(end, start);
+    recordEdgeForRollback(end, start);
     if (this->hasEdge(end, start)) {
       this->getEdge(end, start).addWeight(-lower_bound.value());
     } else {
@@ -64,11 +101,12 @@ void SimpleTemporalNetwork<Vertex, Edge>::addBinaryConstraint(
       edge.addWeight(-lower_bound.value());
       this->addEdge(end, start, edge);
     }
+    recordWeightChange(end, start, previous_weight);
   }
 }
 
-template <typename Vertex, typename Edge>
-void SimpleTemporalNetwork<Vertex, Edge>::updateLastBinaryConstraint(
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::updateLastBinaryConstraint(
     const Vertex &start, const Vertex &end, const std::optional<double> &lower_bound,
     const std::optional<double> &upper_bound) {
   if (!this->hasVertex(start) || !this->hasVertex(end)) {
@@ -77,8 +115,11 @@ void SimpleTemporalNetwork<Vertex, Edge>::updateLastBinaryConstraint(
 
   if (upper_bound.has_value()) {
     if (this->hasEdge(start, end)) {
+      const double previous_weight = this->getEdge(start, end).getWeight();
+      recordEdgeForRollback(start, end);
       this->getEdge(start, end).removeLastWeight();
       this->getEdge(start, end).addWeight(upper_bound.value());
+      recordWeightChange(start, end, previous_weight);
     } else {
       throw std::invalid_argument("Bound cannot be updated if no edge exists");
     }
@@ -86,23 +127,170 @@ void SimpleTemporalNetwork<Vertex, Edge>::updateLastBinaryConstraint(
 
   if (lower_bound.has_value()) {
     if (this->hasEdge(end, start)) {
+      const double previous_weight = this->getEdge(end, start).getWeight();
+      recordEdgeForRollback(end, start);
       this->getEdge(end, start).removeLastWeight();
       this->getEdge(end, start).addWeight(-lower_bound.value());
+      recordWeightChange(end, start, previous_weight);
     } else {
       throw std::invalid_argument("Bound cannot be updated if no edge exists");
     }
   }
 }
 
-template <typename Vertex, typename Edge>
-void SimpleTemporalNetwork<Vertex, Edge>::addUnaryConstraint(
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::addUnaryConstraint(
     const Vertex &vertex, const std::optional<double> &lower_bound,
     const std::optional<double> &upper_bound) {
   addBinaryConstraint(getOrigin(), vertex, lower_bound, upper_bound);
 }
 
-template <typename Vertex, typename Edge> bool SimpleTemporalNetwork<Vertex, Edge>::solve() {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+bool SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::solve() {
+  if (solver_mode_ == StnSolverMode::kIncremental && solution_valid_) {
+    return solveIncremental();
+  }
+
+  return solveFloydWarshall();
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+StnSolverMode SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::getSolverMode() const {
+  return solver_mode_;
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::invalidateSolution() {
+  solution_valid_ = false;
+  tightened_edges_.clear();
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::checkpoint() {
+  if (checkpoint_.has_value()) {
+    throw std::logic_error("Checkpoints cannot be nested");
+  }
+
+  checkpoint_.emplace();
+  checkpoint_->number_of_vertices = this->vertices_.size();
+  checkpoint_->number_of_distances = d_graph_.size();
+  checkpoint_->solution_valid = solution_valid_;
+  checkpoint_->tightened_edges = tightened_edges_;
+  checkpoint_->row_saved.resize(d_graph_.size(), false);
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::rollback() {
+  if (!checkpoint_.has_value()) {
+    throw std::logic_error("No checkpoint to roll back to");
+  }
+
+  auto &edge_changes = checkpoint_->edge_changes;
+  for (auto it = edge_changes.rbegin(); it != edge_changes.rend(); ++it) {
+    auto &[start, end, previous_edge] = *it;
+    this->setEdge(start, end, previous_edge);
+  }
+
+  // vertices are only appended while a checkpoint is active
+  while (this->vertices_.size() > checkpoint_->number_of_vertices) {
+    WeightedDirectedGraph<Vertex, Edge, EdgeStorage>::removeVertex(this->vertices_.back());
+  }
+
+  if (checkpoint_->d_graph.has_value()) {
+    d_graph_ = std::move(checkpoint_->d_graph.value());
+  } else {
+    // rows and columns of vertices added since the checkpoint were appended
+    const size_t n = checkpoint_->number_of_distances;
+    d_graph_.resize(n);
+    for (auto &row : d_graph_) {
+      row.resize(n);
+    }
+
+    const auto &changed_rows = checkpoint_->changed_rows;
+    for (size_t k = 0; k < changed_rows.size(); k++) {
+      const auto previous_row = checkpoint_->previous_distances.begin() + k * n;
+      std::copy(previous_row, previous_row + n, d_graph_[changed_rows[k]].begin());
+    }
+  }
+
+  solution_valid_ = checkpoint_->solution_valid;
+  tightened_edges_ = std::move(checkpoint_->tightened_edges);
+  checkpoint_ = std::nullopt;
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::releaseCheckpoint() {
+  checkpoint_ = std::nullopt;
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+bool SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::hasCheckpoint() const {
+  return checkpoint_.has_value();
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::recordEdgeForRollback(const Vertex &start,
+                                                                             const Vertex &end) {
+  if (checkpoint_.has_value()) {
+    const size_t start_index = this->getVertexIndex(start);
+    const size_t end_index = this->getVertexIndex(end);
+    const Edge *edge = this->findEdge(start_index, end_index);
+    checkpoint_->edge_changes.emplace_back(
+        start_index, end_index, edge != nullptr ? std::make_optional(*edge) : std::nullopt);
+  }
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::recordDistanceRowForRollback(
+    const size_t row) {
+  // rows of vertices added since the checkpoint are removed on rollback anyway, and a distance
+  // graph replaced by Floyd-Warshall is restored as a whole
+  if (!checkpoint_.has_value() || checkpoint_->d_graph.has_value() ||
+      row >= checkpoint_->number_of_distances || checkpoint_->row_saved[row]) {
+    return;
+  }
+
+  const auto &distances = d_graph_[row];
+  checkpoint_->row_saved[row] = true;
+  checkpoint_->changed_rows.push_back(row);
+  checkpoint_->previous_distances.insert(checkpoint_->previous_distances.end(), distances.begin(),
+                                         distances.begin() + checkpoint_->number_of_distances);
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+double SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::getWeightOrInfinity(const Vertex &start,
+                                                                             const Vertex &end) {
+  if (this->hasEdge(start, end)) {
+    return this->getEdge(start, end).getWeight();
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+void SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::recordWeightChange(const Vertex &start,
+                                                                          const Vertex &end,
+                                                                          double previous_weight) {
+  if (solver_mode_ != StnSolverMode::kIncremental || !solution_valid_) {
+    return;
+  }
+
+  const double weight = this->getEdge(start, end).getWeight();
+  if (weight < previous_weight) {
+    tightened_edges_.emplace_back(this->getVertexIndex(start), this->getVertexIndex(end));
+  } else if (weight > previous_weight) {
+    // loosening can make arbitrary shortest paths longer
+    invalidateSolution();
+  }
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+bool SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::solveFloydWarshall() {
+  if (checkpoint_.has_value() && !checkpoint_->d_graph.has_value()) {
+    checkpoint_->d_graph = std::move(d_graph_);
+  }
+
   d_graph_ = this->floydWarshall();
+  invalidateSolution();
 
   for (size_t i = 0; i < this->vertices_.size(); i++) {
     if (d_graph_[i][i] != 0) {
@@ -110,11 +298,67 @@ template <typename Vertex, typename Edge> bool SimpleTemporalNetwork<Vertex, Edg
     }
   }
 
+  solution_valid_ = true;
+  return true;
+}
+
+template <typename Vertex, typename Edge, typename EdgeStorage>
+bool SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::solveIncremental() {
+  const size_t n = d_graph_.size();
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<size_t> affected_targets;
+
+  for (const auto &[start, end] : tightened_edges_) {
+    const double weight = this->findEdge(start, end)->getWeight();
+    if (weight >= d_graph_[start][end]) {
+      continue;
+    }
+
+    // the new edge closes a negative cycle with the shortest path back to its start
+    if (d_graph_[end][start] + weight < 0) {
+      invalidateSolution();
+      return false;
+    }
+
+    // A path i -> j can only get shorter via the new edge if both i -> end and start -> j get
+    // shorter. Row end and column start are not changed by the relaxation, as this would require a
+    // negative cycle. Therefore the matrix can be updated in place, while row start is read before.
+    const auto &from_start = d_graph_[start];
+    const auto &from_end = d_graph_[end];
+    affected_targets.clear();
+    for (size_t j = 0; j < n; j++) {
+      if (weight + from_end[j] < from_start[j]) {
+        affected_targets.push_back(j);
+      }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      const double to_start = d_graph_[i][start];
+      if (to_start == inf || to_start + weight >= d_graph_[i][end]) {
+        continue;
+      }
+
+      // the distance to end gets shorter at least
+      recordDistanceRowForRollback(i);
+
+      const double via_edge = to_start + weight;
+      auto &row = d_graph_[i];
+      for (const size_t j : affected_targets) {
+        const double alternative = via_edge + from_end[j];
+        if (row[j] > alternative) {
+          row[j] = alternative;
+        }
+      }
+    }
+  }
+
+  tightened_edges_.clear();
   return true;
 }
 
-template <typename Vertex, typename Edge>
-std::vector<std::pair<Vertex, double>> SimpleTemporalNetwork<Vertex, Edge>::getEarliestSolution() {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+std::vector<std::pair<Vertex, double>>
+SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::getEarliestSolution() {
   std::vector<std::pair<Vertex, double>> solution;
   for (size_t i = 0; i < this->vertices_.size(); i++) {
     solution.push_back({this->vertices_[i], -d_graph_[i][0]});
@@ -122,8 +366,9 @@ std::vector<std::pair<Vertex, double>> SimpleTemporalNetwork<Vertex, Edge>::getE
   return solution;
 }
 
-template <typename Vertex, typename Edge>
-std::vector<std::pair<Vertex, double>> SimpleTemporalNetwork<Vertex, Edge>::getLatestSolution() {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+std::vector<std::pair<Vertex, double>>
+SimpleTemporalNetwork<Vertex, Edge, EdgeStorage>::getLatestSolution() {
   std::vector<std::pair<Vertex, double>> solution;
   for (size_t i = 0; i < this->vertices_.size(); i++) {
     solution.push_back({this->vertices_[i], d_graph_[0][i]});
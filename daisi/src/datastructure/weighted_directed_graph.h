@@ -21,8 +21,8 @@
 
 namespace daisi::datastructure {
 
-template <typename Vertex, typename Edge>
-class WeightedDirectedGraph : public DirectedGraph<Vertex, Edge> {
+template <typename Vertex, typename Edge, typename EdgeStorage = DenseEdgeStorage<Edge>>
+class WeightedDirectedGraph : public DirectedGraph<Vertex, Edge, EdgeStorage> {
 public:
   WeightedDirectedGraph() = default;
 
@@ -23,34 +23,25 @@
 
 namespace daisi::datastructure {
 
-template <typename Vertex, typename Edge>
-std::vector<std::vector<double>> WeightedDirectedGraph<Vertex, Edge>::getWeightMatrix() const {
-  double inf = std::numeric_limits<double>::infinity();
-  std::vector<std::vector<double>> matrix;
+template <typename Vertex, typename Edge, typename EdgeStorage>
+std::vector<std::vector<double>>
+WeightedDirectedGraph<Vertex, Edge, EdgeStorage>::getWeightMatrix() const {
+  const double inf = std::numeric_limits<double>::infinity();
+  const size_t n = this->vertices_.size();
+  std::vector<std::vector<double>> matrix(n, std::vector<double>(n, inf));
 
-  for (size_t i = 0; i < this->vertices_.size(); i++) {
-    matrix.push_back({});
-
-    for (size_t k = 0; k < this->vertices_.size(); k++) {
-      auto &opt_edge = this->adjacency_matrix_[i][k];
-
-      if (opt_edge.has_value()) {
-        matrix[i].push_back(opt_edge.value().getWeight());
-      } else {
-        if (i == k) {
-          matrix[i].push_back(0.0);
-        } else {
-          matrix[i].push_back(inf);
-        }
-      }
-    }
+  for (size_t i = 0; i < n; i++) {
+    matrix[i][i] = 0.0;
+    this->forEachOutgoingEdge(
+        i, [&row = matrix[i]](size_t k, const Edge &edge) { row[k] = edge.getWeight(); });
   }
 
   return matrix;
 }
 
-template <typename Vertex, typename Edge>
-std::vector<std::vector<double>> WeightedDirectedGraph<Vertex, Edge>::floydWarshall() const {
+template <typename Vertex, typename Edge, typename EdgeStorage>
+std::vector<std::vector<double>>
+WeightedDirectedGraph<Vertex, Edge, EdgeStorage>::floydWarshall() const {
   const int n = this->vertices_.size();
 
   auto dist = this->getWeightMatrix();
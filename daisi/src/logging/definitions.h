@@ -22,10 +22,13 @@
 #include <functional>
 #include <map>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
+#include <variant>
+#include <vector>
 
 // Args: (Application UUID)
 using LogDeviceApp = std::function<void(const std::string &)>;
@@ -36,6 +39,18 @@ using LogFunction = std::function<void(const std::string &)>;
 // Args: (Event UUID, Event type, Application ID)
 using LogEvent = std::function<void(const std::string &, uint8_t, const std::string &)>;
 
+/// Value bound to a parameter of a prepared statement. std::monostate is bound as NULL.
+using DatabaseValue = std::variant<std::monostate, int64_t, double, std::string>;
+
+/// Values of a row in the order of the parameters of getPreparedInsertStatement. Missing trailing
+/// values are bound as NULL.
+using DatabaseRow = std::vector<DatabaseValue>;
+
+class DatabaseTable;
+
+// Args: (Table definition, Row)
+using LogInsert = std::function<void(const DatabaseTable &, DatabaseRow)>;
+
 /// @brief Creates a SQL Statement by calling snprintf. The amount of format specifiers in
 /// format_str has to be identical to the provided values
 /// @tparam ...Tp Derived automatically from the value types
@@ -68,6 +83,7 @@ public:
   bool is_id = false;
   std::string foreign_key = "";
   bool is_primary_key = false;
+  std::string lookup_key = "";
   std::string data_type = "INTEGER";
 
   void setDataType() {
@@ -110,13 +126,17 @@ public:
   /// @param not_null If true, the column will be restricted to be not null
   /// @param foreign_key If set, the foreign key reference will be included, e.g., "Event(Id)"
   /// @param is_primary_key If true, the column will be set as the primary key
+  /// @param lookup_key Only for "sql" formats with a foreign key: Column of the referenced table
+  /// which is compared to the bound value in prepared statements, e.g., "ApplicationUuid"
   DatabaseColumnInfo(std::string name, std::string format, bool not_null = false,
-                     std::string foreign_key = "", bool is_primary_key = false)
+                     std::string foreign_key = "", bool is_primary_key = false,
+                     std::string lookup_key = "")
       : name(std::move(name)),
         format(std::move(format)),
         not_null(not_null),
         foreign_key(std::move(foreign_key)),
-        is_primary_key(is_primary_key) {
+        is_primary_key(is_primary_key),
+        lookup_key(std::move(lookup_key)) {
     setDataType();
   };
 };
@@ -283,4 +303,81 @@ std::string getInsertStatement(const DatabaseTable &table, const std::tuple<Tp..
   return query;
 }
 
+/// @brief Generate a string containing a parameterized SQL Insert Statement based on the table
+/// argument. Every column except the id column gets a parameter. Columns with a lookup key select
+/// the referenced row instead, e.g., "(SELECT Id FROM NatterNode WHERE ApplicationUuid=?)".
+/// @param table DatabaseTable definition
+/// @return String with the complete SQL Statement
+inline std::string getPreparedInsertStatement(const DatabaseTable &table) {
+  std::ostringstream statement;
+  statement << "INSERT INTO " << table.name << " VALUES(";
+
+  for (auto col_it = table.columns.begin(); col_it != table.columns.end(); col_it++) {
+    if (col_it->is_id) {
+      statement << "NULL";
+    } else if (!col_it->lookup_key.empty()) {
+      // foreign_key has the format "Table(Column)"
+      const auto bracket = col_it->foreign_key.find('(');
+      if (bracket == std::string::npos || col_it->foreign_key.back() != ')') {
+        throw std::runtime_error("Lookup key requires a foreign key: " + col_it->name);
+      }
+      statement << "(SELECT "
+                << col_it->foreign_key.substr(bracket + 1,
+                                              col_it->foreign_key.size() - bracket - 2)
+                << " FROM " << col_it->foreign_key.substr(0, bracket) << " WHERE "
+                << col_it->lookup_key << "=?)";
+    } else {
+      statement << "?";
+    }
+
+    if (col_it != --table.columns.end()) {
+      statement << ",";
+    }
+  }
+
+  statement << ");";
+  return statement.str();
+}
+
+/// @brief Returns the tables which have to contain the referenced rows before a row of the table
+/// argument can be inserted with getPreparedInsertStatement
+inline std::vector<std::string> getLookupTables(const DatabaseTable &table) {
+  std::vector<std::string> tables;
+  for (const auto &column : table.columns) {
+    if (!column.lookup_key.empty()) {
+      tables.push_back(column.foreign_key.substr(0, column.foreign_key.find('(')));
+    }
+  }
+  return tables;
+}
+
+template <typename T> inline DatabaseValue toDatabaseValue(const T &value) {
+  if constexpr (std::is_enum_v<T>) {
+    return static_cast<int64_t>(value);
+  } else if constexpr (std::is_integral_v<T>) {
+    return static_cast<int64_t>(value);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<double>(value);
+  } else if constexpr (std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, std::monostate>) {
+    return std::monostate{};
+  } else {
+    return std::string(value);
+  }
+}
+
+/// @brief Converts the values to a row for a prepared statement. The values are given in the same
+/// way as for getInsertStatement, except that strings do not have to be converted to char arrays.
+/// @param values Values to be bound, nullptr is bound as NULL
+/// @return Row with the converted values
+template <typename... Tp> DatabaseRow toDatabaseRow(const std::tuple<Tp...> &values) {
+  return std::apply(
+      [](const auto &...value) {
+        DatabaseRow row;
+        row.reserve(sizeof...(value));
+        (row.push_back(toDatabaseValue(value)), ...);
+        return row;
+      },
+      values);
+}
+
 #endif
@@ -44,7 +44,7 @@ void LoggerManager::logDevice(uint32_t id) {
   const auto &[_, inserted] = cached_ids.insert(id);
   if (inserted) {
     auto t = std::make_tuple(/* Id */ id);
-    sqlite_helper_.execute(getInsertStatement(kDevice, t));
+    sqlite_helper_.insert(kDevice, toDatabaseRow(t));
   }
 }
 
@@ -62,13 +62,12 @@ void LoggerManager::logDeviceApplication(const std::string &application_uuid,
                                          const std::string &application_name) {
   const uint64_t device_id = getDeviceId();
   logDevice(device_id);
+  // StopTime_ms is NULL until the application is stopped
   auto t = std::make_tuple(/* ApplicationUuid */ application_uuid.c_str(),
                            /* ApplicationName */ application_name.c_str(),
                            /* DeviceUuid */ device_id,
                            /* StartTime_ms */ ns3::Simulator::Now().GetMilliSeconds());
-  auto table = kDeviceApplication;
-  table.columns[4] = {"StopTime_ms", "NULL"};
-  sqlite_helper_.execute(getInsertStatement(table, t));
+  sqlite_helper_.insert(kDeviceApplication, toDatabaseRow(t));
 }
 
 // * Event
@@ -86,7 +85,7 @@ void LoggerManager::logEvent(const std::string &event_uuid, uint16_t event_type,
                            /* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
                            /* Type */ event_type,
                            /* ApplicationUuid */ application_uuid.c_str());
-  sqlite_helper_.execute(getInsertStatement(kEvent, t));
+  sqlite_helper_.insert(kEvent, toDatabaseRow(t));
 }
 
 // * General
@@ -206,6 +205,9 @@ std::shared_ptr<minhton::MinhtonLoggerNs3> LoggerManager::createMinhtonLogger(
 
   return std::make_shared<minhton::MinhtonLoggerNs3>(
       log_dev_app, [this](const std::string &sql) -> void { this->sqlite_helper_.execute(sql); },
+      [this](const DatabaseTable &table, DatabaseRow row) -> void {
+        this->sqlite_helper_.insert(table, std::move(row));
+      },
       log_event);
 }
 
@@ -222,6 +224,9 @@ std::shared_ptr<natter::logging::NatterLoggerNs3> LoggerManager::createNatterLog
 
   return std::make_shared<natter::logging::NatterLoggerNs3>(
       log_dev_app, [this](const std::string &sql) -> void { this->sqlite_helper_.execute(sql); },
+      [this](const DatabaseTable &table, DatabaseRow row) -> void {
+        this->sqlite_helper_.insert(table, std::move(row));
+      },
       log_event);
 }
 
@@ -231,7 +236,10 @@ std::shared_ptr<daisi::cpps::CppsLoggerNs3> LoggerManager::createAMRLogger() {
   };
 
   return std::make_shared<daisi::cpps::CppsLoggerNs3>(
-      log_dev_app, [this](const std::string &sql) -> void { this->sqlite_helper_.execute(sql); });
+      log_dev_app, [this](const std::string &sql) -> void { this->sqlite_helper_.execute(sql); },
+      [this](const DatabaseTable &table, DatabaseRow row) -> void {
+        this->sqlite_helper_.insert(table, std::move(row));
+      });
 }
 
 std::shared_ptr<daisi::cpps::CppsLoggerNs3> LoggerManager::createTOLogger() {
@@ -240,7 +248,10 @@ std::shared_ptr<daisi::cpps::CppsLoggerNs3> LoggerManager::createTOLogger() {
   };
 
   return std::make_shared<daisi::cpps::CppsLoggerNs3>(
-      log_dev_app, [this](const std::string &sql) -> void { this->sqlite_helper_.execute(sql); });
+      log_dev_app, [this](const std::string &sql) -> void { this->sqlite_helper_.execute(sql); },
+      [this](const DatabaseTable &table, DatabaseRow row) -> void {
+        this->sqlite_helper_.insert(table, std::move(row));
+      });
 }
 
 // std::shared_ptr<daisi::path_planning::PathPlanningLoggerNs3>
@@ -253,6 +264,9 @@ std::shared_ptr<daisi::cpps::CppsLoggerNs3> LoggerManager::createTOLogger() {
 
 //   return std::make_shared<daisi::path_planning::PathPlanningLoggerNs3>(
 //       log_dev_app, [this](const std::string &sql) -> void { this->sqlite_helper_.execute(sql);
+//       },
+//       [this](const DatabaseTable &table, DatabaseRow row) -> void {
+//         this->sqlite_helper_.insert(table, std::move(row));
 //       });
 // }
 
@@ -21,19 +21,32 @@
 #include <algorithm>
 #include <cstdio>
 #include <filesystem>
+#include <functional>
+#include <iterator>
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
+#include <unordered_set>
+#include <utility>
 
 #ifdef DEFERRED_LOGGING
+// Everything is handed to the writer thread in large chunks
 static constexpr size_t kMaxQueueSize = 100000;
+#else
+static constexpr size_t kMaxQueueSize = 1000;
 #endif
 
+// Maximum number of rows and statements per transaction
+static constexpr size_t kMaxTransactionSize = 10000;
+
+// Maximum number of tasks queued for the writer thread before the simulation is blocked
+static constexpr size_t kMaxQueuedTasks = 16;
+
 namespace daisi {
 
 SQLiteHelper::SQLiteHelper(std::string file_path, std::string file_name)
     : file_path_(std::move(file_path)), file_name_(std::move(file_name)) {
   this->connect();
+  writer_ = std::thread(&SQLiteHelper::writerLoop, this);
 }
 
 SQLiteHelper::~SQLiteHelper() {
@@ -94,72 +107,261 @@ void SQLiteHelper::connect() {
   }
 }
 
-void SQLiteHelper::logQueueTask(const std::vector<std::string> &queries) {
-  // Execute queries as a single transaction
-  std::ostringstream stream;
-  stream << "BEGIN TRANSACTION;";
-  for (const auto &command : queries) {
-    stream << command;
+void SQLiteHelper::disconnect() {
+  if (db_ == nullptr) return;
+
+  try {
+    flush();
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
   }
-  stream << "COMMIT;";
-  auto stream_string = stream.str();
 
-  std::cout << "LOGGING" << std::endl;
-  char *err_msg = nullptr;
-  int rc = sqlite3_exec(db_, stream_string.c_str(), nullptr, nullptr, &err_msg);
+  {
+    std::lock_guard lock(mutex_);
+    stop_writer_ = true;
+  }
+  queue_changed_.notify_all();
+  writer_.join();
+
+  for (auto &[_, statement] : statements_) {
+    sqlite3_finalize(statement);
+  }
+  statements_.clear();
+
+  int rc = sqlite3_close(db_);
+  db_ = nullptr;
 
   if (rc != SQLITE_OK) {
-    setFailed();
-    std::string error_message = "Error executing aggregate query: ";
-    error_message += err_msg;
-    throw std::runtime_error(error_message);
+    throw std::runtime_error("Error closing database!");
   }
 }
 
-void SQLiteHelper::logQueue() {
-#ifdef DEFERRED_LOGGING
+void SQLiteHelper::execute(const std::string &query) {
+  // Rows which were inserted before must be written before the query
+  closeBatches();
+  pending_tasks_.push_back({{}, query});
 
-  // Nothing to do
-  if (queries_.empty()) return;
+  // Avoid excessive RAM usage
+  if (++pending_entries_ >= kMaxQueueSize) submit();
+}
 
-  std::vector<std::string> queries;
-  std::swap(queries, queries_);
+void SQLiteHelper::insert(const DatabaseTable &table, DatabaseRow row) {
+  auto batch_it = batches_.find(table.name);
+  if (batch_it == batches_.end()) {
+    // The statement is prepared from the first definition with this name
+    auto table_it = tables_.find(table.name);
+    if (table_it == tables_.end()) {
+      TableInfo info{getPreparedInsertStatement(table), 0, getLookupTables(table)};
+      info.parameters = static_cast<size_t>(
+          std::count_if(table.columns.begin(), table.columns.end(),
+                        [](const auto &column) { return !column.is_id; }));
+      table_it = tables_.emplace(table.name, std::move(info)).first;
+    }
 
-  if (last_logging_task_.valid()) last_logging_task_.wait();
-  last_logging_task_ = std::async(&SQLiteHelper::logQueueTask, this, queries);
+    TableBatch batch{&table_it->second,
+                     std::vector<ColumnBatch>(table_it->second.parameters), 0};
+    batch_it = batches_.emplace(table.name, std::move(batch)).first;
+  }
 
-#else
-  throw std::runtime_error("deferred logging not enabled");
-#endif
+  TableBatch &batch = batch_it->second;
+  if (row.size() > batch.columns.size()) {
+    throw std::runtime_error("Too many values for table " + table.name);
+  }
+
+  for (size_t i = 0; i < batch.columns.size(); i++) {
+    ColumnBatch &column = batch.columns[i];
+    if (i >= row.size()) {
+      column.kinds.push_back(0);
+      continue;
+    }
+
+    DatabaseValue &value = row[i];
+    column.kinds.push_back(static_cast<uint8_t>(value.index()));
+    if (auto *integer = std::get_if<int64_t>(&value)) {
+      column.integers.push_back(*integer);
+    } else if (auto *real = std::get_if<double>(&value)) {
+      column.reals.push_back(*real);
+    } else if (auto *text = std::get_if<std::string>(&value)) {
+      column.texts.push_back(std::move(*text));
+    }
+  }
+  batch.rows++;
+
+  if (++pending_entries_ >= kMaxQueueSize) submit();
 }
 
-void SQLiteHelper::disconnect() {
-  if (db_ == nullptr) return;
+void SQLiteHelper::flush() {
+  submit();
 
-#ifdef DEFERRED_LOGGING
-  logQueue();
-#endif
+  std::unique_lock lock(mutex_);
+  queue_changed_.wait(lock,
+                      [this] { return (write_queue_.empty() && !writing_) || writer_error_; });
+  if (writer_error_) std::rethrow_exception(std::exchange(writer_error_, nullptr));
+}
 
-  if (last_logging_task_.valid()) last_logging_task_.wait();
+void SQLiteHelper::closeBatches() {
+  WriteTask task;
 
-  int rc = sqlite3_close(db_);
-  db_ = nullptr;
+  // Rows of tables which are looked up by other rows have to be inserted first
+  std::unordered_set<std::string> visited;
+  std::function<void(const std::string &)> visit = [&](const std::string &name) {
+    if (!visited.insert(name).second) return;
 
-  if (rc != SQLITE_OK) {
-    throw std::runtime_error("Error closing database!");
+    auto batch_it = batches_.find(name);
+    if (batch_it == batches_.end() || batch_it->second.rows == 0) return;
+
+    for (const auto &lookup_table : batch_it->second.info->lookup_tables) {
+      visit(lookup_table);
+    }
+
+    TableBatch &batch = batch_it->second;
+    TableBatch closed{batch.info, std::vector<ColumnBatch>(batch.columns.size()), 0};
+    std::swap(closed, batch);
+    task.batches.push_back(std::move(closed));
+  };
+
+  for (const auto &[name, _] : batches_) {
+    visit(name);
+  }
+
+  if (!task.batches.empty()) {
+    pending_tasks_.push_back(std::move(task));
   }
 }
 
-void SQLiteHelper::execute(const std::string &query) {
-#ifdef DEFERRED_LOGGING
-  // Store query and execute them all together when simulation ends
-  queries_.push_back(std::move(query));
+void SQLiteHelper::submit() {
+  closeBatches();
+  pending_entries_ = 0;
+  if (pending_tasks_.empty()) return;
 
-  // Avoid excessive RAM usage
-  if (queries_.size() > kMaxQueueSize) logQueue();
-#else
-  executeSql(query.c_str());
-#endif
+  {
+    std::unique_lock lock(mutex_);
+    queue_changed_.wait(lock,
+                        [this] { return write_queue_.size() < kMaxQueuedTasks || writer_error_; });
+    if (writer_error_) std::rethrow_exception(std::exchange(writer_error_, nullptr));
+
+    std::move(pending_tasks_.begin(), pending_tasks_.end(), std::back_inserter(write_queue_));
+  }
+  pending_tasks_.clear();
+  queue_changed_.notify_all();
+}
+
+void SQLiteHelper::writerLoop() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    queue_changed_.wait(lock, [this] { return !write_queue_.empty() || stop_writer_; });
+    if (write_queue_.empty()) return;
+
+    writing_ = true;
+    lock.unlock();
+
+    try {
+      executeSql("BEGIN TRANSACTION;");
+      size_t transaction_size = 0;
+
+      // Keep the transaction open as long as tasks are queued
+      lock.lock();
+      while (!write_queue_.empty()) {
+        WriteTask task = std::move(write_queue_.front());
+        write_queue_.pop_front();
+        lock.unlock();
+        queue_changed_.notify_all();
+
+        writeTask(task, transaction_size);
+        lock.lock();
+      }
+      lock.unlock();
+
+      executeSql("COMMIT;");
+    } catch (...) {
+      // Keep what was written so far
+      sqlite3_exec(db_, "COMMIT;", nullptr, nullptr, nullptr);
+      setFailed();
+
+      if (!lock.owns_lock()) lock.lock();
+      writer_error_ = std::current_exception();
+      write_queue_.clear();
+      lock.unlock();
+    }
+
+    lock.lock();
+    writing_ = false;
+    queue_changed_.notify_all();
+  }
+}
+
+void SQLiteHelper::writeTask(WriteTask &task, size_t &transaction_size) {
+  for (auto &batch : task.batches) {
+    writeBatch(batch, transaction_size);
+  }
+
+  if (!task.statement.empty()) {
+    executeSql(task.statement.c_str());
+    boundTransaction(transaction_size);
+  }
+}
+
+void SQLiteHelper::writeBatch(TableBatch &batch, size_t &transaction_size) {
+  sqlite3_stmt *&statement = statements_[batch.info];
+  if (statement == nullptr) {
+    int rc = sqlite3_prepare_v2(db_, batch.info->statement.c_str(), -1, &statement, nullptr);
+    if (rc != SQLITE_OK) {
+      throw std::runtime_error("Error preparing query: " + std::string(sqlite3_errmsg(db_)) +
+                               ". Affected query: " + batch.info->statement);
+    }
+  }
+
+  // Position of the next value of each column within the vector of its type
+  struct Cursor {
+    size_t integer = 0;
+    size_t real = 0;
+    size_t text = 0;
+  };
+  std::vector<Cursor> cursors(batch.columns.size());
+
+  for (size_t row = 0; row < batch.rows; row++) {
+    for (size_t i = 0; i < batch.columns.size(); i++) {
+      const ColumnBatch &column = batch.columns[i];
+      Cursor &cursor = cursors[i];
+      const int parameter = static_cast<int>(i) + 1;
+
+      // Values are kept alive until the row is written, so they do not have to be copied
+      switch (column.kinds[row]) {
+        case 1:
+          sqlite3_bind_int64(statement, parameter, column.integers[cursor.integer++]);
+          break;
+        case 2:
+          sqlite3_bind_double(statement, parameter, column.reals[cursor.real++]);
+          break;
+        case 3: {
+          const std::string &text = column.texts[cursor.text++];
+          sqlite3_bind_text(statement, parameter, text.c_str(), static_cast<int>(text.size()),
+                            SQLITE_STATIC);
+          break;
+        }
+        default:
+          sqlite3_bind_null(statement, parameter);
+      }
+    }
+
+    int rc = sqlite3_step(statement);
+    sqlite3_reset(statement);
+    if (rc != SQLITE_DONE) {
+      //! In case of exception: Check the values for constraint violations
+      throw std::runtime_error("Error executing query: " + std::string(sqlite3_errmsg(db_)) +
+                               ". Affected query: " + batch.info->statement);
+    }
+
+    boundTransaction(transaction_size);
+  }
+}
+
+void SQLiteHelper::boundTransaction(size_t &transaction_size) {
+  if (++transaction_size < kMaxTransactionSize) return;
+
+  executeSql("COMMIT;");
+  executeSql("BEGIN TRANSACTION;");
+  transaction_size = 0;
 }
 
 void SQLiteHelper::executeSql(const char *query) {
@@ -171,6 +373,7 @@ void SQLiteHelper::executeSql(const char *query) {
   if (rc != SQLITE_OK) {
     std::string error_message = "Error executing query: ";
     error_message += err_msg_ptr + std::string(". Affected query: ") + query;
+    sqlite3_free(err_msg_ptr);
     //! In case of exception: Check query for broken strings
     throw std::runtime_error(error_message);
   }
@@ -17,14 +17,27 @@
 #ifndef DAISI_SQLITE_HELPER_H_
 #define DAISI_SQLITE_HELPER_H_
 
-#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
-class sqlite3;
+#include "logging/definitions.h"
+
+struct sqlite3;
+struct sqlite3_stmt;
 
 namespace daisi {
 
+/// Logs to a SQLite database. Statements and rows are buffered and written by a background writer
+/// thread in bounded transactions. Rows of tables which are inserted with insert() are stored per
+/// table in columnar batches and written with a prepared statement of the table.
 class SQLiteHelper {
 public:
   /// Constructs a SQLite logger and generates database
@@ -35,25 +48,95 @@ public:
   /// Disconnects and renames the temporary database filename to final name
   ~SQLiteHelper();
 
+  SQLiteHelper(const SQLiteHelper &) = delete;
+  SQLiteHelper &operator=(const SQLiteHelper &) = delete;
+
   void setFailed();
 
+  /// Executes an arbitrary statement after all previously buffered rows and statements
   void execute(const std::string &query);
 
+  /// Buffers a row which is inserted with the prepared insert statement of the table
+  /// \param table Table definition, see getPreparedInsertStatement
+  /// \param row Values of the row
+  void insert(const DatabaseTable &table, DatabaseRow row);
+
+  /// Hands everything buffered to the writer thread and waits until it is written
+  void flush();
+
 private:
+  /// Values of a single column of a batch. Values are stored in the vector of their type, kinds
+  /// holds the variant index of every row.
+  struct ColumnBatch {
+    std::vector<uint8_t> kinds;
+    std::vector<int64_t> integers;
+    std::vector<double> reals;
+    std::vector<std::string> texts;
+  };
+
+  /// Prepared insert statement of a table
+  struct TableInfo {
+    std::string statement;
+    size_t parameters = 0;
+    std::vector<std::string> lookup_tables;
+  };
+
+  /// Buffered rows of one table
+  struct TableBatch {
+    const TableInfo *info = nullptr;
+    std::vector<ColumnBatch> columns;
+    size_t rows = 0;
+  };
+
+  /// Unit of work of the writer thread: Either batches (in the order in which they can be
+  /// inserted) or a single statement
+  struct WriteTask {
+    std::vector<TableBatch> batches;
+    std::string statement;
+  };
+
   sqlite3 *db_ = nullptr;
   const std::string file_path_;
   std::string file_name_;
   std::string temp_file_name_;
-  std::vector<std::string> queries_;
-  std::future<void> last_logging_task_;
-  bool failed_database_ = false;
+  std::atomic<bool> failed_database_ = false;
+
+  // Only accessed by the simulation. Table infos are not modified after their creation.
+  std::unordered_map<std::string, TableInfo> tables_;
+  std::unordered_map<std::string, TableBatch> batches_;
+  std::vector<WriteTask> pending_tasks_;
+  size_t pending_entries_ = 0;
+
+  // Only accessed by the writer thread
+  std::unordered_map<const TableInfo *, sqlite3_stmt *> statements_;
+
+  // Shared with the writer thread
+  std::deque<WriteTask> write_queue_;
+  bool writing_ = false;
+  bool stop_writer_ = false;
+  std::exception_ptr writer_error_;
+  std::mutex mutex_;
+  std::condition_variable queue_changed_;
+  std::thread writer_;
 
   // creates and opens the database files
   void connect();
 
-  // log queued queries to database. Only used if deferred logging is enabled!
-  [[maybe_unused]] void logQueue();
-  [[maybe_unused]] void logQueueTask(const std::vector<std::string> &queries);
+  // moves the current batches to the pending tasks, ordered by their lookup tables
+  void closeBatches();
+
+  // hands the pending tasks to the writer thread, blocks if too many tasks are queued
+  void submit();
+
+  // rethrows an error of the writer thread
+  void checkWriterError();
+
+  void writerLoop();
+  void writeTask(WriteTask &task, size_t &transaction_size);
+  void writeBatch(TableBatch &batch, size_t &transaction_size);
+
+  // starts a new transaction if the current one reached its maximum size
+  void boundTransaction(size_t &transaction_size);
 
   // executes a sql query
   void executeSql(const char *query);
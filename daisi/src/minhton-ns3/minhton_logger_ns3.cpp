@@ -29,7 +29,7 @@ namespace minhton {
 extern const std::unordered_map<uint32_t, std::string> kMapMinhtonMessageTypeStrings;
 
 // Refer to DatabaseTable and DatabaseColumnInfo definitions in ../logging/definitions.h
-//! Don't forget to use .c_str() to convert std::string into a char array
+// Rows are inserted with prepared statements, see getPreparedInsertStatement and toDatabaseRow
 
 // * Event
 void MinhtonLoggerNs3::logEvent(const LoggerInfoAddEvent &info) {
@@ -56,7 +56,7 @@ void MinhtonLoggerNs3::logFindQuery(const LoggerInfoAddFindQuery &info) {
                            /* EventId */ info.event_id,
                            /* NodeUuid */ info.node_uuid.c_str(),
                            /* Query */ info.query.c_str());
-  log_(getInsertStatement(kFindQuery, t));
+  log_insert_(kFindQuery, toDatabaseRow(t));
 }
 
 // * FindQueryResult
@@ -77,7 +77,7 @@ void MinhtonLoggerNs3::logFindQueryResult(const LoggerInfoAddFindQueryResult &in
   auto t = std::make_tuple(/* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
                            /* EventId */ info.event_id,
                            /* NodeUuid */ info.node_uuid.c_str());
-  log_(getInsertStatement(kFindQueryResult, t));
+  log_insert_(kFindQueryResult, toDatabaseRow(t));
 }
 
 // * MinhtonPhysicalNodeInfo
@@ -99,7 +99,7 @@ void MinhtonLoggerNs3::logPhysicalNodeInfo(const LoggerPhysicalNodeInfo &info) {
   auto t = std::make_tuple(/* ApplicationUuid */ uuid_.c_str(),
                            /* Ip */ info.ip.c_str(),
                            /* Port */ info.port);
-  log_(getInsertStatement(kMinhtonPhysicalNodeInfo, t));
+  log_insert_(kMinhtonPhysicalNodeInfo, toDatabaseRow(t));
 }
 
 // * MinhtonNode
@@ -124,15 +124,12 @@ void MinhtonLoggerNs3::logNode(const LoggerInfoAddNode &info) {
                              /* Level */ info.level,
                              /* Number */ info.number,
                              /* Fanout */ info.fanout);
-    log_(getInsertStatement(kMinhtonNode, t));
+    log_insert_(kMinhtonNode, toDatabaseRow(t));
   } else {
+    // Level, Number and Fanout are NULL
     auto t = std::make_tuple(/* PositionUuid */ info.position_uuid.c_str(),
                              /* ApplicationUuid */ uuid_.c_str());
-    auto table = kMinhtonNode;
-    table.columns[2] = {"Level", "NULL"};
-    table.columns[3] = {"Number", "NULL"};
-    table.columns[4] = {"Fanout", "NULL"};
-    log_(getInsertStatement(table, t));
+    log_insert_(kMinhtonNode, toDatabaseRow(t));
   }
 }
 
@@ -163,7 +160,7 @@ void MinhtonLoggerNs3::logMinhtonNodeStates() {
     auto t = std::make_tuple(
         /* Id */ key,
         /* Name */ name.c_str());
-    log_(getInsertStatement(kEnumMinhtonNodeState, t));
+    log_insert_(kEnumMinhtonNodeState, toDatabaseRow(t));
   }
 }
 
@@ -191,7 +188,7 @@ void MinhtonLoggerNs3::logNodeUninit(const LoggerInfoNodeState &info) {
                            /* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
                            /* State */ NodeStatus::kUninit,
                            /* EventId*/ info.event_id);
-  log_(getInsertStatement(kMinhtonNodeState, t));
+  log_insert_(kMinhtonNodeState, toDatabaseRow(t));
 }
 
 void MinhtonLoggerNs3::logNodeRunning(const LoggerInfoNodeState &info) {
@@ -209,7 +206,7 @@ void MinhtonLoggerNs3::logNodeRunning(const LoggerInfoNodeState &info) {
                            /* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
                            /* State */ NodeStatus::kRunning,
                            /* EventId*/ info.event_id);
-  log_(getInsertStatement(kMinhtonNodeState, t));
+  log_insert_(kMinhtonNodeState, toDatabaseRow(t));
 }
 
 void MinhtonLoggerNs3::logNodeLeft(const LoggerInfoNodeState &info) {
@@ -227,7 +224,7 @@ void MinhtonLoggerNs3::logNodeLeft(const LoggerInfoNodeState &info) {
                            /* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
                            /* State */ NodeStatus::kLeft,
                            /* EventId*/ info.event_id);
-  log_(getInsertStatement(kMinhtonNodeState, t));
+  log_insert_(kMinhtonNodeState, toDatabaseRow(t));
 }
 
 // * MinhtonTraffic
@@ -256,7 +253,7 @@ void MinhtonLoggerNs3::logMinhtonMessageTypes() {
     auto t = std::make_tuple(
         /* Id */ key,
         /* Name */ name.c_str());
-    log_(getInsertStatement(kEnumMinhtonMessageType, t));
+    log_insert_(kEnumMinhtonMessageType, toDatabaseRow(t));
   }
 }
 
@@ -308,7 +305,7 @@ void MinhtonLoggerNs3::logTraffic(const MessageLoggingInfo &info) {
       /* PrimaryOtherNodeUuid */ info.additional_info.primary_other_uuid.c_str(),
       /* SecondaryOtherNodeUuid */ info.additional_info.secondary_other_uuid.c_str(),
       /* Content */ info.additional_info.content.c_str());
-  log_(getInsertStatement(kMinhtonTraffic, t));
+  log_insert_(kMinhtonTraffic, toDatabaseRow(t));
 }
 
 // * SearchContent
@@ -336,7 +333,7 @@ void MinhtonLoggerNs3::logContent(const LoggerInfoAddContent &info) {
       /* AttributeName */ info.attribute_name.c_str(),
       /* Type */ info.content_type,
       /* Text */ info.content_text.c_str());
-  log_(getInsertStatement(kSearchContent, t));
+  log_insert_(kSearchContent, toDatabaseRow(t));
 }
 
 // * MinhtonSearchTest
@@ -369,7 +366,7 @@ void MinhtonLoggerNs3::logSearchExactTest(const LoggerInfoSearchExact &info) {
       /* TargetNumber */ info.target_number,
       /* HopLevel */ info.hop_level,
       /* HopNumber */ info.hop_number);
-  log_(getInsertStatement(kSearchTest, t));
+  log_insert_(kSearchTest, toDatabaseRow(t));
 }
 
 // * RoutingInfo
@@ -402,7 +399,7 @@ void MinhtonLoggerNs3::logMinhtonRelationships() {
     auto t = std::make_tuple(
         /* Id */ key,
         /* Name */ name.c_str());
-    log_(getInsertStatement(kEnumMinhtonRelationship, t));
+    log_insert_(kEnumMinhtonRelationship, toDatabaseRow(t));
   }
 }
 
@@ -439,15 +436,16 @@ void MinhtonLoggerNs3::logNeighbor(const LoggerInfoAddNeighbor &info) {
       /* NodeUuid */ info.node_uuid.c_str(),
       /* NeighborNodeUuid */ info.neighbor_node_uuid.c_str(),
       /* Relationship */ info.relationship);
-  log_(getInsertStatement(kRoutingInfo, t));
+  log_insert_(kRoutingInfo, toDatabaseRow(t));
 }
 
 // * Constructor & Other methods
 MinhtonLoggerNs3::MinhtonLoggerNs3(LogDeviceApp log_device_application, LogFunction log,
-                                   LogEvent log_event)
+                                   LogInsert log_insert, LogEvent log_event)
     : LoggerInterface("NOT-KNOWN-YET"),
       log_device_application_(std::move(log_device_application)),
       log_(std::move(log)),
+      log_insert_(std::move(log_insert)),
       log_event_(std::move(log_event)) {}
 
 MinhtonLoggerNs3::~MinhtonLoggerNs3() {
@@ -469,4 +467,6 @@ void MinhtonLoggerNs3::logDebug(const std::string & /*msg*/) const {
   // String logging not implemented yet
 }
 
+bool MinhtonLoggerNs3::isLogLevelEnabled(LogLevel /*level*/) const { return false; }
+
 }  // namespace minhton
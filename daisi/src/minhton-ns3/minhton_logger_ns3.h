@@ -30,7 +30,8 @@ namespace minhton {
 
 class MinhtonLoggerNs3 : public LoggerInterface {
 public:
-  MinhtonLoggerNs3(LogDeviceApp log_device_application, LogFunction log, LogEvent log_event);
+  MinhtonLoggerNs3(LogDeviceApp log_device_application, LogFunction log, LogInsert log_insert,
+                   LogEvent log_event);
   ~MinhtonLoggerNs3() override;
 
   void logCritical(const std::string &msg) const final;
@@ -38,6 +39,9 @@ public:
   void logInfo(const std::string &msg) const final;
   void logDebug(const std::string &msg) const final;
 
+  /// String messages are not logged, so they do not have to be built either
+  bool isLogLevelEnabled(LogLevel level) const final;
+
   void logNodeUninit(const LoggerInfoNodeState &info) final;
   void logNodeRunning(const LoggerInfoNodeState &info) final;
   void logNodeLeft(const LoggerInfoNodeState &info) final;
@@ -61,6 +65,7 @@ private:
   // TODO Refactor to other class
   LogDeviceApp log_device_application_;
   LogFunction log_;
+  LogInsert log_insert_;
   LogEvent log_event_;
 
   void logMinhtonMessageTypes();
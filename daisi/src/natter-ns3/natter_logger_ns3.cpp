@@ -27,7 +27,7 @@
 namespace natter::logging {
 
 // Refer to DatabaseTable and DatabaseColumnInfo definitions in ../logging/definitions.h
-//! Don't forget to use .c_str() to convert std::string into a char array
+// Rows are inserted with prepared statements, see getPreparedInsertStatement and toDatabaseRow
 
 // * Event
 void NatterLoggerNs3::logNatterEvent(uint16_t event_type, solanet::UUID event_id) {
@@ -40,8 +40,10 @@ TableDefinition kNatterConnection("NatterConnection",
                                   {DatabaseColumnInfo{"Id"},
                                    {"Timestamp_ms", "%lu", true},
                                    {"Active", "%i", true},
-                                   {"NodeId", "sql%u", true, "NatterNode(Id)"},
-                                   {"NewNodeId", "sql%u", true, "NatterNode(Id)"}});
+                                   {"NodeId", "sql%u", true, "NatterNode(Id)", false,
+                                    "ApplicationUuid"},
+                                   {"NewNodeId", "sql%u", true, "NatterNode(Id)", false,
+                                    "ApplicationUuid"}});
 static const std::string kCreateNatterConnection = getCreateTableStatement(kNatterConnection);
 
 ViewDefinition kNatterConnectionReplacements = {
@@ -66,16 +68,12 @@ void NatterLoggerNs3::logNs3PeerConnection(uint64_t timestamp, bool active, sola
     natter_connection_exists = true;
   }
 
-  std::string node_id = "(SELECT Id FROM NatterNode WHERE ApplicationUuid='" +
-                        solanet::uuidToString(node_uuid) + "')";
-  std::string new_node_id = "(SELECT Id FROM NatterNode WHERE ApplicationUuid='" +
-                            solanet::uuidToString(new_node_uuid) + "')";
   auto t = std::make_tuple(
       /* Timestamp_ms */ timestamp,
       /* Active */ active ? 1 : 0,
-      /* NodeId */ node_id.c_str(),
-      /* NewNodeId */ new_node_id.c_str());
-  log_(getInsertStatement(kNatterConnection, t));
+      /* NodeId */ solanet::uuidToString(node_uuid),
+      /* NewNodeId */ solanet::uuidToString(new_node_uuid));
+  log_insert_(kNatterConnection, toDatabaseRow(t));
 }
 
 // * NatterMessage
@@ -99,7 +97,7 @@ void NatterLoggerNs3::logNewMessage(const std::string &topic, const std::string
       /* Uuid */ uuid_string.c_str(),
       // /* Content */ msg.c_str(),
       /* Topic */ topic.c_str());
-  log_(getInsertStatement(kMessage, t));
+  log_insert_(kMessage, toDatabaseRow(t));
 }
 
 // * NatterNode
@@ -140,7 +138,7 @@ void NatterLoggerNs3::logNewNetworkPeer(solanet::UUID uuid, const std::string &i
                            /* Number */ number,
                            /* Ip */ ip.c_str(),
                            /* Port */ port);
-  log_(getInsertStatement(kNatterNode, t));
+  log_insert_(kNatterNode, toDatabaseRow(t));
 }
 
 // * NatterControlMessage
@@ -150,9 +148,11 @@ TableDefinition kNatterCtrlMsg("NatterControlMessage",
                                 {"Timestamp_ms", "%lu", true},
                                 {"Type", "%i", true},
                                 {"Mode", "%i", true},
-                                {"SenderNodeId", "sql%u", true, "NatterNode(Id)"},
-                                {"TargetNodeId", "sql%u", false, "NatterNode(Id)"},
-                                {"MessageId", "sql%u", false, "NatterMessage(Id)"}
+                                {"SenderNodeId", "sql%u", true, "NatterNode(Id)", false,
+                                 "ApplicationUuid"},
+                                {"TargetNodeId", "sql%u", false, "NatterNode(Id)", false,
+                                 "ApplicationUuid"},
+                                {"MessageId", "sql%u", false, "NatterMessage(Id)", false, "Uuid"}
                                 /*{"AdditionalContent", "%s"}*/});
 static const std::string kCreateTrafficForward = getCreateTableStatement(kNatterCtrlMsg);
 
@@ -181,34 +181,28 @@ void NatterLoggerNs3::logSendReceive(solanet::UUID msg_uuid, solanet::UUID sende
   }
 
   // TODO: own_uuid is minhton posUUID sometimes when used from cpps
-  std::string sender_node_id =
-      "(SELECT Id FROM NatterNode WHERE ApplicationUuid='" + solanet::uuidToString(sender) + "')";
-  std::string target_node_id =
-      "(SELECT Id FROM NatterNode WHERE ApplicationUuid='" + solanet::uuidToString(own_uuid) + "')";
   std::string message_str = solanet::uuidToString(msg_uuid);
 
-  auto table = kNatterCtrlMsg;
   if (message_str == solanet::uuidToString(solanet::UUID{})) {
-    table.columns[6] = {"MessageId", "NULL"};
+    // MessageId is NULL
     auto t = std::make_tuple(/* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
                              /* Type */ type,
                              /* Mode */ mode,
-                             /* SenderNodeId */ sender_node_id.c_str(),
-                             /* TargetNodeId */ target_node_id.c_str()
+                             /* SenderNodeId */ solanet::uuidToString(sender),
+                             /* TargetNodeId */ solanet::uuidToString(own_uuid)
                              // /* AdditionalContent */ target.c_str()  // TODO
     );
-    log_(getInsertStatement(table, t));
+    log_insert_(kNatterCtrlMsg, toDatabaseRow(t));
   } else {
-    std::string message_id = "(SELECT Id FROM NatterMessage WHERE Uuid='" + message_str + "')";
     auto t = std::make_tuple(/* Timestamp_ms */ ns3::Simulator::Now().GetMilliSeconds(),
                              /* Type */ type,
                              /* Mode */ mode,
-                             /* SenderNodeId */ sender_node_id.c_str(),
-                             /* TargetNodeId */ target_node_id.c_str(),
-                             /* MessageId */ message_id.c_str()
+                             /* SenderNodeId */ solanet::uuidToString(sender),
+                             /* TargetNodeId */ solanet::uuidToString(own_uuid),
+                             /* MessageId */ message_str
                              // /* AdditionalContent */ target.c_str()  // TODO
     );
-    log_(getInsertStatement(table, t));
+    log_insert_(kNatterCtrlMsg, toDatabaseRow(t));
   }
 }
 
@@ -222,9 +216,11 @@ void NatterLoggerNs3::logMinhcastBroadcast(solanet::UUID /*msg_id*/, uint32_t /*
 TableDefinition kTopicMessage("NatterDeliveredTopicMessage",
                               {DatabaseColumnInfo{"Id"},
                                {"Timestamp_us", "%lu", true},
-                               {"NodeId", "sql%u", true, "NatterNode(Id)"},
-                               {"InitialSenderNodeId", "sql%u", true, "NatterNode(Id)"},
-                               {"MessageId", "sql%u", true, "NatterMessage(Id)"},
+                               {"NodeId", "sql%u", true, "NatterNode(Id)", false,
+                                "ApplicationUuid"},
+                               {"InitialSenderNodeId", "sql%u", true, "NatterNode(Id)", false,
+                                "ApplicationUuid"},
+                               {"MessageId", "sql%u", true, "NatterMessage(Id)", false, "Uuid"},
                                {"Round", "%i", true}});
 static const std::string kCreateTopicMessage = getCreateTableStatement(kTopicMessage);
 
@@ -253,27 +249,22 @@ void NatterLoggerNs3::logReceivedMessages(solanet::UUID node_uuid, solanet::UUID
 
   // TODO: Messages should always identified by peer_uuid. Position can change, solanet::UUID not.
   // TODO: Node was a material flow or agv
-  std::string node_id = "(SELECT Id FROM NatterNode WHERE ApplicationUuid='" +
-                        solanet::uuidToString(node_uuid) + "')";
-  std::string initial_sender_node_id = "(SELECT Id FROM NatterNode WHERE ApplicationUuid='" +
-                                       solanet::uuidToString(initial_sender) + "')";
-  std::string message_id =
-      "(SELECT Id FROM NatterMessage WHERE Uuid='" + solanet::uuidToString(message) + "')";
   auto t = std::make_tuple(
       /* Timestamp_us */ ns3::Simulator::Now().GetMicroSeconds(),
-      /* NodeId */ node_id.c_str(),
-      /* InitialSenderNodeId */ initial_sender_node_id.c_str(),
-      /* MessageId */ message_id.c_str(),
+      /* NodeId */ solanet::uuidToString(node_uuid),
+      /* InitialSenderNodeId */ solanet::uuidToString(initial_sender),
+      /* MessageId */ solanet::uuidToString(message),
       /* Round */ round);
-  log_(getInsertStatement(kTopicMessage, t));
+  log_insert_(kTopicMessage, toDatabaseRow(t));
 }
 
 // * Constructor & Other methods
 NatterLoggerNs3::NatterLoggerNs3(LogDeviceApp log_device_application, LogFunction log,
-                                 LogEvent log_event)
+                                 LogInsert log_insert, LogEvent log_event)
     : LoggerInterface("NOT-KNOWN-YET"),
       log_device_application_(std::move(log_device_application)),
       log_(std::move(log)),
+      log_insert_(std::move(log_insert)),
       log_event_(std::move(log_event)) {}
 
 NatterLoggerNs3::~NatterLoggerNs3() {
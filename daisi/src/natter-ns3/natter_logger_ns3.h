@@ -28,7 +28,8 @@ namespace natter::logging {
 
 class NatterLoggerNs3 : public LoggerInterface {
 public:
-  NatterLoggerNs3(LogDeviceApp log_device_application, LogFunction log, LogEvent log_event);
+  NatterLoggerNs3(LogDeviceApp log_device_application, LogFunction log, LogInsert log_insert,
+                  LogEvent log_event);
 
   // natter-ns3 specific logging functions
   void logNewNetworkPeer(solanet::UUID uuid, const std::string &ip, uint16_t port, int level,
@@ -86,6 +87,7 @@ private:
   // TODO Refactor to other class
   LogDeviceApp log_device_application_;
   LogFunction log_;
+  LogInsert log_insert_;
   LogEvent log_event_;
 };
 
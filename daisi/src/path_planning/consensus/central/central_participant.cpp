@@ -78,6 +78,10 @@ void CentralParticipant::findConsensusImpl(const PointTimePairs &points,
   logger_->logSendPathPlanningTraffic("PLACEHOLDER", "CENTRAL", 4);
 }
 
+uint32_t CentralParticipant::getMaxConcurrentRequestsImpl() const {
+  return container_->max_concurrent_requests;
+}
+
 void CentralParticipant::recvTopicMessageImpl(const std::string &topic, const std::string &msg) {
   throw std::runtime_error("Central should not receive topic messages");
 }
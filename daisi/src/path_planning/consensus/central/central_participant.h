@@ -38,6 +38,7 @@ private:
                          std::function<void(uint32_t, double)> success_cb,
                          std::function<void(uint32_t)> fail_cb);
   void recvTopicMessageImpl(const std::string &topic, const std::string &msg);
+  [[nodiscard]] uint32_t getMaxConcurrentRequestsImpl() const;
 
   /**
    * Process messages received from central server
@@ -22,25 +22,26 @@
 #include <cmath>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "cpps/common/uuid_generator.h"
-#include "path_planning/consensus/route_calculation_helper.h"
 #include "path_planning/message/serializer.h"
 
 namespace daisi::path_planning::consensus {
 
 CentralServer::CentralServer(CentralSettings settings,
                              std::shared_ptr<PathPlanningLoggerNs3> logger)
-    : settings_(std::move(settings)), logger_(std::move(logger)) {
+    : settings_(std::move(settings)),
+      logger_(std::move(logger)),
+      occupancy_(settings_.number_of_shards, settings_.shard_region_size,
+                 settings_.time_between_intersects, settings_.occupancy_retention) {
   network_ = std::make_unique<solanet::Network>(
       [this](const solanet::Message &msg) { processMessage(msg); });
   logger_->setApplicationUUID(UUIDGenerator::get()());
 }
 
-void CentralServer::setIntersections(const std::set<PPVector> &intersections) {
-  for (auto intersection : intersections) {
-    intersection_occupancy_[intersection] = {};
-  }
+void CentralServer::setIntersections(const std::set<PPVector> & /*intersections*/) {
+  // The blocked intervals only know intersections once they are occupied
 }
 
 void CentralServer::processMessage(const solanet::Message &msg) {
@@ -58,9 +59,10 @@ void CentralServer::processMessage(const solanet::Message &msg) {
                    return {vec, time};
                  });
 
-  double possible_start_s = RouteCalculationHelper::calculatePossibleStartTime(
-      points, earliest_start_s, settings_.max_preplanning_time, settings_.time_between_intersects,
-      intersection_occupancy_);
+  // Only the shards of the route's intersections are involved
+  const std::vector<uint32_t> shards = occupancy_.getShards(points);
+  double possible_start_s = occupancy_.calculatePossibleStartTime(
+      points, shards, earliest_start_s, settings_.max_preplanning_time);
 
   // Send response to client
   Response response{};
@@ -73,11 +75,7 @@ void CentralServer::processMessage(const solanet::Message &msg) {
     response.start_offset = possible_start_s;
 
     // Update our global intersection knowledge
-    for (auto point : request.intersection_times) {
-      intersection_occupancy_.at(
-          {std::get<0>(point), std::get<1>(point)})[possible_start_s + std::get<2>(point)] =
-          0;  // id = 0 just to mark as occupied
-    }
+    occupancy_.reserve(points, shards, possible_start_s, ns3::Simulator::Now().GetSeconds());
   }
 
   solanet::Message net_msg(msg.getIp(), msg.getPort(), message::serialize<Response>(response));
@@ -21,6 +21,7 @@
 #include <set>
 
 #include "cpps/common/cpps_logger_ns3.h"
+#include "path_planning/consensus/central/sharded_occupancy.h"
 #include "path_planning/constants.h"
 #include "path_planning/path_planning_logger_ns_3.h"
 #include "solanet/network_udp/network_udp.h"
@@ -44,12 +45,11 @@ private:
 
   void processMessage(const solanet::Message &msg);
 
-  IntersectionOccupancy
-      intersection_occupancy_;  //!< Global intersection occupancy (with the centralized approach,
-                                //!< this is only known by the server)
-
   CentralSettings settings_;
   std::shared_ptr<PathPlanningLoggerNs3> logger_;
+
+  ShardedOccupancy occupancy_;  //!< Global intersection occupancy (with the centralized approach,
+                                //!< this is only known by the server), partitioned by regions
 };
 
 }  // namespace daisi::path_planning::consensus
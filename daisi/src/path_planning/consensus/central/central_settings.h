@@ -28,6 +28,13 @@ struct CentralSettings {
                                    //!< seconds
   double max_preplanning_time;     //!< Maximum time to look in the future to find a collision free
                                    //!< occupancy in seconds
+  uint32_t max_concurrent_requests = 4;  //!< Requests a participant sends without waiting for the
+                                         //!< responses
+  double occupancy_retention = 10.0;  //!< Time in seconds for which the server keeps occupancies
+                                      //!< after they passed
+  uint32_t number_of_shards = 1;  //!< Number of indices the blocked intervals of the server are
+                                  //!< split into by region, which bounds the size of each sweep
+  double shard_region_size = 20.0;  //!< Edge length of the square regions assigned to the indices
 };
 }  // namespace daisi::path_planning::consensus
 
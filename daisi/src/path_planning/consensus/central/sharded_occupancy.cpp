@@ -0,0 +1,102 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "sharded_occupancy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "path_planning/consensus/route_calculation_helper.h"
+#include "utils/daisi_check.h"
+
+namespace daisi::path_planning::consensus {
+
+ShardedOccupancy::ShardedOccupancy(uint32_t number_of_shards, double region_size,
+                                   double time_between_intersections_s, double retention_s)
+    : region_size_(region_size) {
+  DAISI_CHECK(number_of_shards > 0, "At least one shard is required");
+  DAISI_CHECK(region_size > 0, "Regions must not be empty");
+
+  shards_.reserve(number_of_shards);
+  for (auto i = 0U; i < number_of_shards; i++) {
+    shards_.push_back(Shard{OccupancyIntervalIndex(time_between_intersections_s),
+                            OccupancyHorizon(retention_s, time_between_intersections_s)});
+  }
+}
+
+uint32_t ShardedOccupancy::getShard(const Intersection &intersection) const {
+  const auto region_x = static_cast<int64_t>(std::floor(intersection.first / region_size_));
+  const auto region_y = static_cast<int64_t>(std::floor(intersection.second / region_size_));
+
+  // Neighboring regions are spread over different shards
+  const auto region = static_cast<uint64_t>(region_x * 73856093) ^
+                      static_cast<uint64_t>(region_y * 19349663);
+  return static_cast<uint32_t>(region % shards_.size());
+}
+
+std::vector<uint32_t> ShardedOccupancy::getShards(const PointTimePairs &points) const {
+  std::vector<uint32_t> shards;
+  for (const auto &[position, relative_time] : points) {
+    shards.push_back(getShard({position.x, position.y}));
+  }
+  std::sort(shards.begin(), shards.end());
+  shards.erase(std::unique(shards.begin(), shards.end()), shards.end());
+  return shards;
+}
+
+double ShardedOccupancy::calculatePossibleStartTime(const PointTimePairs &points,
+                                                    const std::vector<uint32_t> &shards,
+                                                    double earliest_start_s,
+                                                    double max_preplanning_time_s) const {
+  std::vector<const OccupancyIntervalIndex *> intervals;
+  intervals.reserve(shards.size());
+  for (auto shard : shards) {
+    intervals.push_back(&shards_[shard].intervals);
+  }
+
+  return RouteCalculationHelper::calculatePossibleStartTime(points, earliest_start_s,
+                                                            max_preplanning_time_s, intervals);
+}
+
+void ShardedOccupancy::reserve(const PointTimePairs &points, const std::vector<uint32_t> &shards,
+                               double start_time_s, Timestamp now_s) {
+  for (auto shard_id : shards) {
+    Shard &shard = shards_[shard_id];
+    std::size_t added = 0;
+    for (const auto &[position, relative_time] : points) {
+      const Intersection intersection = {position.x, position.y};
+      if (getShard(intersection) != shard_id) {
+        continue;
+      }
+
+      shard.intervals.addOccupancy(intersection, start_time_s + relative_time);
+      added++;
+    }
+
+    shard.horizon.notifyAdded(added);
+    shard.horizon.sweepIfDue(now_s, shard.intervals);
+  }
+}
+
+uint32_t ShardedOccupancy::getNumberOfShards() const {
+  return static_cast<uint32_t>(shards_.size());
+}
+
+const OccupancyIntervalIndex &ShardedOccupancy::getIntervals(uint32_t shard) const {
+  return shards_[shard].intervals;
+}
+
+}  // namespace daisi::path_planning::consensus
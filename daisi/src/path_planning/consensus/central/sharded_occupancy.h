@@ -0,0 +1,91 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_PATH_PLANNING_CONSENSUS_CENTRAL_SHARDED_OCCUPANCY_H_
+#define DAISI_PATH_PLANNING_CONSENSUS_CENTRAL_SHARDED_OCCUPANCY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "path_planning/consensus/occupancy_horizon.h"
+#include "path_planning/consensus/occupancy_interval_index.h"
+#include "path_planning/constants.h"
+
+namespace daisi::path_planning::consensus {
+//! Blocked intervals of the central server, split into one index per shard of spatial regions.
+//! Regions are squares which are distributed over the shards. A request only looks into the
+//! indices of its own intersections and a sweep only covers a single index. This only changes the
+//! layout of the data, requests are still handled one after another.
+//! A request is handled in two phases: The start time is calculated with the blocked intervals of
+//! all shards of the route, before the route is reserved in these shards.
+class ShardedOccupancy {
+public:
+  /**
+   * @param number_of_shards number of partitions, 1 keeps all intersections together
+   * @param region_size edge length of the square regions
+   * @param time_between_intersections_s time between occupancies of the same intersection
+   * @param retention_s time in seconds for which occupancies are kept after they passed
+   */
+  ShardedOccupancy(uint32_t number_of_shards, double region_size,
+                   double time_between_intersections_s, double retention_s);
+
+  //! Shard owning the intersection
+  [[nodiscard]] uint32_t getShard(const Intersection &intersection) const;
+
+  //! Shards of the intersections of a route in ascending order, without duplicates
+  [[nodiscard]] std::vector<uint32_t> getShards(const PointTimePairs &points) const;
+
+  /**
+   * First phase: Calculate a possible conflict free global start time
+   * @param points requested route with relative timestamps
+   * @param shards shards of the route, see getShards()
+   * @param earliest_start_s earliest possible start time
+   * @param max_preplanning_time_s Maximum time in which the start time might be in the future
+   * @return possible global start time in seconds or quiet_NaN() if no start time could be found
+   */
+  [[nodiscard]] double calculatePossibleStartTime(const PointTimePairs &points,
+                                                  const std::vector<uint32_t> &shards,
+                                                  double earliest_start_s,
+                                                  double max_preplanning_time_s) const;
+
+  /**
+   * Second phase: Reserve the route with the calculated start time in all of its shards
+   * @param points requested route with relative timestamps
+   * @param shards shards of the route, see getShards()
+   * @param start_time_s global start time in seconds
+   * @param now_s current simulation time to evict passed occupancies of the shards
+   */
+  void reserve(const PointTimePairs &points, const std::vector<uint32_t> &shards,
+               double start_time_s, Timestamp now_s);
+
+  [[nodiscard]] uint32_t getNumberOfShards() const;
+
+  //! Blocked intervals of a shard
+  [[nodiscard]] const OccupancyIntervalIndex &getIntervals(uint32_t shard) const;
+
+private:
+  struct Shard {
+    OccupancyIntervalIndex intervals;
+    OccupancyHorizon horizon;
+  };
+
+  const double region_size_;
+  std::vector<Shard> shards_;
+};
+
+}  // namespace daisi::path_planning::consensus
+
+#endif  // DAISI_PATH_PLANNING_CONSENSUS_CENTRAL_SHARDED_OCCUPANCY_H_
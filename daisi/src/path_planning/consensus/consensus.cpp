@@ -46,6 +46,16 @@ void Consensus::findConsensus(const PointTimePairs &points, double seconds_earli
     throw std::runtime_error("unsupported consensus type");
   }
 }
+uint32_t Consensus::getMaxConcurrentRequests() const {
+  if (const auto *paxos = std::get_if<PaxosConsensus>(&consensus_)) {
+    return paxos->getMaxConcurrentRequests();
+  }
+  if (const auto *central = std::get_if<CentralParticipant>(&consensus_)) {
+    return central->getMaxConcurrentRequests();
+  }
+  throw std::runtime_error("unsupported consensus type");
+}
+
 void Consensus::recvTopicMessage(const std::string &topic, const std::string &msg) {
   // Only paxos uses topic messages so far
   if (auto *paxos = std::get_if<PaxosConsensus>(&consensus_)) {
@@ -57,6 +57,9 @@ public:
    */
   void recvTopicMessage(const std::string &topic, const std::string &msg);
 
+  //! Number of requests that can be running at the same time, e.g., pipelined Paxos instances
+  [[nodiscard]] uint32_t getMaxConcurrentRequests() const;
+
 private:
   std::variant<std::monostate, PaxosConsensus,
                CentralParticipant>
@@ -42,6 +42,10 @@ public:
     return static_cast<T *>(this)->recvTopicMessageImpl(topic, msg);
   }
 
+  [[nodiscard]] uint32_t getMaxConcurrentRequests() const {
+    return static_cast<const T *>(this)->getMaxConcurrentRequestsImpl();
+  }
+
 protected:
   std::shared_ptr<DataContainer> container_;  //!< Data container which contains data that is needed
                                               //!< in multiple consensus algorithm classes
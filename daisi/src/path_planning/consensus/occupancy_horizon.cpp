@@ -0,0 +1,72 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "occupancy_horizon.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace daisi::path_planning::consensus {
+
+OccupancyHorizon::OccupancyHorizon(double retention_s, double time_between_intersections_s)
+    : retention_s_(retention_s), time_between_intersections_s_(time_between_intersections_s) {}
+
+void OccupancyHorizon::notifyAdded(std::size_t occupancies) { added_since_sweep_ += occupancies; }
+
+bool OccupancyHorizon::isSweepDue() const {
+  return added_since_sweep_ >= std::max(kMinSweepInterval, live_after_sweep_);
+}
+
+Timestamp OccupancyHorizon::getHorizon(Timestamp now_s) const { return now_s - retention_s_; }
+
+std::size_t OccupancyHorizon::sweepIfDue(Timestamp now_s, IntersectionOccupancy &occupancy,
+                                         OccupancyIntervalIndex &index) {
+  return isSweepDue() ? sweep(now_s, occupancy, index) : 0;
+}
+
+std::size_t OccupancyHorizon::sweep(Timestamp now_s, IntersectionOccupancy &occupancy,
+                                    OccupancyIntervalIndex &index) {
+  const Timestamp horizon = getHorizon(now_s);
+
+  // An occupancy at t blocks [t - delta, t + delta]
+  std::size_t evicted = 0;
+  std::size_t live = 0;
+  for (auto &[intersection, times] : occupancy) {
+    auto first_live = times.lower_bound(horizon - time_between_intersections_s_);
+    evicted += std::distance(times.begin(), first_live);
+    times.erase(times.begin(), first_live);
+    live += times.size();
+  }
+  index.pruneBefore(horizon);
+
+  added_since_sweep_ = 0;
+  live_after_sweep_ = live;
+  return evicted;
+}
+
+std::size_t OccupancyHorizon::sweepIfDue(Timestamp now_s, OccupancyIntervalIndex &index) {
+  if (!isSweepDue()) {
+    return 0;
+  }
+
+  const std::size_t evicted = index.pruneBefore(getHorizon(now_s));
+
+  added_since_sweep_ = 0;
+  live_after_sweep_ = index.getNumberOfIntervals();
+  return evicted;
+}
+
+}  // namespace daisi::path_planning::consensus
@@ -0,0 +1,78 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_PATH_PLANNING_CONSENSUS_OCCUPANCY_HORIZON_H_
+#define DAISI_PATH_PLANNING_CONSENSUS_OCCUPANCY_HORIZON_H_
+
+#include <cstddef>
+
+#include "path_planning/consensus/occupancy_interval_index.h"
+#include "path_planning/constants.h"
+
+namespace daisi::path_planning::consensus {
+//! Evicts occupancies whose blocked time window lies entirely before a horizon, which trails the
+//! simulation time by a retention time. New occupancies never start before the current time, so
+//! evicted occupancies cannot conflict with them anymore.
+//! A sweep visits all occupancies, so it only runs once as many occupancies were added as were
+//! live after the previous sweep. Thereby, the cost of the sweeps is amortized over the
+//! insertions and the occupancies stay bounded by the ones within the live time window.
+class OccupancyHorizon {
+public:
+  /**
+   * @param retention_s time in seconds for which occupancies are kept after their blocked window
+   * @param time_between_intersections_s time between occupancies of the same intersection
+   */
+  OccupancyHorizon(double retention_s, double time_between_intersections_s);
+
+  //! Count occupancies which were added since the last sweep
+  void notifyAdded(std::size_t occupancies = 1);
+
+  [[nodiscard]] bool isSweepDue() const;
+
+  //! Blocked windows ending before the horizon are evicted
+  [[nodiscard]] Timestamp getHorizon(Timestamp now_s) const;
+
+  /**
+   * Evict the occupancies and blocked intervals before the horizon if a sweep is due
+   * @param now_s current simulation time in seconds
+   * @param occupancy occupancies, the keys of the intersections are kept
+   * @param index blocked intervals of \p occupancy
+   * @return number of evicted occupancies
+   */
+  std::size_t sweepIfDue(Timestamp now_s, IntersectionOccupancy &occupancy,
+                         OccupancyIntervalIndex &index);
+
+  //! Evict the occupancies and blocked intervals before the horizon
+  std::size_t sweep(Timestamp now_s, IntersectionOccupancy &occupancy,
+                    OccupancyIntervalIndex &index);
+
+  //! Same as sweepIfDue() for blocked intervals which are kept without their occupancies
+  //! @return number of evicted intervals
+  std::size_t sweepIfDue(Timestamp now_s, OccupancyIntervalIndex &index);
+
+private:
+  //! Sweeping tiny tables more often than this is not worth it
+  static constexpr std::size_t kMinSweepInterval = 256;
+
+  const double retention_s_;
+  const double time_between_intersections_s_;
+
+  std::size_t added_since_sweep_ = 0;
+  std::size_t live_after_sweep_ = 0;
+};
+}  // namespace daisi::path_planning::consensus
+
+#endif  // DAISI_PATH_PLANNING_CONSENSUS_OCCUPANCY_HORIZON_H_
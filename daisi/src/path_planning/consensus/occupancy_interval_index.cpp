@@ -0,0 +1,83 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "occupancy_interval_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace daisi::path_planning::consensus {
+
+OccupancyIntervalIndex::OccupancyIntervalIndex(double time_between_intersections_s)
+    : time_between_intersections_s_(time_between_intersections_s) {}
+
+void OccupancyIntervalIndex::addOccupancy(const Intersection &intersection, Timestamp time_s) {
+  double begin = time_s - time_between_intersections_s_;
+  double end = time_s + time_between_intersections_s_;
+  auto &intervals = blocked_intervals_[intersection];
+
+  // Merge with all intervals overlapping [begin, end]
+  auto it = intervals.upper_bound(begin);
+  if (it != intervals.begin() && std::prev(it)->second >= begin) {
+    --it;
+  }
+  while (it != intervals.end() && it->first <= end) {
+    begin = std::min(begin, it->first);
+    end = std::max(end, it->second);
+    it = intervals.erase(it);
+  }
+
+  intervals.emplace_hint(it, begin, end);
+}
+
+bool OccupancyIntervalIndex::isBlocked(const Intersection &intersection, Timestamp time_s) const {
+  bool blocked = false;
+  forEachBlockedInterval(intersection, time_s, time_s,
+                         [&blocked](double /*begin_s*/, double /*end_s*/) { blocked = true; });
+  return blocked;
+}
+
+std::size_t OccupancyIntervalIndex::pruneBefore(Timestamp time_s) {
+  std::size_t removed = 0;
+  for (auto it = blocked_intervals_.begin(); it != blocked_intervals_.end();) {
+    auto &intervals = it->second;
+
+    // Intervals are disjoint and sorted, so their ends are sorted too
+    auto first_live = intervals.begin();
+    while (first_live != intervals.end() && first_live->second < time_s) {
+      ++first_live;
+    }
+    removed += std::distance(intervals.begin(), first_live);
+    intervals.erase(intervals.begin(), first_live);
+
+    it = intervals.empty() ? blocked_intervals_.erase(it) : std::next(it);
+  }
+  return removed;
+}
+
+std::size_t OccupancyIntervalIndex::getNumberOfIntervals() const {
+  std::size_t intervals = 0;
+  for (const auto &[intersection, blocked] : blocked_intervals_) {
+    intervals += blocked.size();
+  }
+  return intervals;
+}
+
+double OccupancyIntervalIndex::getTimeBetweenIntersections() const {
+  return time_between_intersections_s_;
+}
+
+}  // namespace daisi::path_planning::consensus
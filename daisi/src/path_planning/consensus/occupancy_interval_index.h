@@ -0,0 +1,93 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_PATH_PLANNING_CONSENSUS_OCCUPANCY_INTERVAL_INDEX_H_
+#define DAISI_PATH_PLANNING_CONSENSUS_OCCUPANCY_INTERVAL_INDEX_H_
+
+#include <iterator>
+#include <map>
+#include <unordered_map>
+
+#include "path_planning/constants.h"
+
+namespace daisi::path_planning::consensus {
+//! Time intervals in which intersections are blocked by occupancies. An occupancy at time t blocks
+//! the intersection in [t - delta, t + delta] with the minimum time delta between two occupancies
+//! of the same intersection. Overlapping intervals are merged on insertion.
+class OccupancyIntervalIndex {
+public:
+  explicit OccupancyIntervalIndex(double time_between_intersections_s);
+
+  /**
+   * Block the intersection around a new occupancy
+   * @param intersection occupied intersection
+   * @param time_s global time of the occupancy in seconds
+   */
+  void addOccupancy(const Intersection &intersection, Timestamp time_s);
+
+  /**
+   * Call \p function(begin_s, end_s) for every blocked interval of the intersection which
+   * overlaps [\p from_s, \p to_s], in ascending order
+   */
+  template <typename Function>
+  void forEachBlockedInterval(const Intersection &intersection, double from_s, double to_s,
+                              Function &&function) const;
+
+  //! Whether an occupancy at the given time would conflict with another occupancy
+  [[nodiscard]] bool isBlocked(const Intersection &intersection, Timestamp time_s) const;
+
+  /**
+   * Forget the blocked intervals which end before \p time_s, as they cannot conflict with an
+   * occupancy at or after this time anymore
+   * @return number of removed intervals
+   */
+  std::size_t pruneBefore(Timestamp time_s);
+
+  //! Number of blocked intervals of all intersections
+  [[nodiscard]] std::size_t getNumberOfIntervals() const;
+
+  [[nodiscard]] double getTimeBetweenIntersections() const;
+
+private:
+  double time_between_intersections_s_;
+
+  //! Disjoint blocked intervals per intersection, begin -> end
+  std::unordered_map<Intersection, std::map<double, double>> blocked_intervals_;
+};
+
+template <typename Function>
+void OccupancyIntervalIndex::forEachBlockedInterval(const Intersection &intersection,
+                                                    double from_s, double to_s,
+                                                    Function &&function) const {
+  auto intersection_it = blocked_intervals_.find(intersection);
+  if (intersection_it == blocked_intervals_.end()) {
+    return;
+  }
+
+  const auto &intervals = intersection_it->second;
+  auto it = intervals.upper_bound(from_s);
+  if (it != intervals.begin() && std::prev(it)->second >= from_s) {
+    --it;
+  }
+
+  for (; it != intervals.end() && it->first <= to_s; ++it) {
+    function(it->first, it->second);
+  }
+}
+
+}  // namespace daisi::path_planning::consensus
+
+#endif  // DAISI_PATH_PLANNING_CONSENSUS_OCCUPANCY_INTERVAL_INDEX_H_
@@ -21,7 +21,16 @@
 
 namespace daisi::path_planning::consensus {
 
-enum class ConsensusMsgTypes { kPrepare, kPromise, kAccept, kOk, kResponse, kReplication };
+enum class ConsensusMsgTypes {
+  kPrepare,
+  kPromise,
+  kAccept,
+  kOk,
+  kResponse,
+  kReplication,
+  kCatchUpRequest,
+  kCatchUp
+};
 
 const std::string kReplicationTopic = "/replication";
 const std::string kPaxosTopic = "/paxos";
@@ -25,14 +25,15 @@
 
 namespace daisi::path_planning::consensus {
 //!< Accept message send from the proposer to the acceptors with the actual intersection
-//!< occupancies that should be set for the given instance
+//!< occupancies that should be set for the given instance. Several routes might be batched into
+//!< one instance.
 struct AcceptMessage {
-  SERIALIZE(instance_id, proposal_id, station_id, intersections);
+  SERIALIZE(instance_id, proposal_id, station_id, routes);
 
   uint32_t instance_id = 0;
   uint32_t proposal_id = 0;
   uint32_t station_id = 0;
-  std::vector<IntersectionTimeInfo> intersections;
+  std::vector<RouteOccupancies> routes;
 };
 }  // namespace daisi::path_planning::consensus
 
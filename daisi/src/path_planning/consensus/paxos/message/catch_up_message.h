@@ -0,0 +1,54 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_PATH_PLANNING_CONSENSUS_PAXOS_MESSAGE_CATCH_UP_H_
+#define DAISI_PATH_PLANNING_CONSENSUS_PAXOS_MESSAGE_CATCH_UP_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "path_planning/station.h"
+#include "solanet/serializer/serializer.h"
+
+namespace daisi::path_planning::consensus {
+//!< Decided instances for a participant that is lagging behind. If the requested instances are
+//!< already folded into the snapshot of the sender, the snapshot is sent instead, split into
+//!< several chunks.
+struct CatchUpMessage {
+  SERIALIZE(station_id, sender_station_id, first_instance, instance_stations, instance_routes,
+            instance_applied, snapshot, snapshot_chunk, snapshot_chunks, snapshot_occupancies);
+
+  uint32_t station_id = 0;         //!< Station that is catching up
+  uint32_t sender_station_id = 0;  //!< Station that answers
+  uint32_t first_instance = 0;     //!< Instance of the first entry in \p instance_routes
+
+  //!< Proposing station and finally accepted routes of the instances starting at \p first_instance
+  std::vector<uint32_t> instance_stations;
+  std::vector<std::vector<RouteOccupancies>> instance_routes;
+
+  //!< Per instance and route whether the sender applied the route, replayed by the receiver
+  std::vector<std::vector<bool>> instance_applied;
+
+  //!< Whether \p snapshot_occupancies contains the occupancies of all instances before
+  //!< \p first_instance
+  bool snapshot = false;
+  uint32_t snapshot_chunk = 0;   //!< Index of this chunk of the snapshot
+  uint32_t snapshot_chunks = 1;  //!< Number of chunks, the snapshot is restored once all arrived
+  std::vector<IntersectionTimeInfo> snapshot_occupancies;
+};
+}  // namespace daisi::path_planning::consensus
+
+#endif  // DAISI_PATH_PLANNING_CONSENSUS_PAXOS_MESSAGE_CATCH_UP_H_
@@ -0,0 +1,35 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_PATH_PLANNING_CONSENSUS_PAXOS_MESSAGE_CATCH_UP_REQUEST_H_
+#define DAISI_PATH_PLANNING_CONSENSUS_PAXOS_MESSAGE_CATCH_UP_REQUEST_H_
+
+#include <cstdint>
+
+#include "solanet/serializer/serializer.h"
+
+namespace daisi::path_planning::consensus {
+//!< Catch up request send from a participant that missed decided instances, e.g., because it
+//!< received a prepare for an instance after its next undecided instance
+struct CatchUpRequestMessage {
+  SERIALIZE(next_instance, station_id);
+
+  uint32_t next_instance = 0;  //!< First instance that is not decided by the requesting station
+  uint32_t station_id = 0;     //!< Requesting station
+};
+}  // namespace daisi::path_planning::consensus
+
+#endif  // DAISI_PATH_PLANNING_CONSENSUS_PAXOS_MESSAGE_CATCH_UP_REQUEST_H_
@@ -28,11 +28,15 @@ namespace daisi::path_planning::consensus {
 //!< Prepare message send from proposer to all acceptors which is used to get a promise from
 //!< all acceptors (quorum) so that they will accept the occupancies.
 struct PrepareMessage {
-  SERIALIZE(instance_id, prepare_id, station_id);
+  SERIALIZE(instance_id, prepare_id, station_id, all_following_instances);
 
   uint32_t instance_id = 0;
   uint32_t prepare_id = 0;
   uint32_t station_id = 0;
+
+  //!< Multi-Paxos: Promise all following instances too, so that the proposer becomes the leader
+  //!< and sends accepts for them without another prepare
+  bool all_following_instances = false;
 };
 }  // namespace daisi::path_planning::consensus
 
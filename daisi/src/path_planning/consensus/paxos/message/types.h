@@ -20,6 +20,8 @@
 #include <variant>
 
 #include "accept_message.h"
+#include "catch_up_message.h"
+#include "catch_up_request_message.h"
 #include "ok_message.h"
 #include "prepare_message.h"
 #include "promise_message.h"
@@ -27,8 +29,8 @@
 #include "response_message.h"
 
 namespace daisi::path_planning::consensus {
-using PaxosMessage =
-    std::variant<PrepareMessage, PromiseMessage, OKMessage, AcceptMessage, ResponseMessage>;
+using PaxosMessage = std::variant<PrepareMessage, PromiseMessage, OKMessage, AcceptMessage,
+                                  ResponseMessage, CatchUpRequestMessage, CatchUpMessage>;
 }
 
 #endif  // DAISI_PATH_PLANNING_CONSENSUS_PAXOS_MESSAGE_TYPES_H_
@@ -16,40 +16,50 @@
 
 #include "paxos_acceptor.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "constants.h"
+#include "ns3/simulator.h"
 #include "path_planning/consensus/paxos/message/promise_message.h"
-#include "path_planning/intersection_set.h"
 #include "path_planning/message/serializer.h"
 #include "utils/daisi_check.h"
 
 namespace daisi::path_planning::consensus {
 
 PaxosAcceptor::PaxosAcceptor(std::shared_ptr<PaxosContainer> container)
-    : container_(std::move(container)) {}
+    : container_(std::move(container)) {
+  container_->request_catch_up_cb = [this]() { requestCatchUp(); };
+}
 
 void PaxosAcceptor::processPrepareMessage(const PrepareMessage &msg) {
-  auto it = container_->instance_to_promised.find(msg.instance_id);
-  std::pair<uint32_t, uint32_t> prepare = {msg.prepare_id, msg.station_id};
+  if (container_->isDecided(msg.instance_id)) {
+    // There is definitely already some decided value for this instance
+    // Do not send a promise, but let the proposer catch up
+    if (msg.instance_id < container_->decided_instances.getNextInstance() &&
+        isCatchUpResponder()) {
+      sendCatchUpMessage(msg.station_id, msg.instance_id);
+    }
+    return;
+  }
+  if (!isWithinPipeline(msg.instance_id)) {
+    // We missed decided instances and cannot accept data for this instance
+    requestCatchUp();
+    return;
+  }
 
-  if (it == container_->instance_to_promised.end() || prepare > it->second) {
+  RequestID prepare = {msg.prepare_id, msg.station_id};
+  if (container_->promise(msg.instance_id, prepare, msg.all_following_instances)) {
     // New / Greater -> Promise and save
-    container_->instance_to_promised[msg.instance_id] = prepare;
     PromiseMessage promise{msg.instance_id, msg.prepare_id, msg.station_id};
-    uint32_t current_instance = container_->finally_accepted_data.size();
-    if (current_instance == msg.instance_id &&
-        container_->accepted_data_current_instance.initialized()) {
+    auto accepted = container_->accepted_proposals.find(msg.instance_id);
+    if (accepted != container_->accepted_proposals.end()) {
       promise.already_accepted = true;
-      promise.accepted_prepare_id = container_->accepted_data_current_instance.proposal_id;
-      promise.accepted_station_id = container_->accepted_data_current_instance.station_id;
+      promise.accepted_prepare_id = accepted->second.proposal_id;
+      promise.accepted_station_id = accepted->second.station_id;
     }
 
-    if (current_instance > msg.instance_id) {
-      // There is definitely already some decided values for all smaller instances
-      // Do not send a promise
-      return;
-    }
-
-    container_->sola->publishMessage(kPaxosTopic, message::serialize<PaxosMessage>(promise));
+    container_->publish(kPaxosTopic, message::serialize<PaxosMessage>(promise));
     container_->logger->logSendPathPlanningTopicTraffic(
         kPaxosTopic, std::to_string(container_->node_id), promise.instance_id,
         static_cast<uint32_t>(ConsensusMsgTypes::kPromise));
@@ -57,20 +67,35 @@ void PaxosAcceptor::processPrepareMessage(const PrepareMessage &msg) {
 }
 
 void PaxosAcceptor::processAcceptMessage(const AcceptMessage &msg) {
-  std::pair<uint32_t, uint32_t> sender = {msg.proposal_id, msg.station_id};
-  if (sender != container_->instance_to_promised[msg.instance_id]) {
+  if (container_->isDecided(msg.instance_id) || !isWithinPipeline(msg.instance_id)) {
+    // Already decided or we are lagging behind
+    return;
+  }
+
+  RequestID sender = {msg.proposal_id, msg.station_id};
+  auto promised = container_->getPromised(msg.instance_id);
+  if (!promised || sender != *promised) {
     // Not (longer) promised
     return;
   }
 
+  // A leader skipped the prepare of this instance and did not learn about a proposal we already
+  // accepted for it. This proposal might be decided, so it must not be replaced without a prepare.
+  auto instance_promise = container_->instance_to_promised.find(msg.instance_id);
+  auto accepted = container_->accepted_proposals.find(msg.instance_id);
+  if ((instance_promise == container_->instance_to_promised.end() ||
+       instance_promise->second != sender) &&
+      accepted != container_->accepted_proposals.end() &&
+      RequestID{accepted->second.proposal_id, accepted->second.station_id} != sender) {
+    return;
+  }
+
   // Insert into own data
-  assert(!msg.intersections.empty());
-  container_->accepted_data_current_instance =
-      AcceptedProposal{msg.instance_id, msg.proposal_id, msg.station_id, msg.intersections};
-  current_accepted_instance_ = msg.instance_id;
-  current_accepted_proposal_id_ = msg.proposal_id;
-  current_accepted_station_ = msg.station_id;
-  remaining_oks_ =
+  assert(!msg.routes.empty());
+  container_->accepted_proposals[msg.instance_id] =
+      AcceptedProposal{msg.instance_id, msg.proposal_id, msg.station_id, msg.routes};
+  uint32_t &remaining_oks = remaining_oks_[msg.instance_id];
+  remaining_oks =
       container_->settings.number_paxos_participants - 2;  // Excluding initial sender and own
 
   auto it = std::find_if(already_received_.begin(), already_received_.end(),
@@ -79,29 +104,33 @@ void PaxosAcceptor::processAcceptMessage(const AcceptMessage &msg) {
                                   ok.instance == msg.instance_id && ok.station == msg.station_id;
                          });
   if (it != already_received_.end()) {
-    remaining_oks_ = remaining_oks_ - it->already_received;
+    remaining_oks = remaining_oks - it->already_received;
     already_received_.erase(it);
   }
 
   // Send ok
   OKMessage ok{msg.instance_id, msg.proposal_id, msg.station_id, container_->node_id};
-  container_->sola->publishMessage(kPaxosTopic, message::serialize<PaxosMessage>(ok));
+  container_->publish(kPaxosTopic, message::serialize<PaxosMessage>(ok));
   container_->logger->logSendPathPlanningTopicTraffic(
       kPaxosTopic, std::to_string(container_->node_id), ok.instance_id,
       static_cast<uint32_t>(ConsensusMsgTypes::kOk));
 
-  if (remaining_oks_ == 0) {
-    sendResponseMessage();
+  if (remaining_oks == 0) {
+    sendResponseMessage(msg.instance_id);
   }
 }
 void PaxosAcceptor::processOKMessage(const OKMessage &msg) {
   if (msg.station_id == container_->node_id)
     return;  // Message should go to proposer. We are initiator
 
-  if (!container_->accepted_data_current_instance.initialized() ||
-      container_->accepted_data_current_instance.instance_id != msg.instance_id ||
-      container_->accepted_data_current_instance.proposal_id != msg.proposal_id ||
-      container_->accepted_data_current_instance.station_id != msg.station_id) {
+  if (container_->isDecided(msg.instance_id)) {
+    return;  // Already decided
+  }
+
+  auto accepted = container_->accepted_proposals.find(msg.instance_id);
+  if (accepted == container_->accepted_proposals.end() ||
+      accepted->second.proposal_id != msg.proposal_id ||
+      accepted->second.station_id != msg.station_id) {
     // Temporary save
     auto it = std::find_if(already_received_.begin(), already_received_.end(),
                            [msg](const AlreadyReceivedOKS &ok) {
@@ -117,61 +146,198 @@ void PaxosAcceptor::processOKMessage(const OKMessage &msg) {
     return;
   }
 
-  if (msg.instance_id != current_accepted_instance_ ||
-      msg.proposal_id != current_accepted_proposal_id_ ||
-      msg.station_id != current_accepted_station_) {
+  auto remaining_oks = remaining_oks_.find(msg.instance_id);
+  if (remaining_oks == remaining_oks_.end()) {
     throw std::runtime_error("values not equal");
   }
 
-  assert(msg.instance_id == current_accepted_instance_);
-  assert(msg.proposal_id == current_accepted_proposal_id_);
-  assert(msg.station_id == current_accepted_station_);
-
-  remaining_oks_--;
-  if (remaining_oks_ == 0) {
-    sendResponseMessage();
+  remaining_oks->second--;
+  if (remaining_oks->second == 0) {
+    sendResponseMessage(msg.instance_id);
   }
 }
-void PaxosAcceptor::sendResponseMessage() {
-  container_->finally_accepted_data.push_back(container_->accepted_data_current_instance.data);
-
-  if (container_->finally_accepted_data.size() - 1 != current_accepted_instance_)
-    throw std::runtime_error("incorrect size");
+void PaxosAcceptor::sendResponseMessage(InstanceID instance) {
+  auto accepted = container_->accepted_proposals.find(instance);
+  if (accepted == container_->accepted_proposals.end())
+    throw std::runtime_error("missing accepted proposal");
 
-  container_->accepted_data_current_instance = AcceptedProposal{};
-  ResponseMessage response{current_accepted_instance_, current_accepted_proposal_id_,
-                           current_accepted_station_};
-
-  for (auto point :
-       container_->finally_accepted_data[container_->finally_accepted_data.size() - 1]) {
-    // Verify that point is actually an intersection in this scenario
-    DAISI_CHECK(
-        getAllIntersections().count({point.intersection.first, point.intersection.second}) == 1,
-        "Invalid point");
-    container_->agreed_data[point.intersection][point.time_at_intersection] = container_->node_id;
-  }
+  const uint32_t proposal_id = accepted->second.proposal_id;
+  const uint32_t station_id = accepted->second.station_id;
+  ResponseMessage response{instance, proposal_id, station_id};
+  container_->decideInstance(instance, station_id, std::move(accepted->second.routes));
 
   // Send for replication
   if (container_->settings.replication) {
-    ReplicationMessage replication{current_accepted_instance_, current_accepted_proposal_id_,
-                                   current_accepted_station_};
-    container_->sola->publishMessage(kReplicationTopic, message::serialize<>(replication));
+    ReplicationMessage replication{instance, proposal_id, station_id};
+    container_->publish(kReplicationTopic, message::serialize<>(replication));
     container_->logger->logSendPathPlanningTopicTraffic(
-        kReplicationTopic, std::to_string(container_->node_id), current_accepted_instance_,
+        kReplicationTopic, std::to_string(container_->node_id), instance,
         static_cast<uint32_t>(ConsensusMsgTypes::kReplication));
   }
 
-  container_->instance_to_promised[current_accepted_instance_] = {
-      UINT32_MAX, UINT32_MAX};  // Value is decided, block other values
-
-  current_accepted_instance_ = UINT32_MAX;
-  current_accepted_proposal_id_ = UINT32_MAX;
-  current_accepted_station_ = UINT32_MAX;
+  // Value is decided, other values are blocked as the instance is decided
+  pruneDecidedInstances();
 
-  container_->sola->publishMessage(kPaxosTopic, message::serialize<PaxosMessage>(response));
+  container_->publish(kPaxosTopic, message::serialize<PaxosMessage>(response));
   container_->logger->logSendPathPlanningTopicTraffic(
       kPaxosTopic, std::to_string(container_->node_id), response.instance_id,
       static_cast<uint32_t>(ConsensusMsgTypes::kResponse));
 }
 
+void PaxosAcceptor::processCatchUpRequestMessage(const CatchUpRequestMessage &msg) {
+  if (msg.station_id == container_->node_id) return;  // Own request
+
+  if (msg.next_instance >= container_->decided_instances.getNextInstance()) {
+    return;  // Cannot help
+  }
+
+  if (isCatchUpResponder()) {
+    sendCatchUpMessage(msg.station_id, msg.next_instance);
+  } else {
+    scheduleFallbackCatchUp(msg.station_id, msg.next_instance);
+  }
+}
+
+void PaxosAcceptor::scheduleFallbackCatchUp(uint32_t station_id, InstanceID from_instance) {
+  // Answered before the requester asks again, which is rate limited to 500 ms
+  constexpr uint32_t kFallbackDelayMs = 40;
+  const auto rank = static_cast<uint32_t>(container_->node_id %
+                                          container_->settings.number_paxos_participants);
+  const uint32_t delay_ms = std::min(kFallbackDelayMs * (rank + 1), 400U);
+
+  ns3::Simulator::Cancel(fallback_catch_ups_[station_id]);
+  fallback_catch_ups_[station_id] =
+      ns3::Simulator::Schedule(ns3::MilliSeconds(delay_ms), &PaxosAcceptor::sendFallbackCatchUp,
+                               this, station_id, from_instance);
+}
+
+void PaxosAcceptor::sendFallbackCatchUp(uint32_t station_id, InstanceID from_instance) {
+  fallback_catch_ups_.erase(station_id);
+  sendCatchUpMessage(station_id, from_instance);
+}
+
+void PaxosAcceptor::processCatchUpMessage(const CatchUpMessage &msg) {
+  if (auto fallback = fallback_catch_ups_.find(msg.station_id);
+      fallback != fallback_catch_ups_.end() && msg.sender_station_id != container_->node_id) {
+    // Already answered by another participant
+    ns3::Simulator::Cancel(fallback->second);
+    fallback_catch_ups_.erase(fallback);
+  }
+
+  if (msg.station_id != container_->node_id) return;  // Not for us
+
+  if (msg.snapshot) {
+    processSnapshotChunk(msg);
+  }
+
+  for (auto i = 0U; i < msg.instance_routes.size(); i++) {
+    container_->learnAppliedInstance(
+        msg.first_instance + i,
+        DecidedInstance{msg.instance_stations[i], msg.instance_routes[i], msg.instance_applied[i]});
+  }
+
+  pruneDecidedInstances();
+}
+
+void PaxosAcceptor::processSnapshotChunk(const CatchUpMessage &msg) {
+  if (!partial_snapshot_ || partial_snapshot_->sender_station_id != msg.sender_station_id ||
+      partial_snapshot_->next_instance != msg.first_instance) {
+    // Chunks of an older answer are not complete anymore
+    partial_snapshot_ = PartialSnapshot{msg.sender_station_id, msg.first_instance, {}};
+  }
+
+  partial_snapshot_->chunks[msg.snapshot_chunk] = msg.snapshot_occupancies;
+  if (partial_snapshot_->chunks.size() < msg.snapshot_chunks) {
+    return;
+  }
+
+  std::vector<IntersectionTimeInfo> occupancies;
+  for (const auto &[chunk, chunk_occupancies] : partial_snapshot_->chunks) {
+    occupancies.insert(occupancies.end(), chunk_occupancies.begin(), chunk_occupancies.end());
+  }
+  partial_snapshot_.reset();
+  container_->restoreSnapshot(msg.first_instance, occupancies);
+}
+
+bool PaxosAcceptor::isCatchUpResponder() const {
+  const auto *latest = container_->decided_instances.getLatest();
+  return latest != nullptr && latest->station_id == container_->node_id;
+}
+
+void PaxosAcceptor::sendCatchUpMessage(uint32_t station_id, InstanceID from_instance) {
+  const auto &decided_instances = container_->decided_instances;
+  CatchUpMessage catch_up{station_id, container_->node_id, from_instance};
+
+  if (!decided_instances.isFolded(from_instance)) {
+    decided_instances.forEachEntry(
+        from_instance, [&catch_up](InstanceID /*instance*/, const DecidedInstance &entry) {
+          catch_up.instance_stations.push_back(entry.station_id);
+          catch_up.instance_routes.push_back(entry.routes);
+          catch_up.instance_applied.push_back(entry.applied);
+        });
+    publishCatchUpMessage(catch_up);
+    return;
+  }
+
+  // Entries are not available anymore, send everything that was decided instead
+  catch_up.first_instance = decided_instances.getNextInstance();
+  catch_up.snapshot = true;
+
+  const std::vector<IntersectionTimeInfo> occupancies = container_->getAgreedOccupancies();
+  const auto chunk_size = static_cast<std::size_t>(kMaxSnapshotOccupanciesPerMessage);
+  const auto chunks = (occupancies.size() + chunk_size - 1) / chunk_size;
+  catch_up.snapshot_chunks = std::max<uint32_t>(1, static_cast<uint32_t>(chunks));
+  for (auto chunk = 0U; chunk < catch_up.snapshot_chunks; chunk++) {
+    const auto begin = std::min(chunk * chunk_size, occupancies.size());
+    const auto end = std::min(begin + chunk_size, occupancies.size());
+    catch_up.snapshot_chunk = chunk;
+    catch_up.snapshot_occupancies.assign(occupancies.begin() + begin, occupancies.begin() + end);
+    publishCatchUpMessage(catch_up);
+  }
+}
+
+void PaxosAcceptor::publishCatchUpMessage(const CatchUpMessage &catch_up) {
+  container_->publish(kPaxosTopic, message::serialize<PaxosMessage>(catch_up));
+  container_->logger->logSendPathPlanningTopicTraffic(
+      kPaxosTopic, std::to_string(container_->node_id), catch_up.first_instance,
+      static_cast<uint32_t>(ConsensusMsgTypes::kCatchUp));
+}
+
+void PaxosAcceptor::requestCatchUp() {
+  const InstanceID next_instance = container_->decided_instances.getNextInstance();
+  const ns3::Time now = ns3::Simulator::Now();
+  if (catch_up_requested_instance_ == next_instance &&
+      now - catch_up_requested_time_ < ns3::MilliSeconds(500)) {
+    // Still waiting for the answer
+    return;
+  }
+  catch_up_requested_instance_ = next_instance;
+  catch_up_requested_time_ = now;
+
+  CatchUpRequestMessage request{next_instance, container_->node_id};
+  container_->publish(kPaxosTopic, message::serialize<PaxosMessage>(request));
+  container_->logger->logSendPathPlanningTopicTraffic(
+      kPaxosTopic, std::to_string(container_->node_id), request.next_instance,
+      static_cast<uint32_t>(ConsensusMsgTypes::kCatchUpRequest));
+}
+
+bool PaxosAcceptor::isWithinPipeline(InstanceID instance) const {
+  const auto pipelined_instances = container_->settings.max_pipelined_instances *
+                                   container_->settings.number_paxos_participants;
+  return instance < container_->decided_instances.getNextInstance() + pipelined_instances;
+}
+
+void PaxosAcceptor::pruneDecidedInstances() {
+  for (auto it = remaining_oks_.begin(); it != remaining_oks_.end();) {
+    // Decided by others while we were waiting for OKs
+    it = container_->isDecided(it->first) ? remaining_oks_.erase(it) : std::next(it);
+  }
+
+  already_received_.erase(std::remove_if(already_received_.begin(), already_received_.end(),
+                                         [this](const AlreadyReceivedOKS &ok) {
+                                           return container_->isDecided(ok.instance);
+                                         }),
+                          already_received_.end());
+}
+
 }  // namespace daisi::path_planning::consensus
@@ -17,9 +17,17 @@
 #ifndef DAISI_PATH_PLANNING_CONSENSUS_PAXOS_ACCEPTOR_H_
 #define DAISI_PATH_PLANNING_CONSENSUS_PAXOS_ACCEPTOR_H_
 
+#include <map>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "path_planning/consensus/paxos/message/accept_message.h"
+#include "path_planning/consensus/paxos/message/catch_up_message.h"
+#include "path_planning/consensus/paxos/message/catch_up_request_message.h"
 #include "path_planning/consensus/paxos/message/ok_message.h"
 #include "path_planning/consensus/paxos/message/prepare_message.h"
 #include "path_planning/consensus/paxos/paxos_data.h"
@@ -34,15 +42,14 @@ public:
   void processPrepareMessage(const PrepareMessage &msg);
   void processAcceptMessage(const AcceptMessage &msg);
   void processOKMessage(const OKMessage &msg);
+  void processCatchUpRequestMessage(const CatchUpRequestMessage &msg);
+  void processCatchUpMessage(const CatchUpMessage &msg);
 
 private:
   std::shared_ptr<PaxosContainer> container_;
 
-  //! Current accepted proposal for which we send an OK message
-  uint32_t current_accepted_instance_ = UINT32_MAX;
-  uint32_t current_accepted_proposal_id_ = UINT32_MAX;
-  uint32_t current_accepted_station_ = UINT32_MAX;
-  uint32_t remaining_oks_ = 0;  //!< Remaining OKs for the current accepted instance
+  //! Remaining OKs for the accepted proposal of each instance for which we sent an OK message
+  std::map<InstanceID, uint32_t> remaining_oks_;
 
   //! Data of an OK message with a count how often this message was already received
   struct AlreadyReceivedOKS {
@@ -54,7 +61,50 @@ private:
   std::vector<AlreadyReceivedOKS>
       already_received_;  //!< List of all received OKs instances from other acceptors
 
-  void sendResponseMessage();
+  //! Instance and time of the latest catch up request, to not request again for every message
+  uint32_t catch_up_requested_instance_ = UINT32_MAX;
+  ns3::Time catch_up_requested_time_;
+
+  //! Delayed answers to catch up requests per requesting station, in case the designated
+  //! responder does not answer. Cancelled once another participant answered.
+  std::unordered_map<uint32_t, ns3::EventId> fallback_catch_ups_;
+
+  //! Chunks of a snapshot which is restored once all chunks arrived
+  struct PartialSnapshot {
+    uint32_t sender_station_id = 0;
+    InstanceID next_instance = 0;
+    std::map<uint32_t, std::vector<IntersectionTimeInfo>> chunks;
+  };
+  std::optional<PartialSnapshot> partial_snapshot_;
+
+  void sendResponseMessage(InstanceID instance);
+
+  //! Instances after the applied ones which might be proposed concurrently by all participants.
+  //! Prepares for later instances show that we missed decided instances.
+  [[nodiscard]] bool isWithinPipeline(InstanceID instance) const;
+
+  //! The proposer of the latest decided instance answers catch up requests, as it definitely
+  //! decided this instance and all participants receive the requests
+  [[nodiscard]] bool isCatchUpResponder() const;
+
+  //! If the designated responder is gone or lagging itself, other participants which decided the
+  //! requested instances answer after a delay. The delay increases with the node ID, so that
+  //! usually only one of them answers.
+  void scheduleFallbackCatchUp(uint32_t station_id, InstanceID from_instance);
+  void sendFallbackCatchUp(uint32_t station_id, InstanceID from_instance);
+
+  //! Restore a snapshot once all of its chunks arrived
+  void processSnapshotChunk(const CatchUpMessage &msg);
+
+  void sendCatchUpMessage(uint32_t station_id, InstanceID from_instance);
+  void publishCatchUpMessage(const CatchUpMessage &catch_up);
+
+  //! Occupancies per message of a snapshot, to bound the size of catch up messages
+  static constexpr uint32_t kMaxSnapshotOccupanciesPerMessage = 512;
+  void requestCatchUp();
+
+  //! Drop the state of instances that are already decided
+  void pruneDecidedInstances();
 };
 }  // namespace daisi::path_planning::consensus
 
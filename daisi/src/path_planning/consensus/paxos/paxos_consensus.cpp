@@ -47,6 +47,10 @@ void PaxosConsensus::findConsensusImpl(const PointTimePairs &points, double seco
                                  std::move(fail_cb));
 }
 
+uint32_t PaxosConsensus::getMaxConcurrentRequestsImpl() const {
+  return proposer_.getMaxConcurrentProposals();
+}
+
 void PaxosConsensus::recvTopicMessageImpl(const std::string &topic, const std::string &msg) {
   if (topic == kReplicationTopic) {
     assert(container_->settings.replication);
@@ -86,6 +90,16 @@ void PaxosConsensus::processPaxosMessage(const std::string &topic, const std::st
         topic, own_id, ok->instance_id, static_cast<uint32_t>(ConsensusMsgTypes::kOk));
     proposer_.processOKMessage(*ok);
     acceptor_.processOKMessage(*ok);
+  } else if (auto request = std::get_if<CatchUpRequestMessage>(&msg)) {
+    container_->logger->logRecvPathPlanningTopicTraffic(
+        topic, own_id, request->next_instance,
+        static_cast<uint32_t>(ConsensusMsgTypes::kCatchUpRequest));
+    acceptor_.processCatchUpRequestMessage(*request);
+  } else if (auto catch_up = std::get_if<CatchUpMessage>(&msg)) {
+    container_->logger->logRecvPathPlanningTopicTraffic(
+        topic, own_id, catch_up->first_instance,
+        static_cast<uint32_t>(ConsensusMsgTypes::kCatchUp));
+    acceptor_.processCatchUpMessage(*catch_up);
   } else {
     throw std::runtime_error("unknown message type");
   }
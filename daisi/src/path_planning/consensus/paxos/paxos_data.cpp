@@ -0,0 +1,171 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "paxos_data.h"
+
+#include <algorithm>
+
+#include "ns3/simulator.h"
+#include "path_planning/intersection_set.h"
+#include "utils/daisi_check.h"
+
+namespace daisi::path_planning::consensus {
+
+void PaxosContainer::decideInstance(InstanceID instance, uint32_t station_id,
+                                    std::vector<RouteOccupancies> routes) {
+  if (isDecided(instance)) return;
+
+  pending_instances[instance] = DecidedInstance{station_id, std::move(routes)};
+  accepted_proposals.erase(instance);
+  applyPendingInstances();
+}
+
+void PaxosContainer::learnAppliedInstance(InstanceID instance, DecidedInstance entry) {
+  if (decided_instances.isDecided(instance)) return;
+  DAISI_CHECK(entry.applied.size() == entry.routes.size(), "Applied routes are missing");
+
+  // Replaces our own decision of the instance, whose routes were not checked yet
+  pending_instances[instance] = std::move(entry);
+  accepted_proposals.erase(instance);
+  applyPendingInstances();
+}
+
+bool PaxosContainer::promise(InstanceID instance, const RequestID &prepare,
+                             bool all_following_instances) {
+  auto promised = getPromised(instance);
+  if (promised && prepare <= *promised) return false;
+
+  if (all_following_instances) {
+    // A leader must not take over the following instances of a newer leader
+    if (leader_promise && prepare <= leader_promise->promised) return false;
+    leader_promise = LeaderPromise{prepare, instance};
+  }
+
+  instance_to_promised[instance] = prepare;
+  return true;
+}
+
+std::optional<RequestID> PaxosContainer::getPromised(InstanceID instance) const {
+  std::optional<RequestID> promised;
+  if (auto it = instance_to_promised.find(instance); it != instance_to_promised.end()) {
+    promised = it->second;
+  }
+
+  if (leader_promise && leader_promise->from_instance <= instance &&
+      (!promised || leader_promise->promised > *promised)) {
+    promised = leader_promise->promised;
+  }
+  return promised;
+}
+
+bool PaxosContainer::isDecided(InstanceID instance) const {
+  return decided_instances.isDecided(instance) || pending_instances.count(instance) == 1;
+}
+
+void PaxosContainer::restoreSnapshot(InstanceID next_instance,
+                                     const std::vector<IntersectionTimeInfo> &occupancies) {
+  if (next_instance <= decided_instances.getNextInstance()) return;
+
+  agreed_data.clear();
+  agreed_intervals = OccupancyIntervalIndex(settings.time_delta_intersections);
+  // The occupants are not part of the snapshot
+  addOccupancies(occupancies, UINT32_MAX);
+  // Count the live occupancies of the snapshot instead of the replaced ones. The snapshot might
+  // contain occupancies which passed already.
+  agreed_horizon.sweep(ns3::Simulator::Now().GetSeconds(), agreed_data, agreed_intervals);
+  decided_instances.restoreSnapshot(next_instance);
+
+  pending_instances.erase(pending_instances.begin(), pending_instances.lower_bound(next_instance));
+  accepted_proposals.erase(accepted_proposals.begin(),
+                           accepted_proposals.lower_bound(next_instance));
+  applyPendingInstances();
+}
+
+std::vector<IntersectionTimeInfo> PaxosContainer::getAgreedOccupancies() const {
+  std::vector<IntersectionTimeInfo> occupancies;
+  for (const auto &[intersection, times] : agreed_data) {
+    for (const auto &[time, occupant] : times) {
+      occupancies.push_back({intersection, time});
+    }
+  }
+  return occupancies;
+}
+
+void PaxosContainer::applyPendingInstances() {
+  for (auto it = pending_instances.begin();
+       it != pending_instances.end() && it->first == decided_instances.getNextInstance();
+       it = pending_instances.erase(it)) {
+    const InstanceID instance = it->first;
+    DecidedInstance &entry = it->second;
+
+    // Instances are applied in the same order by all participants, so all participants reject the
+    // same conflicting routes. Routes of a batch are checked against the previous routes too.
+    // Instances learned from other participants are replayed instead, as we might apply them
+    // later than the retention and would check them against differently pruned occupancies.
+    const bool replay = entry.applied.size() == entry.routes.size();
+    for (auto i = 0U; i < entry.routes.size(); i++) {
+      const RouteOccupancies &route = entry.routes[i];
+      const bool applied = replay ? entry.applied[i] : !conflictsWithAgreedData(route);
+      if (applied) {
+        addOccupancies(route, entry.station_id);
+        agreed_horizon.notifyAdded(route.size());
+      }
+      if (!replay) {
+        entry.applied.push_back(applied);
+      }
+    }
+
+    decided_instances.decide(instance, entry);
+    if (instance_applied_cb) {
+      instance_applied_cb(instance, entry);
+    }
+  }
+
+  // Routes are checked within the retention after they were decided, or replayed when we lag
+  // behind, so the pruning does not change which routes conflict
+  agreed_horizon.sweepIfDue(ns3::Simulator::Now().GetSeconds(), agreed_data, agreed_intervals);
+  prunePromises();
+}
+
+bool PaxosContainer::conflictsWithAgreedData(const RouteOccupancies &route) const {
+  return std::any_of(route.begin(), route.end(), [this](const IntersectionTimeInfo &point) {
+    return agreed_intervals.isBlocked(point.intersection, point.time_at_intersection);
+  });
+}
+
+void PaxosContainer::addOccupancies(const RouteOccupancies &route, uint32_t station_id) {
+  for (const auto &point : route) {
+    // Verify that point is actually an intersection in this scenario
+    DAISI_CHECK(
+        getAllIntersections().count({point.intersection.first, point.intersection.second}) == 1,
+        "Invalid point");
+    agreed_data[point.intersection][point.time_at_intersection] = station_id;
+    agreed_intervals.addOccupancy(point.intersection, point.time_at_intersection);
+  }
+}
+
+void PaxosContainer::prunePromises() {
+  const InstanceID next_instance = decided_instances.getNextInstance();
+  for (auto it = instance_to_promised.begin(); it != instance_to_promised.end();) {
+    if (it->first < next_instance) {
+      it = instance_to_promised.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace daisi::path_planning::consensus
@@ -17,8 +17,15 @@
 #ifndef DAISI_PATH_PLANNING_CONSENSUS_PAXOS_DATA_H_
 #define DAISI_PATH_PLANNING_CONSENSUS_PAXOS_DATA_H_
 
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include "path_planning/consensus/occupancy_horizon.h"
+#include "path_planning/consensus/occupancy_interval_index.h"
+#include "path_planning/consensus/paxos/paxos_log.h"
 #include "path_planning/constants.h"
 #include "path_planning/path_planning_logger_ns_3.h"
 #include "path_planning/station.h"
@@ -26,26 +33,89 @@
 
 namespace daisi::path_planning::consensus {
 
-using InstanceID = uint32_t;
 using RequestID = std::pair<uint32_t, uint32_t>;
 
 struct AcceptedProposal {
   uint32_t instance_id = 0;
   uint32_t proposal_id = 0;
   uint32_t station_id = 0;
-  std::vector<IntersectionTimeInfo> data;
+  std::vector<RouteOccupancies> routes;
 
-  [[nodiscard]] bool initialized() const { return !data.empty(); }
+  [[nodiscard]] bool initialized() const { return !routes.empty(); }
+};
+
+//! Finally accepted routes of an instance with the global times of the occupancies
+struct DecidedInstance {
+  uint32_t station_id = 0;
+  std::vector<RouteOccupancies> routes;
+  std::vector<bool> applied;  //!< Per route whether it did not conflict with the agreed
+                              //!< occupancies of all previous routes and was added to them.
+                              //!< Empty until the instance is applied, unless it was learned
+                              //!< from a participant which applied it already.
+};
+
+//! Multi-Paxos: Promise of an acceptor for all instances starting at \p from_instance
+struct LeaderPromise {
+  RequestID promised;
+  InstanceID from_instance = 0;
 };
 
 struct PaxosContainer {
+  using PublishFct = std::function<void(const std::string &topic, const std::string &message)>;
+
   PaxosContainer(std::shared_ptr<sola_ns3::SOLAWrapperNs3> sola, uint32_t node_id,
                  PaxosSettings settings, std::shared_ptr<PathPlanningLoggerNs3> logger)
-      : sola(std::move(sola)),
+      : PaxosContainer(
+            [sola](const std::string &topic, const std::string &message) {
+              sola->publishMessage(topic, message);
+            },
+            node_id, std::move(settings), std::move(logger)) {
+    this->sola = std::move(sola);
+  }
+
+  //! Publishing the messages with \p publish instead of SOLA, e.g., for tests
+  PaxosContainer(PublishFct publish, uint32_t node_id, PaxosSettings settings,
+                 std::shared_ptr<PathPlanningLoggerNs3> logger)
+      : publish(std::move(publish)),
         node_id(node_id),
         settings(std::move(settings)),
-        logger(std::move(logger)) {}
-  const std::shared_ptr<sola_ns3::SOLAWrapperNs3> sola{};
+        logger(std::move(logger)),
+        decided_instances(this->settings.log_retention),
+        agreed_intervals(this->settings.time_delta_intersections),
+        agreed_horizon(this->settings.occupancy_retention,
+                       this->settings.time_delta_intersections) {}
+
+  //! Store the finally accepted routes of an instance. Instances may be decided out of order, but
+  //! they are applied to the agreed occupancies in order. A route which conflicts with the
+  //! occupancies of previous routes is not applied.
+  void decideInstance(InstanceID instance, uint32_t station_id,
+                      std::vector<RouteOccupancies> routes);
+
+  //! Store an instance which another participant applied already, e.g., when catching up. Its
+  //! routes are applied as stated by \p entry.applied instead of checking them against our agreed
+  //! occupancies, which might be pruned at a later time than the ones of the other participant.
+  void learnAppliedInstance(InstanceID instance, DecidedInstance entry);
+
+  //! Promise not to accept proposals below \p prepare for the instance, or for the instance and all
+  //! following instances. Returns false if a higher proposal is already promised.
+  bool promise(InstanceID instance, const RequestID &prepare, bool all_following_instances);
+
+  //! Currently promised proposal for the instance, including the promise of a leader
+  [[nodiscard]] std::optional<RequestID> getPromised(InstanceID instance) const;
+
+  //! Whether the instance is decided, even if it is not applied yet
+  [[nodiscard]] bool isDecided(InstanceID instance) const;
+
+  //! Replace the agreed occupancies with a snapshot of another participant which covers all
+  //! instances before \p next_instance
+  void restoreSnapshot(InstanceID next_instance,
+                       const std::vector<IntersectionTimeInfo> &occupancies);
+
+  //! All agreed occupancies, which are the snapshot of all decided instances
+  [[nodiscard]] std::vector<IntersectionTimeInfo> getAgreedOccupancies() const;
+
+  std::shared_ptr<sola_ns3::SOLAWrapperNs3> sola{};
+  PublishFct publish;  //!< Publish a message on a topic to all participants
   const uint32_t node_id;
   const PaxosSettings settings;
   std::shared_ptr<PathPlanningLoggerNs3> logger;
@@ -54,16 +124,42 @@ struct PaxosContainer {
       instance_to_promised;  //!< map of an instance ID to the currently promised proposal id and
                              //!< station id
 
-  AcceptedProposal accepted_data_current_instance;  //!< The current accepted outstanding data for
-                                                    //!< the latest instance (currently in OK phase)
+  std::optional<LeaderPromise> leader_promise;  //!< Promise to the current Multi-Paxos leader
+
+  std::map<InstanceID, AcceptedProposal>
+      accepted_proposals;  //!< The accepted outstanding data per instance (currently in OK phase)
+
+  PaxosLog<DecidedInstance>
+      decided_instances;  //!< Latest applied instances, older ones are only kept in \p agreed_data
+
+  std::map<InstanceID, DecidedInstance>
+      pending_instances;  //!< Instances decided out of order, waiting for the previous instances
+
+  //! Called once an instance is applied, e.g., to finish the proposal of this instance
+  std::function<void(InstanceID, const DecidedInstance &)> instance_applied_cb;
+
+  //! Request the decided instances which are missing to apply the decided ones
+  std::function<void()> request_catch_up_cb;
+
+  IntersectionOccupancy agreed_data;  //!< Global occupancy of all intersections, the snapshot of
+                                      //!< all decided instances
+
+  OccupancyIntervalIndex agreed_intervals;  //!< Blocked intervals of \p agreed_data, needed to
+                                            //!< calculate possible start times
+
+  OccupancyHorizon agreed_horizon;  //!< Evicts passed occupancies from \p agreed_data and
+                                    //!< \p agreed_intervals
+
+private:
+  //! Apply the pending instances which directly follow the applied instances
+  void applyPendingInstances();
+
+  [[nodiscard]] bool conflictsWithAgreedData(const RouteOccupancies &route) const;
 
-  std::vector<std::vector<IntersectionTimeInfo>>
-      finally_accepted_data;  //!< List of instances with their finally accepted occupant for every
-                              //!< intersection
+  void addOccupancies(const RouteOccupancies &route, uint32_t station_id);
 
-  IntersectionOccupancy
-      agreed_data;  //!< Global occupancy of all intersections (same data as in \p
-                    //!< finally_accepted_data) needed to calculate possible start times
+  //! Promises for decided instances are not needed anymore, as these instances are not accepted
+  void prunePromises();
 };
 }  // namespace daisi::path_planning::consensus
 
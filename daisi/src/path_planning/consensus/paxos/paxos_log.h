@@ -0,0 +1,123 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#ifndef DAISI_PATH_PLANNING_CONSENSUS_PAXOS_LOG_H_
+#define DAISI_PATH_PLANNING_CONSENSUS_PAXOS_LOG_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace daisi::path_planning::consensus {
+
+using InstanceID = uint32_t;
+
+//! Log of decided Paxos instances with a bounded number of entries.
+//! Only the latest \p retained_instances entries are kept. Older instances are folded into the
+//! snapshot, which consists of the instance before which everything is folded and of the state
+//! the owner derived from these instances, e.g., the agreed IntersectionOccupancy. Instances may
+//! be decided out of order. If a gap is not closed within the retained instances, it is folded too.
+template <typename Entry> class PaxosLog {
+public:
+  explicit PaxosLog(uint32_t retained_instances) : retained_instances_(retained_instances) {}
+
+  //! Store the entry of a decided instance and fold instances that are no longer retained
+  void decide(InstanceID instance, Entry entry) {
+    entries_.insert_or_assign(instance, std::move(entry));
+    advanceNextInstance();
+    compact();
+  }
+
+  //! Whether the instance was decided, either retained or already folded into the snapshot
+  [[nodiscard]] bool isDecided(InstanceID instance) const {
+    return instance < snapshot_instance_ || entries_.count(instance) == 1;
+  }
+
+  //! Whether the instance is folded into the snapshot and its entry is not available anymore
+  [[nodiscard]] bool isFolded(InstanceID instance) const { return instance < snapshot_instance_; }
+
+  //! Entry of a retained instance, nullptr if the instance is not decided or already folded
+  [[nodiscard]] const Entry *find(InstanceID instance) const {
+    auto it = entries_.find(instance);
+    return it == entries_.end() ? nullptr : &it->second;
+  }
+
+  //! First instance which is not decided. All instances before are decided.
+  [[nodiscard]] InstanceID getNextInstance() const { return next_instance_; }
+
+  //! All instances before are folded into the snapshot
+  [[nodiscard]] InstanceID getSnapshotInstance() const { return snapshot_instance_; }
+
+  //! Entry of the latest decided instance before getNextInstance(), nullptr if folded or none
+  [[nodiscard]] const Entry *getLatest() const {
+    return next_instance_ == 0 ? nullptr : find(next_instance_ - 1);
+  }
+
+  //! Continue after a snapshot from another participant which covers all instances before
+  //! \p next_instance. Retained entries of these instances are dropped.
+  void restoreSnapshot(InstanceID next_instance) {
+    if (next_instance <= snapshot_instance_) return;
+
+    snapshot_instance_ = next_instance;
+    entries_.erase(entries_.begin(), entries_.lower_bound(next_instance));
+    next_instance_ = std::max(next_instance_, next_instance);
+    advanceNextInstance();
+  }
+
+  //! Call \p function(instance, entry) for the retained instances from \p from_instance up to
+  //! getNextInstance() in ascending order
+  template <typename Function>
+  void forEachEntry(InstanceID from_instance, Function &&function) const {
+    for (auto it = entries_.lower_bound(from_instance);
+         it != entries_.end() && it->first < next_instance_; ++it) {
+      function(it->first, it->second);
+    }
+  }
+
+  [[nodiscard]] std::size_t getNumberOfEntries() const { return entries_.size(); }
+
+private:
+  void advanceNextInstance() {
+    for (auto it = entries_.lower_bound(next_instance_);
+         it != entries_.end() && it->first == next_instance_; ++it) {
+      next_instance_++;
+    }
+  }
+
+  void compact() {
+    while (entries_.size() > retained_instances_) {
+      snapshot_instance_ = entries_.begin()->first + 1;
+      entries_.erase(entries_.begin());
+
+      if (next_instance_ < snapshot_instance_) {
+        // Folding over a gap which was never decided here
+        next_instance_ = snapshot_instance_;
+        advanceNextInstance();
+      }
+    }
+  }
+
+  const uint32_t retained_instances_;
+
+  InstanceID snapshot_instance_ = 0;
+  InstanceID next_instance_ = 0;
+  std::map<InstanceID, Entry> entries_;
+};
+
+}  // namespace daisi::path_planning::consensus
+
+#endif  // DAISI_PATH_PLANNING_CONSENSUS_PAXOS_LOG_H_
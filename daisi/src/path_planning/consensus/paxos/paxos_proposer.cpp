@@ -16,19 +16,31 @@
 
 #include "paxos_proposer.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "constants.h"
 #include "ns3/simulator.h"
 #include "path_planning/consensus/paxos/message/prepare_message.h"
 #include "path_planning/consensus/route_calculation_helper.h"
-#include "path_planning/intersection_set.h"
 #include "path_planning/message/serializer.h"
 #include "utils/daisi_check.h"
 
 namespace daisi::path_planning::consensus {
 PaxosProposer::PaxosProposer(std::shared_ptr<PaxosContainer> container)
-    : container_(std::move(container)) {}
+    : container_(std::move(container)),
+      running_intervals_(container_->settings.time_delta_intersections) {
+  container_->instance_applied_cb = [this](InstanceID instance, const DecidedInstance &entry) {
+    processAppliedInstance(instance, entry);
+  };
+}
+
+uint32_t PaxosProposer::getMaxConcurrentProposals() const {
+  const uint32_t routes_per_instance =
+      container_->settings.multi_paxos ? container_->settings.max_batched_routes : 1;
+  return container_->settings.max_pipelined_instances * routes_per_instance;
+}
 
 double PaxosProposer::calculatePossibleStartTime(const PointTimePairs &points,
                                                  const double seconds_till_start) const {
@@ -36,15 +48,67 @@ double PaxosProposer::calculatePossibleStartTime(const PointTimePairs &points,
   double earliest_start_s =
       (ns3::Simulator::Now().GetMilliSeconds() + seconds_till_start * 1000) / 1000.0;
 
+  // Our running proposals are not agreed yet, but must not conflict with the new one
   double possible_start_s = RouteCalculationHelper::calculatePossibleStartTime(
       points, earliest_start_s, container_->settings.max_preplanning_time,
-      container_->settings.time_delta_intersections, container_->agreed_data);
+      {&container_->agreed_intervals, &running_intervals_});
   return possible_start_s;
 }
 
+InstanceID PaxosProposer::getNextFreeInstance() const {
+  // Filling gaps first, as later instances are not applied before
+  InstanceID instance = container_->decided_instances.getNextInstance();
+  while (container_->isDecided(instance) || proposals_.count(instance) == 1) {
+    instance++;
+  }
+  return instance;
+}
+
+PaxosProposer::Proposal *PaxosProposer::findProposal(InstanceID instance, uint32_t proposal_id) {
+  auto it = proposals_.find(instance);
+  if (it == proposals_.end() || it->second.proposal_id != proposal_id) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+bool PaxosProposer::isLeader(InstanceID instance) const {
+  return leader_proposal_id_.has_value() &&
+         container_->getPromised(instance) == RequestID{*leader_proposal_id_, container_->node_id};
+}
+
+bool PaxosProposer::isRequestingLeadership() const {
+  return std::any_of(proposals_.begin(), proposals_.end(), [](const auto &running) {
+    return running.second.all_following_instances && running.second.phase == Phase::kPrepare;
+  });
+}
+
+uint32_t PaxosProposer::getNumberOfRunningRoutes() const {
+  auto routes = static_cast<uint32_t>(pending_routes_.size());
+  for (const auto &[instance, proposal] : proposals_) {
+    routes += static_cast<uint32_t>(proposal.routes.size());
+  }
+  return routes;
+}
+
+std::vector<RouteOccupancies> PaxosProposer::getRouteOccupancies(const Proposal &proposal) {
+  std::vector<RouteOccupancies> routes;
+  for (const auto &route : proposal.routes) {
+    RouteOccupancies intersects;
+    for (const auto &point : route.points) {
+      intersects.push_back({{point.first.x, point.first.y}, point.second + route.start_time});
+    }
+    routes.push_back(std::move(intersects));
+  }
+  return routes;
+}
+
 void PaxosProposer::findConsensus(const PointTimePairs &points, double seconds_till_start,
                                   std::function<void(uint32_t, double)> success_cb,
                                   std::function<void(uint32_t)> fail_cb) {
+  DAISI_CHECK(getNumberOfRunningRoutes() < getMaxConcurrentProposals(),
+              "We cannot start more proposals than instances are pipelined");
+
   // Calculate possible start time
   double possible_start_s = calculatePossibleStartTime(points, seconds_till_start);
   if (std::isnan(possible_start_s)) {
@@ -52,75 +116,158 @@ void PaxosProposer::findConsensus(const PointTimePairs &points, double seconds_t
     return;
   }
 
-  // Next instance ID is the next free list index of accepted data
-  uint32_t instance = container_->finally_accepted_data.size();
+  for (const auto &[position, relative_time] : points) {
+    running_intervals_.addOccupancy({position.x, position.y}, possible_start_s + relative_time);
+  }
+  pending_routes_.push_back(
+      RouteRequest{points, possible_start_s, std::move(success_cb), std::move(fail_cb)});
+
+  proposePendingRoutes();
+}
+
+void PaxosProposer::proposePendingRoutes() {
+  const InstanceID next_instance = container_->decided_instances.getNextInstance();
+  for (auto it = instance_to_proposal_id_.begin(); it != instance_to_proposal_id_.end();) {
+    it = it->first < next_instance ? instance_to_proposal_id_.erase(it) : std::next(it);
+  }
+
+  const bool multi_paxos = container_->settings.multi_paxos;
+  const uint32_t routes_per_instance = multi_paxos ? container_->settings.max_batched_routes : 1;
+
+  while (!pending_routes_.empty() &&
+         proposals_.size() < container_->settings.max_pipelined_instances) {
+    const InstanceID instance = getNextFreeInstance();
+    const bool leader = multi_paxos && isLeader(instance);
+    if (multi_paxos && !leader && isRequestingLeadership()) {
+      // Wait for the leadership instead of preparing each instance
+      return;
+    }
+
+    Proposal proposal;
+    proposal.instance_id = instance;
+    while (!pending_routes_.empty() && proposal.routes.size() < routes_per_instance) {
+      proposal.routes.push_back(std::move(pending_routes_.front()));
+      pending_routes_.pop_front();
+    }
+
+    if (leader) {
+      // The acceptors promised all following instances already -> Skip the prepare phase
+      proposal.proposal_id = *leader_proposal_id_;
+      proposal.phase = Phase::kAccept;
+      proposal.outstanding_oks = container_->settings.number_paxos_participants - 1;
+      proposal.timeout_event =
+          ns3::Simulator::Schedule(ns3::MilliSeconds(500), &PaxosProposer::prepareTimeout, this,
+                                   instance, proposal.proposal_id);
+      proposals_[instance] = std::move(proposal);
+      sendAccept(proposals_[instance]);
+    } else {
+      proposal.all_following_instances = multi_paxos;
+      proposals_[instance] = std::move(proposal);
+      sendPrepare(proposals_[instance]);
+    }
+  }
+}
 
-  // Get next proposal ID for the current instance
-  uint32_t proposal_id = instance_to_proposal_id_[instance]++;
+void PaxosProposer::sendPrepare(Proposal &proposal) {
+  // Get next proposal ID for the instance
+  uint32_t &next_proposal_id = instance_to_proposal_id_[proposal.instance_id];
+  if (proposal.all_following_instances && container_->leader_promise.has_value()) {
+    // Take over from the current leader
+    next_proposal_id =
+        std::max(next_proposal_id, container_->leader_promise->promised.first + 1);
+  }
+  proposal.proposal_id = next_proposal_id++;
+  proposal.phase = Phase::kPrepare;
 
   // Timeout after 500 milliseconds if we did not get any quorum
   const uint32_t timeout_ms = 500;
-  ns3::EventId timeout_event = ns3::Simulator::Schedule(
-      ns3::MilliSeconds(timeout_ms), &PaxosProposer::prepareTimeout, this, proposal_id);
+  proposal.timeout_event =
+      ns3::Simulator::Schedule(ns3::MilliSeconds(timeout_ms), &PaxosProposer::prepareTimeout,
+                               this, proposal.instance_id, proposal.proposal_id);
 
   // Currently our quorum contains all other participants (except ourselves)
-  const uint32_t needed_for_quorum = container_->settings.number_paxos_participants - 1;
-  const uint32_t outstanding_oks = container_->settings.number_paxos_participants - 1;
-  DAISI_CHECK(!current_proposal_.initialized(),
-              "We cannot start a new proposal while one proposal of ourselves is still running");
-  current_proposal_ = Proposal{points,
-                               possible_start_s,
-                               instance,
-                               proposal_id,
-                               needed_for_quorum,
-                               outstanding_oks,
-                               timeout_event,
-                               Phase::kPrepare,
-                               std::move(success_cb),
-                               std::move(fail_cb)};
+  proposal.needed_for_quorum = container_->settings.number_paxos_participants - 1;
+  proposal.outstanding_oks = container_->settings.number_paxos_participants - 1;
 
   // Create prepare message
-  PrepareMessage msg{instance, current_proposal_.proposal_id, container_->node_id};
+  PrepareMessage msg{proposal.instance_id, proposal.proposal_id, container_->node_id,
+                     proposal.all_following_instances};
 
   // Prepare on ourselves. If that is not even possible do not send any prepares to acceptors
-  {
-    std::pair<uint32_t, uint32_t> prepare = {msg.prepare_id, msg.station_id};
-
-    // Get the prepare/station ID for the instance where we (our acceptor) already promised for
-    auto it = container_->instance_to_promised.find(msg.instance_id);
-
-    if (it == container_->instance_to_promised.end() || prepare > it->second) {
-      // Our prepare is newer/greater -> Promise ourselves and save
-      container_->instance_to_promised[msg.instance_id] = prepare;
-    } else {
-      // We do not promise ourselves
-      // Wait for timeout
-      return;
-    }
+  if (!container_->promise(msg.instance_id, {msg.prepare_id, msg.station_id},
+                           msg.all_following_instances)) {
+    // We do not promise ourselves
+    // Wait for timeout
+    return;
   }
 
   // Send prepare message
-  container_->sola->publishMessage(kPaxosTopic, message::serialize<PaxosMessage>(msg));
+  container_->publish(kPaxosTopic, message::serialize<PaxosMessage>(msg));
   container_->logger->logSendPathPlanningTopicTraffic(
       kPaxosTopic, std::to_string(container_->node_id), msg.instance_id,
       static_cast<uint32_t>(ConsensusMsgTypes::kPrepare));
 }
 
-void PaxosProposer::prepareTimeout(uint32_t proposal_id) {
-  if (!current_proposal_.initialized() || current_proposal_.proposal_id != proposal_id) {
+void PaxosProposer::sendAccept(Proposal &proposal) {
+  // insert into own data for the accepted instance
+  std::vector<RouteOccupancies> routes = getRouteOccupancies(proposal);
+  container_->accepted_proposals[proposal.instance_id] =
+      AcceptedProposal{proposal.instance_id, proposal.proposal_id, container_->node_id, routes};
+
+  // send accepts
+  AcceptMessage accept{proposal.instance_id, proposal.proposal_id, container_->node_id,
+                       std::move(routes)};
+
+  // After the OK phase all acceptors will send us an response
+  proposal.remaining_responses = container_->settings.number_paxos_participants;
+  proposal.accept_sent = true;
+
+  container_->publish(kPaxosTopic, message::serialize<PaxosMessage>(accept));
+  container_->logger->logSendPathPlanningTopicTraffic(
+      kPaxosTopic, std::to_string(container_->node_id), accept.instance_id,
+      static_cast<uint32_t>(consensus::ConsensusMsgTypes::kAccept));
+}
+
+void PaxosProposer::prepareTimeout(InstanceID instance, uint32_t proposal_id) {
+  Proposal *proposal = findProposal(instance, proposal_id);
+  if (proposal == nullptr) {
     // Already finished
     return;
   }
 
-  if (current_proposal_.needed_for_quorum != 0) {
-    // Failed to get quorum
-    current_proposal_.fail_cb(0);
-    current_proposal_ = Proposal{};
-  } else if (current_proposal_.outstanding_oks != 0) {
-    // Got quorum -> timeout with oks
-    current_proposal_.fail_cb(0);
-    current_proposal_ = Proposal{};
+  if (proposal->applied.has_value()) {
+    // Applied, but responses of acceptors are missing. They do not change the outcome anymore.
+    finishProposal(instance, true);
+    return;
+  }
+
+  if (!proposal->accept_sent) {
+    // Failed to get quorum. The acceptors never got our routes, so they cannot be decided.
+    finishProposal(instance, false);
+    return;
+  }
+
+  // The acceptors decide on their own once they got all OKs, so our routes might be decided even
+  // though OKs are missing here. We must not report a failure before the instance is decided,
+  // processAppliedInstance finishes the proposal then. Fetch the decisions we missed.
+  if (container_->request_catch_up_cb) {
+    container_->request_catch_up_cb();
+  }
+
+  if (container_->isDecided(instance)) {
+    // Decided, but previous instances are still missing. The routes are applied once the gap is
+    // closed.
+    proposal->timeout_event =
+        ns3::Simulator::Schedule(ns3::MilliSeconds(500), &PaxosProposer::prepareTimeout, this,
+                                 instance, proposal_id);
+    return;
   }
+
+  // Nobody might have decided the instance -> Propose the same routes again with a greater ID.
+  // Another proposer might have taken over, so we do not rely on our leadership anymore.
+  leader_proposal_id_.reset();
+  proposal->all_following_instances = false;
+  sendPrepare(*proposal);
 }
 
 void PaxosProposer::processPromiseMessage(const PromiseMessage &msg) {
@@ -128,7 +275,8 @@ void PaxosProposer::processPromiseMessage(const PromiseMessage &msg) {
     // Promise not meant for us
     return;
   }
-  if (!current_proposal_.initialized() || current_proposal_.needed_for_quorum == 0) {
+  Proposal *proposal = findProposal(msg.instance_id, msg.prepare_id);
+  if (proposal == nullptr || proposal->needed_for_quorum == 0) {
     // Already timed out or got quorum.
     // If we already got a quorum, this is a duplicate message and should not happen.
     return;
@@ -139,53 +287,37 @@ void PaxosProposer::processPromiseMessage(const PromiseMessage &msg) {
     instance_to_proposal_id_[msg.instance_id] = msg.accepted_prepare_id + 1;
   }
 
-  if (current_proposal_.needed_for_quorum > 0) {
-    current_proposal_.needed_for_quorum--;
+  if (proposal->needed_for_quorum > 0) {
+    proposal->needed_for_quorum--;
   }
-  if (current_proposal_.needed_for_quorum == 0) {
+  if (proposal->needed_for_quorum == 0) {
     // Got quorum -> Change to accept phase
-    current_proposal_.phase = Phase::kAccept;
+    proposal->phase = Phase::kAccept;
 
     // cancel timeout event
-    ns3::Simulator::Cancel(current_proposal_.timeout_event);
+    ns3::Simulator::Cancel(proposal->timeout_event);
 
     // setup timeout for response
-    current_proposal_.timeout_event =
+    proposal->timeout_event =
         ns3::Simulator::Schedule(ns3::MilliSeconds(500), &PaxosProposer::prepareTimeout, this,
-                                 current_proposal_.proposal_id);
+                                 proposal->instance_id, proposal->proposal_id);
 
-    std::pair<uint32_t, uint32_t> sender = {msg.prepare_id, msg.station_id};
-    if (sender != container_->instance_to_promised[msg.instance_id]) {
+    RequestID sender = {msg.prepare_id, msg.station_id};
+    if (container_->getPromised(msg.instance_id) != sender) {
       // No longer promised ourselves
       // Wait for timeout
       return;
     }
 
-    // insert into own data for current accepted instance
-    std::vector<IntersectionTimeInfo> info;
-    for (auto &entry : current_proposal_.points) {
-      info.push_back({{entry.first.x, entry.first.y}, entry.second});
-    }
-
-    container_->accepted_data_current_instance = AcceptedProposal{
-        current_proposal_.instance_id, current_proposal_.proposal_id, container_->node_id, info};
-
-    // send accepts
-    std::vector<IntersectionTimeInfo> intersects;
-    for (auto point : current_proposal_.points) {
-      intersects.push_back(
-          {{point.first.x, point.first.y}, point.second + current_proposal_.start_time});
+    if (proposal->all_following_instances) {
+      // All acceptors promised the following instances too
+      leader_proposal_id_ = proposal->proposal_id;
     }
-    AcceptMessage accept{current_proposal_.instance_id, current_proposal_.proposal_id,
-                         container_->node_id, intersects};
 
-    // After the OK phase all acceptors will send us an response
-    remaining_responses_ = container_->settings.number_paxos_participants;
+    sendAccept(*proposal);
 
-    container_->sola->publishMessage(kPaxosTopic, message::serialize<PaxosMessage>(accept));
-    container_->logger->logSendPathPlanningTopicTraffic(
-        kPaxosTopic, std::to_string(container_->node_id), accept.instance_id,
-        static_cast<uint32_t>(consensus::ConsensusMsgTypes::kAccept));
+    // Routes which waited for the leadership
+    proposePendingRoutes();
   }
 }
 
@@ -195,14 +327,14 @@ void PaxosProposer::processResponseMessage(const ResponseMessage &msg) {
     return;
   }
 
-  remaining_responses_--;
-  if (remaining_responses_ == 0) {
-    // Got response from all acceptors. We can now accept
-    current_proposal_.phase = Phase::kFinished;
-    current_proposal_.success_cb(current_proposal_.instance_id, current_proposal_.start_time);
-    ns3::Simulator::Cancel(current_proposal_.timeout_event);
-    current_proposal_ = Proposal{};
+  Proposal *proposal = findProposal(msg.instance_id, msg.proposal_id);
+  if (proposal == nullptr) {
+    // Already finished
+    return;
   }
+
+  proposal->remaining_responses--;
+  tryFinishProposal(msg.instance_id);
 }
 
 void PaxosProposer::processOKMessage(const OKMessage &msg) {
@@ -211,21 +343,85 @@ void PaxosProposer::processOKMessage(const OKMessage &msg) {
     return;
   }
 
-  current_proposal_.outstanding_oks--;
-  if (current_proposal_.outstanding_oks == 0) {
+  Proposal *proposal = findProposal(msg.instance_id, msg.proposal_id);
+  if (proposal == nullptr || proposal->outstanding_oks == 0) {
+    return;
+  }
+
+  proposal->outstanding_oks--;
+  if (proposal->outstanding_oks == 0) {
+    // Set finalized data. It is applied once all previous instances are decided.
+    container_->decideInstance(msg.instance_id, container_->node_id,
+                               getRouteOccupancies(*proposal));
+
     // "Send" a response message to ourselves
     processResponseMessage({msg.instance_id, msg.proposal_id, msg.station_id});
+  }
+}
+
+void PaxosProposer::processAppliedInstance(InstanceID instance, const DecidedInstance &entry) {
+  auto it = proposals_.find(instance);
+  if (it == proposals_.end()) {
+    return;
+  }
+
+  if (entry.station_id != container_->node_id) {
+    // Another proposal was decided for this instance
+    finishProposal(instance, false);
+    return;
+  }
+
+  it->second.applied = entry.applied;
+  tryFinishProposal(instance);
+}
+
+void PaxosProposer::tryFinishProposal(InstanceID instance) {
+  auto it = proposals_.find(instance);
+  if (it == proposals_.end()) {
+    return;
+  }
+
+  const Proposal &proposal = it->second;
+  if (proposal.remaining_responses == 0 && proposal.applied.has_value()) {
+    // Got response from all acceptors and know which routes conflict with previous instances
+    finishProposal(instance, true);
+  }
+}
+
+void PaxosProposer::finishProposal(InstanceID instance, bool success) {
+  auto it = proposals_.find(instance);
+  Proposal proposal = std::move(it->second);
+  proposals_.erase(it);
+  ns3::Simulator::Cancel(proposal.timeout_event);
+
+  if (!success) {
+    // Another proposer might have taken over, so we prepare again
+    leader_proposal_id_.reset();
+  }
+
+  running_intervals_ = OccupancyIntervalIndex(container_->settings.time_delta_intersections);
+  auto add_running_route = [this](const RouteRequest &route) {
+    for (const auto &[position, relative_time] : route.points) {
+      running_intervals_.addOccupancy({position.x, position.y}, route.start_time + relative_time);
+    }
+  };
+  for (const auto &[running_instance, running] : proposals_) {
+    std::for_each(running.routes.begin(), running.routes.end(), add_running_route);
+  }
+  std::for_each(pending_routes_.begin(), pending_routes_.end(), add_running_route);
 
-    // Set finalized data
-    container_->finally_accepted_data.push_back(container_->accepted_data_current_instance.data);
-    container_->accepted_data_current_instance = AcceptedProposal{};
-    for (auto point : current_proposal_.points) {
-      // Verify that point is actually an intersection in this scenario
-      DAISI_CHECK(getAllIntersections().count(point.first) == 1, "Invalid point");
-      container_->agreed_data[{point.first.x, point.first.y}]
-                             [point.second + current_proposal_.start_time] = container_->node_id;
+  proposal.phase = Phase::kFinished;
+  for (auto i = 0U; i < proposal.routes.size(); i++) {
+    const RouteRequest &route = proposal.routes[i];
+    if (success && proposal.applied.value()[i]) {
+      route.success_cb(proposal.instance_id, route.start_time);
+    } else {
+      route.fail_cb(0);
     }
   }
+
+  // The instance is free again
+  proposePendingRoutes();
 }
 
 }  // namespace daisi::path_planning::consensus
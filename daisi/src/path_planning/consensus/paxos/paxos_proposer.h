@@ -17,10 +17,15 @@
 #ifndef DAISI_PATH_PLANNING_CONSENSUS_PAXOS_PROPOSER_H_
 #define DAISI_PATH_PLANNING_CONSENSUS_PAXOS_PROPOSER_H_
 
+#include <deque>
 #include <functional>
+#include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "ns3/event-id.h"
+#include "path_planning/consensus/occupancy_interval_index.h"
 #include "path_planning/consensus/paxos/message/ok_message.h"
 #include "path_planning/consensus/paxos/message/promise_message.h"
 #include "path_planning/consensus/paxos/message/response_message.h"
@@ -28,7 +33,10 @@
 #include "path_planning/constants.h"
 
 namespace daisi::path_planning::consensus {
-//! Implementation for an proposer in the paxos consensus algorithm
+//! Implementation for an proposer in the paxos consensus algorithm. Several proposals run
+//! concurrently, each in its own instance.
+//! In Multi-Paxos mode, the proposer requests a promise for all following instances. As long as
+//! it stays the leader, it skips the prepare phase and batches several routes into one instance.
 class PaxosProposer {
 public:
   explicit PaxosProposer(std::shared_ptr<PaxosContainer> container);
@@ -41,33 +49,87 @@ public:
   void processOKMessage(const OKMessage &msg);
   void processResponseMessage(const ResponseMessage &msg);
 
+  [[nodiscard]] uint32_t getMaxConcurrentProposals() const;
+
 private:
   std::shared_ptr<PaxosContainer> container_;
 
   enum class Phase { kNone, kPrepare, kAccept, kFinished };
 
-  //! Data for a proposal
-  struct Proposal {
+  //! Route which should be reserved, either pending or as part of a proposal
+  struct RouteRequest {
     PointTimePairs points;
     double start_time = 0.0;
+    std::function<void(uint32_t, double)> success_cb;
+    std::function<void(uint32_t)> fail_cb;
+  };
+
+  //! Data for a proposal
+  struct Proposal {
+    std::vector<RouteRequest> routes;
     uint32_t instance_id = 0;
     uint32_t proposal_id = 0;
     uint32_t needed_for_quorum = 0;
     uint32_t outstanding_oks = 0;
+    uint32_t remaining_responses = 0;  //!< Number of remaining responses after the OK phase
     ns3::EventId timeout_event;
     Phase phase = Phase::kNone;
-    std::function<void(uint32_t, double)> success_cb;
-    std::function<void(uint32_t)> fail_cb;
+    bool all_following_instances = false;  //!< Whether the prepare requests the leadership
+
+    //! Whether the routes were sent to the acceptors, which might decide them without our OKs
+    bool accept_sent = false;
+
+    //! Per route whether it did not conflict with the previous routes, once the instance is applied
+    std::optional<std::vector<bool>> applied;
 
-    [[nodiscard]] bool initialized() const { return !points.empty(); }
+    [[nodiscard]] bool initialized() const { return !routes.empty(); }
   };
 
   double calculatePossibleStartTime(const PointTimePairs &points, double seconds_till_start) const;
 
-  void prepareTimeout(uint32_t proposal_id);
+  //! First instance which is neither decided nor used by one of our running proposals
+  [[nodiscard]] InstanceID getNextFreeInstance() const;
+
+  //! Running proposal with the given instance and proposal ID, nullptr if there is none
+  Proposal *findProposal(InstanceID instance, uint32_t proposal_id);
+
+  //! Propose the pending routes in free instances, as long as the pipeline is not full
+  void proposePendingRoutes();
+
+  void sendPrepare(Proposal &proposal);
+  void sendAccept(Proposal &proposal);
+
+  //! Whether we are the Multi-Paxos leader for the instance and can skip the prepare phase
+  [[nodiscard]] bool isLeader(InstanceID instance) const;
+
+  //! Whether one of our prepares for all following instances is still running
+  [[nodiscard]] bool isRequestingLeadership() const;
+
+  //! Number of pending routes and routes of running proposals
+  [[nodiscard]] uint32_t getNumberOfRunningRoutes() const;
+
+  //! Occupancies of the routes with global times
+  [[nodiscard]] static std::vector<RouteOccupancies> getRouteOccupancies(const Proposal &proposal);
+
+  //! Fails the proposal if the acceptors never got its routes. Otherwise it waits for the
+  //! decision of the instance and proposes the routes again while the instance is not decided.
+  void prepareTimeout(InstanceID instance, uint32_t proposal_id);
+
+  void processAppliedInstance(InstanceID instance, const DecidedInstance &entry);
+
+  //! Finish the proposal once it is applied and all acceptors responded
+  void tryFinishProposal(InstanceID instance);
+  void finishProposal(InstanceID instance, bool success);
+
+  std::map<InstanceID, Proposal> proposals_;  //!< Running proposals by their instance
+
+  std::deque<RouteRequest> pending_routes_;  //!< Routes waiting for a free instance
+
+  //! Blocked intervals of the pending routes and running proposals, which are not agreed yet
+  OccupancyIntervalIndex running_intervals_;
 
-  uint32_t remaining_responses_ = 0;  //!< Number of remaining responses for the current proposal
-  Proposal current_proposal_;
+  //! Proposal ID of our promise for all following instances, while we are the Multi-Paxos leader
+  std::optional<uint32_t> leader_proposal_id_;
 
   std::unordered_map<InstanceID, uint32_t>
       instance_to_proposal_id_;  //!< Next proposal ID to be used for a given instance
@@ -25,11 +25,17 @@ namespace daisi::path_planning::consensus {
 PaxosReplicationManager::PaxosReplicationManager(std::string station_id,
                                                  std::shared_ptr<PathPlanningLoggerNs3> logger,
                                                  const PaxosSettings &settings)
-    : station_id_(std::move(station_id)), logger_(std::move(logger)), settings_(settings) {}
+    : station_id_(std::move(station_id)),
+      logger_(std::move(logger)),
+      settings_(settings),
+      log_(settings.log_retention) {}
 
 void PaxosReplicationManager::processReplicationMessage(const ReplicationMessage &msg) {
-  auto already_accepted = log_.find(msg.instance_id);
-  DAISI_CHECK(already_accepted == log_.end(),
+  if (log_.isFolded(msg.instance_id)) {
+    // Too old to verify
+    return;
+  }
+  DAISI_CHECK(!log_.isDecided(msg.instance_id),
               "already accepted for this instance! Duplicate message");
 
   auto it = outstanding_data_.find({msg.instance_id, msg.proposal_id, msg.station_id});
@@ -37,11 +43,19 @@ void PaxosReplicationManager::processReplicationMessage(const ReplicationMessage
     // Already received data for this instance, proposal and station
     it->second.remaining_replications--;
     if (it->second.remaining_replications == 0) {
-      log_[msg.instance_id] = it->second.data;
-      outstanding_data_.erase(it);
-      logger_->logReplication(station_id_, msg.instance_id, log_[msg.instance_id].proposal_id,
-                              log_[msg.instance_id].station_id);
-      // TODO Clear unused data with same instance
+      const Data data = it->second.data;
+      log_.decide(msg.instance_id, data);
+      logger_->logReplication(station_id_, msg.instance_id, data.proposal_id, data.station_id);
+
+      // Data of other proposals for this instance or of folded instances is not needed anymore
+      for (auto outstanding = outstanding_data_.begin(); outstanding != outstanding_data_.end();) {
+        const InstanceID instance = std::get<0>(outstanding->first);
+        if (instance == msg.instance_id || log_.isFolded(instance)) {
+          outstanding = outstanding_data_.erase(outstanding);
+        } else {
+          ++outstanding;
+        }
+      }
     }
   } else {
     // First time that we receive this data
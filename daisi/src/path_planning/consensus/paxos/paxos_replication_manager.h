@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "path_planning/consensus/paxos/message/replication_message.h"
+#include "path_planning/consensus/paxos/paxos_log.h"
 #include "path_planning/path_planning_logger_ns_3.h"
 #include "paxos_settings.h"
 
@@ -50,7 +51,6 @@ private:
     uint32_t remaining_replications;
   };
 
-  using InstanceID = uint32_t;
   using InstanceProposalStationTuple = std::tuple<InstanceID, uint32_t, uint32_t>;
 
   struct TupleHash {
@@ -60,7 +60,7 @@ private:
     }
   };
 
-  std::unordered_map<InstanceID, Data> log_;  //!< Final ledger with data for each instance
+  PaxosLog<Data> log_;  //!< Final ledger with data for the latest instances
   std::unordered_map<InstanceProposalStationTuple, UnfinishedData, TupleHash> outstanding_data_;
 };
 }  // namespace daisi::path_planning::consensus
@@ -28,6 +28,15 @@ struct PaxosSettings {
   uint64_t number_paxos_participants{};  // including ourselves
   double time_delta_intersections{};
   double max_preplanning_time{};
+  uint32_t log_retention = 64;  // number of latest decided instances kept in the log
+  uint32_t max_pipelined_instances = 4;  // instances a participant proposes concurrently
+  bool multi_paxos = false;  // stable leader skips the prepare phase of following instances
+  uint32_t max_batched_routes = 4;  // routes per instance in Multi-Paxos mode
+
+  // seconds for which agreed occupancies are kept after they passed. Participants prune on their
+  // own, so this must exceed the time until a proposed route is decided. Participants which apply
+  // instances later, after catching up, replay the outcome of the participant which sent them.
+  double occupancy_retention = 10.0;
 };
 }  // namespace daisi::path_planning::consensus
 
@@ -16,47 +16,139 @@
 
 #include "route_calculation_helper.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "utils/daisi_check.h"
 
 namespace daisi::path_planning::consensus {
+
+//! Step size to increase possible start times
+static constexpr double kStartTimeStepS = 0.001;
+
 double RouteCalculationHelper::calculatePossibleStartTime(
     const PointTimePairs &points, double initial_start_time, double max_preplanning_time_s,
     double time_between_intersections_s, const IntersectionOccupancy &intersection_occupancy) {
-  // Step size to increase possible start times
-  const double delta_s = 0.001;
-  auto start_time = [delta_s, initial_start_time](int i) {
-    return initial_start_time + delta_s * i;
+  const double latest_start_time = initial_start_time + max_preplanning_time_s;
+
+  std::vector<StartTimeInterval> forbidden_intervals;
+  for (const auto &[position, relative_time] : points) {
+    auto entry_it = intersection_occupancy.find({position.x, position.y});
+    if (entry_it == intersection_occupancy.end()) {
+      // Point not occupied at all and therefore free
+      continue;
+    }
+
+    // Occupancies conflicting with any start time in [initial_start_time, latest_start_time]
+    const auto &entry = entry_it->second;
+    auto it = entry.lower_bound(initial_start_time + relative_time - time_between_intersections_s);
+    auto end = entry.upper_bound(latest_start_time + relative_time + time_between_intersections_s);
+    for (; it != end; ++it) {
+      forbidden_intervals.emplace_back(it->first - relative_time - time_between_intersections_s,
+                                       it->first - relative_time + time_between_intersections_s);
+    }
+  }
+
+  return findEarliestStartTime(
+      forbidden_intervals, initial_start_time, max_preplanning_time_s, [&](double start_time) {
+        return possibleRoute(points, start_time, time_between_intersections_s,
+                             intersection_occupancy);
+      });
+}
+
+double RouteCalculationHelper::calculatePossibleStartTime(
+    const PointTimePairs &points, double initial_start_time, double max_preplanning_time_s,
+    const OccupancyIntervalIndex &occupancy_index) {
+  return calculatePossibleStartTime(points, initial_start_time, max_preplanning_time_s,
+                                    std::vector<const OccupancyIntervalIndex *>{&occupancy_index});
+}
+
+double RouteCalculationHelper::calculatePossibleStartTime(
+    const PointTimePairs &points, double initial_start_time, double max_preplanning_time_s,
+    const std::vector<const OccupancyIntervalIndex *> &occupancy_indices) {
+  const double latest_start_time = initial_start_time + max_preplanning_time_s;
+
+  std::vector<StartTimeInterval> forbidden_intervals;
+  for (const auto *occupancy_index : occupancy_indices) {
+    for (const auto &[position, relative_time] : points) {
+      occupancy_index->forEachBlockedInterval(
+          {position.x, position.y}, initial_start_time + relative_time,
+          latest_start_time + relative_time,
+          [&forbidden_intervals, relative_time = relative_time](double begin_s, double end_s) {
+            forbidden_intervals.emplace_back(begin_s - relative_time, end_s - relative_time);
+          });
+    }
+  }
+
+  return findEarliestStartTime(forbidden_intervals, initial_start_time, max_preplanning_time_s,
+                               [&](double start_time) {
+                                 for (const auto *occupancy_index : occupancy_indices) {
+                                   for (const auto &[position, relative_time] : points) {
+                                     if (occupancy_index->isBlocked({position.x, position.y},
+                                                                    start_time + relative_time)) {
+                                       return false;
+                                     }
+                                   }
+                                 }
+                                 return true;
+                               });
+}
+
+double RouteCalculationHelper::findEarliestStartTime(
+    std::vector<StartTimeInterval> &forbidden_intervals, double initial_start_time,
+    double max_preplanning_time_s, const std::function<bool(double)> &possible) {
+  auto start_time = [initial_start_time](int i) {
+    return initial_start_time + kStartTimeStepS * i;
   };
-  bool possible = false;
-  const int retries = static_cast<int>(max_preplanning_time_s) / delta_s;
+  const int retries = static_cast<int>(max_preplanning_time_s) / kStartTimeStepS;
+
+  std::sort(forbidden_intervals.begin(), forbidden_intervals.end());
+  auto next_interval = forbidden_intervals.cbegin();
+
   int i = 0;
-  for (; i < retries && !possible; i++) {
-    // Increment start time by \p delta_s until a conflict free occupancy is found or \p
-    // max_preplanning_time_s is reached
-    possible =
-        possibleRoute(points, start_time(i), time_between_intersections_s, intersection_occupancy);
-  }
-  double actual_start_time =
-      possible ? start_time(i - 1) : std::numeric_limits<double>::quiet_NaN();
+  while (i < retries) {
+    // Skip all steps of the first interval containing the current start time. As the intervals are
+    // sorted by their begin and the start time only increases, intervals are visited once.
+    bool forbidden = false;
+    for (; next_interval != forbidden_intervals.cend() && next_interval->first <= start_time(i);
+         ++next_interval) {
+      if (next_interval->second >= start_time(i)) {
+        const auto steps_till_end = static_cast<int>(
+            std::floor((next_interval->second - initial_start_time) / kStartTimeStepS));
+        i = std::max(i + 1, steps_till_end + 1);
+        forbidden = true;
+        ++next_interval;
+        break;
+      }
+    }
+
+    if (forbidden) {
+      continue;
+    }
+
+    if (possible(start_time(i))) {
+      DAISI_CHECK(initial_start_time <= start_time(i), "Cannot start before initial start time");
+      return start_time(i);
+    }
 
-  if (!std::isnan(actual_start_time)) {
-    DAISI_CHECK(initial_start_time <= actual_start_time, "Cannot start before initial start time");
+    // Only at bounds of forbidden intervals due to rounding
+    i++;
   }
 
-  return actual_start_time;
+  return std::numeric_limits<double>::quiet_NaN();
 }
 
 bool RouteCalculationHelper::possibleRoute(const PointTimePairs &points, double start_time_s,
                                            double time_between_intersections_s,
                                            const IntersectionOccupancy &intersection_occupancy) {
-  for (auto point : points) {
-    if (intersection_occupancy.count({point.first.x, point.first.y}) == 0) {
+  for (const auto &point : points) {
+    auto entry_it = intersection_occupancy.find({point.first.x, point.first.y});
+    if (entry_it == intersection_occupancy.end()) {
       // Point not occupied at all and therefore free
       continue;
     }
-    auto entry = intersection_occupancy.at({point.first.x, point.first.y});
+    const auto &entry = entry_it->second;
     if (entry.empty()) {
       // Point is already known but is not occupied at all.
       continue;
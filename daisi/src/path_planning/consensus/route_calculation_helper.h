@@ -17,7 +17,12 @@
 #ifndef DAISI_PATH_PLANNING_CONSENSUS_ROUTE_CALCULATION_HELPER_H_
 #define DAISI_PATH_PLANNING_CONSENSUS_ROUTE_CALCULATION_HELPER_H_
 
+#include <functional>
+#include <utility>
+#include <vector>
+
 #include "path_planning/constants.h"
+#include "path_planning/consensus/occupancy_interval_index.h"
 
 namespace daisi::path_planning::consensus {
 struct RouteCalculationHelper {
@@ -35,7 +40,49 @@ struct RouteCalculationHelper {
       const PointTimePairs &points, double initial_start_time, double max_preplanning_time_s,
       double time_between_intersections_s, const IntersectionOccupancy &intersection_occupancy);
 
+  /**
+   * Calculate a possible conflict free global start time with the blocked intervals of all
+   * intersections, as maintained by the consensus servers alongside their occupancies
+   * @param points requested route with relative timestamps
+   * @param initial_start_time earliest possible start time
+   * @param max_preplanning_time_s Maximum time in which the start time might be in the future
+   * @param occupancy_index blocked intervals of all global intersections
+   * @return possible global start time in seconds or quiet_NaN() if no start time could be found
+   */
+  [[nodiscard]] static double calculatePossibleStartTime(
+      const PointTimePairs &points, double initial_start_time, double max_preplanning_time_s,
+      const OccupancyIntervalIndex &occupancy_index);
+
+  /**
+   * Calculate a possible conflict free global start time with the blocked intervals of several
+   * indices, e.g., of the agreed occupancies and of the occupancies which are not agreed yet
+   * @param points requested route with relative timestamps
+   * @param initial_start_time earliest possible start time
+   * @param max_preplanning_time_s Maximum time in which the start time might be in the future
+   * @param occupancy_indices blocked intervals, the route must not conflict with any of them
+   * @return possible global start time in seconds or quiet_NaN() if no start time could be found
+   */
+  [[nodiscard]] static double calculatePossibleStartTime(
+      const PointTimePairs &points, double initial_start_time, double max_preplanning_time_s,
+      const std::vector<const OccupancyIntervalIndex *> &occupancy_indices);
+
 private:
+  //! Interval of global start times in seconds, including both bounds
+  using StartTimeInterval = std::pair<double, double>;
+
+  /**
+   * Find the earliest start time in steps of 1 ms from \p initial_start_time which is not within
+   * one of the \p forbidden_intervals. Every step within a forbidden interval is skipped at once.
+   * @param forbidden_intervals start times at which the route would conflict with an occupancy
+   * @param initial_start_time earliest possible start time
+   * @param max_preplanning_time_s Maximum time in which the start time might be in the future
+   * @param possible exact check of a start time, to rule out rounding errors at interval bounds
+   * @return possible global start time in seconds or quiet_NaN() if no start time could be found
+   */
+  [[nodiscard]] static double findEarliestStartTime(
+      std::vector<StartTimeInterval> &forbidden_intervals, double initial_start_time,
+      double max_preplanning_time_s, const std::function<bool(double)> &possible);
+
   /**
    * Check if the route from \p points and the given \p start_time is conflict free to all other
    * intersection occupancies
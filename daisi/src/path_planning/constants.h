@@ -17,6 +17,7 @@
 #ifndef DAISI_PATH_PLANNING_CONSTANTS_H_
 #define DAISI_PATH_PLANNING_CONSTANTS_H_
 
+#include <map>
 #include <unordered_map>
 #include <utility>
 #include <variant>
@@ -223,8 +223,9 @@ void PathPlanningLoggerNs3::logTOSpawn(const std::string &to_uuid, uint32_t stat
 }
 
 // * Constructor & Other methods
-PathPlanningLoggerNs3::PathPlanningLoggerNs3(LogDeviceApp log_device_application, LogFunction log)
-    : daisi::cpps::CppsLoggerNs3(log_device_application, log) {}
+PathPlanningLoggerNs3::PathPlanningLoggerNs3(LogDeviceApp log_device_application, LogFunction log,
+                                             LogInsert log_insert)
+    : daisi::cpps::CppsLoggerNs3(log_device_application, log, log_insert) {}
 
 // * Logging to CPPS tables
 void PathPlanningLoggerNs3::logPPTransportOrderUpdate(const std::string &order_uuid,
@@ -26,7 +26,8 @@ namespace daisi::path_planning {
 //! structure
 class PathPlanningLoggerNs3 : public daisi::cpps::CppsLoggerNs3 {
 public:
-  PathPlanningLoggerNs3(LogDeviceApp log_device_application, LogFunction log);
+  PathPlanningLoggerNs3(LogDeviceApp log_device_application, LogFunction log,
+                        LogInsert log_insert);
 
   void logTOSpawn(const std::string &to_uuid, uint32_t station_id, uint32_t time_to_station);
 
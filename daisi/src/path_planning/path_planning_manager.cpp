@@ -602,6 +602,8 @@ void PathPlanningManager::parseConsensusSettings() {
   double max_preplanning_time = getParsed(float, "maxPreplanningTimeBeforeReject");
   if (consensus_type_ == consensus::ConsensusType::kPaxos) {
     bool replication = getParsed(uint64_t, "paxosReplication");
+    bool multi_paxos = getParsed(uint64_t, "paxosMultiPaxos");
+    double occupancy_retention = getParsed(float, "paxosOccupancyRetention");
     consensus_settings_ =
         consensus::PaxosSettings{.pickup_active_participate = true,
                                  .delivery_active_participate = false,
@@ -609,10 +611,15 @@ void PathPlanningManager::parseConsensusSettings() {
                                  .replication = replication,
                                  .number_paxos_participants = number_pickup_stations_,
                                  .time_delta_intersections = time_between_intersects,
-                                 .max_preplanning_time = max_preplanning_time};
+                                 .max_preplanning_time = max_preplanning_time,
+                                 .multi_paxos = multi_paxos,
+                                 .occupancy_retention = occupancy_retention};
   } else if (consensus_type_ == consensus::ConsensusType::kCentral) {
-    consensus_settings_ =
-        consensus::CentralSettings{"N/A", 0, time_between_intersects, max_preplanning_time};
+    consensus::CentralSettings settings{"N/A", 0, time_between_intersects, max_preplanning_time};
+    settings.number_of_shards = getParsed(uint64_t, "centralShards");
+    settings.shard_region_size = getParsed(float, "centralShardRegionSize");
+    settings.occupancy_retention = getParsed(float, "centralOccupancyRetention");
+    consensus_settings_ = settings;
   }
 }
 
@@ -288,15 +288,15 @@ void PickupStation::initiateConsensusToPickup(AGVInfo &agv) {
 void PickupStation::initiateConsensus(const std::string &agv_id, RouteIdentifier d) {
   logger_->logPPTransportOrderUpdate(agv_ownership_[agv_id].current_to.uuid, 1);
 
-  if (current_consensus_.has_value()) {
-    // Already one consensus in progress, try again in 300 ms
+  if (running_consensus_.size() >= consensus_->getMaxConcurrentRequests()) {
+    // Already the maximum number of consensus in progress, try again in 300 ms
     constexpr uint32_t kConsensusInProgressRetryMs = 300;
     logger_->logPPTransportOrderUpdate(agv_ownership_[agv_id].current_to.uuid, 5);
     ns3::Simulator::Schedule(ns3::MilliSeconds(kConsensusInProgressRetryMs),
                              &PickupStation::initiateConsensus, this, agv_id, d);
     return;
   }
-  assert(!current_consensus_.has_value());
+  DAISI_CHECK(running_consensus_.count(agv_id) == 0, "Consensus for AGV already in progress");
 
   const cpps::AmrKinematics &kinematics = agv_ownership_.at(agv_id).kinematics;
   const cpps::AmrLoadHandlingUnit &load_handling = agv_ownership_.at(agv_id).load_handling;
@@ -312,51 +312,51 @@ void PickupStation::initiateConsensus(const std::string &agv_id, RouteIdentifier
   auto intersection_times =
       calculateTimeTillPoints(kinematics, load_handling, start, end, intersections);
 
-  current_consensus_.emplace(ConsensusData{agv_id, intersection_times});
+  running_consensus_.emplace(agv_id, ConsensusData{agv_id, intersection_times});
 
   consensus_->findConsensus(
       intersection_times, load_handling.getLoadTime(),
-      [this](uint32_t instance, double start_time) {
-        assert(current_consensus_.has_value());
-        retry_ = 1;
-        logger_->logConsensusFinished(instance, info_.station_id,
-                                      current_consensus_.value().agv_uuid);
-        const AGVInfo &agv = agv_ownership_[current_consensus_.value().agv_uuid];
+      [this, agv_id](uint32_t instance, double start_time) {
+        auto consensus = running_consensus_.find(agv_id);
+        assert(consensus != running_consensus_.end());
+        consensus_retries_.erase(agv_id);
+        logger_->logConsensusFinished(instance, info_.station_id, agv_id);
+        const AGVInfo &agv = agv_ownership_[agv_id];
         logger_->logPPTransportOrderUpdate(agv.current_to.uuid, 2);
         uint64_t current_time = ns3::Simulator::Now().GetMilliSeconds();
         assert(start_time * 1000 - current_time > 0);
         ns3::Simulator::Schedule(ns3::MilliSeconds(start_time * 1000 - current_time),
-                                 &PickupStation::negotiationGo, this,
-                                 current_consensus_.value().agv_uuid);
+                                 &PickupStation::negotiationGo, this, agv_id);
         uint32_t to = agv.state == AGVState::kNegotiatingDriveToDelivery
                           ? agv.current_to.delivery_station
                           : info_.station_id;
-        for (auto point : current_consensus_.value().pairs) {
+        for (auto point : consensus->second.pairs) {
           logger_->logIntersectOccupancy(
               info_.station_id, to, agv.id,
               agv.state == AGVState::kNegotiatingDriveToDelivery ? "LOADED" : "EMPTY",
               point.first.x, point.first.y, start_time + point.second);
         }
-        current_consensus_.reset();
+        running_consensus_.erase(consensus);
       },
-      [&](uint32_t /*unused*/) {
-        assert(current_consensus_.has_value());
-        AGVInfo agv = agv_ownership_[current_consensus_.value().agv_uuid];
+      [this, agv_id](uint32_t /*unused*/) {
+        assert(running_consensus_.count(agv_id) == 1);
+        AGVInfo agv = agv_ownership_[agv_id];
         logger_->logPPTransportOrderUpdate(agv.current_to.uuid, 6);
 
-        current_consensus_.reset();
+        running_consensus_.erase(agv_id);
+        ConsensusRetry &backoff = consensus_retries_[agv_id];
         std::uniform_int_distribution<uint32_t> dist(300, 1000);
-        if (retry_ == 1) {
-          current_delay_ = dist(daisi::global_random_engine);
+        if (backoff.retry == 1) {
+          backoff.current_delay = dist(daisi::global_random_engine);
         }
         if (agv.state == AGVState::kNegotiatingDriveToDelivery) {
-          ns3::Simulator::Schedule(ns3::MilliSeconds(current_delay_ * retry_),
+          ns3::Simulator::Schedule(ns3::MilliSeconds(backoff.current_delay * backoff.retry),
                                    &PickupStation::initiateConsensusToDelivery, this, agv);
-          retry_++;
+          backoff.retry++;
         } else if (agv.state == AGVState::kNegotiatingDriveToPickup) {
-          ns3::Simulator::Schedule(ns3::MilliSeconds(current_delay_ * retry_),
+          ns3::Simulator::Schedule(ns3::MilliSeconds(backoff.current_delay * backoff.retry),
                                    &PickupStation::initiateConsensusToPickup, this, agv);
-          retry_++;
+          backoff.retry++;
         }
       });
 }
@@ -115,9 +115,6 @@ private:
 
   PickupStationInfo info_;
 
-  uint32_t current_delay_ = 0;  //!< Random delay that is used if consensus is failing
-  uint32_t retry_ = 1;          //!< Number of retries for a failing consensus
-
   std::function<TransportOrderInfo()>
       create_order_;  //!< Function that creates a new order (with random delivery station)
 
@@ -139,9 +136,17 @@ private:
     PointTimePairs pairs;
   };
 
-  std::optional<ConsensusData>
-      current_consensus_;  //!< Data of the currently running consensus (only one consensus at a
-                           //!< time per PickupStation allowed yet)
+  std::unordered_map<std::string, ConsensusData>
+      running_consensus_;  //!< Data of the currently running consensus per AGV. Routes of several
+                           //!< AGVs are negotiated concurrently, up to the consensus' limit.
+
+  struct ConsensusRetry {
+    uint32_t current_delay = 0;  //!< Random delay that is used if consensus is failing
+    uint32_t retry = 1;          //!< Number of retries for a failing consensus
+  };
+
+  std::unordered_map<std::string, ConsensusRetry>
+      consensus_retries_;  //!< Backoff per AGV whose consensus failed, until it succeeds
   NextTOMode next_to_mode_;
 };
 
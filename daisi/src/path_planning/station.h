@@ -37,6 +37,9 @@ struct IntersectionTimeInfo {
   }
 };
 
+//! Occupancies of all intersections of one route
+using RouteOccupancies = std::vector<IntersectionTimeInfo>;
+
 //! Map of all delivery stations (id) to their center points
 using DeliveryStationPoints = std::unordered_map<uint32_t, ns3::Vector2D>;
 
@@ -150,11 +150,18 @@ Network::Network(const std::function<void(const Message &)> &callback)
 Network::Network(const std::string &ip, const std::function<void(const Message &)> &callback)
     : pimpl_(std::make_unique<Impl>(ip, callback)) {}
 
+// I/O options only affect the socket path of the real network and are ignored in simulation
+Network::Network(const std::string &ip, const std::function<void(const Message &)> &callback,
+                 const NetworkOptions & /*options*/)
+    : pimpl_(std::make_unique<Impl>(ip, callback)) {}
+
 Network::~Network() = default;  // Declared as default here (and not in header) because otherwise
                                 // class Impl has incomplete type
 
 void Network::send(const Message &msg) { pimpl_->send(msg); }
 
+void Network::send(Message &&msg) { pimpl_->send(msg); }
+
 uint16_t Network::getPort() const { return pimpl_->getPort(); }
 
 std::string Network::getIP() const { return pimpl_->getIP(); }
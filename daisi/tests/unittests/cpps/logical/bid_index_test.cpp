@@ -0,0 +1,136 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "cpps/logical/algorithms/assignment/bid_index.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+using namespace daisi;
+using namespace daisi::cpps;
+using namespace daisi::cpps::logical;
+
+BidSubmission createBid(const std::string &task_uuid, const std::string &participant,
+                        double cost) {
+  amr::AmrStaticAbility ability(amr::LoadCarrier(amr::LoadCarrier::Types::kPackage), 20);
+  MetricsComposition composition(Metrics(cost, cost, cost, cost, cost));
+  return {task_uuid, participant, ability, composition};
+}
+
+TEST_CASE("BidIndex best bid per task", "[bid_index]") {
+  BidIndex index;
+  REQUIRE(index.empty());
+  REQUIRE(index.getBestBidPerTask().empty());
+
+  index.add(createBid("task1", "amr1", 30));
+  index.add(createBid("task1", "amr2", 10));
+  index.add(createBid("task2", "amr1", 20));
+  index.add(createBid("task2", "amr2", 40));
+  index.add(createBid("task3", "amr3", 50));
+  REQUIRE(index.size() == 5);
+
+  auto best_bids = index.getBestBidPerTask();
+  REQUIRE(best_bids.size() == 3);
+  REQUIRE(best_bids[0]->getTaskUuid() == "task1");
+  REQUIRE(best_bids[0]->getParticipantConnection() == "amr2");
+  REQUIRE(best_bids[1]->getTaskUuid() == "task2");
+  REQUIRE(best_bids[1]->getParticipantConnection() == "amr1");
+  REQUIRE(best_bids[2]->getTaskUuid() == "task3");
+  REQUIRE(best_bids[2]->getParticipantConnection() == "amr3");
+}
+
+TEST_CASE("BidIndex removal", "[bid_index]") {
+  BidIndex index;
+  index.add(createBid("task1", "amr1", 30));
+  index.add(createBid("task1", "amr2", 10));
+  index.add(createBid("task2", "amr1", 20));
+  index.add(createBid("task2", "amr2", 40));
+  index.add(createBid("task3", "amr3", 50));
+
+  SECTION("removing a single bid") {
+    index.removeBid("task1", "amr2");
+    REQUIRE(index.size() == 4);
+
+    auto best_bids = index.getBestBidPerTask();
+    REQUIRE(best_bids.size() == 3);
+    REQUIRE(best_bids[0]->getTaskUuid() == "task2");
+    REQUIRE(best_bids[1]->getTaskUuid() == "task1");
+    REQUIRE(best_bids[1]->getParticipantConnection() == "amr1");
+
+    // removing an unknown bid has no effect
+    index.removeBid("task1", "amr3");
+    index.removeBid("task4", "amr1");
+    REQUIRE(index.size() == 4);
+  }
+
+  SECTION("removing all bids of a task") {
+    index.removeTask("task1");
+    REQUIRE(index.size() == 3);
+
+    auto best_bids = index.getBestBidPerTask();
+    REQUIRE(best_bids.size() == 2);
+    REQUIRE(best_bids[0]->getTaskUuid() == "task2");
+    REQUIRE(best_bids[1]->getTaskUuid() == "task3");
+  }
+
+  SECTION("removing all bids of a participant") {
+    index.removeParticipant("amr1");
+    REQUIRE(index.size() == 3);
+
+    auto best_bids = index.getBestBidPerTask();
+    REQUIRE(best_bids.size() == 3);
+    REQUIRE(best_bids[0]->getParticipantConnection() == "amr2");
+    REQUIRE(best_bids[1]->getTaskUuid() == "task2");
+    REQUIRE(best_bids[1]->getParticipantConnection() == "amr2");
+
+    index.removeParticipant("amr3");
+    REQUIRE(index.getBestBidPerTask().size() == 2);
+  }
+
+  SECTION("clearing") {
+    index.clear();
+    REQUIRE(index.empty());
+    REQUIRE(index.getBestBidPerTask().empty());
+  }
+}
+
+TEST_CASE("BidIndex compaction keeps valid bids", "[bid_index]") {
+  BidIndex index;
+  for (int amr = 0; amr < 100; amr++) {
+    for (int task = 0; task < 10; task++) {
+      index.add(createBid("task" + std::to_string(task), "amr" + std::to_string(amr),
+                          1 + amr + task * 1000));
+    }
+  }
+  REQUIRE(index.size() == 1000);
+
+  // removing most of the participants triggers compactions
+  for (int amr = 0; amr < 95; amr++) {
+    index.removeParticipant("amr" + std::to_string(amr));
+  }
+  REQUIRE(index.size() == 50);
+
+  auto best_bids = index.getBestBidPerTask();
+  REQUIRE(best_bids.size() == 10);
+  for (int task = 0; task < 10; task++) {
+    REQUIRE(best_bids[task]->getTaskUuid() == "task" + std::to_string(task));
+    REQUIRE(best_bids[task]->getParticipantConnection() == "amr95");
+  }
+
+  index.removeTask("task0");
+  REQUIRE(index.size() == 45);
+  REQUIRE(index.getBestBidPerTask().size() == 9);
+}
@@ -18,6 +18,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <string>
+#include <vector>
 
 struct TestVertex {
   explicit TestVertex(const std::string &name) : name_(name){};
@@ -366,3 +367,104 @@ TEST_CASE("Simple graph with four vertices", "[getter outgoing/incoming edges]")
   REQUIRE(incoming_v4.size() == 2);
   REQUIRE(outgoing_v4.size() == 1);
 }
+
+struct UnhashableTestVertex {
+  explicit UnhashableTestVertex(const std::string &name) : name_(name){};
+
+  friend bool operator==(const UnhashableTestVertex &v1, const UnhashableTestVertex &v2) {
+    return v1.name_ == v2.name_;
+  }
+
+private:
+  std::string name_;
+};
+
+template <typename Graph, typename Vertex> void requireEdgesAfterRemovals() {
+  Graph g1;
+
+  std::vector<Vertex> vertices;
+  for (int i = 0; i < 6; i++) {
+    vertices.emplace_back(std::to_string(i));
+    g1.addVertex(vertices.back());
+  }
+
+  // edge i -> j for i < j
+  for (int i = 0; i < 6; i++) {
+    for (int j = i + 1; j < 6; j++) {
+      g1.addEdge(vertices[i], vertices[j], TestEdge(std::to_string(i) + std::to_string(j)));
+    }
+  }
+
+  g1.removeVertex(vertices[1]);
+  g1.removeVertex(vertices[3]);
+  REQUIRE(g1.getVertices().size() == 4);
+  REQUIRE(g1.getVertices()[0] == vertices[0]);
+  REQUIRE(g1.getVertices()[1] == vertices[2]);
+  REQUIRE(g1.getVertices()[2] == vertices[4]);
+  REQUIRE(g1.getVertices()[3] == vertices[5]);
+
+  for (int i : {0, 2, 4, 5}) {
+    for (int j : {0, 2, 4, 5}) {
+      REQUIRE(g1.hasEdge(vertices[i], vertices[j]) == (i < j));
+      if (i < j) {
+        REQUIRE(g1.getEdge(vertices[i], vertices[j]).getName() ==
+                std::to_string(i) + std::to_string(j));
+      }
+    }
+  }
+
+  // slots of removed vertices are reused without their previous edges
+  Vertex v6("6");
+  Vertex v7("7");
+  g1.addVertex(v6);
+  g1.addVertex(v7);
+  REQUIRE(g1.getVertices().size() == 6);
+  REQUIRE(g1.getVertices()[4] == v6);
+  REQUIRE(g1.getVertices()[5] == v7);
+  REQUIRE(g1.getOutgoingEdges(v6).empty());
+  REQUIRE(g1.getIncomingEdges(v6).empty());
+  REQUIRE(g1.getOutgoingEdges(v7).empty());
+  REQUIRE(g1.getIncomingEdges(v7).empty());
+  REQUIRE(!g1.hasVertex(vertices[1]));
+  REQUIRE(!g1.hasVertex(vertices[3]));
+
+  g1.addEdge(v7, v6, TestEdge("76"));
+  g1.addEdge(vertices[0], v7, TestEdge("07"));
+
+  // edges are returned in the order of the vertices
+  auto outgoing = g1.getOutgoingEdges(vertices[0]);
+  REQUIRE(outgoing.size() == 4);
+  REQUIRE(outgoing[0].first == vertices[2]);
+  REQUIRE(outgoing[1].first == vertices[4]);
+  REQUIRE(outgoing[2].first == vertices[5]);
+  REQUIRE(outgoing[3].first == v7);
+
+  auto incoming = g1.getIncomingEdges(v6);
+  REQUIRE(incoming.size() == 1);
+  REQUIRE(incoming[0].first == v7);
+  REQUIRE(incoming[0].second.getName() == "76");
+
+  g1.removeEdge(v7, v6);
+  REQUIRE(!g1.hasEdge(v7, v6));
+  REQUIRE(g1.getIncomingEdges(v6).empty());
+
+  g1.removeVertex(v7);
+  REQUIRE(!g1.hasEdge(vertices[0], v7));
+  REQUIRE(g1.getOutgoingEdges(vertices[0]).size() == 3);
+}
+
+TEST_CASE("Removing vertices keeps the remaining edges", "[adding and removing vertices]") {
+  SECTION("dense edge storage") {
+    requireEdgesAfterRemovals<DirectedGraph<TestVertex, TestEdge>, TestVertex>();
+  }
+
+  SECTION("sparse edge storage") {
+    requireEdgesAfterRemovals<
+        DirectedGraph<TestVertex, TestEdge, SparseEdgeStorage<TestEdge>>, TestVertex>();
+  }
+
+  SECTION("vertex without hash") {
+    requireEdgesAfterRemovals<DirectedGraph<UnhashableTestVertex, TestEdge>,
+                              UnhashableTestVertex>();
+  }
+}
@@ -17,6 +17,7 @@
 #include "datastructure/simple_temporal_network.tpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <random>
 #include <string>
 
 using namespace daisi::datastructure;
@@ -190,3 +191,224 @@ TEST_CASE("Simple graph with four vertices", "[weight matrix, floyd warshall]")
   REQUIRE(it_v4l != latest_solution.end());
   REQUIRE(it_v4l->second == 70);
 }
+
+class InspectableSTN : public TestSTN {
+public:
+  using TestSTN::TestSTN;
+
+  const std::vector<std::vector<double>> &getDistanceGraph() const { return d_graph_; }
+};
+
+void requireEquivalentSolutions(InspectableSTN &floyd_warshall, InspectableSTN &incremental) {
+  const bool floyd_warshall_solved = floyd_warshall.solve();
+  const bool incremental_solved = incremental.solve();
+
+  REQUIRE(floyd_warshall_solved == incremental_solved);
+  if (floyd_warshall_solved) {
+    // integer weights, so that both solvers compute exactly the same sums
+    REQUIRE(floyd_warshall.getDistanceGraph() == incremental.getDistanceGraph());
+  }
+}
+
+TEST_CASE("Incremental solver is equivalent to Floyd-Warshall", "[incremental solver]") {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> small(1, 20);
+  std::uniform_int_distribution<int> large(100, 2000);
+
+  InspectableSTN floyd_warshall(StnSolverMode::kFloydWarshall);
+  InspectableSTN incremental(StnSolverMode::kIncremental);
+  REQUIRE(incremental.getSolverMode() == StnSolverMode::kIncremental);
+
+  auto both = [&](auto &&operation) {
+    operation(floyd_warshall);
+    operation(incremental);
+  };
+
+  // Task queue like in the StnTaskManagement: start and finish vertices with durations, time
+  // windows, and travel times between consecutive tasks
+  std::vector<TestVertex> starts;
+  std::vector<TestVertex> finishes;
+  for (int i = 0; i < 30; i++) {
+    TestVertex start{"s" + std::to_string(i)};
+    TestVertex finish{"f" + std::to_string(i)};
+    const double duration = small(gen);
+    const double earliest_start = large(gen);
+    const double latest_finish = earliest_start + 10 * large(gen);
+
+    both([&](auto &stn) {
+      stn.addVertex(start);
+      stn.addVertex(finish);
+      stn.addBinaryConstraint(start, finish, duration, std::nullopt);
+      stn.addUnaryConstraint(start, earliest_start, std::nullopt);
+      stn.addUnaryConstraint(finish, std::nullopt, latest_finish);
+    });
+    requireEquivalentSolutions(floyd_warshall, incremental);
+
+    if (i > 0) {
+      const double travel_time = small(gen);
+      both([&](auto &stn) {
+        stn.addBinaryConstraint(finishes.back(), start, travel_time, std::nullopt);
+      });
+      requireEquivalentSolutions(floyd_warshall, incremental);
+    }
+
+    starts.push_back(start);
+    finishes.push_back(finish);
+  }
+
+  SECTION("Tightening and loosening constraints") {
+    std::uniform_int_distribution<size_t> task(0, starts.size() - 1);
+    std::uniform_int_distribution<int> operation(0, 2);
+
+    for (int step = 0; step < 200; step++) {
+      const size_t first = task(gen);
+      const size_t second = task(gen);
+
+      switch (operation(gen)) {
+        case 0: {
+          // additional precedence, can create cycles and therefore inconsistencies
+          if (first == second) continue;
+          const double lower_bound = small(gen);
+          both([&](auto &stn) {
+            stn.addBinaryConstraint(finishes[first], starts[second], lower_bound, std::nullopt);
+          });
+          break;
+        }
+        case 1: {
+          // changed duration, tightens or loosens
+          const double duration = small(gen);
+          both([&](auto &stn) {
+            stn.updateLastBinaryConstraint(starts[first], finishes[first], duration, std::nullopt);
+          });
+          break;
+        }
+        default: {
+          const double upper_bound = large(gen);
+          both([&](auto &stn) {
+            stn.addBinaryConstraint(starts[first], finishes[first], std::nullopt, upper_bound);
+          });
+          break;
+        }
+      }
+
+      requireEquivalentSolutions(floyd_warshall, incremental);
+    }
+  }
+
+  SECTION("Inconsistent constraints") {
+    both([&](auto &stn) {
+      stn.addBinaryConstraint(finishes.back(), starts.front(), 1, std::nullopt);
+    });
+    requireEquivalentSolutions(floyd_warshall, incremental);
+    REQUIRE(!incremental.solve());
+
+    // stays inconsistent until the cycle is removed
+    TestVertex unconstrained{"unconstrained"};
+    both([&](auto &stn) {
+      stn.addVertex(unconstrained);
+      stn.addUnaryConstraint(unconstrained, 5, std::nullopt);
+    });
+    requireEquivalentSolutions(floyd_warshall, incremental);
+  }
+}
+
+TEST_CASE("Rollback to checkpoint", "[checkpoint]") {
+  InspectableSTN floyd_warshall(StnSolverMode::kFloydWarshall);
+  InspectableSTN incremental(StnSolverMode::kIncremental);
+  TestVertex v1{"v1"};
+  TestVertex v2{"v2"};
+  TestVertex v3{"v3"};
+
+  for (auto *stn : {&floyd_warshall, &incremental}) {
+    stn->addVertex(v1);
+    stn->addVertex(v2);
+    stn->addBinaryConstraint(stn->getOrigin(), v1, 10, 20);
+    stn->addBinaryConstraint(v1, v2, 30, 40);
+    REQUIRE(stn->solve());
+  }
+
+  const auto distances = incremental.getDistanceGraph();
+
+  REQUIRE(!incremental.hasCheckpoint());
+  incremental.checkpoint();
+  REQUIRE(incremental.hasCheckpoint());
+  REQUIRE_THROWS(incremental.checkpoint());
+
+  incremental.addVertex(v3);
+  incremental.addBinaryConstraint(v2, v3, 5, std::nullopt);
+  incremental.addBinaryConstraint(incremental.getOrigin(), v1, 15, std::nullopt);
+  incremental.updateLastBinaryConstraint(v1, v2, 35, std::nullopt);
+  REQUIRE_THROWS(incremental.removeVertex(v3));
+  REQUIRE(incremental.solve());
+  REQUIRE(incremental.getDistanceGraph() != distances);
+
+  incremental.rollback();
+  REQUIRE(!incremental.hasCheckpoint());
+  REQUIRE(!incremental.hasVertex(v3));
+  REQUIRE(incremental.getVertices().size() == 3);
+  REQUIRE(incremental.getEdge(incremental.getOrigin(), v1).getWeight() == 20);
+  REQUIRE(incremental.getEdge(v1, incremental.getOrigin()).getWeight() == -10);
+  REQUIRE(incremental.getEdge(v2, v1).getWeight() == -30);
+  REQUIRE(incremental.getDistanceGraph() == distances);
+
+  // the restored solution is used for further incremental solving
+  for (auto *stn : {&floyd_warshall, &incremental}) {
+    stn->addBinaryConstraint(v1, v2, 35, std::nullopt);
+  }
+  requireEquivalentSolutions(floyd_warshall, incremental);
+
+  incremental.checkpoint();
+  incremental.addBinaryConstraint(incremental.getOrigin(), v2, 45, std::nullopt);
+  incremental.releaseCheckpoint();
+  REQUIRE(!incremental.hasCheckpoint());
+  REQUIRE(incremental.getEdge(v2, incremental.getOrigin()).getWeight() == -45);
+}
+
+TEST_CASE("Rollback of trial insertions", "[checkpoint]") {
+  InspectableSTN floyd_warshall(StnSolverMode::kFloydWarshall);
+  InspectableSTN incremental(StnSolverMode::kIncremental);
+  std::vector<TestVertex> vertices;
+  for (int i = 0; i < 5; i++) {
+    vertices.push_back(TestVertex{"v" + std::to_string(i)});
+  }
+
+  for (auto *stn : {&floyd_warshall, &incremental}) {
+    for (size_t i = 0; i < vertices.size(); i++) {
+      stn->addVertex(vertices[i]);
+      stn->addUnaryConstraint(vertices[i], 10 * (i + 1), 100 + 10 * i);
+    }
+  }
+  requireEquivalentSolutions(floyd_warshall, incremental);
+
+  const auto distances = incremental.getDistanceGraph();
+  TestVertex inserted{"inserted"};
+
+  SECTION("Incremental solves are undone") {
+    for (size_t i = 0; i + 1 < vertices.size(); i++) {
+      incremental.checkpoint();
+      incremental.addVertex(inserted);
+      incremental.addBinaryConstraint(vertices[i], inserted, 5, std::nullopt);
+      incremental.addBinaryConstraint(inserted, vertices[i + 1], 5, std::nullopt);
+      REQUIRE(incremental.solve());
+      incremental.rollback();
+
+      REQUIRE(incremental.getDistanceGraph() == distances);
+    }
+  }
+
+  SECTION("Floyd-Warshall solves are undone") {
+    incremental.checkpoint();
+    incremental.updateLastBinaryConstraint(incremental.getOrigin(), vertices[0], 10, 200);
+    REQUIRE(incremental.solve());
+    REQUIRE(incremental.getDistanceGraph() != distances);
+    incremental.rollback();
+
+    REQUIRE(incremental.getDistanceGraph() == distances);
+  }
+
+  // further incremental solving continues from the restored solution
+  for (auto *stn : {&floyd_warshall, &incremental}) {
+    stn->addBinaryConstraint(vertices[0], vertices[1], 15, std::nullopt);
+  }
+  requireEquivalentSolutions(floyd_warshall, incremental);
+}
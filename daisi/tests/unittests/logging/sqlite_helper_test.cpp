@@ -0,0 +1,103 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "logging/sqlite/sqlite_helper.h"
+
+#include <sqlite3.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace daisi;
+
+static const DatabaseTable kNode("Node", {DatabaseColumnInfo{"Id"},
+                                          {"Uuid", "%s", true},
+                                          {"Level", "%u"},
+                                          {"Load", "%f"}});
+
+static const DatabaseTable kConnection("Connection",
+                                       {DatabaseColumnInfo{"Id"},
+                                        {"Timestamp_ms", "%lu", true},
+                                        {"NodeId", "sql%u", true, "Node(Id)", false, "Uuid"}});
+
+// Runs the query on the database and returns the first column of all rows as text
+std::vector<std::string> query(const std::string &file, const std::string &statement) {
+  sqlite3 *db = nullptr;
+  REQUIRE(sqlite3_open(file.c_str(), &db) == SQLITE_OK);
+
+  std::vector<std::string> result;
+  sqlite3_stmt *prepared = nullptr;
+  REQUIRE(sqlite3_prepare_v2(db, statement.c_str(), -1, &prepared, nullptr) == SQLITE_OK);
+  while (sqlite3_step(prepared) == SQLITE_ROW) {
+    const auto *text = sqlite3_column_text(prepared, 0);
+    result.emplace_back(text == nullptr ? "NULL" : reinterpret_cast<const char *>(text));
+  }
+  sqlite3_finalize(prepared);
+  sqlite3_close(db);
+  return result;
+}
+
+TEST_CASE("Prepared insert statement", "[sqlite_helper]") {
+  CHECK(getPreparedInsertStatement(kNode) == "INSERT INTO Node VALUES(NULL,?,?,?);");
+  CHECK(getPreparedInsertStatement(kConnection) ==
+        "INSERT INTO Connection VALUES(NULL,?,(SELECT Id FROM Node WHERE Uuid=?));");
+  CHECK(getLookupTables(kConnection) == std::vector<std::string>{"Node"});
+
+  DatabaseRow row = toDatabaseRow(std::make_tuple(std::string("a"), 3U, 0.5, nullptr));
+  CHECK(row == DatabaseRow{std::string("a"), int64_t{3}, 0.5, std::monostate{}});
+}
+
+TEST_CASE("Batched inserts", "[sqlite_helper]") {
+  const std::string path = (std::filesystem::temp_directory_path() / "daisi_sqlite_test/").string();
+  const std::string name = "sqlite_helper_test.db";
+  std::filesystem::remove(path + name);
+
+  {
+    SQLiteHelper helper(path, name);
+    helper.execute(getCreateTableStatement(kNode));
+    helper.execute(getCreateTableStatement(kConnection));
+
+    // Connections are inserted first, but require the nodes for the lookup of their id
+    for (uint32_t i = 0; i < 2500; i++) {
+      helper.insert(kConnection, toDatabaseRow(std::make_tuple(i, "node" + std::to_string(i))));
+      helper.insert(kNode, toDatabaseRow(std::make_tuple("node" + std::to_string(i), i / 100,
+                                                         0.25 * i)));
+    }
+
+    // Missing values are NULL
+    helper.insert(kNode, {std::string("uninitialized")});
+
+    // Statements are executed after the rows inserted before
+    helper.execute("UPDATE Node SET Level=42 WHERE Uuid='node0';");
+  }
+
+  const std::string file = path + name;
+  CHECK(query(file, "SELECT COUNT(*) FROM Node;") == std::vector<std::string>{"2501"});
+  CHECK(query(file, "SELECT COUNT(*) FROM Connection WHERE NodeId IS NOT NULL;") ==
+        std::vector<std::string>{"2500"});
+  CHECK(query(file, "SELECT Node.Uuid FROM Connection JOIN Node ON NodeId = Node.Id WHERE "
+                    "Timestamp_ms = 1234;") == std::vector<std::string>{"node1234"});
+  CHECK(query(file, "SELECT Level FROM Node WHERE Uuid='node0';") ==
+        std::vector<std::string>{"42"});
+  CHECK(query(file, "SELECT Load FROM Node WHERE Uuid='node10';") ==
+        std::vector<std::string>{"2.5"});
+  CHECK(query(file, "SELECT Level FROM Node WHERE Uuid='uninitialized';") ==
+        std::vector<std::string>{"NULL"});
+
+  std::filesystem::remove(file);
+}
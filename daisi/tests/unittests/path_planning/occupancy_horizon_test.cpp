@@ -0,0 +1,103 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "path_planning/consensus/occupancy_horizon.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+
+#include "path_planning/consensus/route_calculation_helper.h"
+
+using namespace daisi::path_planning;
+using namespace daisi::path_planning::consensus;
+
+TEST_CASE("Occupancies before the horizon are evicted", "[occupancy horizon]") {
+  const double delta = 0.5;
+  OccupancyHorizon horizon(2.0, delta);
+  IntersectionOccupancy occupancy{{{1, 1}, {}}, {{2, 2}, {}}};
+  OccupancyIntervalIndex index(delta);
+
+  for (double time : {1.0, 5.0, 7.6, 8.0, 12.0}) {
+    occupancy[{1, 1}][time] = 0;
+    index.addOccupancy({1, 1}, time);
+  }
+  occupancy[{2, 2}][3.0] = 0;
+  index.addOccupancy({2, 2}, 3.0);
+
+  // Horizon at 8.0: Blocked windows ending before are evicted, 7.6 still blocks until 8.1
+  REQUIRE(horizon.getHorizon(10.0) == 8.0);
+  REQUIRE(horizon.sweep(10.0, occupancy, index) == 3);
+
+  REQUIRE(occupancy.at({1, 1}).size() == 3);
+  REQUIRE(occupancy.at({1, 1}).count(7.6) == 1);
+  REQUIRE(occupancy.at({2, 2}).empty());
+  REQUIRE(index.getNumberOfIntervals() == 2);
+  REQUIRE(index.isBlocked({1, 1}, 8.4));
+  REQUIRE_FALSE(index.isBlocked({1, 1}, 5.0));
+  REQUIRE_FALSE(index.isBlocked({2, 2}, 3.0));
+}
+
+TEST_CASE("Sweeps are amortized over the added occupancies", "[occupancy horizon]") {
+  const double delta = 0.5;
+  OccupancyHorizon horizon(1.0, delta);
+  IntersectionOccupancy occupancy;
+  OccupancyIntervalIndex index(delta);
+
+  // Constant number of live occupancies per time while the time advances
+  uint32_t sweeps = 0;
+  std::size_t max_intervals = 0;
+  for (uint32_t i = 0; i < 100000; i++) {
+    const double now = i * 0.01;
+    const Intersection intersection = {static_cast<float>(i % 10), 0};
+    occupancy[intersection][now + 2.0] = 0;
+    index.addOccupancy(intersection, now + 2.0);
+
+    horizon.notifyAdded();
+    if (horizon.isSweepDue()) {
+      horizon.sweep(now, occupancy, index);
+      sweeps++;
+    }
+    max_intervals = std::max(max_intervals, index.getNumberOfIntervals());
+  }
+
+  REQUIRE(sweeps > 100);
+  REQUIRE(sweeps < 100000 / 256 + 1);
+  REQUIRE(max_intervals < 1000);
+
+  // Start times are still found with the pruned occupancies
+  PointTimePairs points = {{{0, 0}, 0.0}};
+  const double start = RouteCalculationHelper::calculatePossibleStartTime(points, 999.0, 10.0,
+                                                                          index);
+  REQUIRE(start >= 999.0);
+  REQUIRE_FALSE(index.isBlocked({0, 0}, start));
+}
+
+TEST_CASE("Blocked intervals are evicted without occupancies", "[occupancy horizon]") {
+  const double delta = 0.5;
+  OccupancyHorizon horizon(2.0, delta);
+  OccupancyIntervalIndex index(delta);
+
+  for (double time : {1.0, 5.0, 7.6, 12.0}) {
+    index.addOccupancy({1, 1}, time);
+  }
+  REQUIRE(horizon.sweepIfDue(10.0, index) == 0);
+
+  horizon.notifyAdded(256);
+  REQUIRE(horizon.sweepIfDue(10.0, index) == 2);
+  REQUIRE(index.getNumberOfIntervals() == 2);
+  REQUIRE(index.isBlocked({1, 1}, 8.0));
+  REQUIRE_FALSE(horizon.isSweepDue());
+}
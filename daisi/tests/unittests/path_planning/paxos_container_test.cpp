@@ -0,0 +1,134 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "path_planning/consensus/paxos/paxos_data.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ns3/simulator.h"
+#include "path_planning/intersection_set.h"
+#include "path_planning/path_planning_logger_ns_3.h"
+
+using namespace daisi::path_planning;
+using namespace daisi::path_planning::consensus;
+
+TEST_CASE("Restoring a snapshot rebuilds the occupancy horizon", "[paxos container]") {
+  getAllIntersections().insert(ns3::Vector2D(1, 1));
+  getAllIntersections().insert(ns3::Vector2D(2, 2));
+
+  PaxosSettings settings;
+  settings.replication = false;
+  settings.number_paxos_participants = 2;
+  settings.time_delta_intersections = 0.5;
+  settings.max_preplanning_time = 5.0;
+  settings.occupancy_retention = 10.0;
+
+  auto logger = std::make_shared<PathPlanningLoggerNs3>(
+      [](const std::string & /*app*/) {}, [](const std::string & /*sql*/) {},
+      [](const auto & /*table*/, auto /*row*/) {});
+  PaxosContainer container(
+      [](const std::string & /*topic*/, const std::string & /*message*/) {}, 1, settings, logger);
+
+  // Occupancies of decided instances which are replaced by the snapshot
+  for (uint32_t instance = 0; instance < 200; instance++) {
+    container.decideInstance(instance, 2, {{{{1, 1}, 100.0 + instance}}});
+  }
+  REQUIRE(container.getAgreedOccupancies().size() == 200);
+
+  // Snapshot with occupancies far behind the horizon and some ahead of it
+  std::vector<IntersectionTimeInfo> occupancies;
+  for (uint32_t i = 0; i < 300; i++) {
+    occupancies.push_back({{2, 2}, -1000.0 + i});
+  }
+  occupancies.push_back({{2, 2}, 50.0});
+  occupancies.push_back({{1, 1}, 60.0});
+  container.restoreSnapshot(500, occupancies);
+
+  // Passed occupancies of the snapshot are evicted right away and the sweeps start over
+  REQUIRE(container.decided_instances.getNextInstance() == 500);
+  REQUIRE(container.getAgreedOccupancies().size() == 2);
+  REQUIRE(container.agreed_intervals.getNumberOfIntervals() == 2);
+  REQUIRE_FALSE(container.agreed_horizon.isSweepDue());
+
+  // Added occupancies are counted from the restored state
+  for (uint32_t instance = 500; instance < 500 + 255; instance++) {
+    container.decideInstance(instance, 2, {{{{1, 1}, 100.0 + instance}}});
+  }
+  REQUIRE_FALSE(container.agreed_horizon.isSweepDue());
+  container.agreed_horizon.notifyAdded();
+  REQUIRE(container.agreed_horizon.isSweepDue());
+
+  ns3::Simulator::Destroy();
+}
+
+TEST_CASE("Instances learned while catching up replay the outcome of the sender",
+          "[paxos container]") {
+  getAllIntersections().insert(ns3::Vector2D(1, 1));
+  getAllIntersections().insert(ns3::Vector2D(2, 2));
+
+  PaxosSettings settings;
+  settings.replication = false;
+  settings.number_paxos_participants = 2;
+  settings.time_delta_intersections = 0.5;
+  settings.max_preplanning_time = 5.0;
+  settings.occupancy_retention = 10.0;
+
+  auto logger = std::make_shared<PathPlanningLoggerNs3>(
+      [](const std::string & /*app*/) {}, [](const std::string & /*sql*/) {},
+      [](const auto & /*table*/, auto /*row*/) {});
+  PaxosContainer sender(
+      [](const std::string & /*topic*/, const std::string & /*message*/) {}, 1, settings, logger);
+  PaxosContainer lagging(
+      [](const std::string & /*topic*/, const std::string & /*message*/) {}, 2, settings, logger);
+
+  std::vector<bool> lagging_applied;
+  lagging.instance_applied_cb = [&lagging_applied](InstanceID /*instance*/,
+                                                   const DecidedInstance &entry) {
+    lagging_applied = entry.applied;
+  };
+
+  // The sender rejects the second route of instance 1, which conflicts with instance 0
+  sender.decideInstance(0, 1, {{{{1, 1}, 1.0}}});
+  sender.decideInstance(1, 2, {{{{2, 2}, 1.0}}, {{{1, 1}, 1.2}}});
+  const DecidedInstance *second = sender.decided_instances.find(1);
+  REQUIRE(second != nullptr);
+  REQUIRE(second->applied == std::vector<bool>{true, false});
+
+  // The lagging participant decided instance 1 already, but applies it long after its own clock
+  // pruned the occupancies of instance 0
+  lagging.decideInstance(0, 1, {{{{1, 1}, 1.0}}});
+  lagging.decideInstance(2, 1, {{{{2, 2}, 5.0}}});
+  lagging.agreed_horizon.sweep(100.0, lagging.agreed_data, lagging.agreed_intervals);
+  REQUIRE(lagging.getAgreedOccupancies().empty());
+
+  // Checking the routes again would apply the conflicting route, the replay rejects it
+  lagging.learnAppliedInstance(1, *second);
+  REQUIRE(lagging.decided_instances.getNextInstance() == 3);
+  REQUIRE(lagging.decided_instances.find(1)->applied == std::vector<bool>{true, false});
+  REQUIRE(lagging.agreed_data.at({2, 2}).size() == 2);
+  REQUIRE(lagging.agreed_data.count({1, 1}) == 1);
+  REQUIRE(lagging.agreed_data.at({1, 1}).empty());
+  REQUIRE(lagging_applied == std::vector<bool>{true});
+
+  // Instances which are applied already are not replaced
+  lagging.learnAppliedInstance(1, DecidedInstance{1, {{{{1, 1}, 1.2}}}, {true}});
+  REQUIRE(lagging.decided_instances.find(1)->station_id == 2);
+
+  ns3::Simulator::Destroy();
+}
@@ -0,0 +1,116 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "path_planning/consensus/paxos/paxos_log.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace daisi::path_planning::consensus;
+
+TEST_CASE("Decided instances are retained up to the limit", "[paxos log]") {
+  PaxosLog<uint32_t> log(3);
+  REQUIRE(log.getNextInstance() == 0);
+  REQUIRE(log.getLatest() == nullptr);
+
+  for (uint32_t instance = 0; instance < 10; instance++) {
+    log.decide(instance, instance * 10);
+    REQUIRE(log.getNextInstance() == instance + 1);
+    REQUIRE(*log.getLatest() == instance * 10);
+    REQUIRE(log.getNumberOfEntries() <= 3);
+  }
+
+  REQUIRE(log.getSnapshotInstance() == 7);
+  for (uint32_t instance = 0; instance < 7; instance++) {
+    REQUIRE(log.isDecided(instance));
+    REQUIRE(log.isFolded(instance));
+    REQUIRE(log.find(instance) == nullptr);
+  }
+  for (uint32_t instance = 7; instance < 10; instance++) {
+    REQUIRE(log.isDecided(instance));
+    REQUIRE_FALSE(log.isFolded(instance));
+    REQUIRE(*log.find(instance) == instance * 10);
+  }
+  REQUIRE_FALSE(log.isDecided(10));
+
+  std::vector<uint32_t> entries;
+  log.forEachEntry(8, [&entries](InstanceID /*instance*/, uint32_t entry) {
+    entries.push_back(entry);
+  });
+  REQUIRE(entries == std::vector<uint32_t>{80, 90});
+}
+
+TEST_CASE("Instances decided out of order", "[paxos log]") {
+  PaxosLog<uint32_t> log(4);
+
+  log.decide(0, 0);
+  log.decide(2, 20);
+  log.decide(3, 30);
+  REQUIRE(log.getNextInstance() == 1);
+  REQUIRE_FALSE(log.isDecided(1));
+  REQUIRE(log.isDecided(2));
+
+  // Only decided instances up to the first gap are visited
+  std::vector<InstanceID> instances;
+  log.forEachEntry(0, [&instances](InstanceID instance, uint32_t /*entry*/) {
+    instances.push_back(instance);
+  });
+  REQUIRE(instances == std::vector<InstanceID>{0});
+
+  log.decide(1, 10);
+  REQUIRE(log.getNextInstance() == 4);
+  REQUIRE(*log.getLatest() == 30);
+}
+
+TEST_CASE("Gaps are folded once they leave the retained instances", "[paxos log]") {
+  PaxosLog<uint32_t> log(2);
+
+  log.decide(1, 10);
+  log.decide(2, 20);
+  REQUIRE(log.getNextInstance() == 0);
+
+  log.decide(3, 30);
+  REQUIRE(log.getSnapshotInstance() == 2);
+  REQUIRE(log.getNextInstance() == 4);
+  REQUIRE(log.isDecided(0));
+  REQUIRE(log.getNumberOfEntries() == 2);
+}
+
+TEST_CASE("Restore a snapshot of another participant", "[paxos log]") {
+  PaxosLog<uint32_t> log(5);
+  log.decide(0, 0);
+  log.decide(1, 10);
+  log.decide(6, 60);
+
+  log.restoreSnapshot(5);
+  REQUIRE(log.getSnapshotInstance() == 5);
+  REQUIRE(log.getNextInstance() == 5);
+  REQUIRE(log.isFolded(1));
+  REQUIRE(log.find(1) == nullptr);
+  REQUIRE(*log.find(6) == 60);
+  REQUIRE(log.getNumberOfEntries() == 1);
+
+  // Older snapshots are ignored
+  log.restoreSnapshot(3);
+  REQUIRE(log.getSnapshotInstance() == 5);
+  REQUIRE(log.getNextInstance() == 5);
+
+  log.decide(5, 50);
+  REQUIRE(log.getNextInstance() == 7);
+  log.decide(7, 70);
+  REQUIRE(log.getNextInstance() == 8);
+  REQUIRE(*log.getLatest() == 70);
+}
@@ -0,0 +1,169 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "path_planning/consensus/paxos/paxos_proposer.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ns3/simulator.h"
+#include "path_planning/intersection_set.h"
+#include "path_planning/path_planning_logger_ns_3.h"
+
+using namespace daisi::path_planning;
+using namespace daisi::path_planning::consensus;
+
+TEST_CASE("Decided proposal times out before the gap to it is filled", "[paxos proposer]") {
+  getAllIntersections().insert(ns3::Vector2D(1, 1));
+  getAllIntersections().insert(ns3::Vector2D(2, 2));
+
+  PaxosSettings settings;
+  settings.replication = false;
+  settings.number_paxos_participants = 2;
+  settings.time_delta_intersections = 0.5;
+  settings.max_preplanning_time = 5.0;
+
+  auto logger = std::make_shared<PathPlanningLoggerNs3>(
+      [](const std::string & /*app*/) {}, [](const std::string & /*sql*/) {},
+      [](const auto & /*table*/, auto /*row*/) {});
+  std::vector<std::string> published;
+  auto container = std::make_shared<PaxosContainer>(
+      [&published](const std::string & /*topic*/, const std::string &message) {
+        published.push_back(message);
+      },
+      1, settings, logger);
+
+  uint32_t catch_up_requests = 0;
+  container->request_catch_up_cb = [&catch_up_requests]() { catch_up_requests++; };
+
+  PaxosProposer proposer(container);
+
+  bool first_failed = false;
+  proposer.findConsensus(
+      {{{1, 1}, 0.0}}, 1.0, [](uint32_t /*instance*/, double /*start*/) { FAIL(); },
+      [&first_failed](uint32_t /*unused*/) { first_failed = true; });
+
+  std::optional<uint32_t> second_instance;
+  bool second_failed = false;
+  proposer.findConsensus(
+      {{{2, 2}, 0.0}}, 1.0,
+      [&second_instance](uint32_t instance, double /*start*/) { second_instance = instance; },
+      [&second_failed](uint32_t /*unused*/) { second_failed = true; });
+
+  // The second route is decided in instance 1, while instance 0 is still open
+  proposer.processPromiseMessage({1, 0, 1});
+  proposer.processOKMessage({1, 0, 1, 2});
+  proposer.processResponseMessage({1, 0, 1});
+  REQUIRE(container->isDecided(1));
+  REQUIRE_FALSE(container->isDecided(0));
+
+  // Both proposals time out
+  ns3::Simulator::Stop(ns3::MilliSeconds(600));
+  ns3::Simulator::Run();
+
+  REQUIRE(first_failed);
+  REQUIRE_FALSE(second_failed);
+  REQUIRE_FALSE(second_instance.has_value());
+  REQUIRE(catch_up_requests > 0);
+
+  // Another participant decided instance 0, which closes the gap
+  container->decideInstance(0, 2, {{{{1, 1}, 10.0}}});
+
+  REQUIRE(second_instance == 1);
+  REQUIRE_FALSE(second_failed);
+  REQUIRE(container->agreed_data.at({2, 2}).size() == 1);
+  REQUIRE(container->agreed_data.at({2, 2}).begin()->second == 1);
+
+  ns3::Simulator::Destroy();
+}
+
+TEST_CASE("Accepted proposal times out while OKs are outstanding", "[paxos proposer]") {
+  getAllIntersections().insert(ns3::Vector2D(1, 1));
+  getAllIntersections().insert(ns3::Vector2D(2, 2));
+
+  PaxosSettings settings;
+  settings.replication = false;
+  settings.number_paxos_participants = 2;
+  settings.time_delta_intersections = 0.5;
+  settings.max_preplanning_time = 5.0;
+
+  auto logger = std::make_shared<PathPlanningLoggerNs3>(
+      [](const std::string & /*app*/) {}, [](const std::string & /*sql*/) {},
+      [](const auto & /*table*/, auto /*row*/) {});
+  std::vector<std::string> published;
+  auto container = std::make_shared<PaxosContainer>(
+      [&published](const std::string & /*topic*/, const std::string &message) {
+        published.push_back(message);
+      },
+      1, settings, logger);
+
+  uint32_t catch_up_requests = 0;
+  container->request_catch_up_cb = [&catch_up_requests]() { catch_up_requests++; };
+
+  PaxosProposer proposer(container);
+
+  std::optional<uint32_t> first_instance;
+  bool first_failed = false;
+  proposer.findConsensus(
+      {{{1, 1}, 0.0}}, 1.0,
+      [&first_instance](uint32_t instance, double /*start*/) { first_instance = instance; },
+      [&first_failed](uint32_t /*unused*/) { first_failed = true; });
+
+  bool second_succeeded = false;
+  bool second_failed = false;
+  proposer.findConsensus(
+      {{{2, 2}, 0.0}}, 1.0,
+      [&second_succeeded](uint32_t /*instance*/, double /*start*/) { second_succeeded = true; },
+      [&second_failed](uint32_t /*unused*/) { second_failed = true; });
+
+  // Both routes are sent to the acceptors, but their OKs do not reach us
+  proposer.processPromiseMessage({0, 0, 1});
+  proposer.processPromiseMessage({1, 0, 1});
+  REQUIRE_FALSE(container->isDecided(0));
+  REQUIRE_FALSE(container->isDecided(1));
+
+  // The acceptors might have decided the routes, so the timeout must not report a failure
+  const std::size_t published_before_timeout = published.size();
+  ns3::Simulator::Stop(ns3::MilliSeconds(600));
+  ns3::Simulator::Run();
+
+  REQUIRE_FALSE(first_failed);
+  REQUIRE_FALSE(first_instance.has_value());
+  REQUIRE_FALSE(second_failed);
+  REQUIRE_FALSE(second_succeeded);
+  REQUIRE(catch_up_requests > 0);
+  // Both routes are prepared again
+  REQUIRE(published.size() == published_before_timeout + 2);
+
+  // The acceptors decided our first route, but another route in the second instance
+  container->decideInstance(0, 1, {{{{1, 1}, 1.0}}});
+  container->decideInstance(1, 2, {{{{2, 2}, 10.0}}});
+  REQUIRE(second_failed);
+  REQUIRE_FALSE(second_succeeded);
+
+  // The responses of the acceptors are missing, the next timeout finishes the first proposal
+  ns3::Simulator::Stop(ns3::MilliSeconds(600));
+  ns3::Simulator::Run();
+
+  REQUIRE(first_instance == 0);
+  REQUIRE_FALSE(first_failed);
+  REQUIRE(container->agreed_data.at({1, 1}).size() == 1);
+
+  ns3::Simulator::Destroy();
+}
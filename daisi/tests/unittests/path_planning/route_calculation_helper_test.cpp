@@ -0,0 +1,145 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "path_planning/consensus/route_calculation_helper.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace daisi::path_planning;
+using namespace daisi::path_planning::consensus;
+
+// Previous implementation, probing start times in steps of 1 ms
+double calculatePossibleStartTimeBruteForce(const PointTimePairs &points,
+                                            double initial_start_time,
+                                            double max_preplanning_time_s,
+                                            double time_between_intersections_s,
+                                            const IntersectionOccupancy &intersection_occupancy) {
+  const double delta_s = 0.001;
+  const int retries = static_cast<int>(max_preplanning_time_s) / delta_s;
+  for (int i = 0; i < retries; i++) {
+    const double start_time = initial_start_time + delta_s * i;
+    bool possible = true;
+    for (const auto &[position, relative_time] : points) {
+      auto it = intersection_occupancy.find({position.x, position.y});
+      if (it == intersection_occupancy.end()) continue;
+      for (const auto &[time, id] : it->second) {
+        if (std::abs(time - (start_time + relative_time)) <= time_between_intersections_s) {
+          possible = false;
+        }
+      }
+    }
+    if (possible) return start_time;
+  }
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+void requireSameStartTime(double expected, double actual) {
+  if (std::isnan(expected)) {
+    REQUIRE(std::isnan(actual));
+  } else {
+    REQUIRE(std::abs(expected - actual) < 1e-9);
+  }
+}
+
+TEST_CASE("Start time without and with occupancies", "[start time]") {
+  const PointTimePairs points = {{{0, 0}, 0}, {{10, 0}, 10}, {{10, 10}, 20}};
+  IntersectionOccupancy occupancy;
+  OccupancyIntervalIndex index(1);
+
+  REQUIRE(RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, 1, occupancy) == 5);
+  REQUIRE(RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, index) == 5);
+
+  // (10, 0) is occupied at 15.5, so the route must reach it after 16.5
+  occupancy[{10, 0}][15.5] = 1;
+  index.addOccupancy({10, 0}, 15.5);
+  requireSameStartTime(
+      6.501, RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, 1, occupancy));
+  requireSameStartTime(
+      6.501, RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, index));
+
+  // adjacent blocked intervals are merged
+  occupancy[{10, 10}][27.5] = 2;
+  index.addOccupancy({10, 10}, 27.5);
+  requireSameStartTime(
+      8.501, RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, 1, occupancy));
+  requireSameStartTime(
+      8.501, RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, index));
+  REQUIRE(index.isBlocked({10, 10}, 26.5));
+  REQUIRE(!index.isBlocked({10, 10}, 28.6));
+
+  // no start time within the preplanning time
+  REQUIRE(
+      std::isnan(RouteCalculationHelper::calculatePossibleStartTime(points, 5, 1, 1, occupancy)));
+  REQUIRE(std::isnan(RouteCalculationHelper::calculatePossibleStartTime(points, 5, 1, index)));
+}
+
+TEST_CASE("Start time equals probing every millisecond", "[start time]") {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> intersection(0, 4);
+  std::uniform_real_distribution<double> time(0, 30);
+
+  for (int run = 0; run < 20; run++) {
+    const double delta = run % 2 == 0 ? 0.5 : 2;
+    IntersectionOccupancy occupancy;
+    OccupancyIntervalIndex index(delta);
+    for (int i = 0; i < 40; i++) {
+      const Intersection occupied(intersection(gen) * 10, 0);
+      const double occupied_at = std::round(time(gen) * 1000) / 1000;
+      occupancy[occupied][occupied_at] = i;
+      index.addOccupancy(occupied, occupied_at);
+    }
+
+    PointTimePairs points;
+    double relative_time = 0;
+    for (int i = 0; i < 4; i++) {
+      points.push_back({{intersection(gen) * 10.0, 0}, relative_time});
+      relative_time += std::round(time(gen) * 100) / 1000;
+    }
+
+    const double initial_start_time = std::round(time(gen) * 1000) / 1000;
+    const double expected =
+        calculatePossibleStartTimeBruteForce(points, initial_start_time, 20, delta, occupancy);
+
+    requireSameStartTime(expected, RouteCalculationHelper::calculatePossibleStartTime(
+                                       points, initial_start_time, 20, delta, occupancy));
+    requireSameStartTime(expected, RouteCalculationHelper::calculatePossibleStartTime(
+                                       points, initial_start_time, 20, index));
+  }
+}
+
+TEST_CASE("Start time with occupancies split over several indices", "[start time]") {
+  const PointTimePairs points = {{{0, 0}, 0}, {{10, 0}, 10}, {{10, 10}, 20}};
+  IntersectionOccupancy occupancy;
+  OccupancyIntervalIndex agreed(1);
+  OccupancyIntervalIndex running(1);
+
+  REQUIRE(RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60,
+                                                             {&agreed, &running}) == 5);
+
+  // The same start time as with all occupancies in one index
+  occupancy[{10, 0}][15.5] = 1;
+  agreed.addOccupancy({10, 0}, 15.5);
+  occupancy[{10, 10}][27.5] = 2;
+  running.addOccupancy({10, 10}, 27.5);
+  requireSameStartTime(
+      RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, 1, occupancy),
+      RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, {&agreed, &running}));
+  requireSameStartTime(
+      6.501, RouteCalculationHelper::calculatePossibleStartTime(points, 5, 60, {&agreed}));
+}
@@ -0,0 +1,66 @@
+// Copyright 2023 The SOLA authors
+//
+// This file is part of DAISI.
+//
+// DAISI is free software: you can redistribute it and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation; version 2.
+//
+// DAISI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with DAISI. If not, see
+// <https://www.gnu.org/licenses/>.
+//
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include "path_planning/consensus/central/sharded_occupancy.h"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+using namespace daisi::path_planning;
+using namespace daisi::path_planning::consensus;
+
+TEST_CASE("Intersections of a region belong to the same shard", "[sharded occupancy]") {
+  ShardedOccupancy occupancy(4, 10.0, 0.5, 10.0);
+  REQUIRE(occupancy.getNumberOfShards() == 4);
+
+  REQUIRE(occupancy.getShard({1, 1}) == occupancy.getShard({9.5, 0}));
+  REQUIRE(occupancy.getShard({-1, -1}) == occupancy.getShard({-9.5, -0.5}));
+
+  PointTimePairs points = {{{1, 1}, 0.0}, {{9, 1}, 1.0}, {{15, 1}, 2.0}, {{25, 1}, 3.0}};
+  auto shards = occupancy.getShards(points);
+  REQUIRE(std::is_sorted(shards.begin(), shards.end()));
+  REQUIRE(std::adjacent_find(shards.begin(), shards.end()) == shards.end());
+  for (const auto &[position, relative_time] : points) {
+    auto shard = occupancy.getShard({position.x, position.y});
+    REQUIRE(std::find(shards.begin(), shards.end(), shard) != shards.end());
+  }
+}
+
+TEST_CASE("Routes spanning several shards do not conflict", "[sharded occupancy]") {
+  const double delta = 0.5;
+  ShardedOccupancy occupancy(3, 5.0, delta, 10.0);
+
+  PointTimePairs first = {{{1, 1}, 0.0}, {{11, 1}, 1.0}, {{21, 1}, 2.0}};
+  auto first_shards = occupancy.getShards(first);
+  double first_start = occupancy.calculatePossibleStartTime(first, first_shards, 10.0, 5.0);
+  REQUIRE(first_start == 10.0);
+  occupancy.reserve(first, first_shards, first_start, 0.0);
+
+  for (const auto &[position, relative_time] : first) {
+    const Intersection intersection = {position.x, position.y};
+    REQUIRE(occupancy.getIntervals(occupancy.getShard(intersection))
+                .isBlocked(intersection, first_start + relative_time));
+  }
+
+  // Reaches the last intersection of the first route at the same time
+  PointTimePairs second = {{{16, 1}, 0.0}, {{21, 1}, 2.0}};
+  auto second_shards = occupancy.getShards(second);
+  double second_start = occupancy.calculatePossibleStartTime(second, second_shards, 10.0, 5.0);
+  REQUIRE_FALSE(std::isnan(second_start));
+  REQUIRE(second_start > first_start + delta);
+  REQUIRE(second_start < first_start + delta + 0.01);
+}
@@ -0,0 +1,156 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minhton/algorithms/esearch/attribute_index.h"
+#include "minhton/algorithms/esearch/distributed_data.h"
+#include "minhton/algorithms/esearch/find_query.h"
+#include "minhton/algorithms/esearch/key_table.h"
+
+/**
+ * Compares how a DSN finds the true and the undecided nodes of its cover area for a find query,
+ * with 1000 covered nodes with 50 attributes each: Evaluating the query for every node (as done
+ * before) against evaluating only the candidates found with the attribute index.
+ * Also measures the cost of keeping the index up to date.
+ */
+
+using namespace minhton;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Function> double measure(uint32_t iterations, Function &&function) {
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < iterations; i++) function();
+  auto end = Clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+  const uint32_t iterations = argc > 1 ? std::stoul(argv[1]) : 200;
+  const uint32_t node_count = 1000;
+  const uint64_t timestamp_now = 1000;
+
+  // Selective queries on rare attributes, and broad ones on attributes every node has
+  const std::vector<std::string> queries{
+      "( HAS topic/transport )",
+      "(( HAS topic/transport ) AND ( battery >= 0.8 ))",
+      "(( zone == hall2 ) AND ( payload <= 20.5 ))",
+      "(( HAS ability/lift ) OR ( zone == hall7 ))",
+      "(( battery >= 0.5 ) AND ( NOT ( state == busy )))",
+  };
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+
+  std::vector<DistributedData> cover_data(node_count);
+  AttributeIndex index;
+  CompiledExpression::Batch batch;
+  for (auto &distr_data : cover_data) {
+    const auto slot = index.addSlot();
+    batch.push_back(&distr_data);
+
+    auto insert = [&](const NodeData::Key &key, const NodeData::Value &value, uint64_t timestamp) {
+      distr_data.insert(key, {value, timestamp, NodeData::ValueType::kValueDynamic});
+      index.setValue(slot, KeyTable::intern(key),
+                     {value, timestamp, NodeData::ValueType::kValueDynamic});
+    };
+
+    for (int i = 0; i < 44; i++) {
+      insert("attribute" + std::to_string(i), static_cast<int>(rng() % 100), 1000);
+    }
+    insert("battery", unit(rng), 900 + rng() % 200);
+    insert("payload", unit(rng) * 50, 1000);
+    insert("state", std::string(rng() % 4 ? "idle" : "busy"), 1000);
+    insert("zone", "hall" + std::to_string(rng() % 10), 1000);
+    if (rng() % 20 == 0) insert("topic/transport", true, 1000);
+    if (rng() % 50 == 0) insert("ability/lift", true, 1000);
+  }
+
+  std::cout << std::setw(7) << "query" << std::setw(7) << "true" << std::setw(12) << "undecided"
+            << std::setw(12) << "candidates" << std::setw(11) << "scan us" << std::setw(14)
+            << "indexed us" << std::endl
+            << std::fixed << std::setprecision(2);
+
+  for (std::size_t i = 0; i < queries.size(); i++) {
+    FindQuery query(queries[i], "all");
+    query.setValidityThreshold(50);
+
+    std::size_t true_count = 0;
+    std::size_t undecided_count = 0;
+    std::size_t candidate_count = 0;
+
+    const double scan = measure(iterations, [&]() {
+      true_count = 0;
+      for (const auto &value : query.evaluate(batch, true, timestamp_now)) {
+        true_count += value.isTrue();
+      }
+
+      CompiledExpression::Batch undecided;
+      const auto values = query.evaluate(batch, false, timestamp_now);
+      for (std::size_t j = 0; j < batch.size(); j++) {
+        if (values[j].isUndecided()) undecided.push_back(batch[j]);
+      }
+      undecided_count = query.evaluateMissingAttributes(undecided, timestamp_now).size();
+    });
+
+    const double indexed = measure(iterations, [&]() {
+      auto evaluate_candidates = [&](FuzzyValue value, bool all_information_present) {
+        CompiledExpression::Batch candidates;
+        query.getCandidates(index, value, all_information_present, timestamp_now)
+            .forEach([&](AttributeIndex::Slot slot) { candidates.push_back(batch[slot]); });
+        candidate_count += candidates.size();
+
+        CompiledExpression::Batch matching;
+        const auto values = query.evaluate(candidates, all_information_present, timestamp_now);
+        for (std::size_t j = 0; j < candidates.size(); j++) {
+          if (values[j] == value) matching.push_back(candidates[j]);
+        }
+        return matching;
+      };
+
+      candidate_count = 0;
+      const auto true_nodes = evaluate_candidates(FuzzyValue::createTrue(), true);
+      const auto undecided = evaluate_candidates(FuzzyValue::createUndecided(), false);
+      const auto missing = query.evaluateMissingAttributes(undecided, timestamp_now);
+      if (true_nodes.size() != true_count || missing.size() != undecided_count) {
+        std::cerr << "Different results for " << queries[i] << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    });
+
+    std::cout << std::setw(7) << i << std::setw(7) << true_count << std::setw(12)
+              << undecided_count << std::setw(12) << candidate_count << std::setw(11) << scan
+              << std::setw(14) << indexed << std::endl;
+  }
+
+  // Maintenance: one attribute update of a node as done for each inquiry answer
+  const auto battery = KeyTable::intern("battery");
+  const auto zone = KeyTable::intern("zone");
+  uint32_t update = 0;
+  const double numeric_update = measure(iterations * 100, [&]() {
+    update++;
+    index.setValue(update % node_count, battery,
+                   {unit(rng), timestamp_now + update, NodeData::ValueType::kValueDynamic});
+  });
+  const double string_update = measure(iterations * 100, [&]() {
+    update++;
+    index.setValue(update % node_count, zone,
+                   {"hall" + std::to_string(update % 10), timestamp_now + update,
+                    NodeData::ValueType::kValueDynamic});
+  });
+  std::cout << std::endl
+            << "numeric update us " << numeric_update << ", string update us " << string_update
+            << std::endl;
+
+  return EXIT_SUCCESS;
+}
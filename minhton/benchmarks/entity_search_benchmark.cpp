@@ -0,0 +1,132 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "minhton/algorithms/esearch/minhton_entity_search_algorithm.h"
+#include "minhton/core/access_container.h"
+#include "minhton/message/find_query_answer.h"
+
+/**
+ * Runs many concurrent find queries through the MinhtonEntitySearchAlgorithm of a requesting
+ * node, which keeps the state of each query in its ProcedureInfo: starting the queries, receiving
+ * the answers of several DSNs per query, and concluding all queries at the DSN aggregation
+ * timeout. Reports the time per query of each phase.
+ */
+
+using namespace minhton;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Function>
+double measurePerQuery(uint32_t number_of_queries, Function &&function) {
+  auto start = Clock::now();
+  function();
+  auto end = Clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / number_of_queries;
+}
+
+int main(int argc, char *argv[]) {
+  const uint32_t number_of_queries = argc > 1 ? std::stoul(argv[1]) : 10000;
+  const uint32_t answers_per_query = argc > 2 ? std::stoul(argv[2]) : 4;
+  const uint32_t nodes_per_answer = argc > 3 ? std::stoul(argv[3]) : 8;
+
+  const uint16_t fanout = 2;
+  NodeInfo self(3, 1, fanout, "127.0.0.1", 2000);
+  uint64_t timestamp = 100000;
+
+  auto access = std::make_shared<AccessContainer>();
+  access->routing_info = std::make_shared<RoutingInformation>(self, Logger());
+  access->procedure_info = std::make_shared<ProcedureInfo>();
+  access->send = [](const MessageVariant & /*msg*/) {};
+  access->perform_search_exact = [](const NodeInfo & /*target*/,
+                                    const std::shared_ptr<MessageSEVariant> & /*query*/) {};
+  access->set_timeout = [](TimeoutType /*type*/) {};
+  access->get_timeout_length = [](TimeoutType /*type*/) -> uint16_t { return 1000; };
+  access->get_timestamp = [&timestamp]() { return timestamp; };
+
+  MinhtonEntitySearchAlgorithm algorithm(access);
+
+  // Answers of the DSNs with nodes fulfilling the query, the same for every query
+  std::vector<NodeInfo> dsns;
+  std::vector<NodeData::NodesWithAttributes> answers;
+  for (uint32_t dsn = 0; dsn < answers_per_query; dsn++) {
+    dsns.emplace_back(4, dsn * 3, fanout, "127.0.0.1", 3000 + dsn);
+
+    NodeData::NodesWithAttributes nodes_with_attributes;
+    for (uint32_t node = 0; node < nodes_per_answer; node++) {
+      NodeInfo fulfilling(5, dsn * nodes_per_answer + node, fanout, "127.0.0.1",
+                          4000 + dsn * nodes_per_answer + node);
+      nodes_with_attributes[fulfilling] = {{"topic/transport", true},
+                                           {"load", static_cast<int>(node)}};
+    }
+    answers.push_back(nodes_with_attributes);
+  }
+
+  // The algorithm prints every query
+  std::ostringstream discarded_output;
+  auto *cout_buffer = std::cout.rdbuf(discarded_output.rdbuf());
+
+  std::vector<std::future<FindResult>> futures;
+  futures.reserve(number_of_queries);
+  const double start = measurePerQuery(number_of_queries, [&]() {
+    for (uint32_t i = 0; i < number_of_queries; i++) {
+      futures.push_back(algorithm.find(FindQuery("( HAS topic/transport )", "all")));
+    }
+  });
+
+  std::vector<uint64_t> ref_event_ids;
+  for (auto const &[ref_event_id, start_timestamp] :
+       access->procedure_info->getDSNAggregationStartTimestampMap()) {
+    ref_event_ids.push_back(ref_event_id);
+  }
+
+  const double answer = measurePerQuery(number_of_queries, [&]() {
+    for (auto ref_event_id : ref_event_ids) {
+      for (uint32_t dsn = 0; dsn < answers_per_query; dsn++) {
+        MinhtonMessageHeader header(dsns[dsn], self, ref_event_id);
+        algorithm.process(MessageFindQueryAnswer(header, answers[dsn]));
+      }
+    }
+  });
+
+  timestamp += 500;
+  const double conclude = measurePerQuery(number_of_queries, [&]() {
+    algorithm.processTimeout(TimeoutType::kDsnAggregationTimeout);
+  });
+
+  std::cout.rdbuf(cout_buffer);
+
+  std::size_t results = 0;
+  for (auto &future : futures) {
+    results += future.get().size();
+  }
+  if (results != static_cast<std::size_t>(number_of_queries) * answers_per_query *
+                     nodes_per_answer) {
+    std::cerr << "Unexpected number of results: " << results << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (access->procedure_info->getNumberOfFindQueryStates() != 0) {
+    std::cerr << "States of concluded queries were not removed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << number_of_queries << " concurrent queries, " << answers_per_query
+            << " answers with " << nodes_per_answer << " nodes each" << std::endl
+            << std::setw(12) << "start us" << std::setw(12) << "answer us" << std::setw(14)
+            << "conclude us" << std::endl
+            << std::fixed << std::setprecision(3) << std::setw(12) << start << std::setw(12)
+            << answer << std::setw(14) << conclude << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "minhton/algorithms/esearch/distributed_data.h"
+#include "minhton/algorithms/esearch/find_query.h"
+#include "minhton/algorithms/esearch/find_query_parser.h"
+
+/**
+ * Compares how a DSN gets the expression of a received find query: parsing the text with a new
+ * parser (as done for every received query before), parsing it with the process-wide parser, and
+ * decoding the binary encoding. Also measures evaluating the queries against the distributed data
+ * of a peer with 50 attributes, and evaluating a cover area of 256 such peers entry by entry with
+ * the expression tree compared to a single batch with the compiled expression.
+ */
+
+using namespace minhton;
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Function> double measure(uint32_t iterations, Function &&function) {
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < iterations; i++) function();
+  auto end = Clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+  const uint32_t iterations = argc > 1 ? std::stoul(argv[1]) : 2000;
+
+  // Typical peer discovery queries with increasing depth
+  const std::vector<std::string> queries{
+      "( HAS topic/transport )",
+      "(( HAS topic/transport ) AND ( load < 3.0 ))",
+      "((( HAS topic/transport ) AND ( battery >= 0.3 )) OR ( NOT ( state == busy )))",
+      "(((( HAS topic/transport ) AND ( battery >= 0.3 )) AND ( NOT ( state == busy ))) AND "
+      "((( payload <= 20.5 ) OR ( HAS ability/lift )) AND ( zone == hall2 )))",
+  };
+
+  DistributedData data;
+  for (int i = 0; i < 42; i++) {
+    data.insert("attribute" + std::to_string(i), {i, 1000, NodeData::ValueType::kValueDynamic});
+  }
+  data.insert("topic/transport", {true, 1000, NodeData::ValueType::kValueDynamic});
+  data.insert("ability/lift", {true, 1000, NodeData::ValueType::kValueDynamic});
+  data.insert("load", {2, 1000, NodeData::ValueType::kValueDynamic});
+  data.insert("battery", {0.8f, 1000, NodeData::ValueType::kValueDynamic});
+  data.insert("payload", {25.0f, 1000, NodeData::ValueType::kValueDynamic});
+  data.insert("state", {std::string("idle"), 1000, NodeData::ValueType::kValueDynamic});
+  data.insert("zone", {std::string("hall2"), 1000, NodeData::ValueType::kValueDynamic});
+  data.insert("speed", {1.5f, 1000, NodeData::ValueType::kValueDynamic});
+
+  std::cout << std::setw(7) << "query" << std::setw(10) << "text B" << std::setw(10) << "binary B"
+            << std::setw(16) << "new parser us" << std::setw(19) << "shared parser us"
+            << std::setw(11) << "decode us" << std::setw(13) << "evaluate us" << std::endl
+            << std::fixed << std::setprecision(3);
+
+  for (std::size_t i = 0; i < queries.size(); i++) {
+    FindQuery query(queries[i], "all");
+    if (!query.getBooleanExpression()) {
+      std::cerr << "Could not parse " << queries[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+    const std::string text = query.serializeBooleanExpression();
+    const std::string encoded = query.encodeBooleanExpression();
+
+    std::size_t checksum = 0;
+    const double new_parser = measure(iterations / 10, [&]() {
+      FindQueryParser parser;
+      checksum += parser.parseBooleanExpression(text) != nullptr;
+    });
+    const double shared_parser = measure(iterations, [&]() {
+      checksum += FindQueryParser::parse(text) != nullptr;
+    });
+    const double decode = measure(iterations, [&]() {
+      checksum += decodeBooleanExpression(encoded) != nullptr;
+    });
+    const double evaluate = measure(iterations * 10, [&]() {
+      checksum += query.evaluate(data, false, 1000).isTrue();
+    });
+    if (checksum == 0) std::cerr << "unexpected checksum" << std::endl;
+
+    std::cout << std::setw(7) << i << std::setw(10) << text.size() << std::setw(10)
+              << encoded.size() << std::setw(16) << new_parser << std::setw(19) << shared_parser
+              << std::setw(11) << decode << std::setw(13) << evaluate << std::endl;
+  }
+
+  // Peers of a cover area, some of them without or with outdated attributes
+  std::vector<DistributedData> cover_data(256, data);
+  CompiledExpression::Batch batch;
+  for (std::size_t i = 0; i < cover_data.size(); i++) {
+    if (i % 3 == 0) cover_data[i].remove("battery");
+    if (i % 5 == 0) {
+      cover_data[i].remove("state");
+      cover_data[i].insert("state", {std::string("busy"), 500, NodeData::ValueType::kValueDynamic});
+    }
+    batch.push_back(&cover_data[i]);
+  }
+
+  std::cout << std::endl
+            << std::setw(7) << "query" << std::setw(14) << "tree us" << std::setw(14)
+            << "compiled us" << std::setw(18) << "tree missing us" << std::setw(22)
+            << "compiled missing us" << std::endl;
+
+  for (std::size_t i = 0; i < queries.size(); i++) {
+    FindQuery query(queries[i], "all");
+    query.setValidityThreshold(100);
+
+    std::size_t checksum = 0;
+    const double tree = measure(iterations / 10, [&]() {
+      for (auto &distr_data : cover_data) {
+        checksum += query.evaluate(distr_data, false, 1000).isTrue();
+      }
+    });
+    const double compiled = measure(iterations / 10, [&]() {
+      for (const auto &value : query.evaluate(batch, false, 1000)) checksum += value.isTrue();
+    });
+    const double tree_missing = measure(iterations / 10, [&]() {
+      for (auto &distr_data : cover_data) {
+        checksum += query.evaluateMissingAttributes(distr_data, 1000).size();
+      }
+    });
+    const double compiled_missing = measure(iterations / 10, [&]() {
+      for (const auto &keys : query.evaluateMissingAttributes(batch, 1000)) {
+        checksum += keys.size();
+      }
+    });
+    if (checksum == 0) std::cerr << "unexpected checksum" << std::endl;
+
+    std::cout << std::setw(7) << i << std::setw(14) << tree << std::setw(14) << compiled
+              << std::setw(18) << tree_missing << std::setw(22) << compiled_missing << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "minhton/core/logical_node_info.h"
+#include "minhton/core/routing_calculations.h"
+
+/**
+ * Sorts the positions of a balanced tree horizontally, once by comparing the TreeMapper values
+ * (as the comparison operators did before) and once with the comparison operators, which use the
+ * cached horizontal keys. Both orders are checked to be the same.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Compare>
+double measure(const std::vector<minhton::LogicalNodeInfo> &positions, uint32_t repetitions,
+               Compare &&compare, std::vector<minhton::LogicalNodeInfo> &sorted) {
+  double total = 0;
+  for (uint32_t i = 0; i < repetitions; i++) {
+    sorted = positions;
+    auto start = Clock::now();
+    std::sort(sorted.begin(), sorted.end(), compare);
+    auto end = Clock::now();
+    total += std::chrono::duration<double, std::milli>(end - start).count();
+  }
+  return total / repetitions;
+}
+
+int main(int argc, char *argv[]) {
+  const uint32_t number_of_nodes = argc > 1 ? std::stoul(argv[1]) : 100000;
+  const uint32_t repetitions = argc > 2 ? std::stoul(argv[2]) : 5;
+
+  std::cout << std::setw(7) << "fanout" << std::setw(9) << "nodes" << std::setw(7) << "depth"
+            << std::setw(18) << "treeMapper ms" << std::setw(10) << "key ms" << std::setw(10)
+            << "speedup" << std::endl
+            << std::fixed << std::setprecision(2);
+
+  for (uint16_t fanout : {2, 3, 4, 8, 16}) {
+    // Positions of a balanced tree, filled level by level
+    std::vector<minhton::LogicalNodeInfo> positions;
+    positions.reserve(number_of_nodes);
+    uint32_t level = 0;
+    while (positions.size() < number_of_nodes) {
+      const uint64_t nodes_on_level = minhton::calcNodesOnLevel(level, fanout);
+      for (uint64_t number = 0; number < nodes_on_level && positions.size() < number_of_nodes;
+           number++) {
+        positions.emplace_back(level, number, fanout);
+      }
+      level++;
+    }
+    std::shuffle(positions.begin(), positions.end(), std::mt19937(42));
+
+    std::vector<minhton::LogicalNodeInfo> by_value;
+    std::vector<minhton::LogicalNodeInfo> by_key;
+    const double value_ms = measure(
+        positions, repetitions,
+        [](const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2) {
+          return p1.getHorizontalValue() < p2.getHorizontalValue();
+        },
+        by_value);
+    const double key_ms = measure(
+        positions, repetitions,
+        [](const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2) {
+          return p1 < p2;
+        },
+        by_key);
+
+    if (by_value != by_key) {
+      std::cerr << "Orders differ for fanout " << fanout << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << std::setw(7) << fanout << std::setw(9) << positions.size() << std::setw(7)
+              << level << std::setw(18) << value_ms << std::setw(10) << key_ms << std::setw(9)
+              << value_ms / key_ms << "x" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef MINHTON_BENCHMARKS_MESSAGE_SAMPLES_H_
+#define MINHTON_BENCHMARKS_MESSAGE_SAMPLES_H_
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "minhton/message/types_all.h"
+
+namespace minhton::benchmark {
+
+/// Name and instance of a message
+using MessageSample = std::pair<std::string, MessageVariant>;
+
+/// Creates a header between two nodes of a tree with the given fanout. Nodes are numbered like in
+/// the serializer unit tests, with distinct IPs per position.
+inline MinhtonMessageHeader createHeader(uint32_t level, uint32_t number, uint16_t fanout) {
+  MinhtonMessageHeader header;
+  header.setSender(NodeInfo(level, number, fanout, "127.0.0.1", 2000));
+  header.setTarget(NodeInfo(level + 1, number * fanout, fanout, "127.0.0.2", 2001));
+  return header;
+}
+
+inline NodeInfo createNode(uint32_t level, uint32_t number, uint16_t fanout) {
+  return {level, number, fanout,
+          "10.0." + std::to_string(level) + "." + std::to_string(number % 256),
+          static_cast<uint16_t>(2000 + number % 1000)};
+}
+
+/// Neighbors of a node as sent in routing-table related messages (routing table neighbors on the
+/// same level, children, parent and adjacents)
+inline std::vector<NodeInfo> createNeighbors(uint32_t level, uint32_t number, uint16_t fanout) {
+  std::vector<NodeInfo> neighbors;
+  for (uint32_t i = 1; i <= 2 * fanout && i <= number; i++) {
+    neighbors.push_back(createNode(level, number - i, fanout));
+  }
+  for (uint32_t i = 0; i < fanout; i++) {
+    neighbors.push_back(createNode(level + 1, number * fanout + i, fanout));
+  }
+  if (level > 0) neighbors.push_back(createNode(level - 1, number / fanout, fanout));
+  return neighbors;
+}
+
+/// One sample of every message type in MessageVariant, modeled after the serializer unit test
+/// fixtures. Level and fanout scale the number of neighbors in routing-table related messages.
+inline std::vector<MessageSample> createMessageSamples(uint32_t level = 4, uint16_t fanout = 2) {
+  const uint32_t number = (1U << level) / 2;
+  auto header = [&]() { return createHeader(level, number, fanout); };
+  auto neighbors = createNeighbors(level, number, fanout);
+
+  std::vector<MessageSample> samples;
+
+  std::unordered_map<std::string, NodeData::ValueAndType> attributes = {
+      {"cpu", {NodeData::Value(4), NodeData::ValueType::kValueStatic}},
+      {"load", {NodeData::Value(0.42F), NodeData::ValueType::kValueDynamic}},
+      {"gpu", {NodeData::Value(false), NodeData::ValueType::kValueStatic}},
+      {"type", {NodeData::Value(std::string("amr")), NodeData::ValueType::kValueStatic}}};
+  samples.emplace_back("AttributeInquiryAnswer",
+                       MessageAttributeInquiryAnswer(header(), createNode(level, number, fanout),
+                                                     attributes, {"battery"}));
+  samples.emplace_back("AttributeInquiryRequest",
+                       MessageAttributeInquiryRequest(header(), false, {"cpu", "load", "type"}));
+  samples.emplace_back("BootstrapDiscover", MessageBootstrapDiscover(header(), "TestMessage"));
+  samples.emplace_back("BootstrapResponse",
+                       MessageBootstrapResponse(header(), createNode(level + 1, 0, fanout)));
+  samples.emplace_back("Empty", MessageEmpty(header()));
+
+  NodeData::NodesWithAttributes nodes_with_attributes;
+  for (uint32_t i = 0; i < fanout; i++) {
+    nodes_with_attributes[createNode(level, i, fanout)] = {{"cpu", NodeData::Value(4)},
+                                                           {"load", NodeData::Value(0.42F)}};
+  }
+  samples.emplace_back("FindQueryAnswer", MessageFindQueryAnswer(header(), nodes_with_attributes));
+
+  FindQuery query("((HAS cpu) AND (load < 0.5))", "all");
+  query.setRequestingNode(createNode(level, number, fanout));
+  query.setValidityThreshold(16);
+  samples.emplace_back(
+      "FindQueryRequest",
+      MessageFindQueryRequest(header(), query,
+                              MessageFindQueryRequest::ForwardingDirection::kDirectionRight,
+                              std::make_pair<uint32_t, uint32_t>(256, 1)));
+  samples.emplace_back("FindReplacement",
+                       MessageFindReplacement(header(), createNode(level, number + 1, fanout)));
+  samples.emplace_back(
+      "GetNeighbors",
+      MessageGetNeighbors(header(), createNode(level, number, fanout),
+                          {NeighborRelationship::kParent, NeighborRelationship::kAdjacentLeft,
+                           NeighborRelationship::kChild}));
+  samples.emplace_back("InformAboutNeighbors", MessageInformAboutNeighbors(header(), neighbors));
+  samples.emplace_back("Join", MessageJoin(header(), NodeInfo(0, 0, fanout, "127.0.0.3", 2002)));
+  samples.emplace_back("JoinAccept",
+                       MessageJoinAccept(header(), fanout, createNode(level, number - 1, fanout),
+                                         createNode(level - 1, number / fanout, fanout),
+                                         neighbors));
+  samples.emplace_back("JoinAcceptAck", MessageJoinAcceptAck(header()));
+  samples.emplace_back("LockNeighborRequest", MessageLockNeighborRequest(header()));
+  samples.emplace_back("LockNeighborResponse", MessageLockNeighborResponse(header(), true));
+
+  MessageRemoveNeighbor remove_neighbor(header(), createNode(level + 1, 0, fanout), true);
+  std::vector<std::tuple<NodeInfo, NeighborRelationship>> neighbors_to_update;
+  for (const auto &neighbor : neighbors) {
+    neighbors_to_update.emplace_back(neighbor, NeighborRelationship::kRoutingTableNeighbor);
+  }
+  MessageUpdateNeighbors update_neighbors(header(), neighbors_to_update, true);
+  samples.emplace_back("RemoveAndUpdateNeighbors",
+                       MessageRemoveAndUpdateNeighbors(header(), remove_neighbor, update_neighbors));
+  samples.emplace_back("RemoveNeighbor", remove_neighbor);
+  samples.emplace_back("RemoveNeighborAck", MessageRemoveNeighborAck(header()));
+  samples.emplace_back("ReplacementAck", MessageReplacementAck(header(), neighbors,
+                                                               {true, false, true}));
+  samples.emplace_back("ReplacementNack", MessageReplacementNack(header()));
+  samples.emplace_back("ReplacementOffer", MessageReplacementOffer(header()));
+  samples.emplace_back("ReplacementUpdate",
+                       MessageReplacementUpdate(header(), createNode(level + 1, 0, fanout),
+                                                createNode(level, number, fanout),
+                                                LogicalNodeInfo(level, number, fanout)));
+
+  MinhtonMessageHeader query_header = header();
+  query_header.setTarget(NodeInfo(level, 0, fanout));
+  auto se_query = std::make_shared<MessageSEVariant>(
+      MessageReplacementAck(query_header, neighbors, {false, true, false}));
+  samples.emplace_back(
+      "SearchExact", MessageSearchExact(header(), NodeInfo(level, 0, fanout), se_query));
+  samples.emplace_back("SearchExactFailure",
+                       MessageSearchExactFailure(header(), NodeInfo(level, 0, fanout), se_query));
+  samples.emplace_back("SignoffParentAnswer", MessageSignoffParentAnswer(header(), true));
+  samples.emplace_back("SignoffParentRequest", MessageSignoffParentRequest(header()));
+  samples.emplace_back("SubscriptionOrder",
+                       MessageSubscriptionOrder(header(), {"cpu", "load"}, true));
+  samples.emplace_back("SubscriptionUpdate",
+                       MessageSubscriptionUpdate(header(), "load", NodeData::Value(0.42F)));
+  samples.emplace_back("UnlockNeighbor", MessageUnlockNeighbor(header()));
+  samples.emplace_back("UpdateNeighbors", update_neighbors);
+
+  return samples;
+}
+
+}  // namespace minhton::benchmark
+
+#endif  // MINHTON_BENCHMARKS_MESSAGE_SAMPLES_H_
@@ -0,0 +1,88 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "minhton/core/routing_calculations.h"
+
+/**
+ * Compares DSN membership tests by materializing the DSN set of a level (as done before) with the
+ * arithmetic NumberSetView, for fanouts 2 to 16 and even levels up to 30, as long as the numbers
+ * of the level fit into uint32_t. Materializing is skipped for sets with more than 2^24 entries.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint64_t kMaxMaterializedSize = 1ULL << 24;
+
+template <typename Function>
+double measure(const std::vector<uint32_t> &numbers, uint32_t iterations, Function &&function) {
+  uint64_t hits = 0;
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    hits += function(numbers[i % numbers.size()]) ? 1 : 0;
+  }
+  auto end = Clock::now();
+
+  // Prevent the calls from being optimized away
+  if (hits > iterations) std::cerr << "unexpected hits" << std::endl;
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+  const uint32_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+  std::cout << std::setw(7) << "fanout" << std::setw(7) << "level" << std::setw(12) << "dsns"
+            << std::setw(18) << "materialize ns" << std::setw(12) << "view ns" << std::setw(16)
+            << "lowerBound ns" << std::endl
+            << std::fixed << std::setprecision(1);
+
+  std::mt19937 rng(42);
+  for (uint16_t fanout : {2, 3, 4, 8, 16}) {
+    for (uint32_t level = 2; level <= 30; level += 2) {
+      const uint64_t nodes_on_level = minhton::calcNodesOnLevel(level, fanout);
+      if (nodes_on_level - 1 > std::numeric_limits<uint32_t>::max()) break;
+
+      std::uniform_int_distribution<uint32_t> dist(0, nodes_on_level - 1);
+      std::vector<uint32_t> numbers(1024);
+      for (auto &number : numbers) number = dist(rng);
+
+      const auto dsn_set = minhton::getDSNSetView(level, fanout);
+
+      std::cout << std::setw(7) << fanout << std::setw(7) << level << std::setw(12)
+                << dsn_set.size();
+
+      if (dsn_set.size() <= kMaxMaterializedSize) {
+        // Each call materializes the set, so fewer iterations are enough for large sets
+        const auto materialized_iterations = static_cast<uint32_t>(std::clamp<uint64_t>(
+            kMaxMaterializedSize / dsn_set.size(), 1, iterations));
+        std::cout << std::setw(18)
+                  << measure(numbers, materialized_iterations, [&](uint32_t number) {
+                       auto materialized = minhton::getDSNSet(level, fanout);
+                       return std::find(materialized.begin(), materialized.end(), number) !=
+                              materialized.end();
+                     });
+      } else {
+        std::cout << std::setw(18) << "-";
+      }
+
+      std::cout << std::setw(12) << measure(numbers, iterations, [&](uint32_t number) {
+        return minhton::isDSN(level, number, fanout);
+      });
+      std::cout << std::setw(16) << measure(numbers, iterations, [&](uint32_t number) {
+        return minhton::getDSNSetView(level, fanout).lowerBound(number).has_value();
+      }) << std::endl;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#ifndef CPPCHECK_IGNORE
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/memory.hpp>
+#include <cereal/types/optional.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/tuple.hpp>
+#include <cereal/types/unordered_map.hpp>
+#include <cereal/types/utility.hpp>
+#include <cereal/types/variant.hpp>
+#include <cereal/types/vector.hpp>
+#endif
+
+#include "message_samples.h"
+#include "minhton/utils/serializer_cereal.h"
+
+/**
+ * Compares the stream-based serialization (std::stringstream + cereal::BinaryArchive, as used
+ * before) with serialization into a reused buffer and deserialization from a view, for every
+ * message type in MessageVariant. Reports wire size, ns/op and heap allocations/op.
+ */
+
+static std::atomic<uint64_t> allocations = 0;
+
+void *operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+
+using Clock = std::chrono::steady_clock;
+
+struct Measurement {
+  double ns_per_op = 0;
+  double allocations_per_op = 0;
+};
+
+template <typename Function> Measurement measure(uint32_t iterations, Function &&function) {
+  function();  // Warm up (e.g. to let reused buffers grow)
+
+  uint64_t allocations_before = allocations.load();
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    function();
+  }
+  auto end = Clock::now();
+  uint64_t allocations_after = allocations.load();
+
+  return {std::chrono::duration<double, std::nano>(end - start).count() / iterations,
+          static_cast<double>(allocations_after - allocations_before) / iterations};
+}
+
+std::string serializeStream(const minhton::MessageVariant &msg) {
+  std::stringstream ss;
+  cereal::BinaryOutputArchive archive(ss);
+  archive(msg);
+  return ss.str();
+}
+
+minhton::MessageVariant deserializeStream(const std::string &str) {
+  minhton::MessageVariant msg;
+  std::istringstream iss(str);
+  cereal::BinaryInputArchive archive(iss);
+  archive(msg);
+  return msg;
+}
+
+void printMeasurement(const Measurement &measurement) {
+  std::cout << std::setw(10) << std::setprecision(0) << measurement.ns_per_op << std::setw(8)
+            << std::setprecision(1) << measurement.allocations_per_op;
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t iterations = argc > 1 ? std::stoul(argv[1]) : 10000;
+
+  minhton::serializer::SerializerCereal serializer;
+
+  std::cout << std::left << std::setw(26) << "message" << std::right << std::setw(7) << "bytes"
+            << std::setw(18) << "stream ser" << std::setw(18) << "buffer ser" << std::setw(18)
+            << "stream deser" << std::setw(18) << "view deser" << std::endl;
+  std::cout << std::left << std::setw(33) << "" << std::right;
+  for (int i = 0; i < 4; i++) std::cout << std::setw(10) << "ns/op" << std::setw(8) << "allocs";
+  std::cout << std::endl << std::fixed;
+
+  for (const auto &[name, msg] : minhton::benchmark::createMessageSamples()) {
+    std::string stream_serialized = serializeStream(msg);
+    std::string buffer;
+    serializer.serializeInto(msg, buffer);
+    if (buffer != stream_serialized) {
+      std::cerr << "Wire format mismatch for " << name << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    auto stream_ser = measure(iterations, [&] { stream_serialized = serializeStream(msg); });
+    auto buffer_ser = measure(iterations, [&] { serializer.serializeInto(msg, buffer); });
+    auto stream_deser = measure(iterations, [&] { deserializeStream(stream_serialized); });
+    auto view_deser = measure(iterations, [&] { serializer.deserialize(buffer); });
+
+    std::cout << std::left << std::setw(26) << name << std::right << std::setw(7) << buffer.size();
+    printMeasurement(stream_ser);
+    printMeasurement(buffer_ser);
+    printMeasurement(stream_deser);
+    printMeasurement(view_deser);
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,152 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <event2/event.h>
+#include <event2/thread.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minhton/core/timer_wheel.h"
+
+/**
+ * Schedules and cancels 100k timeouts of one second to one minute, like the timeouts of many
+ * MINHTON nodes in one process:
+ * - with a libevent timer event and a heap allocated callback per timeout, as the WatchDog did
+ *   before on its own libevent thread,
+ * - with the TimerWheel alone,
+ * - with the TimerService, which locks and runs the wheel on its own thread.
+ * Afterwards, measures how long the TimerService takes to fire 100k short timeouts.
+ */
+
+using namespace minhton::core;
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct LibeventTimer {
+  std::function<void()> function;
+  struct event *event;
+};
+
+void executeLibeventTimer(evutil_socket_t /*socket*/, short /*ev_flags*/, void *entry) {
+  auto *timer = static_cast<LibeventTimer *>(entry);
+  timer->function();
+}
+
+double perTimeout(Clock::time_point start, std::size_t count) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+}
+
+void printRow(const std::string &name, double schedule, double cancel) {
+  std::cout << std::setw(12) << name << std::setw(15) << schedule << std::setw(13) << cancel
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+  std::mt19937 rng(42);
+  std::vector<uint32_t> milliseconds(count);
+  for (auto &timeout : milliseconds) timeout = 1000 + rng() % 59000;
+
+  uint32_t executed = 0;
+  auto function = [&executed]() { executed++; };
+
+  std::cout << std::setw(12) << "timers" << std::setw(15) << "schedule ns" << std::setw(13)
+            << "cancel ns" << std::endl
+            << std::fixed << std::setprecision(1);
+
+  {
+    evthread_use_pthreads();
+    struct event_base *base = event_base_new();
+    std::vector<LibeventTimer *> timers(count);
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < count; i++) {
+      timers[i] = new LibeventTimer{function, nullptr};
+      timers[i]->event = event_new(base, -1, 0, executeLibeventTimer, timers[i]);
+      struct timeval tv {};
+      tv.tv_sec = milliseconds[i] / 1000;
+      tv.tv_usec = 1000 * (milliseconds[i] % 1000);
+      event_add(timers[i]->event, &tv);
+    }
+    const double schedule = perTimeout(start, count);
+
+    start = Clock::now();
+    for (auto *timer : timers) {
+      event_del(timer->event);
+      event_free(timer->event);
+      delete timer;
+    }
+    printRow("libevent", schedule, perTimeout(start, count));
+    event_base_free(base);
+  }
+
+  {
+    TimerWheel wheel;
+    std::vector<TimerHandle> handles(count);
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < count; i++) handles[i] = wheel.schedule(milliseconds[i], function);
+    const double schedule = perTimeout(start, count);
+
+    start = Clock::now();
+    for (const auto &handle : handles) wheel.cancel(handle);
+    printRow("wheel", schedule, perTimeout(start, count));
+  }
+
+  {
+    TimerService service;
+    std::vector<TimerHandle> handles(count);
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < count; i++) {
+      handles[i] = service.schedule(milliseconds[i], function);
+    }
+    const double schedule = perTimeout(start, count);
+
+    start = Clock::now();
+    for (const auto &handle : handles) service.cancel(handle);
+    printRow("service", schedule, perTimeout(start, count));
+  }
+
+  if (executed != 0) {
+    std::cerr << "Cancelled timeouts were executed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  {
+    TimerService service;
+    std::atomic<std::size_t> fired = 0;
+    std::promise<void> all_fired;
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < count; i++) {
+      service.schedule(1 + rng() % 50, [&fired, &all_fired, count]() {
+        if (++fired == count) all_fired.set_value();
+      });
+    }
+    all_fired.get_future().wait();
+    std::cout << std::endl
+              << "fired " << fired << " timeouts of up to 50 ms after "
+              << std::chrono::duration<double, std::milli>(Clock::now() - start).count() << " ms"
+              << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
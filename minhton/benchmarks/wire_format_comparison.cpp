@@ -0,0 +1,100 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "message_samples.h"
+#include "minhton/utils/serializer_cereal.h"
+
+/**
+ * Compares the message sizes of the binary and the compact wire format.
+ *
+ * Without arguments, the message samples (modeled after the serializer unit test fixtures) are
+ * generated for trees of increasing size and fanout. Otherwise every argument is a file containing
+ * one captured message in either wire format, which is re-encoded in both formats.
+ */
+
+struct Sizes {
+  uint64_t binary = 0;
+  uint64_t compact = 0;
+};
+
+Sizes compare(const minhton::MessageVariant &msg) {
+  static minhton::serializer::SerializerCereal binary(minhton::WireFormat::kBinary);
+  static minhton::serializer::SerializerCereal compact(minhton::WireFormat::kCompact);
+  return {binary.serialize(msg).size(), compact.serialize(msg).size()};
+}
+
+void printRow(const std::string &name, const Sizes &sizes) {
+  std::cout << std::left << std::setw(32) << name << std::right << std::setw(10) << sizes.binary
+            << std::setw(10) << sizes.compact << std::setw(9) << std::fixed << std::setprecision(1)
+            << 100.0 * static_cast<double>(sizes.compact) / static_cast<double>(sizes.binary)
+            << "%" << std::endl;
+}
+
+void printHeader(const std::string &name) {
+  std::cout << std::left << std::setw(32) << name << std::right << std::setw(10) << "binary"
+            << std::setw(10) << "compact" << std::setw(10) << "ratio" << std::endl;
+}
+
+int compareCapturedMessages(const std::vector<std::string> &paths) {
+  minhton::serializer::SerializerCereal serializer;
+  Sizes total;
+
+  printHeader("file");
+  for (const auto &path : paths) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      std::cerr << "Cannot open " << path << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::string captured((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    auto sizes = compare(serializer.deserialize(captured));
+    total.binary += sizes.binary;
+    total.compact += sizes.compact;
+    printRow(path, sizes);
+  }
+  printRow("total", total);
+  return EXIT_SUCCESS;
+}
+
+void compareSamples() {
+  printHeader("message (level 4, fanout 2)");
+  for (const auto &[name, msg] : minhton::benchmark::createMessageSamples(4, 2)) {
+    printRow(name, compare(msg));
+  }
+
+  // Larger trees mainly increase the number of neighbors per message and the varint lengths
+  std::cout << std::endl;
+  printHeader("all messages (level, fanout)");
+  for (uint16_t fanout : {2, 4, 8}) {
+    for (uint32_t level : {4, 8, 12}) {
+      Sizes total;
+      for (const auto &[name, msg] : minhton::benchmark::createMessageSamples(level, fanout)) {
+        auto sizes = compare(msg);
+        total.binary += sizes.binary;
+        total.compact += sizes.compact;
+      }
+      printRow("level " + std::to_string(level) + ", fanout " + std::to_string(fanout), total);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1) {
+    return compareCapturedMessages(std::vector<std::string>(argv + 1, argv + argc));
+  }
+
+  compareSamples();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef MINHTON_ALGORITHMS_ESEARCH_ATTRIBUTE_INDEX_H_
+#define MINHTON_ALGORITHMS_ESEARCH_ATTRIBUTE_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minhton/algorithms/esearch/boolean_expression.h"
+#include "minhton/algorithms/esearch/node_data.h"
+
+namespace minhton {
+
+/// Set of AttributeIndex slots
+class SlotBitset {
+public:
+  bool test(uint32_t slot) const;
+  void set(uint32_t slot);
+  void reset(uint32_t slot);
+
+  bool none() const;
+  std::size_t count() const;
+
+  SlotBitset &operator&=(const SlotBitset &other);
+  SlotBitset &operator|=(const SlotBitset &other);
+
+  /// Removes all slots contained in other
+  SlotBitset &subtract(const SlotBitset &other);
+
+  /// Calls the function with each slot of the set in ascending order
+  template <typename Function> void forEach(Function &&function) const {
+    for (std::size_t word_index = 0; word_index < words_.size(); word_index++) {
+      uint64_t word = words_[word_index];
+      while (word != 0) {
+        const auto bit = static_cast<uint32_t>(__builtin_ctzll(word));
+        function(static_cast<uint32_t>(word_index * 64 + bit));
+        word &= word - 1;
+      }
+    }
+  }
+
+private:
+  std::vector<uint64_t> words_;
+};
+
+///
+/// Secondary indexes over the attribute values of many NodeData entries, each identified by a
+/// slot. For each key, the index knows which slots have a value for it, which of them are
+/// outdated like in DistributedData::isValueUpToDate, and which of them satisfy a presence check,
+/// a string equality or a numeric comparison, without looking at the entries themselves.
+///
+/// The values and subscriptions have to be kept in sync with the entries by the owner of the
+/// index.
+///
+/// Typical usage:
+/// \code
+///     AttributeIndex index;
+///     auto slot = index.addSlot();
+///     index.setValue(slot, KeyTable::intern("battery"),
+///                    {0.8F, timestamp, NodeData::ValueType::kValueDynamic});
+///     SlotBitset charged = index.getComparisonMatches(KeyTable::intern("battery"),
+///                                                    ComparisonTypes::kGreater, 0.5F);
+/// \endcode
+///
+class AttributeIndex {
+public:
+  using Slot = uint32_t;
+
+  /// \returns a new slot without any values, reusing removed slots
+  Slot addSlot();
+
+  /// Removes all values of the slot and frees it
+  void removeSlot(Slot slot);
+
+  /// Removes all values and subscriptions of the slot
+  void clearSlot(Slot slot);
+
+  void clear();
+
+  /// Sets the value of the key of the slot, replacing a previous value
+  void setValue(Slot slot, NodeData::KeyId key_id,
+                const NodeData::ValueTimestampAndType &value_timestamp_and_type);
+  void removeValue(Slot slot, NodeData::KeyId key_id);
+
+  /// Subscribed values are always up to date, see DistributedData::addSubscriptionOrderKey
+  void setSubscribed(Slot slot, NodeData::KeyId key_id, bool subscribed);
+
+  /// \returns all slots in use
+  const SlotBitset &getSlots() const { return slots_; }
+
+  /// \returns the slots with any value for the key
+  SlotBitset getPresent(NodeData::KeyId key_id) const;
+
+  /// \returns the slots with a value for the key which is not up to date, see
+  /// DistributedData::isValueUpToDate
+  SlotBitset getOutdated(NodeData::KeyId key_id, uint64_t validity_threshold_timestamp) const;
+
+  /// \returns the slots which satisfy PresenceExpression::evaluateExisting
+  SlotBitset getPresenceMatches(NodeData::KeyId key_id) const;
+
+  /// \returns the slots which satisfy StringEqualityExpression::evaluateExisting
+  SlotBitset getStringMatches(NodeData::KeyId key_id, const std::string &value) const;
+
+  /// \returns the slots with a numeric value which satisfies the comparison with the operand,
+  /// comparing int and float values like NumericComparisonExpression does
+  SlotBitset getComparisonMatches(NodeData::KeyId key_id, ComparisonTypes comparison_type,
+                                  const NodeData::Value &operand) const;
+
+private:
+  struct KeyIndex {
+    SlotBitset present;
+    SlotBitset true_values;
+    SlotBitset false_values;
+    SlotBitset nan_values;  // cannot be ordered
+    SlotBitset subscribed;
+    std::unordered_map<std::string, SlotBitset> strings;
+
+    // Sorted by value
+    std::vector<std::pair<int, Slot>> ints;
+    std::vector<std::pair<float, Slot>> floats;
+
+    // Sorted timestamps of dynamic values, static values are always up to date
+    std::vector<std::pair<uint64_t, Slot>> dynamic_timestamps;
+  };
+
+  static void removeValue(KeyIndex &key_index, Slot slot);
+
+  template <typename OperandType>
+  static SlotBitset getComparisonMatches(const KeyIndex &key_index, ComparisonTypes comparison_type,
+                                         OperandType operand);
+
+  SlotBitset slots_;
+  std::vector<Slot> free_slots_;
+  Slot slot_count_ = 0;
+
+  std::unordered_map<NodeData::KeyId, KeyIndex> keys_;
+};
+
+}  // namespace minhton
+
+#endif
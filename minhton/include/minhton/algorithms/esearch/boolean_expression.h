@@ -8,6 +8,7 @@
 #define MINHTON_ALGORITHMS_ESEARCH_BOOLEAN_EXPRESSION_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minhton/algorithms/esearch/evaluation_information.h"
@@ -16,6 +17,8 @@
 
 namespace minhton {
 
+class CompiledExpression;
+
 // TODO move into numeric comparison expression
 enum class ComparisonTypes {
   kEqualTo,
@@ -26,6 +29,27 @@ enum class ComparisonTypes {
   kGreaterThanOrEqualTo
 };
 
+/// Node types of the binary encoding of boolean expressions.
+/// Each node is encoded in pre-order as its tag followed by its fields.
+enum class ExpressionTag : uint8_t {
+  kEmpty = 0,
+  kOr = 1,
+  kAnd = 2,
+  kNot = 3,
+  kPresence = 4,
+  kStringEquality = 5,
+  kIntComparison = 6,
+  kFloatComparison = 7,
+};
+
+namespace expression_encoding {
+void writeTag(std::string &buffer, ExpressionTag tag);
+void writeString(std::string &buffer, const std::string &value);
+void writeComparison(std::string &buffer, ComparisonTypes comparison_type);
+void writeNumber(std::string &buffer, int value);
+void writeNumber(std::string &buffer, float value);
+}  // namespace expression_encoding
+
 class BooleanExpression {
 public:
   virtual ~BooleanExpression() = default;
@@ -40,20 +64,45 @@ public:
   virtual uint8_t getDepth() = 0;
 
   virtual std::string serialize() = 0;
+
+  /// Appends the binary encoding of this expression to the buffer
+  virtual void encode(std::string &buffer) const = 0;
+
+  /// Appends the instructions of this expression to the program in postfix order
+  virtual void compile(CompiledExpression &program) const = 0;
 };
 
+///
+/// Encodes the expression into a compact binary representation for the wire.
+/// Decoding it does not need the textual grammar and preserves the exact expression types.
+///
+/// \returns the encoded expression
+std::string encodeBooleanExpression(const BooleanExpression &expr);
+
+///
+/// Decodes an expression encoded by encodeBooleanExpression.
+///
+/// \returns the expression, otherwise throws std::invalid_argument if the encoding is malformed
+std::shared_ptr<BooleanExpression> decodeBooleanExpression(const std::string &encoded);
+
 class AtomicBooleanExpression : public BooleanExpression {
 public:
-  explicit AtomicBooleanExpression(NodeData::Key key) : key_(std::move(key)){};
+  explicit AtomicBooleanExpression(NodeData::Key key)
+      : key_(std::move(key)), key_id_(KeyTable::find(key_).value_or(KeyTable::kUnknownKey)){};
 
   ~AtomicBooleanExpression() override = default;
 
   std::vector<NodeData::Key> evaluateMissingAttributes(
       NodeData &data, const EvaluationInformation &eval_info) const override {
+    const NodeData::KeyId key_id = resolveKeyId();
+    const auto *value = data.find(key_id, key_);
+    auto is_up_to_date = [&]() {
+      return data.isValueUpToDate(key_id, *value, eval_info.validity_threshold_timestamp);
+    };
+
     if (eval_info.inquire_unknown_attributes && eval_info.inquire_outdated_attributes) {
       // if we do not have the key, or its outdated, we inquire
-      if (!data.hasKey(key_) ||
-          !data.isValueUpToDate(key_, eval_info.validity_threshold_timestamp)) {
+      if (value == nullptr || !is_up_to_date()) {
         return {key_};
       }
       return {};
@@ -62,7 +111,7 @@ public:
     if (eval_info.inquire_unknown_attributes && !eval_info.inquire_outdated_attributes) {
       // if we have the key, we dont have to do anything
       // if we do not have the key, we inquire
-      if (!data.hasKey(key_)) {
+      if (value == nullptr) {
         return {key_};
       }
       return {};
@@ -71,8 +120,7 @@ public:
     if (!eval_info.inquire_unknown_attributes && eval_info.inquire_outdated_attributes) {
       // if we have the key, we inquire outdated
       // if we do not have the key, we do not inquire
-      if (data.hasKey(key_) &&
-          !data.isValueUpToDate(key_, eval_info.validity_threshold_timestamp)) {
+      if (value != nullptr && !is_up_to_date()) {
         return {key_};
       }
       return {};
@@ -91,7 +139,9 @@ public:
       return evaluateExisting(data, eval_info);
     }
 
-    if (!data.hasKey(key_)) {
+    const NodeData::KeyId key_id = resolveKeyId();
+    const auto *value_timestamp_and_type = data.find(key_id, key_);
+    if (value_timestamp_and_type == nullptr) {
       if (!eval_info.all_information_present && eval_info.inquire_unknown_attributes) {
         return FuzzyValue::createUndecided();
       }
@@ -101,7 +151,8 @@ public:
     // we have the key
 
     if (eval_info.inquire_outdated_attributes &&
-        !data.isValueUpToDate(key_, eval_info.validity_threshold_timestamp)) {
+        !data.isValueUpToDate(key_id, *value_timestamp_and_type,
+                              eval_info.validity_threshold_timestamp)) {
       if (eval_info.all_information_present) {
         return FuzzyValue::createFalse();
       }
@@ -123,6 +174,19 @@ public:
 
 protected:
   NodeData::Key key_;
+
+  /// \returns the interned key_ for all lookups in NodeData. Expressions may be received from
+  /// other nodes, therefore key_ is not interned. It is looked up again if it was not in the
+  /// KeyTable when the expression was created, and may stay unknown, see NodeData::find.
+  NodeData::KeyId resolveKeyId() const {
+    if (key_id_ != KeyTable::kUnknownKey) {
+      return key_id_;
+    }
+    return KeyTable::find(key_).value_or(KeyTable::kUnknownKey);
+  }
+
+private:
+  const NodeData::KeyId key_id_;
 };
 
 class OrExpression : public BooleanExpression {
@@ -173,6 +237,14 @@ public:
     return "( " + expr1_->serialize() + " OR " + expr2_->serialize() + " )";
   }
 
+  void encode(std::string &buffer) const override {
+    expression_encoding::writeTag(buffer, ExpressionTag::kOr);
+    expr1_->encode(buffer);
+    expr2_->encode(buffer);
+  }
+
+  void compile(CompiledExpression &program) const override;
+
   uint8_t getDepth() override { return expr1_->getDepth() + expr2_->getDepth(); }
 
 private:
@@ -218,6 +290,14 @@ public:
     return "( " + expr1_->serialize() + " AND " + expr2_->serialize() + " )";
   }
 
+  void encode(std::string &buffer) const override {
+    expression_encoding::writeTag(buffer, ExpressionTag::kAnd);
+    expr1_->encode(buffer);
+    expr2_->encode(buffer);
+  }
+
+  void compile(CompiledExpression &program) const override;
+
   uint8_t getDepth() override { return expr1_->getDepth() + expr2_->getDepth(); }
 
 private:
@@ -249,6 +329,13 @@ public:
 
   std::string serialize() override { return "( NOT " + expr_->serialize() + " )"; }
 
+  void encode(std::string &buffer) const override {
+    expression_encoding::writeTag(buffer, ExpressionTag::kNot);
+    expr_->encode(buffer);
+  }
+
+  void compile(CompiledExpression &program) const override;
+
   uint8_t getDepth() override { return expr_->getDepth(); }
 
 private:
@@ -263,12 +350,12 @@ public:
 
   FuzzyValue evaluateExisting(NodeData &data,
                               [[maybe_unused]] const EvaluationInformation &eval_info) override {
-    if (!data.hasKey(key_)) {
+    const auto *value_timestamp_and_type = data.find(resolveKeyId(), key_);
+    if (value_timestamp_and_type == nullptr) {
       return FuzzyValue::createFalse();
     }
 
-    auto variant = data.getValue(key_);
-    auto pval = std::get_if<bool>(&variant);
+    auto pval = std::get_if<bool>(&std::get<0>(*value_timestamp_and_type));
     if (pval != nullptr) {
       // if value is bool, return value converted to fuzzy value
       return *pval ? FuzzyValue::createTrue() : FuzzyValue::createFalse();
@@ -280,6 +367,13 @@ public:
   std::vector<NodeData::Key> getRelevantTopicKeys() const override { return {key_}; }
 
   std::string serialize() override { return "( HAS " + key_ + " )"; }
+
+  void encode(std::string &buffer) const override {
+    expression_encoding::writeTag(buffer, ExpressionTag::kPresence);
+    expression_encoding::writeString(buffer, key_);
+  }
+
+  void compile(CompiledExpression &program) const override;
 };
 
 class StringEqualityExpression : public AtomicBooleanExpression {
@@ -291,11 +385,11 @@ public:
 
   FuzzyValue evaluateExisting(NodeData &data,
                               [[maybe_unused]] const EvaluationInformation &eval_info) override {
-    if (!data.hasKey(key_)) {
+    const auto *value_timestamp_and_type = data.find(resolveKeyId(), key_);
+    if (value_timestamp_and_type == nullptr) {
       return FuzzyValue::createFalse();
     }
-    NodeData::Value variant = data.getValue(key_);
-    auto pval = std::get_if<std::string>(&variant);
+    auto pval = std::get_if<std::string>(&std::get<0>(*value_timestamp_and_type));
     if (pval != nullptr) {
       if ((*pval) == value_) {
         return FuzzyValue::createTrue();
@@ -310,6 +404,14 @@ public:
 
   std::string serialize() override { return "( " + key_ + " == " + value_ + " )"; }
 
+  void encode(std::string &buffer) const override {
+    expression_encoding::writeTag(buffer, ExpressionTag::kStringEquality);
+    expression_encoding::writeString(buffer, key_);
+    expression_encoding::writeString(buffer, value_);
+  }
+
+  void compile(CompiledExpression &program) const override;
+
 private:
   std::string value_;
 };
@@ -329,27 +431,20 @@ public:
 
   FuzzyValue evaluateExisting(NodeData &data,
                               [[maybe_unused]] const EvaluationInformation &eval_info) override {
-    if (!data.hasKey(key_)) return FuzzyValue::createFalse();
+    const auto *value_timestamp_and_type = data.find(resolveKeyId(), key_);
+    if (value_timestamp_and_type == nullptr) return FuzzyValue::createFalse();
 
-    NodeData::Value variant = data.getValue(key_);
+    const NodeData::Value &variant = std::get<0>(*value_timestamp_and_type);
 
     bool comparison = false;
     bool compared = false;
 
-    try {
-      int int_value = std::get<int>(variant);
-      comparison = applyComparison<int>(int_value);
+    if (const auto *int_value = std::get_if<int>(&variant)) {
+      comparison = applyComparison<int>(*int_value);
+      compared = true;
+    } else if (const auto *float_value = std::get_if<float>(&variant)) {
+      comparison = applyComparison<float>(*float_value);
       compared = true;
-    } catch (std::bad_variant_access const &ex) {
-    }
-
-    if (!compared) {
-      try {
-        float float_value = std::get<float>(variant);
-        comparison = applyComparison<float>(float_value);
-        compared = true;
-      } catch (std::bad_variant_access const &ex) {
-      }
     }
 
     if (compared) {
@@ -390,6 +485,17 @@ public:
     return "( " + key_ + " " + comp_str + " " + std::to_string(comparison_value_) + " )";
   }
 
+  void encode(std::string &buffer) const override {
+    expression_encoding::writeTag(buffer, std::is_same_v<NumericType, int>
+                                              ? ExpressionTag::kIntComparison
+                                              : ExpressionTag::kFloatComparison);
+    expression_encoding::writeString(buffer, key_);
+    expression_encoding::writeComparison(buffer, comparison_type_);
+    expression_encoding::writeNumber(buffer, comparison_value_);
+  }
+
+  void compile(CompiledExpression &program) const override;
+
 private:
   ComparisonTypes comparison_type_;
   NumericType comparison_value_;
@@ -441,9 +547,17 @@ public:
   std::vector<NodeData::Key> getRelevantKeys() const override { return {}; }
   std::vector<NodeData::Key> getRelevantTopicKeys() const override { return {}; }
   std::string serialize() override { return "( empty )"; }
+  void encode(std::string &buffer) const override {
+    expression_encoding::writeTag(buffer, ExpressionTag::kEmpty);
+  }
+  void compile(CompiledExpression &program) const override;
   uint8_t getDepth() override { return 0; }
 };
 
+// Defined in boolean_expression.cpp
+extern template class NumericComparisonExpression<int>;
+extern template class NumericComparisonExpression<float>;
+
 }  // namespace minhton
 
 #endif
@@ -0,0 +1,140 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef MINHTON_ALGORITHMS_ESEARCH_COMPILED_EXPRESSION_H_
+#define MINHTON_ALGORITHMS_ESEARCH_COMPILED_EXPRESSION_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "minhton/algorithms/esearch/attribute_index.h"
+#include "minhton/algorithms/esearch/boolean_expression.h"
+
+namespace minhton {
+
+///
+/// A BooleanExpression compiled into a flat postfix program over interned keys.
+///
+/// Instead of walking the expression tree for every node, a whole batch of NodeData entries is
+/// evaluated at once: The value of each key of the expression is looked up once per entry, and
+/// each instruction is applied to a column with one value per entry. The results are identical
+/// to BooleanExpression::evaluate and BooleanExpression::evaluateMissingAttributes.
+///
+/// Typical usage:
+/// \code
+///     CompiledExpression program(*query.getBooleanExpression());
+///     std::vector<FuzzyValue> values = program.evaluate(batch, eval_info);
+/// \endcode
+///
+class CompiledExpression {
+public:
+  using Batch = std::vector<NodeData *>;
+
+  explicit CompiledExpression(const BooleanExpression &expr);
+
+  /// \returns the value of the expression for each entry of the batch, in the same order
+  std::vector<FuzzyValue> evaluate(const Batch &batch,
+                                   const EvaluationInformation &eval_info) const;
+
+  /// \returns the missing attributes of each entry of the batch, in the same order
+  std::vector<std::vector<NodeData::Key>> evaluateMissingAttributes(
+      const Batch &batch, const EvaluationInformation &eval_info) const;
+
+  ///
+  /// Narrows down the slots of the index which can evaluate to the given value, so that only
+  /// those have to be evaluated. The index has to contain DistributedData entries only.
+  ///
+  /// \returns a superset of the slots whose entries evaluate to the value
+  SlotBitset getCandidates(const AttributeIndex &index, FuzzyValue value,
+                           const EvaluationInformation &eval_info) const;
+
+  std::size_t getInstructionCount() const { return instructions_.size(); }
+
+  // Used by BooleanExpression::compile to append the instructions in postfix order
+  void addEmpty();
+  void addNot();
+  void addAnd();
+  void addOr();
+  void addPresence(const NodeData::Key &key);
+  void addStringEquality(const NodeData::Key &key, const std::string &value);
+  void addComparison(const NodeData::Key &key, ComparisonTypes comparison_type, int value);
+  void addComparison(const NodeData::Key &key, ComparisonTypes comparison_type, float value);
+
+private:
+  enum class Opcode : uint8_t {
+    kEmpty,
+    kPresence,
+    kStringEquality,
+    kIntComparison,
+    kFloatComparison,
+    kNot,
+    kAnd,
+    kOr,
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    ComparisonTypes comparison_type = ComparisonTypes::kEqualTo;
+    uint32_t key_index = 0;  // into keys_
+    NodeData::Value operand;
+  };
+
+  // Values of one key for all entries of a batch
+  struct KeyColumn {
+    std::vector<const NodeData::ValueTimestampAndType *> values;  // nullptr if unknown
+    std::vector<bool> up_to_date;
+  };
+
+  uint32_t addKey(const NodeData::Key &key);
+
+  /// Same as AtomicBooleanExpression::resolveKeyId for the key at the index
+  NodeData::KeyId resolveKeyId(uint32_t key_index) const;
+
+  std::vector<KeyColumn> fetchColumns(const Batch &batch,
+                                      const EvaluationInformation &eval_info) const;
+
+  /// Column of values for all entries, calculated like BooleanExpression::evaluate.
+  /// If or_values is given, only the operands of ORs are evaluated and the values of each OR are
+  /// stored at its instruction index, like BooleanExpression::evaluateMissingAttributes does.
+  std::vector<FuzzyValue> run(const Batch &batch, const std::vector<KeyColumn> &columns,
+                              const EvaluationInformation &eval_info,
+                              std::vector<std::vector<FuzzyValue>> *or_values) const;
+
+  /// Like AtomicBooleanExpression::evaluate for the entry at the given index of the batch
+  static FuzzyValue evaluateAtomic(const Instruction &instruction, const KeyColumn &column,
+                                   const NodeData &data, std::size_t index,
+                                   const EvaluationInformation &eval_info);
+
+  /// Like AtomicBooleanExpression::evaluateMissingAttributes
+  static bool isMissing(const KeyColumn &column, std::size_t index,
+                        const EvaluationInformation &eval_info);
+
+  /// Like AtomicBooleanExpression::evaluateExisting
+  static FuzzyValue evaluateExisting(const Instruction &instruction,
+                                     const NodeData::ValueTimestampAndType *value);
+
+  template <typename NumericType> static bool applyComparison(ComparisonTypes comparison_type,
+                                                              NumericType value,
+                                                              const NodeData::Value &operand);
+
+  std::vector<Instruction> instructions_;
+
+  // Indices of the atomic instructions in postfix order
+  std::vector<uint32_t> atomic_instructions_;
+
+  // Indices of all ORs an instruction is an operand of, from the innermost one. Only those
+  // operands are evaluated by BooleanExpression::evaluateMissingAttributes.
+  std::vector<std::vector<uint32_t>> enclosing_ors_;
+
+  // Distinct keys of the expression as names and interned ids, KeyTable::kUnknownKey if a key was
+  // not in the KeyTable when the expression was compiled
+  std::vector<NodeData::Key> keys_;
+  std::vector<NodeData::KeyId> key_ids_;
+};
+
+}  // namespace minhton
+
+#endif
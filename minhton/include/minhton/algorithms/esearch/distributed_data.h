@@ -38,8 +38,12 @@ public:
   std::queue<uint64_t> getUpdateTimestamps(const NodeData::Key &key);
 
   bool isKeySubscribed(NodeData::Key key);
+  bool isKeySubscribed(KeyId key_id) const;
 
-  bool isValueUpToDate(const NodeData::Key &key, uint64_t validity_threshold_timestamp) override;
+  using NodeData::isValueUpToDate;
+  bool isValueUpToDate(KeyId key_id, uint64_t validity_threshold_timestamp) override;
+  bool isValueUpToDate(KeyId key_id, const ValueTimestampAndType &value_timestamp_and_type,
+                       uint64_t validity_threshold_timestamp) const override;
 
   uint8_t getTimestampStorageLimit() const;
 
@@ -49,7 +53,7 @@ private:
   PhysicalNodeInfo p_node_info_;
 
   // for which keys we have sent a subscription order
-  std::vector<NodeData::Key> subscription_ordered_keys_;
+  std::vector<KeyId> subscription_ordered_keys_;
 
   // to see how often we get updates
   std::unordered_map<NodeData::Key, std::queue<uint64_t>> update_timestamps_;
@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "minhton/algorithms/esearch/attribute_index.h"
 #include "minhton/algorithms/esearch/distributed_data.h"
 #include "minhton/algorithms/esearch/find_query.h"
 #include "minhton/core/routing_information.h"
@@ -134,6 +135,20 @@ private:
 
   void buildTempCoverArea();
 
+  /// Modifying cover_data_ only through these methods keeps cover_index_ in sync
+  void setCoverData(const LogicalNodeInfo &peer, const DistributedData &distr_data);
+  std::unordered_map<LogicalNodeInfo, DistributedData, LogicalNodeInfoHasher>::iterator
+  eraseCoverData(
+      std::unordered_map<LogicalNodeInfo, DistributedData, LogicalNodeInfoHasher>::iterator it);
+  void clearCoverData();
+
+  /// Updates the indexed value of the key after it changed in the cover data of the peer
+  void updateCoverIndex(const LogicalNodeInfo &peer, NodeData::KeyId key_id);
+
+  /// \returns the entries of cover_data_ in the slots of the candidates
+  std::vector<std::pair<const LogicalNodeInfo *, DistributedData *>> getCoverEntries(
+      const SlotBitset &candidates) const;
+
   /// If this node is an active dominating set node
   bool is_active_;
 
@@ -151,6 +166,16 @@ private:
   /// It requires constant maintanance if a neighbor or our own position changes
   std::unordered_map<LogicalNodeInfo, DistributedData, LogicalNodeInfoHasher> cover_data_;
 
+  /// Secondary indexes over the attribute values in cover_data_.
+  /// Find queries are only evaluated for the nodes which can match according to the indexes.
+  AttributeIndex cover_index_;
+
+  /// Slot in cover_index_ of each node in cover_data_
+  std::unordered_map<LogicalNodeInfo, AttributeIndex::Slot, LogicalNodeInfoHasher> cover_slots_;
+
+  /// Entry in cover_data_ of each slot in cover_index_, nullptr for unused slots
+  std::vector<std::pair<const LogicalNodeInfo *, DistributedData *>> cover_slot_entries_;
+
   /// Precalculated vector of all positions within the cover area,
   /// depending on our current position.
   std::vector<std::tuple<uint32_t, uint32_t>> cover_area_positions_;
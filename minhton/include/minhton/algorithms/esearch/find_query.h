@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "minhton/algorithms/esearch/boolean_expression.h"
+#include "minhton/algorithms/esearch/compiled_expression.h"
 #include "minhton/algorithms/esearch/distributed_data.h"
 #include "minhton/algorithms/esearch/evaluation_information.h"
 #include "minhton/algorithms/esearch/local_data.h"
@@ -41,9 +42,25 @@ public:
   void deserializeBooleanExpression(const std::string &expr_string);
   void deserializeScope(const std::string &scope_string);
 
+  /// Binary representation of the expression for the wire (see encodeBooleanExpression)
+  std::string encodeBooleanExpression() const;
+  void decodeBooleanExpression(const std::string &encoded);
+
   FuzzyValue evaluate(NodeData &data, bool all_information_present, const uint64_t &timestamp_now);
   std::vector<NodeData::Key> evaluateMissingAttributes(NodeData &data,
                                                        uint64_t const &timestamp_now) const;
+
+  /// Same as the single entry versions, but evaluates the whole batch with the compiled expression
+  std::vector<FuzzyValue> evaluate(const CompiledExpression::Batch &batch,
+                                   bool all_information_present, const uint64_t &timestamp_now);
+  std::vector<std::vector<NodeData::Key>> evaluateMissingAttributes(
+      const CompiledExpression::Batch &batch, uint64_t const &timestamp_now) const;
+
+  /// \returns a superset of the slots of the index whose entries evaluate to the value,
+  /// see CompiledExpression::getCandidates
+  SlotBitset getCandidates(const AttributeIndex &index, FuzzyValue value,
+                           bool all_information_present, const uint64_t &timestamp_now) const;
+
   std::vector<NodeData::Key> getRelevantAttributes() const;
   std::vector<NodeData::Key> getRelevantTopicAttributes() const;
 
@@ -78,25 +95,35 @@ public:
     if (!this->expr_) {
       throw std::runtime_error("Expression in FindQuery is empty!");
     }
-    archive(validity_threshold_, serializeBooleanExpression(), scope_, requesting_node_,
+    archive(validity_threshold_, encodeBooleanExpression(), scope_, requesting_node_,
             inquire_unknown_attributes_, inquire_outdated_attributes_, permissive_, selection_,
             selected_attribute_keys_);
   }
 
   template <class Archive> void load(Archive &archive) {
-    std::string expr_string;
-    archive(validity_threshold_, expr_string, scope_, requesting_node_, inquire_unknown_attributes_,
-            inquire_outdated_attributes_, permissive_, selection_, selected_attribute_keys_);
-    deserializeBooleanExpression(expr_string);
+    std::string encoded_expr;
+    archive(validity_threshold_, encoded_expr, scope_, requesting_node_,
+            inquire_unknown_attributes_, inquire_outdated_attributes_, permissive_, selection_,
+            selected_attribute_keys_);
+    decodeBooleanExpression(encoded_expr);
   }
 
 private:
   EvaluationInformation createEvaluationInformation(bool all_information_present,
                                                     const uint64_t &timestamp_now) const;
 
+  /// Compiles expr_ on first use
+  const CompiledExpression &getCompiledExpression() const;
+
+  std::vector<NodeData::Key> addSelectedAttributes(
+      std::vector<NodeData::Key> missing_attributes) const;
+
   // LATER change to unique_ptr if possible
   std::shared_ptr<BooleanExpression> expr_;
 
+  /// expr_ compiled for batch evaluations, reset whenever expr_ changes
+  mutable std::shared_ptr<const CompiledExpression> compiled_expr_;
+
   // all, some...
   FindQueryScope scope_ = FindQuery::FindQueryScope::kAll;
 
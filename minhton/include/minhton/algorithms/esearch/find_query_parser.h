@@ -20,6 +20,9 @@ public:
 
   std::shared_ptr<BooleanExpression> parseBooleanExpression(const std::string &expr_string);
 
+  /// Parses the expression with a process-wide parser, so that the grammar is only loaded once
+  static std::shared_ptr<BooleanExpression> parse(const std::string &expr_string);
+
 private:
   peg::parser boolean_expression_parser_;
 
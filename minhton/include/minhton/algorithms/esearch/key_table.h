@@ -0,0 +1,65 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef MINHTON_ALGORITHMS_ESEARCH_KEY_TABLE_H_
+#define MINHTON_ALGORITHMS_ESEARCH_KEY_TABLE_H_
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace minhton {
+
+///
+/// Process-wide table of interned attribute keys.
+///
+/// Each attribute name is hashed once when it is interned and is referred to by its KeyId
+/// afterwards. NodeData stores its values by KeyId, and expressions resolve their keys when they
+/// are created, so that evaluating a find query does not hash attribute names again.
+///
+/// KeyIds are only valid within the process and must never be sent over the network.
+///
+/// Keys are never removed, therefore only keys known locally are interned unconditionally. Keys
+/// received from other nodes are only looked up, or interned while the table is not full.
+///
+class KeyTable {
+public:
+  using KeyId = uint32_t;
+
+  /// Id of keys which are not in the table, no NodeData has a value for it
+  static constexpr KeyId kUnknownKey = std::numeric_limits<KeyId>::max();
+
+  /// Number of keys up to which tryIntern adds keys
+  static constexpr std::size_t kMaxKeys = 1U << 16U;
+
+  /// \returns the id of the key, which gets added to the table if it is not known yet
+  static KeyId intern(const std::string &key);
+
+  /// Like intern for keys received from other nodes
+  /// \returns the id of the key, otherwise std::nullopt if the table is full
+  static std::optional<KeyId> tryIntern(const std::string &key);
+
+  /// \returns the id of the key if it has been interned before, without adding it
+  static std::optional<KeyId> find(const std::string &key);
+
+  /// \returns the name of an interned key, otherwise throws std::out_of_range
+  static const std::string &getName(KeyId key_id);
+
+private:
+  static KeyTable &getInstance();
+
+  std::shared_mutex mutex_;
+  std::unordered_map<std::string, KeyId> ids_;
+  std::deque<std::string> names_;  // never invalidates references to its elements on push_back
+};
+
+}  // namespace minhton
+
+#endif
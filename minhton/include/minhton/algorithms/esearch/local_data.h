@@ -18,7 +18,8 @@ public:
   void addKeySubscriber(NodeData::Key key, NodeInfo &subscriber);
   void removeKeySubscriber(const NodeData::Key &key, NodeInfo &unsubscriber);
 
-  bool isValueUpToDate(const NodeData::Key &key, uint64_t validity_threshold_timestamp) override;
+  using NodeData::isValueUpToDate;
+  bool isValueUpToDate(KeyId key_id, uint64_t validity_threshold_timestamp) override;
 
   bool isLocal() const override;
 
@@ -49,7 +49,7 @@ private:
   void performFindQueryForwarding(const MessageFindQueryRequest &msg);
   void performSendInquiryAggregations(uint64_t ref_event_id, FindQuery &query);
   void savePreliminaryResultsFromInquiryAggregation(uint64_t ref_event_id,
-                                                    NodeData::NodesWithAttributes results);
+                                                    const NodeData::NodesWithAttributes &results);
 
   void processDSNAggregationTimeout();
   void processInquiryAggregationTimeout();
@@ -12,6 +12,7 @@
 #include <variant>
 #include <vector>
 
+#include "minhton/algorithms/esearch/key_table.h"
 #include "minhton/core/node_info.h"
 #include "solanet/serializer/serialize.h"
 
@@ -25,6 +26,7 @@ public:
   };
 
   using Key = std::string;
+  using KeyId = KeyTable::KeyId;
   using Value = std::variant<int, float, bool, std::string>;
   using ValueAndTimestamp = std::tuple<Value, uint64_t>;
   using ValueTimestampAndType = std::tuple<Value, uint64_t, ValueType>;
@@ -45,22 +47,56 @@ public:
   virtual void remove(Key key);
 
   bool hasKey(const Key &key);
+  bool hasKey(KeyId key_id) const;
   Value getValue(Key key);
   ValueAndTimestamp getValueAndTimestamp(Key key);
   ValueTimestampAndType getValueTimestampAndType(Key key);
 
+  /// \returns the value, timestamp and type of the key without copying it, or nullptr if the key
+  /// is unknown. The pointer is invalidated by inserting or removing keys.
+  const ValueTimestampAndType *find(KeyId key_id) const;
+
+  /// Same as find(KeyId), which also finds the values of keys which are not in the KeyTable.
+  /// \p key_id may be KeyTable::kUnknownKey, the key is looked up by \p key then.
+  const ValueTimestampAndType *find(KeyId key_id, const Key &key) const;
+
   std::unordered_map<Key, ValueTimestampAndType> getData() const;
 
-  virtual bool isValueUpToDate(const NodeData::Key &key, uint64_t validity_threshold_timestamp);
+  bool isValueUpToDate(const NodeData::Key &key, uint64_t validity_threshold_timestamp);
+  virtual bool isValueUpToDate(KeyId key_id, uint64_t validity_threshold_timestamp);
+
+  /// Same as isValueUpToDate for a known key whose value was already looked up with find
+  virtual bool isValueUpToDate(KeyId key_id, const ValueTimestampAndType &value_timestamp_and_type,
+                               uint64_t validity_threshold_timestamp) const;
 
   virtual bool isLocal() const = 0;
 
   std::vector<Key> getAllCurrentKeys();
 
-  SERIALIZE(data_);
+  // KeyIds are only valid within the process, therefore the data is archived by the key names
+  template <class Archive> void save(Archive &archive) const { archive(getData()); }
+
+  template <class Archive> void load(Archive &archive) {
+    std::unordered_map<Key, ValueTimestampAndType> data;
+    archive(data);
+    data_.clear();
+    overflow_data_.clear();
+    for (auto &[key, value_timestamp_and_type] : data) {
+      if (auto key_id = KeyTable::tryIntern(key)) {
+        data_.emplace(*key_id, std::move(value_timestamp_and_type));
+      } else {
+        overflow_data_.emplace(key, std::move(value_timestamp_and_type));
+      }
+    }
+  }
 
 private:
-  std::unordered_map<Key, ValueTimestampAndType> data_;
+  ValueTimestampAndType *findByName(const Key &key);
+
+  std::unordered_map<KeyId, ValueTimestampAndType> data_;
+
+  // Values of keys which did not fit into the KeyTable anymore, see KeyTable::tryIntern
+  std::unordered_map<Key, ValueTimestampAndType> overflow_data_;
 };
 
 }  // namespace minhton
@@ -124,5 +124,15 @@ enum class ResponseAlgorithms {
 enum class BootstrapAlgorithms {
   kBootstrapGeneral,
 };
+
+/// Encoding of messages on the network (see utils/compact_archive.h)
+enum class WireFormat : uint8_t {
+  kBinary = 0,
+  kCompact = 1,
+};
+
+/// First byte of messages in the compact wire format. Binary messages start with the index of the
+/// message type, which is far smaller.
+const uint8_t kCompactWireFormatMarker = 0xC0;
 }  // namespace minhton
 #endif
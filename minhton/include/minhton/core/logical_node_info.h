@@ -9,7 +9,7 @@
 
 #include <string>
 
-#include "solanet/serializer/serialize.h"
+#include "minhton/utils/compact_archive_tag.h"
 #include "solanet/uuid.h"
 #include "solanet/uuid_generator.h"
 
@@ -93,9 +93,15 @@ public:
   /// \returns the uuid of this peer
   solanet::UUID getRawUuid() const;
 
-  /// \returns the horizontal value defined by the TreeMapper of this peer
+  /// \returns the horizontal value defined by the TreeMapper of this peer.
+  /// Only kept for calculating horizontal distances, the comparison operators use the exact
+  /// horizontal key instead.
   double getHorizontalValue() const;
 
+  /// \returns the exact horizontal key of this peer (see calcHorizontalKey), which is calculated
+  /// once per position. It is 0 if the fanout is not set yet or the level is too deep for a key.
+  uint64_t getHorizontalKey() const;
+
   ///
   /// Sets the fanout of this peer
   ///
@@ -220,14 +226,28 @@ public:
   friend bool operator>(const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2);
   friend bool operator>=(const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2);
 
-  SERIALIZE(level_, number_, fanout_, uuid_, initialized_);
+  template <class Archive> void serialize(Archive &archive) {
+    if constexpr (serializer::kIsCompactArchive<Archive>) {
+      archive.varint(level_);
+      archive.varint(number_);
+      archive.varint(fanout_);
+      archive(uuid_, initialized_);
+    } else {
+      archive(level_, number_, fanout_, uuid_, initialized_);
+    }
+    // The key is not part of the wire format and has to be restored after loading
+    this->updateHorizontalKey();
+  }
 
 private:
+  void updateHorizontalKey();
+
   uint32_t level_ = 0;
   uint32_t number_ = 0;
   uint16_t fanout_ = 0;
   solanet::UUID uuid_ = solanet::generateUUID();
   bool initialized_ = false;
+  uint64_t horizontal_key_ = 0;
 };
 
 struct LogicalNodeInfoHasher {
@@ -11,7 +11,7 @@
 
 #include "minhton/core/logical_node_info.h"
 #include "minhton/core/physical_node_info.h"
-#include "solanet/serializer/serialize.h"
+#include "minhton/utils/compact_archive_tag.h"
 
 namespace minhton {
 
@@ -136,7 +136,14 @@ public:
   friend bool operator>(const minhton::NodeInfo &n1, const minhton::NodeInfo &n2);
   friend bool operator>=(const minhton::NodeInfo &n1, const minhton::NodeInfo &n2);
 
-  SERIALIZE(l_node_info_, p_node_info_);
+  template <class Archive> void serialize(Archive &archive) {
+    if constexpr (serializer::kIsCompactArchive<Archive>) {
+      // Peers are often repeated within a message, e.g. as target and as neighbor
+      archive.peer([this](auto &peer_archive) { peer_archive(l_node_info_, p_node_info_); });
+    } else {
+      archive(l_node_info_, p_node_info_);
+    }
+  }
 
 private:
   minhton::LogicalNodeInfo l_node_info_;
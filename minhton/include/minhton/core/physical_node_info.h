@@ -11,7 +11,7 @@
 #include <string>
 #include <vector>
 
-#include "solanet/serializer/serialize.h"
+#include "minhton/utils/compact_archive_tag.h"
 
 namespace minhton {
 constexpr uint16_t kPortMin = 1024;
@@ -92,7 +92,14 @@ public:
   /// \returns true if the calculated unique value of n1 is larger or equal than that of n2
   friend bool operator>=(const minhton::PhysicalNodeInfo &n1, const minhton::PhysicalNodeInfo &n2);
 
-  SERIALIZE(address_, port_);
+  template <class Archive> void serialize(Archive &archive) {
+    if constexpr (serializer::kIsCompactArchive<Archive>) {
+      archive.address(address_);
+      archive(port_);
+    } else {
+      archive(address_, port_);
+    }
+  }
 
 private:
   uint16_t port_ = 0;
@@ -7,7 +7,11 @@
 #ifndef MINHTON_CORE_ROUTING_CALCULATIONS_H_
 #define MINHTON_CORE_ROUTING_CALCULATIONS_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
 #include <set>
 #include <tuple>
 #include <vector>
@@ -152,6 +156,179 @@ std::vector<std::tuple<uint32_t, uint32_t>> calcLeftRT(uint32_t level, uint32_t
 std::vector<std::tuple<uint32_t, uint32_t>> calcRightRT(uint32_t level, uint32_t number,
                                                         uint16_t fanout);
 
+///
+/// Lazy, allocation-free view of an ordered set of node numbers on one level, which consists of
+/// an arithmetic progression and an optional last number. This is the shape of the prio sets and
+/// the DSN sets (see getPrioSetView and getDSNSetView).
+///
+/// Membership, rank and the neighboring numbers are calculated arithmetically, so that the set
+/// never has to be materialized. Iterating over the view generates the numbers on the fly.
+///
+/// Typical usage:
+/// \code
+///     auto dsn_set = getDSNSetView(4, 2);
+///     bool is_dsn = dsn_set.contains(6);
+///     auto next_dsn = dsn_set.lowerBound(7);  // 10
+/// \endcode
+///
+class NumberSetView {
+public:
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const uint32_t *;
+    using reference = uint32_t;
+
+    constexpr Iterator() = default;
+    constexpr Iterator(const NumberSetView *view, uint64_t index) : view_(view), index_(index) {}
+
+    constexpr uint32_t operator*() const { return (*view_)[index_]; }
+    constexpr Iterator &operator++() {
+      index_++;
+      return *this;
+    }
+    constexpr Iterator operator++(int) {
+      Iterator previous = *this;
+      index_++;
+      return previous;
+    }
+    constexpr bool operator==(const Iterator &other) const { return index_ == other.index_; }
+    constexpr bool operator!=(const Iterator &other) const { return index_ != other.index_; }
+
+  private:
+    const NumberSetView *view_ = nullptr;
+    uint64_t index_ = 0;
+  };
+
+  /// Empty set
+  constexpr NumberSetView() = default;
+
+  /// Set of first, first + step, ... (count numbers), followed by last if has_last is true.
+  /// last must be greater than all other numbers.
+  constexpr NumberSetView(uint64_t first, uint64_t step, uint64_t count, bool has_last = false,
+                          uint64_t last = 0)
+      : first_(first), step_(step), count_(count), has_last_(has_last), last_(last) {}
+
+  constexpr uint64_t size() const { return count_ + (has_last_ ? 1 : 0); }
+  constexpr bool empty() const { return size() == 0; }
+
+  /// \returns the number at the given index, which must be smaller than size()
+  constexpr uint32_t operator[](uint64_t index) const {
+    return static_cast<uint32_t>(index < count_ ? first_ + index * step_ : last_);
+  }
+
+  constexpr uint32_t front() const { return (*this)[0]; }
+  constexpr uint32_t back() const { return (*this)[size() - 1]; }
+
+  constexpr bool contains(uint32_t number) const { return rank(number).has_value(); }
+
+  /// \returns the index of the number within the set, or nullopt if it is not part of the set
+  constexpr std::optional<uint64_t> rank(uint32_t number) const {
+    if (has_last_ && number == last_) return count_;
+    if (count_ == 0 || number < first_) return std::nullopt;
+
+    const uint64_t offset = number - first_;
+    if (offset % step_ != 0 || offset / step_ >= count_) return std::nullopt;
+    return offset / step_;
+  }
+
+  /// \returns the index of the first number which is not smaller than the given number
+  /// (size() if there is none)
+  constexpr uint64_t lowerBoundIndex(uint32_t number) const {
+    uint64_t index = 0;
+    if (count_ > 0 && number > first_) {
+      // Ceiling division without overflow
+      const uint64_t offset = number - first_;
+      index = offset / step_ + (offset % step_ != 0 ? 1 : 0);
+    }
+    if (index < count_) return index;
+    return has_last_ && number <= last_ ? count_ : size();
+  }
+
+  /// \returns the smallest number of the set which is not smaller than the given number
+  constexpr std::optional<uint32_t> lowerBound(uint32_t number) const {
+    const uint64_t index = lowerBoundIndex(number);
+    if (index == size()) return std::nullopt;
+    return (*this)[index];
+  }
+
+  /// \returns the smallest number of the set which is greater than the given number
+  constexpr std::optional<uint32_t> next(uint32_t number) const {
+    if (number == std::numeric_limits<uint32_t>::max()) return std::nullopt;
+    return lowerBound(number + 1);
+  }
+
+  /// \returns the greatest number of the set which is smaller than the given number
+  constexpr std::optional<uint32_t> previous(uint32_t number) const {
+    const uint64_t index = lowerBoundIndex(number);
+    if (index == 0) return std::nullopt;
+    return (*this)[index - 1];
+  }
+
+  constexpr Iterator begin() const { return {this, 0}; }
+  constexpr Iterator end() const { return {this, size()}; }
+
+private:
+  uint64_t first_ = 0;
+  uint64_t step_ = 1;
+  uint64_t count_ = 0;
+  bool has_last_ = false;
+  uint64_t last_ = 0;
+};
+
+///
+/// \returns fanout^level, saturated at the maximum of uint64_t
+///
+constexpr uint64_t calcNodesOnLevel(uint32_t level, uint16_t fanout) {
+  uint64_t nodes = 1;
+  for (uint32_t i = 0; i < level; i++) {
+    if (nodes > std::numeric_limits<uint64_t>::max() / fanout) {
+      return std::numeric_limits<uint64_t>::max();
+    }
+    nodes *= fanout;
+  }
+  return nodes;
+}
+
+namespace detail {
+// Numbers fanout, 3 * fanout, 5 * fanout, ... up to the last number of the level, followed by
+// (last number - fanout) if it is not part of them. Level must be >= 2.
+constexpr NumberSetView calcSpacedSetView(uint32_t level, uint16_t fanout) {
+  const uint64_t max_number = calcNodesOnLevel(level, fanout) - 1;
+  const uint64_t step = 2 * static_cast<uint64_t>(fanout);
+  const uint64_t count = (max_number - fanout) / step + 1;
+  const uint64_t last_regular = fanout + (count - 1) * step;
+  return {fanout, step, count, last_regular < max_number - fanout, max_number - fanout};
+}
+}  // namespace detail
+
+///
+/// Allocation-free view of the prio set of a level, which contains the same numbers as
+/// calcPrioSet.
+///
+constexpr NumberSetView getPrioSetView(uint32_t level, uint16_t fanout) {
+  if (level == 0) return {0, 1, 1};
+  if (level == 1) return {(fanout + 1U) / 2, 1, 1};
+  return detail::calcSpacedSetView(level, fanout);
+}
+
+///
+/// Allocation-free view of the DSN set of a level, which contains the same numbers as getDSNSet.
+/// Only even levels contain DSNs.
+///
+constexpr NumberSetView getDSNSetView(uint32_t level, uint16_t fanout) {
+  if (level % 2 == 1) return {};
+  if (level == 0) return {0, 1, 1};
+  return detail::calcSpacedSetView(level, fanout);
+}
+
+/// \returns true if the node at the given position is a DSN
+constexpr bool isDSN(uint32_t level, uint32_t number, uint16_t fanout) {
+  return getDSNSetView(level, fanout).contains(number);
+}
+
 ///
 /// Calculates the numbers of the prio nodes, with a given level and fanout.
 ///
@@ -205,6 +382,76 @@ double treeMapper(uint32_t level, uint32_t number, uint16_t fanout, double K);
 std::tuple<double, double, double> treeMapperInternal(uint32_t level, uint32_t number,
                                                       uint16_t fanout, uint8_t K);
 
+/// \returns the deepest level for which calcHorizontalKey is exact, i.e. the largest level with
+/// fanout^(level + 1) still fitting into uint64_t, or 0 for an invalid fanout
+constexpr uint32_t calcHorizontalKeyMaxLevel(uint16_t fanout) {
+  if (fanout < 2) return 0;
+
+  uint32_t level = 0;
+  for (uint64_t width = fanout; width <= std::numeric_limits<uint64_t>::max() / fanout;
+       width *= fanout) {
+    level++;
+  }
+  return level;
+}
+
+///
+/// Exact integer counterpart of the treeMapper. For the same fanout, the keys are ordered like the
+/// horizontal values, i.e. like an in-order traversal of the tree in which the first
+/// ceil(fanout / 2) children are to the left of their parent.
+///
+/// The key is the center of the position within a root interval of width fanout^(max level + 1):
+/// (number * fanout + ceil(fanout / 2)) * fanout^(max level - level).
+///
+/// Typical usage:
+/// \code
+///     bool left_of = calcHorizontalKey(3, 1, 2) < calcHorizontalKey(2, 1, 2);
+/// \endcode
+///
+/// \returns the key, which is > 0, or 0 if the fanout is invalid or the level is deeper than
+/// calcHorizontalKeyMaxLevel(fanout)
+///
+constexpr uint64_t calcHorizontalKey(uint32_t level, uint32_t number, uint16_t fanout) {
+  const uint32_t max_level = calcHorizontalKeyMaxLevel(fanout);
+  if (fanout < 2 || level > max_level) return 0;
+
+  uint64_t key = static_cast<uint64_t>(number) * fanout + (fanout + 1) / 2;
+  for (uint64_t base = fanout, exponent = max_level - level; exponent != 0; exponent /= 2) {
+    if (exponent % 2 == 1) key *= base;
+    if (exponent > 1) base *= base;
+  }
+  return key;
+}
+
+///
+/// Exact horizontal comparison of two positions with the same fanout at any level, for positions
+/// without a horizontal key. The deeper position is moved up to the level of the other one. If it
+/// is a descendant of the other one, the child taken in the last step decides about the side.
+///
+/// \returns a negative value if the first position is to the left of the second one, a positive
+/// value if it is to the right, and 0 if both are equal
+///
+constexpr int compareHorizontalPositions(uint32_t level_1, uint32_t number_1, uint32_t level_2,
+                                         uint32_t number_2, uint16_t fanout) {
+  // Deeper position as (level, number), the other one as (other_level, other_number)
+  const int sign = level_1 >= level_2 ? 1 : -1;
+  uint32_t level = sign > 0 ? level_1 : level_2;
+  uint32_t number = sign > 0 ? number_1 : number_2;
+  const uint32_t other_level = sign > 0 ? level_2 : level_1;
+  const uint32_t other_number = sign > 0 ? number_2 : number_1;
+
+  uint32_t child = 0;
+  const bool descended = level > other_level;
+  for (; level > other_level; level--) {
+    child = number % fanout;
+    number /= fanout;
+  }
+
+  if (number != other_number) return number < other_number ? -sign : sign;
+  if (!descended) return 0;
+  return child < static_cast<uint32_t>(fanout + 1) / 2 ? -sign : sign;
+}
+
 std::tuple<uint32_t, uint32_t> getCoveringDSN(uint32_t level, uint32_t number, uint16_t fanout);
 std::vector<std::tuple<uint32_t, uint32_t>> getCoverArea(uint32_t level, uint32_t number,
                                                          uint16_t fanout);
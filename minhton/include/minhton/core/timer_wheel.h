@@ -0,0 +1,194 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef MINHTON_CORE_TIMER_WHEEL_H_
+#define MINHTON_CORE_TIMER_WHEEL_H_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace minhton::core {
+
+/**
+ * Identifies a scheduled timer. Handles of fired or cancelled timers stay invalid, even if their
+ * timer node is reused.
+ */
+struct TimerHandle {
+  uint32_t index = UINT32_MAX;
+  uint32_t generation = 0;
+
+  bool operator==(const TimerHandle &other) const {
+    return index == other.index && generation == other.generation;
+  }
+  bool operator!=(const TimerHandle &other) const { return !(*this == other); }
+};
+
+/**
+ * Hierarchical timing wheel with four levels of 64 slots each, counting in ticks.
+ *
+ * Timers are kept in pooled nodes, which are linked into the slot of their expiry, so that
+ * scheduling and cancelling are O(1). Timers of higher levels are cascaded into lower levels when
+ * the wheel reaches them. Timers further away than the range of the wheel are cascaded again
+ * until they are in range.
+ *
+ * Not thread safe, see TimerService.
+ *
+ * Typical usage:
+ * \code
+ *     TimerWheel wheel;
+ *     TimerHandle handle = wheel.schedule(100, []() { ... });
+ *     wheel.cancel(handle);
+ *     std::vector<std::pair<TimerHandle, std::function<void()>>> expired;
+ *     wheel.advance(200, expired);
+ * \endcode
+ */
+class TimerWheel {
+public:
+  using Expired = std::vector<std::pair<TimerHandle, std::function<void()>>>;
+
+  static constexpr uint32_t kSlotBits = 6;
+  static constexpr uint32_t kSlots = 1U << kSlotBits;
+  static constexpr uint32_t kLevels = 4;
+  static constexpr uint64_t kRange = uint64_t{1} << (kSlotBits * kLevels);
+
+  TimerWheel();
+
+  /**
+   * Schedules the function to expire after the given number of ticks, at least one
+   * @return handle to cancel the timer
+   */
+  TimerHandle schedule(uint64_t ticks, std::function<void()> function);
+
+  /**
+   * Removes the timer if it did not expire yet
+   * @return true if the timer was removed
+   */
+  bool cancel(const TimerHandle &handle);
+
+  /// @return true if the timer did not expire and was not cancelled
+  bool isPending(const TimerHandle &handle) const {
+    return handle.index < nodes_.size() && nodes_[handle.index].pending &&
+           nodes_[handle.index].generation == handle.generation;
+  }
+
+  /**
+   * Advances the wheel to the given tick and appends all expired timers, ordered by their expiry
+   */
+  void advance(uint64_t tick, Expired &expired);
+
+  /// @return the tick of the next expiry or cascade, or std::nullopt without timers
+  std::optional<uint64_t> getNextTick() const;
+
+  uint64_t getCurrentTick() const { return current_tick_; }
+  std::size_t size() const { return size_; }
+
+private:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  struct Node {
+    std::function<void()> function;
+    uint64_t expiry = 0;
+    uint32_t previous = kNone;
+    uint32_t next = kNone;
+    uint32_t generation = 0;
+    uint8_t level = 0;
+    uint8_t slot = 0;
+    bool pending = false;
+  };
+
+  void link(uint32_t index);
+  void unlink(uint32_t index);
+  void release(uint32_t index);
+  void cascade(uint32_t level);
+
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> free_nodes_;
+
+  std::array<std::array<uint32_t, kSlots>, kLevels> slots_;
+
+  // One bit per non-empty slot of each level
+  std::array<uint64_t, kLevels> occupied_{};
+
+  uint64_t current_tick_ = 0;
+  std::size_t size_ = 0;
+};
+
+/**
+ * Runs a TimerWheel with millisecond ticks on its own thread. All WatchDogs of a process share one
+ * service, see getInstance.
+ *
+ * Functions are executed on the thread of the service. Once cancel returns, the function of the
+ * timer is neither running nor will it run, unless cancel is called by the function itself.
+ *
+ * Typical usage:
+ * \code
+ *     auto &service = TimerService::getInstance();
+ *     TimerHandle handle = service.schedule(500, []() { ... });
+ *     service.cancel(handle);
+ * \endcode
+ */
+class TimerService {
+public:
+  TimerService();
+  ~TimerService();
+
+  TimerService(const TimerService &) = delete;
+  TimerService &operator=(const TimerService &) = delete;
+  TimerService(TimerService &&) = delete;
+  TimerService &operator=(TimerService &&) = delete;
+
+  /// @return the service shared by the whole process
+  static TimerService &getInstance();
+
+  TimerHandle schedule(uint32_t milliseconds, std::function<void()> function);
+
+  /**
+   * Cancels the timer, waiting for its function to return if it is running on another thread
+   * @return true if the timer was cancelled before its function started
+   */
+  bool cancel(const TimerHandle &handle);
+
+  /// @return true if the function of the timer did not return yet and the timer was not cancelled
+  bool isActive(const TimerHandle &handle) const;
+
+  /// @return the number of timers which were not executed or cancelled yet
+  std::size_t size() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void run();
+  uint64_t getTick() const;
+
+  const Clock::time_point start_ = Clock::now();
+
+  mutable std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::condition_variable finished_;
+
+  TimerWheel wheel_;
+  TimerWheel::Expired expired_;
+  std::size_t next_expired_ = 0;
+  std::optional<TimerHandle> running_;
+
+  // Tick until which the runner waits, earlier timers have to wake it up
+  uint64_t wakeup_tick_ = 0;
+
+  bool stop_ = false;
+  std::thread runner_;
+};
+
+}  // namespace minhton::core
+
+#endif
@@ -15,7 +15,8 @@
 namespace minhton::core {
 
 /**
- * Helper class to execute functions after a given time asynchronous
+ * Helper class to execute functions after a given time asynchronous, on the thread of the
+ * TimerService shared by the whole process
  */
 class WatchDog {
 public:
@@ -28,12 +29,17 @@ public:
   WatchDog &operator=(const WatchDog &&) = delete;
 
   /**
-   * Add new job to watchdog (only one job can exist at a time for now)
+   * Add new job to watchdog
    * @param function function to execute
    * @param milliseconds milliseconds until \p function will be executed.
+   * @param timeout_type type to cancel the job with
    */
   void addJob(std::function<void()> function, uint32_t milliseconds, TimeoutType &timeout_type);
 
+  /**
+   * Cancel all jobs of the type, so that they are not executed anymore. Waits for jobs of the type
+   * which are running on another thread.
+   */
   void cancelJob(const TimeoutType &timeout_type);
 
 private:
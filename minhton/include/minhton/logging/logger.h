@@ -7,6 +7,7 @@
 #ifndef MINHTON_LOGGING_LOGGER_H_
 #define MINHTON_LOGGING_LOGGER_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -15,8 +16,13 @@
 
 namespace minhton {
 
-enum class LogLevel { kDebug, kInfo, kWarning, kCritical };
-
+///
+/// Dispatches log messages and records to all added loggers.
+///
+/// String messages are only passed on for levels at or above the log level, and only to loggers
+/// which enabled that level. Use the macros from logging.h, which check isEnabled before building
+/// the message.
+///
 class Logger {
 public:
   using LoggerPtr = std::shared_ptr<LoggerInterface>;
@@ -28,6 +34,14 @@ public:
   void logInfo(const std::string &msg) const;
   void logDebug(const std::string &msg) const;
 
+  /// \returns true if any logger wants string messages of the level
+  bool isEnabled(LogLevel level) const {
+    return (enabled_levels_ & (1U << static_cast<uint32_t>(level))) != 0;
+  }
+
+  /// \returns true if there is any logger to pass records to
+  bool hasLoggers() const { return !logger_list_.empty(); }
+
   void logNodeUninit(const LoggerInfoNodeState &info);
   void logNodeRunning(const LoggerInfoNodeState &info);
   void logNodeLeft(const LoggerInfoNodeState &info);
@@ -50,9 +64,17 @@ public:
 private:
   // Command pattern
   template <typename LogFunction> void logCommand(LogFunction function) const;
+  template <typename LogFunction> void logMessage(LogLevel level, LogFunction function) const;
+
+  /// Recalculates the enabled levels of each logger and of all of them together
+  void updateEnabledLevels();
 
   std::vector<LoggerPtr> logger_list_;
 
+  // Bit masks of the enabled levels, one per logger
+  std::vector<uint8_t> logger_levels_;
+  uint8_t enabled_levels_ = 0;
+
   LogLevel log_level_ = LogLevel::kDebug;
 };
 
@@ -16,6 +16,9 @@
 
 namespace minhton {
 
+/// Levels of string messages in ascending order, the values are used by MINHTON_LOG_LEVEL
+enum class LogLevel { kDebug = 0, kInfo = 1, kWarning = 2, kCritical = 3 };
+
 struct LoggerInfoSearchExact {
   uint64_t timestamp;
   uint64_t event_id;
@@ -93,6 +96,10 @@ public:
   virtual void logInfo(const std::string &msg) const = 0;
   virtual void logDebug(const std::string &msg) const = 0;
 
+  /// Loggers can reject string messages of some levels, which are then neither built nor passed
+  /// to them. Queried whenever the logger is added to a Logger or the log level changes.
+  virtual bool isLogLevelEnabled(LogLevel /*level*/) const { return true; }
+
   // Used for loggers which are initialized before node starts
   virtual void setApplicationUUID(const solanet::UUID &app_uuid) = 0;
 
@@ -9,37 +9,60 @@
 
 #include "minhton/logging/logger.h"
 
-#define LOG_CRITICAL(M) access_->logger.logCritical(M)
-#define LOG_WARNING(M) access_->logger.logWarning(M)
-#define LOG_INFO(M) access_->logger.logInfo(M)
-#define LOG_DEBUG(M) access_->logger.logDebug(M)
+// Lowest level of string messages which is compiled at all, see LogLevel
+#ifndef MINHTON_LOG_LEVEL
+#define MINHTON_LOG_LEVEL 0
+#endif
+
+// The message is only built if a logger wants its level
+#define MINHTON_LOG_MESSAGE(level, log_function, M)                          \
+  do {                                                                       \
+    if constexpr (static_cast<int>(level) >= MINHTON_LOG_LEVEL) {            \
+      if (access_->logger.isEnabled(level)) access_->logger.log_function(M); \
+    }                                                                        \
+  } while (false)
+
+// The record is only built if there is any logger
+#define MINHTON_LOG_RECORD(log_function, ...)                                    \
+  do {                                                                           \
+    if (access_->logger.hasLoggers()) access_->logger.log_function(__VA_ARGS__); \
+  } while (false)
+
+#define LOG_CRITICAL(M) MINHTON_LOG_MESSAGE(minhton::LogLevel::kCritical, logCritical, M)
+#define LOG_WARNING(M) MINHTON_LOG_MESSAGE(minhton::LogLevel::kWarning, logWarning, M)
+#define LOG_INFO(M) MINHTON_LOG_MESSAGE(minhton::LogLevel::kInfo, logInfo, M)
+#define LOG_DEBUG(M) MINHTON_LOG_MESSAGE(minhton::LogLevel::kDebug, logDebug, M)
 
-#define LOG_NODE(n)                                                                               \
-  (access_->logger.logNode(minhton::LoggerInfoAddNode{n.getLogicalNodeInfo().getUuid(),           \
-                                                      n.getLevel(), n.getNumber(), n.getFanout(), \
-                                                      n.isValidPeer()}))
+#define LOG_NODE(n)                                                               \
+  MINHTON_LOG_RECORD(logNode, minhton::LoggerInfoAddNode{                         \
+                                  n.getLogicalNodeInfo().getUuid(), n.getLevel(), \
+                                  n.getNumber(), n.getFanout(), n.isValidPeer()})
 
 #define LOG_EVENT(event_type, event_id) \
-  (access_->logger.logEvent(minhton::LoggerInfoAddEvent{0, event_type, event_id}))
+  MINHTON_LOG_RECORD(logEvent, minhton::LoggerInfoAddEvent{0, event_type, event_id})
 
 #define LOG_SEARCH_EXACT(status, event_id, sender, target, hop)                      \
-  (access_->logger.logSearchExactTest(minhton::LoggerInfoSearchExact{                \
-      0, event_id, status, sender.getLevel(), sender.getNumber(), target.getLevel(), \
-      target.getNumber(), hop.getLevel(), hop.getNumber()}))
-
-#define LOG_CONTENT(n, content_status, attribute_name, content_type, content_text)               \
-  (access_->logger.logContent(minhton::LoggerInfoAddContent{0, n.getLogicalNodeInfo().getUuid(), \
-                                                            content_status, attribute_name,      \
-                                                            content_type, content_text}))
-
-#define LOG_FIND_QUERY(event_id, initiator, find_query)                                    \
-  (access_->logger.logFindQuery(minhton::LoggerInfoAddFindQuery{                           \
-      0, event_id, initiator.getLogicalNodeInfo().getUuid(),                               \
-      find_query.getInquireUnknownAttributes(), find_query.getInquireOutdatedAttributes(), \
-      find_query.serializeBooleanExpression()}))
-
-#define LOG_FIND_QUERY_RESULT(event_id, result_node)                         \
-  (access_->logger.logFindQueryResult(minhton::LoggerInfoAddFindQueryResult{ \
-      0, event_id, result_node.getLogicalNodeInfo().getUuid()}))
+  MINHTON_LOG_RECORD(logSearchExactTest,                                             \
+                     minhton::LoggerInfoSearchExact{                                 \
+                         0, event_id, status, sender.getLevel(), sender.getNumber(), \
+                         target.getLevel(), target.getNumber(), hop.getLevel(),      \
+                         hop.getNumber()})
+
+#define LOG_CONTENT(n, content_status, attribute_name, content_type, content_text)        \
+  MINHTON_LOG_RECORD(logContent, minhton::LoggerInfoAddContent{                           \
+                                     0, n.getLogicalNodeInfo().getUuid(), content_status, \
+                                     attribute_name, content_type, content_text})
+
+#define LOG_FIND_QUERY(event_id, initiator, find_query)                                       \
+  MINHTON_LOG_RECORD(logFindQuery, minhton::LoggerInfoAddFindQuery{                           \
+                                       0, event_id, initiator.getLogicalNodeInfo().getUuid(), \
+                                       find_query.getInquireUnknownAttributes(),              \
+                                       find_query.getInquireOutdatedAttributes(),             \
+                                       find_query.serializeBooleanExpression()})
+
+#define LOG_FIND_QUERY_RESULT(event_id, result_node)        \
+  MINHTON_LOG_RECORD(logFindQueryResult,                    \
+                     minhton::LoggerInfoAddFindQueryResult{ \
+                         0, event_id, result_node.getLogicalNodeInfo().getUuid()})
 
 #endif
@@ -15,14 +15,21 @@
 namespace minhton {
 /**
  * Facade to abstract serialization and networking
+ *
+ * Messages are sent in the configured wire format. Once a message in the compact wire format is
+ * received, the facade switches to the compact format as well, so that nodes joining a network
+ * adopt the format of the network.
  */
 class NetworkFacade {
 public:
-  NetworkFacade(std::function<void(const MessageVariant &msg)> recv_fct, const std::string &ip);
+  NetworkFacade(std::function<void(const MessageVariant &msg)> recv_fct, const std::string &ip,
+                WireFormat wire_format = WireFormat::kBinary,
+                const solanet::NetworkOptions &network_options = {});
   void send(const MessageVariant &msg);
 
   std::string getIP() const;
   uint16_t getPort() const;
+  WireFormat getWireFormat() const;
 
 private:
   void processMessage(const solanet::Message &msg);
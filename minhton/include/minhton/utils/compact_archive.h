@@ -0,0 +1,282 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef MINHTON_UTILS_COMPACT_ARCHIVE_H_
+#define MINHTON_UTILS_COMPACT_ARCHIVE_H_
+
+#ifndef CPPCHECK_IGNORE
+#include <cereal/cereal.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "minhton/utils/compact_archive_tag.h"
+
+///
+/// Compact wire format for MINHTON messages. Compared to the binary format it
+///   - encodes size tags (containers, strings) as varints instead of 8 bytes,
+///   - encodes the position of peers (level, number, fanout) as varints,
+///   - encodes IPv4 addresses as 4 raw bytes instead of a length-prefixed string,
+///   - replaces peers which occur more than once within a message (e.g. a neighbor in the header
+///     and in the payload) by a varint reference to their first occurrence.
+/// Everything else is encoded like in the binary format.
+///
+
+namespace minhton::serializer {
+
+/// Address kinds of the compact encoding of PhysicalNodeInfo
+enum class CompactAddressKind : uint8_t { kString = 0, kIPv4 = 4 };
+
+/// Parses an address in canonical dotted-decimal IPv4 notation (no leading zeros), so that
+/// formatting the parsed bytes yields the same string again
+inline bool parseCanonicalIPv4(std::string_view address, std::array<uint8_t, 4> &bytes) {
+  std::size_t position = 0;
+  for (std::size_t i = 0; i < bytes.size(); i++) {
+    if (i > 0) {
+      if (position >= address.size() || address[position] != '.') return false;
+      position++;
+    }
+
+    std::size_t start = position;
+    uint32_t value = 0;
+    while (position < address.size() && address[position] >= '0' && address[position] <= '9' &&
+           position - start < 3) {
+      value = value * 10 + (address[position] - '0');
+      position++;
+    }
+
+    std::size_t digits = position - start;
+    if (digits == 0 || value > 255 || (digits > 1 && address[start] == '0')) return false;
+    bytes[i] = static_cast<uint8_t>(value);
+  }
+  return position == address.size();
+}
+
+inline std::string formatIPv4(const std::array<uint8_t, 4> &bytes) {
+  return std::to_string(bytes[0]) + "." + std::to_string(bytes[1]) + "." +
+         std::to_string(bytes[2]) + "." + std::to_string(bytes[3]);
+}
+
+/**
+ * Compact output archive appending to a caller-provided buffer.
+ * The peer dictionary spans everything written with one archive instance, i.e. one message.
+ */
+class CompactOutputArchive
+    : public cereal::OutputArchive<CompactOutputArchive, cereal::AllowEmptyClassElision>,
+      public CompactArchiveTag {
+public:
+  explicit CompactOutputArchive(std::string &buffer)
+      : cereal::OutputArchive<CompactOutputArchive, cereal::AllowEmptyClassElision>(this),
+        buffer_(buffer) {}
+
+  ~CompactOutputArchive() CEREAL_NOEXCEPT = default;
+
+  void saveBinary(const void *data, std::streamsize size) {
+    buffer_.append(static_cast<const char *>(data), static_cast<std::size_t>(size));
+  }
+
+  /// LEB128 encoding: 7 bits per byte, least significant group first
+  template <typename T> void varint(const T &value) {
+    static_assert(std::is_unsigned_v<T>, "Only unsigned integers can be encoded as varint");
+    uint64_t remaining = value;
+    while (remaining >= 0x80) {
+      buffer_.push_back(static_cast<char>((remaining & 0x7F) | 0x80));
+      remaining >>= 7;
+    }
+    buffer_.push_back(static_cast<char>(remaining));
+  }
+
+  void address(const std::string &address) {
+    std::array<uint8_t, 4> bytes{};
+    if (parseCanonicalIPv4(address, bytes)) {
+      buffer_.push_back(static_cast<char>(CompactAddressKind::kIPv4));
+      saveBinary(bytes.data(), bytes.size());
+    } else {
+      buffer_.push_back(static_cast<char>(CompactAddressKind::kString));
+      varint(address.size());
+      saveBinary(address.data(), static_cast<std::streamsize>(address.size()));
+    }
+  }
+
+  /**
+   * Writes a peer with the given function, unless exactly the same encoding was already written
+   * within this message. In that case only a reference to the first occurrence is kept.
+   * Layout: varint 0 followed by the encoded peer, or varint i referring to the i-th peer (1-based)
+   */
+  template <typename Function> void peer(Function &&save_fields) {
+    const std::size_t start = buffer_.size();
+    varint(0U);
+    const std::size_t body = buffer_.size();
+    save_fields(*this);
+
+    std::string_view encoded(buffer_.data() + body, buffer_.size() - body);
+    for (std::size_t i = 0; i < peers_.size(); i++) {
+      if (encoded == std::string_view(buffer_.data() + peers_[i].first, peers_[i].second)) {
+        buffer_.resize(start);
+        varint(i + 1);
+        return;
+      }
+    }
+    peers_.emplace_back(body, encoded.size());
+  }
+
+private:
+  std::string &buffer_;
+
+  /// Offset and length of the encoded peers within buffer_
+  std::vector<std::pair<std::size_t, std::size_t>> peers_;
+};
+
+/**
+ * Compact input archive reading from a non-owning view.
+ * The viewed data must outlive the archive.
+ */
+class CompactInputArchive
+    : public cereal::InputArchive<CompactInputArchive, cereal::AllowEmptyClassElision>,
+      public CompactArchiveTag {
+public:
+  explicit CompactInputArchive(std::string_view buffer)
+      : cereal::InputArchive<CompactInputArchive, cereal::AllowEmptyClassElision>(this),
+        buffer_(buffer) {}
+
+  ~CompactInputArchive() CEREAL_NOEXCEPT = default;
+
+  void loadBinary(void *const data, std::streamsize size) {
+    auto length = static_cast<std::size_t>(size);
+    if (length > buffer_.size() - position_) {
+      throw cereal::Exception("Failed to read " + std::to_string(size) +
+                              " bytes from input buffer! Read " +
+                              std::to_string(buffer_.size() - position_));
+    }
+
+    std::memcpy(data, buffer_.data() + position_, length);
+    position_ += length;
+  }
+
+  template <typename T> void varint(T &value) {
+    static_assert(std::is_unsigned_v<T>, "Only unsigned integers can be encoded as varint");
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      if (position_ >= buffer_.size()) {
+        throw cereal::Exception("Failed to read varint from input buffer!");
+      }
+
+      auto byte = static_cast<uint8_t>(buffer_[position_++]);
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        if (result > std::numeric_limits<T>::max()) {
+          throw cereal::Exception("Varint " + std::to_string(result) + " out of range!");
+        }
+        value = static_cast<T>(result);
+        return;
+      }
+    }
+    throw cereal::Exception("Varint exceeds 64 bits!");
+  }
+
+  void address(std::string &address) {
+    uint8_t kind_value = 0;
+    loadBinary(&kind_value, sizeof(kind_value));
+    auto kind = static_cast<CompactAddressKind>(kind_value);
+    if (kind == CompactAddressKind::kIPv4) {
+      std::array<uint8_t, 4> bytes{};
+      loadBinary(bytes.data(), bytes.size());
+      address = formatIPv4(bytes);
+    } else if (kind == CompactAddressKind::kString) {
+      std::size_t size = 0;
+      varint(size);
+      address.resize(std::min(size, buffer_.size() - position_));
+      loadBinary(address.data(), static_cast<std::streamsize>(size));
+    } else {
+      throw cereal::Exception("Unknown address kind " + std::to_string(kind_value));
+    }
+  }
+
+  /// Counterpart of CompactOutputArchive::peer. References are resolved by loading the peer again
+  /// from its first occurrence.
+  template <typename Function> void peer(Function &&load_fields) {
+    std::size_t reference = 0;
+    varint(reference);
+
+    if (reference == 0) {
+      const std::size_t body = position_;
+      load_fields(*this);
+      peers_.emplace_back(body, position_ - body);
+      return;
+    }
+
+    if (reference > peers_.size()) {
+      throw cereal::Exception("Invalid peer reference " + std::to_string(reference));
+    }
+    const auto &[offset, length] = peers_[reference - 1];
+    CompactInputArchive peer_archive(buffer_.substr(offset, length));
+    load_fields(peer_archive);
+  }
+
+private:
+  std::string_view buffer_;
+  std::size_t position_ = 0;
+
+  /// Offset and length of the encoded peers within buffer_
+  std::vector<std::pair<std::size_t, std::size_t>> peers_;
+};
+
+// Serialization functions like those of cereal's binary archives, except for size tags
+
+template <class T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, void>::type CEREAL_SAVE_FUNCTION_NAME(
+    CompactOutputArchive &ar, T const &t) {
+  ar.saveBinary(std::addressof(t), sizeof(t));
+}
+
+template <class T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, void>::type CEREAL_LOAD_FUNCTION_NAME(
+    CompactInputArchive &ar, T &t) {
+  ar.loadBinary(std::addressof(t), sizeof(t));
+}
+
+template <class Archive, class T>
+inline CEREAL_ARCHIVE_RESTRICT(CompactInputArchive, CompactOutputArchive)
+    CEREAL_SERIALIZE_FUNCTION_NAME(Archive &ar, cereal::NameValuePair<T> &t) {
+  ar(t.value);
+}
+
+template <class Archive, class T>
+inline CEREAL_ARCHIVE_RESTRICT(CompactInputArchive, CompactOutputArchive)
+    CEREAL_SERIALIZE_FUNCTION_NAME(Archive &ar, cereal::SizeTag<T> &t) {
+  ar.varint(t.size);
+}
+
+template <class T>
+inline void CEREAL_SAVE_FUNCTION_NAME(CompactOutputArchive &ar, cereal::BinaryData<T> const &bd) {
+  ar.saveBinary(bd.data, static_cast<std::streamsize>(bd.size));
+}
+
+template <class T>
+inline void CEREAL_LOAD_FUNCTION_NAME(CompactInputArchive &ar, cereal::BinaryData<T> &bd) {
+  ar.loadBinary(bd.data, static_cast<std::streamsize>(bd.size));
+}
+
+}  // namespace minhton::serializer
+
+CEREAL_REGISTER_ARCHIVE(minhton::serializer::CompactOutputArchive)
+CEREAL_REGISTER_ARCHIVE(minhton::serializer::CompactInputArchive)
+
+// Tie input and output archives together
+CEREAL_SETUP_ARCHIVE_TRAITS(minhton::serializer::CompactInputArchive,
+                            minhton::serializer::CompactOutputArchive)
+
+#endif  // MINHTON_UTILS_COMPACT_ARCHIVE_H_
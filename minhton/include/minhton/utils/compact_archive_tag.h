@@ -0,0 +1,24 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef MINHTON_UTILS_COMPACT_ARCHIVE_TAG_H_
+#define MINHTON_UTILS_COMPACT_ARCHIVE_TAG_H_
+
+#include <type_traits>
+
+namespace minhton::serializer {
+
+/// Common base of the archives implementing the compact wire format (see compact_archive.h).
+/// Types with a dedicated compact encoding branch on kIsCompactArchive in their serialize method,
+/// so that they do not depend on cereal themselves.
+struct CompactArchiveTag {};
+
+template <class Archive>
+inline constexpr bool kIsCompactArchive = std::is_base_of_v<CompactArchiveTag, Archive>;
+
+}  // namespace minhton::serializer
+
+#endif  // MINHTON_UTILS_COMPACT_ARCHIVE_TAG_H_
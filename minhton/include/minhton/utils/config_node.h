@@ -14,6 +14,7 @@
 #include "minhton/logging/logger.h"
 #include "minhton/utils/algorithm_types_container.h"
 #include "minhton/utils/timeout_lengths_container.h"
+#include "solanet/network_udp/network_udp.h"
 
 namespace minhton {
 ///
@@ -52,6 +53,14 @@ private:
 
   bool verbose_ = false;
 
+  /// Wire format used for sending. Nodes switch to the compact format once they receive a message
+  /// in the compact format, so it is sufficient to configure it for the root.
+  WireFormat wire_format_ = WireFormat::kBinary;
+
+  /// Options of the network interface, e.g. to share the I/O threads and the socket of the
+  /// process with other overlays
+  solanet::NetworkOptions network_options_{};
+
   TimeoutLengthsContainer timeout_lengths_container_{};
   AlgorithmTypesContainer algorithm_types_container_{};
 
@@ -68,6 +77,12 @@ public:
   bool getVerbose() const;
   void setVerbose(bool verbose);
 
+  WireFormat getWireFormat() const;
+  void setWireFormat(WireFormat wire_format);
+
+  solanet::NetworkOptions getNetworkOptions() const;
+  void setNetworkOptions(const solanet::NetworkOptions &network_options);
+
   uint16_t getTreemapper() const;
   void setTreemapper(uint16_t treemapper);
 
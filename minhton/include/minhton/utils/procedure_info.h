@@ -7,7 +7,9 @@
 #ifndef MINHTON_PROCEDURES_INFO_H_
 #define MINHTON_PROCEDURES_INFO_H_
 
+#include <deque>
 #include <future>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -35,6 +37,10 @@ enum class ProcedureKey : uint8_t {
 ///
 /// Supports saving, loading, updating and removing of procedure states.
 ///
+/// The states of find queries are kept together per query (identified by the ref event id)
+/// in reused slots, so that accessing any part of a query needs a single lookup and all parts
+/// can be removed at once when the query is concluded.
+///
 class ProcedureInfo {
 public:
   ProcedureInfo() = default;
@@ -52,18 +58,18 @@ public:
   void removeEventId(ProcedureKey key);
 
   void saveFindQuery(uint64_t ref_event_id, const FindQuery &value);
-  FindQuery loadFindQuery(uint64_t ref_event_id);
+  FindQuery &loadFindQuery(uint64_t ref_event_id);
   void updateFindQuery(uint64_t ref_event_id, const FindQuery &value);
   void removeFindQuery(uint64_t ref_event_id);
 
   void saveFindQueryUndecidedNodes(uint64_t ref_event_id, const std::vector<NodeInfo> &value);
-  std::vector<NodeInfo> loadFindQueryUndecidedNodes(uint64_t ref_event_id);
+  std::vector<NodeInfo> &loadFindQueryUndecidedNodes(uint64_t ref_event_id);
   void updateFindQueryUndecidedNodes(uint64_t ref_event_id, const std::vector<NodeInfo> &value);
   void removeFindQueryUndecidedNodes(uint64_t ref_event_id);
 
   void saveFindQueryPreliminaryResults(uint64_t ref_event_id,
                                        const NodeData::NodesWithAttributes &value);
-  NodeData::NodesWithAttributes loadFindQueryPreliminaryResults(uint64_t ref_event_id);
+  NodeData::NodesWithAttributes &loadFindQueryPreliminaryResults(uint64_t ref_event_id);
   void addFindQueryPreliminaryResults(uint64_t ref_event_id, const NodeInfo &node,
                                       NodeData::Attributes value);
   void removeFindQueryPreliminaryResults(uint64_t ref_event_id);
@@ -94,6 +100,11 @@ public:
   std::promise<FindResult> &loadFindResultPromise(uint64_t ref_event_id);
   void removeFindResultPromise(uint64_t ref_event_id);
 
+  /// Removes all saved parts of the find query at once
+  void removeFindQueryState(uint64_t ref_event_id);
+  bool hasFindQueryState(uint64_t ref_event_id) const;
+  std::size_t getNumberOfFindQueryStates() const;
+
   bool hasEvent(ProcedureKey key) const;
   bool hasNodeInfo(ProcedureKey key) const;
 
@@ -110,28 +121,39 @@ private:
   std::unordered_map<ProcedureKey, std::vector<minhton::NodeInfo>> map_;
   std::unordered_map<ProcedureKey, uint64_t> event_ids_;
 
-  // RefEventId -> FindQuery
-  std::unordered_map<uint64_t, FindQuery> find_query_requests_;
-
-  // RefEventId -> vector of undecided nodes
-  std::unordered_map<uint64_t, std::vector<NodeInfo>> find_query_undecided_nodes_;
-
-  // RefEventId -> vector answered nodes and preliminary answers
-  std::unordered_map<uint64_t, NodeData::NodesWithAttributes> find_query_preliminary_results_;
-
-  // RefEventId -> Timestamp
-  std::unordered_map<uint64_t, uint64_t> dsn_aggregation_start_timestamp_;
-
-  // RefEventId -> Timestamp
-  std::unordered_map<uint64_t, uint64_t> inquiry_aggregation_start_timestamp_;
-
-  // RefEventId -> Number of addressed DSNs
-  std::unordered_map<uint64_t, uint16_t> number_of_addressed_dsns_;
-
-  // RefEventId -> Number of answered DSNs
-  std::unordered_map<uint64_t, uint16_t> number_of_answered_dsns_;
-
-  std::unordered_map<uint64_t, std::promise<FindResult>> find_result_promises_;
+  // Parts of the state of a find query, each only present while it is saved
+  struct FindQueryState {
+    std::optional<FindQuery> query;
+    std::optional<std::vector<NodeInfo>> undecided_nodes;
+    // Answered nodes and preliminary answers
+    std::optional<NodeData::NodesWithAttributes> preliminary_results;
+    std::optional<uint64_t> dsn_aggregation_start_timestamp;
+    std::optional<uint64_t> inquiry_aggregation_start_timestamp;
+    std::optional<uint16_t> number_of_addressed_dsns;
+    std::optional<uint16_t> number_of_answered_dsns;
+    std::optional<std::promise<FindResult>> find_result_promise;
+
+    bool empty() const;
+  };
+
+  template <typename T> using FindQueryStatePart = std::optional<T> FindQueryState::*;
+
+  template <typename T>
+  void savePart(uint64_t ref_event_id, FindQueryStatePart<T> part, T &&value);
+  template <typename T>
+  T &loadPart(uint64_t ref_event_id, FindQueryStatePart<T> part, const char *action);
+  template <typename T> void removePart(uint64_t ref_event_id, FindQueryStatePart<T> part);
+  template <typename T> bool hasPart(uint64_t ref_event_id, FindQueryStatePart<T> part) const;
+
+  const FindQueryState *findState(uint64_t ref_event_id) const;
+  FindQueryState *findState(uint64_t ref_event_id);
+
+  // The deque keeps references to states valid when further states are added
+  std::deque<FindQueryState> find_query_states_;
+  std::vector<uint32_t> free_find_query_slots_;
+
+  // RefEventId -> Slot in find_query_states_
+  std::unordered_map<uint64_t, uint32_t> find_query_slots_;
 };
 
 }  // namespace minhton
@@ -8,6 +8,8 @@
 #define MINHTON_UTILS_SERIALIZER_H_
 
 #include <memory>
+#include <string>
+#include <string_view>
 
 #include "minhton/message/message.h"
 #include "minhton/message/types_all.h"
@@ -27,10 +29,15 @@ public:
   /// \returns Message as serialized string
   virtual std::string serialize(const minhton::MessageVariant &msg) = 0;
 
+  /// Serialize message into a caller-provided buffer, reusing its capacity
+  /// \param msg Message to be serialized
+  /// \param buffer Buffer to be overwritten with the serialized message
+  virtual void serializeInto(const minhton::MessageVariant &msg, std::string &buffer) = 0;
+
   /// Deserialize message
-  /// \param input Message as string which should be deserialized
+  /// \param input Message as string which should be deserialized. Only viewed, not copied
   /// \returns shared_ptr to the deserialized message
-  virtual minhton::MessageVariant deserialize(const std::string &input) = 0;
+  virtual minhton::MessageVariant deserialize(std::string_view input) = 0;
 };
 }  // namespace minhton
 #endif
@@ -7,6 +7,7 @@
 #ifndef MINHTON_UTILS_SERIALIZER_CEREAL_H_
 #define MINHTON_UTILS_SERIALIZER_CEREAL_H_
 
+#include <atomic>
 #include <cassert>
 #include <unordered_map>
 #include <variant>
@@ -19,14 +20,28 @@
 namespace minhton::serializer {
 ///
 /// A serializer which converts a MessageVariant into a binary format and vice versa.
+/// Messages are serialized in the configured wire format, while the format of received messages is
+/// detected automatically.
 ///
 class SerializerCereal final : public ISerializer {
 public:
+  explicit SerializerCereal(WireFormat wire_format = WireFormat::kBinary);
   ~SerializerCereal() override = default;
 
   std::string serialize(const minhton::MessageVariant &msg) override;
 
-  minhton::MessageVariant deserialize(const std::string &str) override;
+  void serializeInto(const minhton::MessageVariant &msg, std::string &buffer) override;
+
+  minhton::MessageVariant deserialize(std::string_view str) override;
+
+  WireFormat getWireFormat() const;
+  void setWireFormat(WireFormat wire_format);
+
+  /// \returns the wire format of a serialized message
+  static WireFormat detectWireFormat(std::string_view str);
+
+private:
+  std::atomic<WireFormat> wire_format_;
 };
 }  // namespace minhton::serializer
 #endif
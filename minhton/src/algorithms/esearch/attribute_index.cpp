@@ -0,0 +1,278 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "minhton/algorithms/esearch/attribute_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace minhton {
+
+namespace {
+
+template <typename Entries, typename Entry> void insertSorted(Entries &entries, Entry entry) {
+  entries.insert(std::upper_bound(entries.begin(), entries.end(), entry), entry);
+}
+
+template <typename Entries> bool eraseSlot(Entries &entries, AttributeIndex::Slot slot) {
+  auto it = std::find_if(entries.begin(), entries.end(),
+                         [slot](const auto &entry) { return entry.second == slot; });
+  if (it == entries.end()) return false;
+  entries.erase(it);
+  return true;
+}
+
+/// Adds the slots of the sorted entries whose values satisfy the comparison. The comparisons are
+/// written like in NumericComparisonExpression, so that int and float values are converted the
+/// same way. Converting sorted values keeps them sorted, so each comparison selects a range.
+template <typename Entries, typename OperandType>
+void addComparisonMatches(const Entries &entries, ComparisonTypes comparison_type,
+                          OperandType operand, SlotBitset &matches) {
+  auto partition_point = [&entries](auto predicate) {
+    return std::partition_point(entries.begin(), entries.end(),
+                                [&predicate](const auto &entry) { return predicate(entry.first); });
+  };
+
+  auto first = entries.begin();
+  auto last = entries.end();
+  switch (comparison_type) {
+    case ComparisonTypes::kLessThan:
+      last = partition_point([operand](auto value) { return value < operand; });
+      break;
+    case ComparisonTypes::kLessThanOrEqualTo:
+      last = partition_point([operand](auto value) { return value <= operand; });
+      break;
+    case ComparisonTypes::kGreater:
+      first = partition_point([operand](auto value) { return !(value > operand); });
+      break;
+    case ComparisonTypes::kGreaterThanOrEqualTo:
+      first = partition_point([operand](auto value) { return !(value >= operand); });
+      break;
+    case ComparisonTypes::kEqualTo:
+    case ComparisonTypes::kNotEqualTo:
+      first = partition_point([operand](auto value) { return !(value >= operand); });
+      last = partition_point([operand](auto value) { return value <= operand; });
+      break;
+  }
+
+  // A NaN operand is not equal to anything, which results in first being behind last
+  const bool equal_range_empty = first >= last;
+  if (comparison_type == ComparisonTypes::kNotEqualTo) {
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (equal_range_empty || it < first || it >= last) matches.set(it->second);
+    }
+    return;
+  }
+
+  if (equal_range_empty) return;
+  for (auto it = first; it != last; ++it) matches.set(it->second);
+}
+
+}  // namespace
+
+bool SlotBitset::test(uint32_t slot) const {
+  const std::size_t word_index = slot / 64;
+  return word_index < words_.size() && (words_[word_index] >> (slot % 64)) & 1;
+}
+
+void SlotBitset::set(uint32_t slot) {
+  const std::size_t word_index = slot / 64;
+  if (word_index >= words_.size()) words_.resize(word_index + 1, 0);
+  words_[word_index] |= uint64_t{1} << (slot % 64);
+}
+
+void SlotBitset::reset(uint32_t slot) {
+  const std::size_t word_index = slot / 64;
+  if (word_index < words_.size()) words_[word_index] &= ~(uint64_t{1} << (slot % 64));
+}
+
+bool SlotBitset::none() const {
+  return std::all_of(words_.begin(), words_.end(), [](uint64_t word) { return word == 0; });
+}
+
+std::size_t SlotBitset::count() const {
+  std::size_t count = 0;
+  for (uint64_t word : words_) count += __builtin_popcountll(word);
+  return count;
+}
+
+SlotBitset &SlotBitset::operator&=(const SlotBitset &other) {
+  if (words_.size() > other.words_.size()) words_.resize(other.words_.size());
+  for (std::size_t i = 0; i < words_.size(); i++) words_[i] &= other.words_[i];
+  return *this;
+}
+
+SlotBitset &SlotBitset::operator|=(const SlotBitset &other) {
+  if (words_.size() < other.words_.size()) words_.resize(other.words_.size(), 0);
+  for (std::size_t i = 0; i < other.words_.size(); i++) words_[i] |= other.words_[i];
+  return *this;
+}
+
+SlotBitset &SlotBitset::subtract(const SlotBitset &other) {
+  const std::size_t size = std::min(words_.size(), other.words_.size());
+  for (std::size_t i = 0; i < size; i++) words_[i] &= ~other.words_[i];
+  return *this;
+}
+
+AttributeIndex::Slot AttributeIndex::addSlot() {
+  Slot slot = slot_count_;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    slot_count_++;
+  }
+  slots_.set(slot);
+  return slot;
+}
+
+void AttributeIndex::removeSlot(Slot slot) {
+  if (!slots_.test(slot)) return;
+
+  clearSlot(slot);
+  slots_.reset(slot);
+  free_slots_.push_back(slot);
+}
+
+void AttributeIndex::clearSlot(Slot slot) {
+  for (auto &[key_id, key_index] : keys_) {
+    removeValue(key_index, slot);
+    key_index.subscribed.reset(slot);
+  }
+}
+
+void AttributeIndex::clear() {
+  slots_ = {};
+  free_slots_.clear();
+  slot_count_ = 0;
+  keys_.clear();
+}
+
+void AttributeIndex::setValue(Slot slot, NodeData::KeyId key_id,
+                              const NodeData::ValueTimestampAndType &value_timestamp_and_type) {
+  KeyIndex &key_index = keys_[key_id];
+  removeValue(key_index, slot);
+  key_index.present.set(slot);
+
+  const auto &[value, timestamp, type] = value_timestamp_and_type;
+  if (type != NodeData::ValueType::kValueStatic) {
+    insertSorted(key_index.dynamic_timestamps, std::make_pair(timestamp, slot));
+  }
+
+  if (const auto *bool_value = std::get_if<bool>(&value)) {
+    (*bool_value ? key_index.true_values : key_index.false_values).set(slot);
+  } else if (const auto *string_value = std::get_if<std::string>(&value)) {
+    key_index.strings[*string_value].set(slot);
+  } else if (const auto *int_value = std::get_if<int>(&value)) {
+    insertSorted(key_index.ints, std::make_pair(*int_value, slot));
+  } else if (const auto *float_value = std::get_if<float>(&value)) {
+    if (std::isnan(*float_value)) {
+      key_index.nan_values.set(slot);
+    } else {
+      insertSorted(key_index.floats, std::make_pair(*float_value, slot));
+    }
+  }
+}
+
+void AttributeIndex::removeValue(Slot slot, NodeData::KeyId key_id) {
+  auto it = keys_.find(key_id);
+  if (it != keys_.end()) removeValue(it->second, slot);
+}
+
+void AttributeIndex::setSubscribed(Slot slot, NodeData::KeyId key_id, bool subscribed) {
+  KeyIndex &key_index = keys_[key_id];
+  if (subscribed) {
+    key_index.subscribed.set(slot);
+  } else {
+    key_index.subscribed.reset(slot);
+  }
+}
+
+void AttributeIndex::removeValue(KeyIndex &key_index, Slot slot) {
+  if (!key_index.present.test(slot)) return;
+  key_index.present.reset(slot);
+  eraseSlot(key_index.dynamic_timestamps, slot);
+
+  if (key_index.true_values.test(slot)) {
+    key_index.true_values.reset(slot);
+  } else if (key_index.false_values.test(slot)) {
+    key_index.false_values.reset(slot);
+  } else if (key_index.nan_values.test(slot)) {
+    key_index.nan_values.reset(slot);
+  } else if (!eraseSlot(key_index.ints, slot) && !eraseSlot(key_index.floats, slot)) {
+    for (auto it = key_index.strings.begin(); it != key_index.strings.end(); ++it) {
+      if (it->second.test(slot)) {
+        it->second.reset(slot);
+        if (it->second.none()) key_index.strings.erase(it);
+        break;
+      }
+    }
+  }
+}
+
+SlotBitset AttributeIndex::getPresent(NodeData::KeyId key_id) const {
+  auto it = keys_.find(key_id);
+  return it != keys_.end() ? it->second.present : SlotBitset();
+}
+
+SlotBitset AttributeIndex::getOutdated(NodeData::KeyId key_id,
+                                       uint64_t validity_threshold_timestamp) const {
+  auto it = keys_.find(key_id);
+  if (it == keys_.end()) return {};
+
+  const auto &timestamps = it->second.dynamic_timestamps;
+  auto end = std::partition_point(timestamps.begin(), timestamps.end(), [&](const auto &entry) {
+    return entry.first < validity_threshold_timestamp;
+  });
+
+  SlotBitset outdated;
+  for (auto entry = timestamps.begin(); entry != end; ++entry) outdated.set(entry->second);
+  return outdated.subtract(it->second.subscribed);
+}
+
+SlotBitset AttributeIndex::getPresenceMatches(NodeData::KeyId key_id) const {
+  auto it = keys_.find(key_id);
+  if (it == keys_.end()) return {};
+  return SlotBitset(it->second.present).subtract(it->second.false_values);
+}
+
+SlotBitset AttributeIndex::getStringMatches(NodeData::KeyId key_id,
+                                            const std::string &value) const {
+  auto it = keys_.find(key_id);
+  if (it == keys_.end()) return {};
+  auto string_it = it->second.strings.find(value);
+  return string_it != it->second.strings.end() ? string_it->second : SlotBitset();
+}
+
+SlotBitset AttributeIndex::getComparisonMatches(NodeData::KeyId key_id,
+                                                ComparisonTypes comparison_type,
+                                                const NodeData::Value &operand) const {
+  auto it = keys_.find(key_id);
+  if (it == keys_.end()) return {};
+
+  if (const auto *int_operand = std::get_if<int>(&operand)) {
+    return getComparisonMatches(it->second, comparison_type, *int_operand);
+  }
+  if (const auto *float_operand = std::get_if<float>(&operand)) {
+    return getComparisonMatches(it->second, comparison_type, *float_operand);
+  }
+  return {};
+}
+
+template <typename OperandType>
+SlotBitset AttributeIndex::getComparisonMatches(const KeyIndex &key_index,
+                                                ComparisonTypes comparison_type,
+                                                OperandType operand) {
+  SlotBitset matches;
+  addComparisonMatches(key_index.ints, comparison_type, operand, matches);
+  addComparisonMatches(key_index.floats, comparison_type, operand, matches);
+
+  // NaN is only unequal to everything
+  if (comparison_type == ComparisonTypes::kNotEqualTo) matches |= key_index.nan_values;
+  return matches;
+}
+
+}  // namespace minhton
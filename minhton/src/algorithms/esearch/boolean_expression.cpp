@@ -0,0 +1,212 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "minhton/algorithms/esearch/boolean_expression.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "minhton/algorithms/esearch/compiled_expression.h"
+
+namespace minhton {
+
+namespace {
+// Incremented whenever the encoding changes incompatibly
+constexpr uint8_t kEncodingVersion = 1;
+
+// Protects the decoder against stack overflows by deeply nested input
+constexpr uint32_t kMaxDecodingDepth = 256;
+
+void writeVarint(std::string &buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+class ExpressionDecoder {
+public:
+  explicit ExpressionDecoder(const std::string &encoded) : encoded_(encoded) {}
+
+  std::shared_ptr<BooleanExpression> decode() {
+    if (readByte() != kEncodingVersion) {
+      throw std::invalid_argument("Unsupported boolean expression encoding");
+    }
+    auto expr = decodeExpression(0);
+    if (position_ != encoded_.size()) {
+      throw std::invalid_argument("Trailing bytes after boolean expression");
+    }
+    return expr;
+  }
+
+private:
+  std::shared_ptr<BooleanExpression> decodeExpression(uint32_t depth) {
+    if (depth > kMaxDecodingDepth) {
+      throw std::invalid_argument("Boolean expression is nested too deeply");
+    }
+
+    switch (static_cast<ExpressionTag>(readByte())) {
+      case ExpressionTag::kEmpty:
+        return std::make_shared<EmptyExpression>();
+      case ExpressionTag::kOr: {
+        auto expr1 = decodeExpression(depth + 1);
+        auto expr2 = decodeExpression(depth + 1);
+        return std::make_shared<OrExpression>(expr1, expr2);
+      }
+      case ExpressionTag::kAnd: {
+        auto expr1 = decodeExpression(depth + 1);
+        auto expr2 = decodeExpression(depth + 1);
+        return std::make_shared<AndExpression>(expr1, expr2);
+      }
+      case ExpressionTag::kNot:
+        return std::make_shared<NotExpression>(decodeExpression(depth + 1));
+      case ExpressionTag::kPresence:
+        return std::make_shared<PresenceExpression>(readString());
+      case ExpressionTag::kStringEquality: {
+        auto key = readString();
+        auto value = readString();
+        return std::make_shared<StringEqualityExpression>(key, value);
+      }
+      case ExpressionTag::kIntComparison: {
+        auto key = readString();
+        auto comparison_type = readComparison();
+        uint64_t zigzag = readVarint();
+        auto value = static_cast<int>(static_cast<int64_t>(zigzag >> 1) ^
+                                      -static_cast<int64_t>(zigzag & 1));
+        return std::make_shared<NumericComparisonExpression<int>>(key, comparison_type, value);
+      }
+      case ExpressionTag::kFloatComparison: {
+        auto key = readString();
+        auto comparison_type = readComparison();
+        uint32_t bits = 0;
+        for (uint32_t i = 0; i < sizeof(bits); i++) {
+          bits |= static_cast<uint32_t>(readByte()) << (8 * i);
+        }
+        float value = 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return std::make_shared<NumericComparisonExpression<float>>(key, comparison_type, value);
+      }
+    }
+    throw std::invalid_argument("Unknown boolean expression tag");
+  }
+
+  uint8_t readByte() {
+    if (position_ >= encoded_.size()) {
+      throw std::invalid_argument("Truncated boolean expression");
+    }
+    return static_cast<uint8_t>(encoded_[position_++]);
+  }
+
+  uint64_t readVarint() {
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = readByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return value;
+    }
+    throw std::invalid_argument("Invalid varint in boolean expression");
+  }
+
+  std::string readString() {
+    uint64_t length = readVarint();
+    if (length > encoded_.size() - position_) {
+      throw std::invalid_argument("Truncated boolean expression");
+    }
+    std::string value = encoded_.substr(position_, length);
+    position_ += length;
+    return value;
+  }
+
+  ComparisonTypes readComparison() {
+    uint8_t comparison_type = readByte();
+    if (comparison_type > static_cast<uint8_t>(ComparisonTypes::kGreaterThanOrEqualTo)) {
+      throw std::invalid_argument("Unknown comparison type in boolean expression");
+    }
+    return static_cast<ComparisonTypes>(comparison_type);
+  }
+
+  const std::string &encoded_;
+  std::size_t position_ = 0;
+};
+}  // namespace
+
+namespace expression_encoding {
+void writeTag(std::string &buffer, ExpressionTag tag) {
+  buffer.push_back(static_cast<char>(tag));
+}
+
+void writeString(std::string &buffer, const std::string &value) {
+  writeVarint(buffer, value.size());
+  buffer.append(value);
+}
+
+void writeComparison(std::string &buffer, ComparisonTypes comparison_type) {
+  buffer.push_back(static_cast<char>(comparison_type));
+}
+
+void writeNumber(std::string &buffer, int value) {
+  // ZigZag, so that small negative values stay small
+  auto wide = static_cast<int64_t>(value);
+  writeVarint(buffer, (static_cast<uint64_t>(wide) << 1) ^ static_cast<uint64_t>(wide >> 63));
+}
+
+void writeNumber(std::string &buffer, float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (uint32_t i = 0; i < sizeof(bits); i++) {
+    buffer.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+  }
+}
+}  // namespace expression_encoding
+
+std::string encodeBooleanExpression(const BooleanExpression &expr) {
+  std::string buffer;
+  buffer.push_back(static_cast<char>(kEncodingVersion));
+  expr.encode(buffer);
+  return buffer;
+}
+
+std::shared_ptr<BooleanExpression> decodeBooleanExpression(const std::string &encoded) {
+  return ExpressionDecoder(encoded).decode();
+}
+
+void OrExpression::compile(CompiledExpression &program) const {
+  expr1_->compile(program);
+  expr2_->compile(program);
+  program.addOr();
+}
+
+void AndExpression::compile(CompiledExpression &program) const {
+  expr1_->compile(program);
+  expr2_->compile(program);
+  program.addAnd();
+}
+
+void NotExpression::compile(CompiledExpression &program) const {
+  expr_->compile(program);
+  program.addNot();
+}
+
+void PresenceExpression::compile(CompiledExpression &program) const {
+  program.addPresence(key_);
+}
+
+void StringEqualityExpression::compile(CompiledExpression &program) const {
+  program.addStringEquality(key_, value_);
+}
+
+template <typename NumericType>
+void NumericComparisonExpression<NumericType>::compile(CompiledExpression &program) const {
+  program.addComparison(key_, comparison_type_, comparison_value_);
+}
+
+void EmptyExpression::compile(CompiledExpression &program) const { program.addEmpty(); }
+
+template class NumericComparisonExpression<int>;
+template class NumericComparisonExpression<float>;
+
+}  // namespace minhton
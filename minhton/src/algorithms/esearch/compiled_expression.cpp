@@ -0,0 +1,409 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "minhton/algorithms/esearch/compiled_expression.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace minhton {
+
+CompiledExpression::CompiledExpression(const BooleanExpression &expr) {
+  expr.compile(*this);
+
+  // Start index of the subtree ending at each instruction, to find the operands of ORs
+  enclosing_ors_.resize(instructions_.size());
+  std::vector<std::size_t> subtree_starts;
+  for (std::size_t pc = 0; pc < instructions_.size(); pc++) {
+    std::size_t start = pc;
+    switch (instructions_[pc].opcode) {
+      case Opcode::kNot:
+        start = subtree_starts.back();
+        subtree_starts.pop_back();
+        break;
+      case Opcode::kAnd:
+      case Opcode::kOr:
+        subtree_starts.pop_back();
+        start = subtree_starts.back();
+        subtree_starts.pop_back();
+        break;
+      default:
+        atomic_instructions_.push_back(static_cast<uint32_t>(pc));
+        break;
+    }
+    if (instructions_[pc].opcode == Opcode::kOr) {
+      for (std::size_t operand_pc = start; operand_pc < pc; operand_pc++) {
+        enclosing_ors_[operand_pc].push_back(static_cast<uint32_t>(pc));
+      }
+    }
+    subtree_starts.push_back(start);
+  }
+}
+
+void CompiledExpression::addEmpty() { instructions_.push_back({Opcode::kEmpty}); }
+
+void CompiledExpression::addNot() { instructions_.push_back({Opcode::kNot}); }
+
+void CompiledExpression::addAnd() { instructions_.push_back({Opcode::kAnd}); }
+
+void CompiledExpression::addOr() { instructions_.push_back({Opcode::kOr}); }
+
+void CompiledExpression::addPresence(const NodeData::Key &key) {
+  instructions_.push_back({Opcode::kPresence, ComparisonTypes::kEqualTo, addKey(key)});
+}
+
+void CompiledExpression::addStringEquality(const NodeData::Key &key, const std::string &value) {
+  instructions_.push_back({Opcode::kStringEquality, ComparisonTypes::kEqualTo, addKey(key), value});
+}
+
+void CompiledExpression::addComparison(const NodeData::Key &key, ComparisonTypes comparison_type,
+                                       int value) {
+  instructions_.push_back({Opcode::kIntComparison, comparison_type, addKey(key), value});
+}
+
+void CompiledExpression::addComparison(const NodeData::Key &key, ComparisonTypes comparison_type,
+                                       float value) {
+  instructions_.push_back({Opcode::kFloatComparison, comparison_type, addKey(key), value});
+}
+
+uint32_t CompiledExpression::addKey(const NodeData::Key &key) {
+  auto it = std::find(keys_.begin(), keys_.end(), key);
+  if (it != keys_.end()) {
+    return static_cast<uint32_t>(it - keys_.begin());
+  }
+  keys_.push_back(key);
+  key_ids_.push_back(KeyTable::find(key).value_or(KeyTable::kUnknownKey));
+  return static_cast<uint32_t>(keys_.size() - 1);
+}
+
+NodeData::KeyId CompiledExpression::resolveKeyId(uint32_t key_index) const {
+  if (key_ids_[key_index] != KeyTable::kUnknownKey) {
+    return key_ids_[key_index];
+  }
+  return KeyTable::find(keys_[key_index]).value_or(KeyTable::kUnknownKey);
+}
+
+std::vector<CompiledExpression::KeyColumn> CompiledExpression::fetchColumns(
+    const Batch &batch, const EvaluationInformation &eval_info) const {
+  std::vector<KeyColumn> columns(keys_.size());
+  for (uint32_t key_index = 0; key_index < keys_.size(); key_index++) {
+    KeyColumn &column = columns[key_index];
+    column.values.reserve(batch.size());
+    column.up_to_date.reserve(batch.size());
+
+    const NodeData::KeyId key_id = resolveKeyId(key_index);
+    for (NodeData *data : batch) {
+      const auto *value = data->find(key_id, keys_[key_index]);
+      column.values.push_back(value);
+
+      // Only asked for known keys, as DistributedData does not allow it for unknown keys
+      column.up_to_date.push_back(value != nullptr && eval_info.inquire_outdated_attributes &&
+                                  data->isValueUpToDate(key_id, *value,
+                                                        eval_info.validity_threshold_timestamp));
+    }
+  }
+  return columns;
+}
+
+std::vector<FuzzyValue> CompiledExpression::evaluate(
+    const Batch &batch, const EvaluationInformation &eval_info) const {
+  return run(batch, fetchColumns(batch, eval_info), eval_info, nullptr);
+}
+
+std::vector<FuzzyValue> CompiledExpression::run(
+    const Batch &batch, const std::vector<KeyColumn> &columns,
+    const EvaluationInformation &eval_info,
+    std::vector<std::vector<FuzzyValue>> *or_values) const {
+  std::vector<std::vector<FuzzyValue>> stack;
+
+  for (std::size_t pc = 0; pc < instructions_.size(); pc++) {
+    const Instruction &instruction = instructions_[pc];
+    switch (instruction.opcode) {
+      case Opcode::kEmpty:
+        stack.emplace_back(batch.size(), FuzzyValue::createTrue());
+        break;
+      case Opcode::kNot:
+        for (auto &value : stack.back()) value = !value;
+        break;
+      case Opcode::kAnd:
+      case Opcode::kOr: {
+        std::vector<FuzzyValue> right = std::move(stack.back());
+        stack.pop_back();
+        std::vector<FuzzyValue> &left = stack.back();
+        for (std::size_t i = 0; i < left.size(); i++) {
+          left[i] = instruction.opcode == Opcode::kAnd ? left[i] && right[i] : left[i] || right[i];
+        }
+        if (or_values != nullptr && instruction.opcode == Opcode::kOr) {
+          (*or_values)[pc] = left;
+        }
+        break;
+      }
+      default: {
+        std::vector<FuzzyValue> &result = stack.emplace_back();
+        if (or_values != nullptr && enclosing_ors_[pc].empty()) {
+          // Never reaches an OR, so there is nothing to evaluate
+          result.assign(batch.size(), FuzzyValue::createUndecided());
+          break;
+        }
+
+        const KeyColumn &column = columns[instruction.key_index];
+        result.reserve(batch.size());
+        for (std::size_t i = 0; i < batch.size(); i++) {
+          result.push_back(evaluateAtomic(instruction, column, *batch[i], i, eval_info));
+        }
+        break;
+      }
+    }
+  }
+
+  if (stack.size() != 1) {
+    throw std::logic_error("Invalid compiled expression");
+  }
+  return std::move(stack.back());
+}
+
+std::vector<std::vector<NodeData::Key>> CompiledExpression::evaluateMissingAttributes(
+    const Batch &batch, const EvaluationInformation &eval_info) const {
+  // OrExpression evaluates its operands without all information being present,
+  // the atomic expressions only look at the inquire flags
+  EvaluationInformation eval_info_c = eval_info;
+  eval_info_c.all_information_present = false;
+
+  const auto columns = fetchColumns(batch, eval_info_c);
+
+  // An OR which is true drops the missing keys of both its operands
+  std::vector<std::vector<FuzzyValue>> or_values(instructions_.size());
+  run(batch, columns, eval_info_c, &or_values);
+
+  // Concatenation in postfix order is the same as the expression tree concatenating its operands
+  std::vector<std::vector<NodeData::Key>> missing_keys(batch.size());
+  for (std::size_t i = 0; i < batch.size(); i++) {
+    for (uint32_t pc : atomic_instructions_) {
+      const Instruction &instruction = instructions_[pc];
+      if (instruction.opcode == Opcode::kEmpty ||
+          !isMissing(columns[instruction.key_index], i, eval_info_c)) {
+        continue;
+      }
+
+      const auto &ors = enclosing_ors_[pc];
+      if (std::none_of(ors.begin(), ors.end(),
+                       [&](uint32_t or_pc) { return or_values[or_pc][i].isTrue(); })) {
+        missing_keys[i].push_back(keys_[instruction.key_index]);
+      }
+    }
+  }
+  return missing_keys;
+}
+
+SlotBitset CompiledExpression::getCandidates(const AttributeIndex &index, FuzzyValue value,
+                                             const EvaluationInformation &eval_info) const {
+  // Slots which may evaluate to true, undecided or false for each operand on the stack
+  struct Candidates {
+    SlotBitset may_true;
+    SlotBitset may_undecided;
+    SlotBitset may_false;
+  };
+  std::vector<Candidates> stack;
+
+  const SlotBitset &all = index.getSlots();
+  auto intersection = [](SlotBitset lhs, const SlotBitset &rhs) { return lhs &= rhs; };
+  auto union_of = [](SlotBitset lhs, const SlotBitset &rhs) { return lhs |= rhs; };
+
+  for (const Instruction &instruction : instructions_) {
+    switch (instruction.opcode) {
+      case Opcode::kEmpty:
+        stack.push_back({all, {}, {}});
+        break;
+      case Opcode::kNot:
+        std::swap(stack.back().may_true, stack.back().may_false);
+        break;
+      case Opcode::kAnd:
+      case Opcode::kOr: {
+        Candidates rhs = std::move(stack.back());
+        stack.pop_back();
+        Candidates lhs = std::move(stack.back());
+
+        // AND is the minimum and OR the maximum of false < undecided < true
+        const bool is_and = instruction.opcode == Opcode::kAnd;
+        SlotBitset &dominant_lhs = is_and ? lhs.may_false : lhs.may_true;
+        SlotBitset &dominant_rhs = is_and ? rhs.may_false : rhs.may_true;
+        SlotBitset &other_lhs = is_and ? lhs.may_true : lhs.may_false;
+        SlotBitset &other_rhs = is_and ? rhs.may_true : rhs.may_false;
+
+        SlotBitset may_undecided =
+            union_of(intersection(lhs.may_undecided, union_of(rhs.may_undecided, other_rhs)),
+                     intersection(rhs.may_undecided, union_of(lhs.may_undecided, other_lhs)));
+        SlotBitset dominant = union_of(dominant_lhs, dominant_rhs);
+        SlotBitset other = intersection(other_lhs, other_rhs);
+
+        Candidates &result = stack.back();
+        result.may_undecided = std::move(may_undecided);
+        result.may_true = is_and ? std::move(other) : std::move(dominant);
+        result.may_false = is_and ? std::move(dominant) : std::move(other);
+        break;
+      }
+      default: {
+        // Same cases as AtomicBooleanExpression::evaluate for DistributedData
+        const NodeData::KeyId key_id = resolveKeyId(instruction.key_index);
+        if (key_id == KeyTable::kUnknownKey) {
+          // Values of keys which are not in the KeyTable are not indexed, see NodeData::find
+          Candidates &result = stack.emplace_back();
+          result.may_true = all;
+          result.may_undecided = all;
+          result.may_false = all;
+          break;
+        }
+
+        SlotBitset present = index.getPresent(key_id);
+        SlotBitset matches;
+        switch (instruction.opcode) {
+          case Opcode::kPresence:
+            matches = index.getPresenceMatches(key_id);
+            break;
+          case Opcode::kStringEquality:
+            matches = index.getStringMatches(key_id, std::get<std::string>(instruction.operand));
+            break;
+          default:
+            matches = index.getComparisonMatches(key_id, instruction.comparison_type,
+                                                 instruction.operand);
+            break;
+        }
+
+        const bool unknown_undecided =
+            !eval_info.all_information_present && eval_info.inquire_unknown_attributes;
+
+        // Known values which are up to date, or whose age does not matter
+        SlotBitset considered = present;
+        SlotBitset outdated;
+        if (eval_info.inquire_outdated_attributes) {
+          outdated = index.getOutdated(key_id, eval_info.validity_threshold_timestamp);
+          considered.subtract(outdated);
+        }
+        matches &= considered;
+
+        SlotBitset unknown = SlotBitset(all).subtract(present);
+        Candidates &result = stack.emplace_back();
+        result.may_false = considered.subtract(matches);
+        (unknown_undecided ? result.may_undecided : result.may_false) |= unknown;
+        (eval_info.all_information_present ? result.may_false : result.may_undecided) |= outdated;
+        result.may_true = std::move(matches);
+        break;
+      }
+    }
+  }
+
+  if (stack.size() != 1) {
+    throw std::logic_error("Invalid compiled expression");
+  }
+  if (value.isTrue()) return std::move(stack.back().may_true);
+  if (value.isUndecided()) return std::move(stack.back().may_undecided);
+  return std::move(stack.back().may_false);
+}
+
+FuzzyValue CompiledExpression::evaluateAtomic(const Instruction &instruction,
+                                              const KeyColumn &column, const NodeData &data,
+                                              std::size_t index,
+                                              const EvaluationInformation &eval_info) {
+  const auto *value = column.values[index];
+  if (data.isLocal()) {
+    return evaluateExisting(instruction, value);
+  }
+
+  if (value == nullptr) {
+    return !eval_info.all_information_present && eval_info.inquire_unknown_attributes
+               ? FuzzyValue::createUndecided()
+               : FuzzyValue::createFalse();
+  }
+
+  if (eval_info.inquire_outdated_attributes && !column.up_to_date[index]) {
+    return eval_info.all_information_present ? FuzzyValue::createFalse()
+                                             : FuzzyValue::createUndecided();
+  }
+
+  FuzzyValue existing = evaluateExisting(instruction, value);
+  if (existing.isUndecided() && !eval_info.inquire_outdated_attributes && eval_info.permissive) {
+    return FuzzyValue::createTrue();
+  }
+  return existing;
+}
+
+bool CompiledExpression::isMissing(const KeyColumn &column, std::size_t index,
+                                   const EvaluationInformation &eval_info) {
+  const bool known = column.values[index] != nullptr;
+  if (!known) {
+    return eval_info.inquire_unknown_attributes;
+  }
+  return eval_info.inquire_outdated_attributes && !column.up_to_date[index];
+}
+
+FuzzyValue CompiledExpression::evaluateExisting(const Instruction &instruction,
+                                                const NodeData::ValueTimestampAndType *value) {
+  if (value == nullptr) {
+    return FuzzyValue::createFalse();
+  }
+  const NodeData::Value &variant = std::get<0>(*value);
+
+  switch (instruction.opcode) {
+    case Opcode::kPresence: {
+      const auto *bool_value = std::get_if<bool>(&variant);
+      if (bool_value != nullptr && !*bool_value) {
+        return FuzzyValue::createFalse();
+      }
+      return FuzzyValue::createTrue();
+    }
+    case Opcode::kStringEquality: {
+      const auto *string_value = std::get_if<std::string>(&variant);
+      if (string_value != nullptr && *string_value == std::get<std::string>(instruction.operand)) {
+        return FuzzyValue::createTrue();
+      }
+      return FuzzyValue::createFalse();
+    }
+    case Opcode::kIntComparison:
+    case Opcode::kFloatComparison: {
+      bool comparison = false;
+      if (const auto *int_value = std::get_if<int>(&variant)) {
+        comparison = applyComparison(instruction.comparison_type, *int_value, instruction.operand);
+      } else if (const auto *float_value = std::get_if<float>(&variant)) {
+        comparison =
+            applyComparison(instruction.comparison_type, *float_value, instruction.operand);
+      } else {
+        throw std::invalid_argument("Could not compare");
+      }
+      return comparison ? FuzzyValue::createTrue() : FuzzyValue::createFalse();
+    }
+    default:
+      throw std::logic_error("Not an atomic expression");
+  }
+}
+
+template <typename NumericType>
+bool CompiledExpression::applyComparison(ComparisonTypes comparison_type, NumericType value,
+                                         const NodeData::Value &operand) {
+  return std::visit(
+      [&](const auto &comparison_value) -> bool {
+        using OperandType = std::decay_t<decltype(comparison_value)>;
+        if constexpr (std::is_same_v<OperandType, int> || std::is_same_v<OperandType, float>) {
+          switch (comparison_type) {
+            case ComparisonTypes::kEqualTo:
+              return value == comparison_value;
+            case ComparisonTypes::kNotEqualTo:
+              return value != comparison_value;
+            case ComparisonTypes::kLessThan:
+              return value < comparison_value;
+            case ComparisonTypes::kGreater:
+              return value > comparison_value;
+            case ComparisonTypes::kLessThanOrEqualTo:
+              return value <= comparison_value;
+            case ComparisonTypes::kGreaterThanOrEqualTo:
+              return value >= comparison_value;
+          }
+        }
+        return false;
+      },
+      operand);
+}
+
+}  // namespace minhton
@@ -68,21 +68,32 @@ void DistributedData::remove(NodeData::Key key) {
 }
 
 void DistributedData::addSubscriptionOrderKey(NodeData::Key key) {
-  auto it = std::find(subscription_ordered_keys_.begin(), subscription_ordered_keys_.end(), key);
-  if (it == subscription_ordered_keys_.end()) {
-    subscription_ordered_keys_.push_back(key);
+  KeyId key_id = KeyTable::intern(key);
+  if (!isKeySubscribed(key_id)) {
+    subscription_ordered_keys_.push_back(key_id);
   }
 }
 
 void DistributedData::removeSubscriptionOrderKey(NodeData::Key key) {
-  auto it = std::find(subscription_ordered_keys_.begin(), subscription_ordered_keys_.end(), key);
+  auto key_id = KeyTable::find(key);
+  if (!key_id) {
+    return;
+  }
+
+  auto it =
+      std::find(subscription_ordered_keys_.begin(), subscription_ordered_keys_.end(), *key_id);
   if (it != subscription_ordered_keys_.end()) {
     subscription_ordered_keys_.erase(it);
   }
 }
 
 std::vector<NodeData::Key> DistributedData::getSubscriptionOrderKeys() const {
-  return subscription_ordered_keys_;
+  std::vector<NodeData::Key> keys;
+  keys.reserve(subscription_ordered_keys_.size());
+  for (KeyId key_id : subscription_ordered_keys_) {
+    keys.push_back(KeyTable::getName(key_id));
+  }
+  return keys;
 }
 
 std::queue<uint64_t> DistributedData::getUpdateTimestamps(const NodeData::Key &key) {
@@ -94,21 +105,30 @@ std::queue<uint64_t> DistributedData::getUpdateTimestamps(const NodeData::Key &k
 }
 
 bool DistributedData::isKeySubscribed(NodeData::Key key) {
-  return std::find(subscription_ordered_keys_.begin(), subscription_ordered_keys_.end(), key) !=
+  auto key_id = KeyTable::find(key);
+  return key_id && isKeySubscribed(*key_id);
+}
+
+bool DistributedData::isKeySubscribed(KeyId key_id) const {
+  return std::find(subscription_ordered_keys_.begin(), subscription_ordered_keys_.end(), key_id) !=
          subscription_ordered_keys_.end();
 }
 
-bool DistributedData::isValueUpToDate(const NodeData::Key &key,
-                                      uint64_t validity_threshold_timestamp) {
-  if (!hasKey(key)) {
+bool DistributedData::isValueUpToDate(KeyId key_id, uint64_t validity_threshold_timestamp) {
+  const auto *value_timestamp_and_type = find(key_id);
+  if (value_timestamp_and_type == nullptr) {
     throw std::logic_error("This method should not be called if the key is unknown");
   }
+  return isValueUpToDate(key_id, *value_timestamp_and_type, validity_threshold_timestamp);
+}
 
-  if (isKeySubscribed(key)) {
+bool DistributedData::isValueUpToDate(KeyId key_id,
+                                      const ValueTimestampAndType &value_timestamp_and_type,
+                                      uint64_t validity_threshold_timestamp) const {
+  if (isKeySubscribed(key_id)) {
     return true;
   }
 
-  auto value_timestamp_and_type = getValueTimestampAndType(key);
   auto timestamp = std::get<1>(value_timestamp_and_type);
   auto type = std::get<2>(value_timestamp_and_type);
 
@@ -52,7 +52,7 @@ void DSNHandler::checkPosition() {
 
   // if we are not initialized, invalidating everything we knew
   if (!routing_info_->getSelfNodeInfo().isInitialized()) {
-    cover_data_.clear();
+    clearCoverData();
     extended_cover_data_.clear();
     return;
   }
@@ -66,7 +66,7 @@ void DSNHandler::checkPosition() {
     // not a dsn
     // clearning previous dsn info
 
-    cover_data_.clear();
+    clearCoverData();
     extended_cover_data_.clear();
     return;
   }
@@ -112,7 +112,7 @@ void DSNHandler::buildCoverArea() {
                                      });
 
     if (it_positions == cover_area_positions.end()) {
-      it_cover_data = cover_data_.erase(it_cover_data);
+      it_cover_data = eraseCoverData(it_cover_data);
     } else {
       cover_area_positions.erase(it_positions);
       ++it_cover_data;
@@ -128,7 +128,7 @@ void DSNHandler::buildCoverArea() {
 
     if (cover_node.isInitialized()) {
       DistributedData distr_data(cover_node.getPhysicalNodeInfo());
-      cover_data_[cover_node.getLogicalNodeInfo()] = distr_data;
+      setCoverData(cover_node.getLogicalNodeInfo(), distr_data);
     }
   }
 }
@@ -154,7 +154,7 @@ void DSNHandler::buildTempCoverArea() {
 
     if (cover_node.isInitialized()) {
       DistributedData distr_data(cover_node.getPhysicalNodeInfo());
-      cover_data_[cover_node.getLogicalNodeInfo()] = distr_data;
+      setCoverData(cover_node.getLogicalNodeInfo(), distr_data);
     }
   }
 }
@@ -222,7 +222,7 @@ void DSNHandler::onNeighborChangeNotification(const minhton::NodeInfo &neighbor,
   bool init = neighbor.getPhysicalNodeInfo().isInitialized();
 
   if (inside && !init) {  // -> delete
-    cover_data_.erase(it_cover_data);
+    eraseCoverData(it_cover_data);
 
   } else if (inside && init) {  // -> update if different PhysicalNodeInfo, otherwise nothing
     if (it_cover_data->second.getPhysicalNodeInfo() != neighbor.getPhysicalNodeInfo()) {
@@ -232,7 +232,7 @@ void DSNHandler::onNeighborChangeNotification(const minhton::NodeInfo &neighbor,
 
   } else if (!inside && init) {  // -> insert
     DistributedData distr_data(neighbor.getPhysicalNodeInfo());
-    cover_data_[neighbor.getLogicalNodeInfo()] = distr_data;
+    setCoverData(neighbor.getLogicalNodeInfo(), distr_data);
     requestAttributeInformation(neighbor.getLogicalNodeInfo(), distr_data);
   }
 }
@@ -254,18 +254,32 @@ DSNHandler::getUndecidedNodesAndMissingKeys(FindQuery &query, bool all_informati
                                             const uint64_t &timestamp_now) {
   std::vector<std::tuple<NodeInfo, std::vector<NodeData::Key>>> undecided;
 
-  for (auto &[peer, distr_data] : cover_data_) {
-    FuzzyValue val = query.evaluate(distr_data, all_information_present, timestamp_now);
-    if (val.isUndecided()) {
-      NodeInfo undecided_node;
-      undecided_node.setLogicalNodeInfo(peer);
-      undecided_node.setPhysicalNodeInfo(distr_data.getPhysicalNodeInfo());
+  // The indexes narrow down the nodes which can be undecided, which are then evaluated exactly
+  const auto entries = getCoverEntries(query.getCandidates(
+      cover_index_, FuzzyValue::createUndecided(), all_information_present, timestamp_now));
+  CompiledExpression::Batch batch;
+  batch.reserve(entries.size());
+  for (const auto &entry : entries) batch.push_back(entry.second);
+
+  const auto values = query.evaluate(batch, all_information_present, timestamp_now);
+
+  // Missing keys are only needed for the undecided nodes
+  std::vector<std::pair<const LogicalNodeInfo *, DistributedData *>> undecided_entries;
+  CompiledExpression::Batch undecided_batch;
+  for (std::size_t i = 0; i < entries.size(); i++) {
+    if (values[i].isUndecided()) {
+      undecided_entries.push_back(entries[i]);
+      undecided_batch.push_back(batch[i]);
+    }
+  }
 
-      std::vector<NodeData::Key> missing_keys =
-          query.evaluateMissingAttributes(distr_data, timestamp_now);
+  auto missing_keys = query.evaluateMissingAttributes(undecided_batch, timestamp_now);
+  for (std::size_t i = 0; i < undecided_entries.size(); i++) {
+    NodeInfo undecided_node;
+    undecided_node.setLogicalNodeInfo(*undecided_entries[i].first);
+    undecided_node.setPhysicalNodeInfo(undecided_entries[i].second->getPhysicalNodeInfo());
 
-      undecided.emplace_back(undecided_node, missing_keys);
-    }
+    undecided.emplace_back(undecided_node, std::move(missing_keys[i]));
   }
 
   return undecided;
@@ -274,12 +288,18 @@ DSNHandler::getUndecidedNodesAndMissingKeys(FindQuery &query, bool all_informati
 std::vector<NodeInfo> DSNHandler::getTrueNodes(FindQuery &query, const uint64_t &timestamp_now) {
   std::vector<NodeInfo> true_nodes;
 
-  for (auto &[peer, distr_data] : cover_data_) {
-    FuzzyValue val = query.evaluate(distr_data, true, timestamp_now);
-    if (val.isTrue()) {
+  const auto entries = getCoverEntries(
+      query.getCandidates(cover_index_, FuzzyValue::createTrue(), true, timestamp_now));
+  CompiledExpression::Batch batch;
+  batch.reserve(entries.size());
+  for (const auto &entry : entries) batch.push_back(entry.second);
+
+  const auto values = query.evaluate(batch, true, timestamp_now);
+  for (std::size_t i = 0; i < entries.size(); i++) {
+    if (values[i].isTrue()) {
       NodeInfo true_node;
-      true_node.setLogicalNodeInfo(peer);
-      true_node.setPhysicalNodeInfo(distr_data.getPhysicalNodeInfo());
+      true_node.setLogicalNodeInfo(*entries[i].first);
+      true_node.setPhysicalNodeInfo(entries[i].second->getPhysicalNodeInfo());
 
       true_nodes.push_back(true_node);
     }
@@ -324,6 +344,11 @@ void DSNHandler::updateInquiredOrSubscribedAttributeValues(
         throw std::logic_error("something has gone wrong");
       }
     }
+
+    // Values of keys which did not fit into the KeyTable are only evaluated without the index
+    if (auto key_id = KeyTable::find(key)) {
+      updateCoverIndex(inquired_or_updated_node.getLogicalNodeInfo(), *key_id);
+    }
   }
 }
 
@@ -343,6 +368,9 @@ void DSNHandler::updateRemovedAttributes(const NodeInfo &inquired_node,
 
   for (const auto &key : removed_keys) {
     inquired_distr_data.remove(key);
+    if (auto key_id = KeyTable::find(key)) {
+      updateCoverIndex(inquired_node.getLogicalNodeInfo(), *key_id);
+    }
   }
 }
 
@@ -511,8 +539,14 @@ void DSNHandler::setPlacedSubscriptionOrders(
       throw std::logic_error("subscribed node is not in cover data");
     }
 
+    const auto slot = cover_slots_.at(it->first);
     for (auto const &key : sub_keys) {
+      // Keys which do not fit into the KeyTable are not subscribed, but inquired when outdated
+      auto key_id = KeyTable::tryIntern(key);
+      if (!key_id) continue;
+
       it->second.addSubscriptionOrderKey(key);
+      cover_index_.setSubscribed(slot, *key_id, true);
     }
   }
 }
@@ -527,8 +561,10 @@ void DSNHandler::setPlacedUnsubscriptionOrders(
       throw std::logic_error("subscribed node is not in cover data");
     }
 
+    const auto slot = cover_slots_.at(it->first);
     for (auto const &key : unsub_keys) {
       it->second.removeSubscriptionOrderKey(key);
+      if (auto key_id = KeyTable::find(key)) cover_index_.setSubscribed(slot, *key_id, false);
     }
   }
 }
@@ -546,6 +582,70 @@ NodeData::Attributes DSNHandler::getNodeAttributes(const NodeInfo &node) {
   return attributes;
 }
 
+void DSNHandler::setCoverData(const LogicalNodeInfo &peer, const DistributedData &distr_data) {
+  auto [it, inserted] = cover_data_.insert_or_assign(peer, distr_data);
+
+  AttributeIndex::Slot slot = 0;
+  if (inserted) {
+    slot = cover_index_.addSlot();
+    cover_slots_[peer] = slot;
+    if (slot >= cover_slot_entries_.size()) cover_slot_entries_.resize(slot + 1);
+    cover_slot_entries_[slot] = {&it->first, &it->second};
+  } else {
+    slot = cover_slots_.at(peer);
+    cover_index_.clearSlot(slot);
+  }
+
+  for (const auto &[key, value_timestamp_and_type] : distr_data.getData()) {
+    if (auto key_id = KeyTable::find(key)) {
+      cover_index_.setValue(slot, *key_id, value_timestamp_and_type);
+    }
+  }
+  for (const auto &key : distr_data.getSubscriptionOrderKeys()) {
+    cover_index_.setSubscribed(slot, KeyTable::intern(key), true);
+  }
+}
+
+std::unordered_map<LogicalNodeInfo, DistributedData, LogicalNodeInfoHasher>::iterator
+DSNHandler::eraseCoverData(
+    std::unordered_map<LogicalNodeInfo, DistributedData, LogicalNodeInfoHasher>::iterator it) {
+  auto slot_it = cover_slots_.find(it->first);
+  cover_index_.removeSlot(slot_it->second);
+  cover_slot_entries_[slot_it->second] = {nullptr, nullptr};
+  cover_slots_.erase(slot_it);
+  return cover_data_.erase(it);
+}
+
+void DSNHandler::clearCoverData() {
+  cover_data_.clear();
+  cover_index_.clear();
+  cover_slots_.clear();
+  cover_slot_entries_.clear();
+}
+
+void DSNHandler::updateCoverIndex(const LogicalNodeInfo &peer, NodeData::KeyId key_id) {
+  auto slot_it = cover_slots_.find(peer);
+  if (slot_it == cover_slots_.end()) {
+    return;  // extended cover data is not indexed
+  }
+
+  const auto *value_timestamp_and_type = cover_slot_entries_[slot_it->second].second->find(key_id);
+  if (value_timestamp_and_type != nullptr) {
+    cover_index_.setValue(slot_it->second, key_id, *value_timestamp_and_type);
+  } else {
+    cover_index_.removeValue(slot_it->second, key_id);
+  }
+}
+
+std::vector<std::pair<const LogicalNodeInfo *, DistributedData *>> DSNHandler::getCoverEntries(
+    const SlotBitset &candidates) const {
+  std::vector<std::pair<const LogicalNodeInfo *, DistributedData *>> entries;
+  entries.reserve(candidates.count());
+  candidates.forEach(
+      [&](AttributeIndex::Slot slot) { entries.push_back(cover_slot_entries_[slot]); });
+  return entries;
+}
+
 void DSNHandler::requestAttributeInformation(LogicalNodeInfo peer,
                                              const DistributedData &distr_data) {
   if (distr_data.getPhysicalNodeInfo().isInitialized()) {
@@ -27,12 +27,21 @@ FindQuery::FindQuery(const std::string &expr_string, const std::string &scope_st
 }
 
 void FindQuery::deserializeBooleanExpression(const std::string &expr_string) {
-  FindQueryParser parser;
-  this->expr_ = parser.parseBooleanExpression(expr_string);
+  this->expr_ = FindQueryParser::parse(expr_string);
+  this->compiled_expr_.reset();
 }
 
 std::string FindQuery::serializeBooleanExpression() const { return this->expr_->serialize(); }
 
+std::string FindQuery::encodeBooleanExpression() const {
+  return minhton::encodeBooleanExpression(*this->expr_);
+}
+
+void FindQuery::decodeBooleanExpression(const std::string &encoded) {
+  this->expr_ = minhton::decodeBooleanExpression(encoded);
+  this->compiled_expr_.reset();
+}
+
 void FindQuery::deserializeScope(const std::string &scope_string) {
   if (scope_string == "all") {
     this->scope_ = FindQuery::kAll;
@@ -76,8 +85,66 @@ std::vector<NodeData::Key> FindQuery::evaluateMissingAttributes(
   }
 
   auto eval_info = createEvaluationInformation(false, timestamp_now);
-  auto missing_attributes = this->expr_->evaluateMissingAttributes(data, eval_info);
+  return addSelectedAttributes(this->expr_->evaluateMissingAttributes(data, eval_info));
+}
+
+std::vector<FuzzyValue> FindQuery::evaluate(const CompiledExpression::Batch &batch,
+                                            bool all_information_present,
+                                            const uint64_t &timestamp_now) {
+  auto eval_info = createEvaluationInformation(all_information_present, timestamp_now);
+
+  std::vector<FuzzyValue> values = getCompiledExpression().evaluate(batch, eval_info);
+  if (all_information_present) {
+    for (auto &val : values) {
+      if (val.isUndecided()) val = FuzzyValue::createFalse();
+    }
+  }
+
+  return values;
+}
+
+std::vector<std::vector<NodeData::Key>> FindQuery::evaluateMissingAttributes(
+    const CompiledExpression::Batch &batch, uint64_t const &timestamp_now) const {
+  if (selection_ == FindQuery::FindQuerySelection::kSelectAll) {
+    return std::vector<std::vector<NodeData::Key>>(batch.size());
+  }
+
+  auto eval_info = createEvaluationInformation(false, timestamp_now);
+  auto missing_attributes = getCompiledExpression().evaluateMissingAttributes(batch, eval_info);
+  for (auto &entry_missing_attributes : missing_attributes) {
+    entry_missing_attributes = addSelectedAttributes(std::move(entry_missing_attributes));
+  }
+
+  return missing_attributes;
+}
+
+SlotBitset FindQuery::getCandidates(const AttributeIndex &index, FuzzyValue value,
+                                    bool all_information_present,
+                                    const uint64_t &timestamp_now) const {
+  auto eval_info = createEvaluationInformation(all_information_present, timestamp_now);
+  const auto &program = getCompiledExpression();
+
+  // evaluate turns undecided into false if all information is present
+  if (all_information_present && value.isUndecided()) {
+    return {};
+  }
+  if (all_information_present && value.isFalse()) {
+    auto candidates = program.getCandidates(index, FuzzyValue::createFalse(), eval_info);
+    candidates |= program.getCandidates(index, FuzzyValue::createUndecided(), eval_info);
+    return candidates;
+  }
+  return program.getCandidates(index, value, eval_info);
+}
+
+const CompiledExpression &FindQuery::getCompiledExpression() const {
+  if (!this->compiled_expr_) {
+    this->compiled_expr_ = std::make_shared<const CompiledExpression>(*this->expr_);
+  }
+  return *this->compiled_expr_;
+}
 
+std::vector<NodeData::Key> FindQuery::addSelectedAttributes(
+    std::vector<NodeData::Key> missing_attributes) const {
   if (selection_ == FindQuery::FindQuerySelection::kSelectUnspecific) {
     // returning only the least neccessary keys, because we don't care about the return values
     return missing_attributes;
@@ -115,6 +182,7 @@ std::shared_ptr<BooleanExpression> FindQuery::getBooleanExpression() const { ret
 
 void FindQuery::setBooleanExpression(std::shared_ptr<BooleanExpression> expr) {
   this->expr_ = expr;
+  this->compiled_expr_.reset();
 }
 
 void FindQuery::setRequestingNode(const NodeInfo &requesting_node) {
@@ -6,12 +6,21 @@
 
 #include "minhton/algorithms/esearch/find_query_parser.h"
 
-namespace minhton {
+#include <mutex>
 
-// TODO: turn into singleton
+namespace minhton {
 
 FindQueryParser::FindQueryParser() { this->initBooleanExpressionParser(); }
 
+std::shared_ptr<BooleanExpression> FindQueryParser::parse(const std::string &expr_string) {
+  static FindQueryParser parser;
+  static std::mutex parser_mutex;
+
+  // The semantic actions of the parser are shared, therefore only one parse at a time
+  std::scoped_lock lock(parser_mutex);
+  return parser.parseBooleanExpression(expr_string);
+}
+
 void FindQueryParser::initBooleanExpressionParser() {
   static const std::string boolean_expression_grammar = R"(
     expr          <- exprOR / exprAND / exprNOT / exprPRES / exprSringEq / exprNumComp / exprEmpty
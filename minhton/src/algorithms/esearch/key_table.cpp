@@ -0,0 +1,60 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "minhton/algorithms/esearch/key_table.h"
+
+#include <mutex>
+#include <stdexcept>
+
+namespace minhton {
+
+KeyTable &KeyTable::getInstance() {
+  static KeyTable instance;
+  return instance;
+}
+
+KeyTable::KeyId KeyTable::intern(const std::string &key) {
+  if (auto key_id = find(key)) return *key_id;
+
+  KeyTable &table = getInstance();
+  std::unique_lock lock(table.mutex_);
+  auto [it, inserted] = table.ids_.try_emplace(key, static_cast<KeyId>(table.names_.size()));
+  if (inserted) table.names_.push_back(key);
+  return it->second;
+}
+
+std::optional<KeyTable::KeyId> KeyTable::tryIntern(const std::string &key) {
+  if (auto key_id = find(key)) return key_id;
+
+  KeyTable &table = getInstance();
+  std::unique_lock lock(table.mutex_);
+  auto it = table.ids_.find(key);
+  if (it != table.ids_.end()) return it->second;
+  if (table.names_.size() >= kMaxKeys) return std::nullopt;
+
+  it = table.ids_.emplace(key, static_cast<KeyId>(table.names_.size())).first;
+  table.names_.push_back(key);
+  return it->second;
+}
+
+std::optional<KeyTable::KeyId> KeyTable::find(const std::string &key) {
+  KeyTable &table = getInstance();
+  std::shared_lock lock(table.mutex_);
+  auto it = table.ids_.find(key);
+  if (it == table.ids_.end()) return std::nullopt;
+  return it->second;
+}
+
+const std::string &KeyTable::getName(KeyId key_id) {
+  KeyTable &table = getInstance();
+  std::shared_lock lock(table.mutex_);
+  if (key_id >= table.names_.size()) {
+    throw std::out_of_range("Unknown key id " + std::to_string(key_id));
+  }
+  return table.names_[key_id];
+}
+
+}  // namespace minhton
@@ -38,9 +38,9 @@ void LocalData::removeKeySubscriber(const NodeData::Key &key, NodeInfo &unsubscr
   }
 }
 
-bool LocalData::isValueUpToDate(const NodeData::Key &key,
+bool LocalData::isValueUpToDate(KeyId key_id,
                                 [[maybe_unused]] uint64_t validity_threshold_timestamp) {
-  return hasKey(key);
+  return hasKey(key_id);
 }
 
 bool LocalData::isLocal() const { return true; }
@@ -125,14 +125,11 @@ void MinhtonEntitySearchAlgorithm::performFindQueryForwarding(const MessageFindQ
   auto const interval_end = std::get<1>(msg.getInterval());
   auto direction = msg.getForwardingDirection();
   auto rt_neighbors = getRoutingInfo()->getAllInitializedRoutingTableNeighbors();
-  auto dsn_numbers = getDSNSet(level, fanout);
+  auto dsn_numbers = getDSNSetView(level, fanout);
 
   std::vector<NodeInfo> dsn_rt_neighbors_in_interval;
   auto is_dsn_and_in_interval = [&](const NodeInfo &node) {
-    bool is_dsn = std::find_if(dsn_numbers.begin(), dsn_numbers.end(), [&](const uint32_t &num) {
-                    return num == node.getNumber();
-                  }) != dsn_numbers.end();
-    if (is_dsn) {
+    if (dsn_numbers.contains(node.getNumber())) {
       return interval_start < node.getNumber() && node.getNumber() < interval_end;
     }
     return false;
@@ -303,7 +300,7 @@ void MinhtonEntitySearchAlgorithm::processAttributeInquiryAnswer(
 
 // called on DSN
 void MinhtonEntitySearchAlgorithm::concludeAggregationOfInquiries(uint64_t ref_event_id) {
-  FindQuery query = access_->procedure_info->loadFindQuery(ref_event_id);
+  FindQuery &query = access_->procedure_info->loadFindQuery(ref_event_id);
   NodeInfo requesting_node = query.getRequestingNode();
 
   auto timestamp_now = access_->get_timestamp();
@@ -355,7 +352,7 @@ void MinhtonEntitySearchAlgorithm::processFindQueryAnswer(const MessageFindQuery
 }
 
 void MinhtonEntitySearchAlgorithm::savePreliminaryResultsFromInquiryAggregation(
-    const uint64_t ref_event_id, NodeData::NodesWithAttributes results) {
+    const uint64_t ref_event_id, const NodeData::NodesWithAttributes &results) {
   try {
     for (auto const &[node, attributes] : results) {
       access_->procedure_info->addFindQueryPreliminaryResults(ref_event_id, node, attributes);
@@ -367,18 +364,18 @@ void MinhtonEntitySearchAlgorithm::savePreliminaryResultsFromInquiryAggregation(
 
 // called on Requesting Node
 void MinhtonEntitySearchAlgorithm::concludeAggregationOfDSNs(uint64_t ref_event_id) {
-  FindQuery query = access_->procedure_info->loadFindQuery(ref_event_id);
+  const FindQuery &query = access_->procedure_info->loadFindQuery(ref_event_id);
 
-  NodeData::NodesWithAttributes results =
+  const NodeData::NodesWithAttributes &results =
       access_->procedure_info->loadFindQueryPreliminaryResults(ref_event_id);
   NodeData::NodesWithAttributes filtered_results =
       filterAggregationResultsAfterDSNs(results, query.getScope());
 
   notifyAboutFindQueryResults(ref_event_id, query, filtered_results);
 
-  access_->procedure_info->removeFindQuery(ref_event_id);
-  access_->procedure_info->removeFindQueryPreliminaryResults(ref_event_id);
-  access_->procedure_info->removeDSNAggregationStartTimestamp(ref_event_id);
+  // also removing the fulfilled promise and a pending inquiry aggregation
+  // if we are DSN ourselves
+  access_->procedure_info->removeFindQueryState(ref_event_id);
 }
 
 // called on Requesting Node - in the very end
@@ -510,9 +507,7 @@ std::vector<NodeInfo> MinhtonEntitySearchAlgorithm::calcDSNsToSendInitialCDSForw
   auto adj_left = getRoutingInfo()->getAdjacentLeft();
   auto adj_right = getRoutingInfo()->getAdjacentRight();
 
-  auto this_level_ds = getDSNSet(self.getLevel(), fanout);
-  bool we_are_dsn = !this_level_ds.empty() && std::find(this_level_ds.begin(), this_level_ds.end(),
-                                                        self.getNumber()) != this_level_ds.end();
+  bool we_are_dsn = isDSN(self.getLevel(), self.getNumber(), fanout);
 
   uint32_t known_max_level = 0;
   if (adj_left.getLevel() != adj_right.getLevel() || adj_left.getLevel() != self.getLevel() ||
@@ -535,17 +530,14 @@ std::vector<NodeInfo> MinhtonEntitySearchAlgorithm::calcDSNsToSendInitialCDSForw
       initial_dsns.push_back(self);
 
     } else {
-      auto level_ds = getDSNSet(level, fanout);
+      auto level_ds = getDSNSetView(level, fanout);
       if (level_ds.size() <= (size_t)fanout + 1) {
         // pick first
         initial_dsns.emplace_back(level, fanout, fanout);
 
       } else {
         // pick dsn in middle of set
-        int middle_index = level_ds.size() / 2;
-        auto it = level_ds.begin();
-        std::advance(it, middle_index);
-        uint32_t middle_number = *it;
+        uint32_t middle_number = level_ds[level_ds.size() / 2];
 
         initial_dsns.emplace_back(level, middle_number, fanout);
       }
@@ -11,66 +11,142 @@
 
 namespace minhton {
 
-NodeData::NodeData() { this->data_ = std::unordered_map<Key, ValueTimestampAndType>(); }
+NodeData::NodeData() { this->data_ = std::unordered_map<KeyId, ValueTimestampAndType>(); }
 
 bool NodeData::insert(Key key, NodeData::ValueTimestampAndType value_timestamp_and_type) {
   if (hasKey(key)) {
     return false;
   }
-  bool inserted = data_.try_emplace(key, value_timestamp_and_type).second;
-  return inserted;
+
+  // Keys may be received from other nodes, which must not fill the KeyTable without a bound
+  if (auto key_id = KeyTable::tryIntern(key)) {
+    return data_.try_emplace(*key_id, value_timestamp_and_type).second;
+  }
+  return overflow_data_.try_emplace(key, value_timestamp_and_type).second;
 }
 
 bool NodeData::update(Key key, NodeData::ValueTimestampAndType value_timestamp_and_type) {
-  auto it = data_.find(key);
-  if (it != data_.end()) {
-    if (std::get<2>(it->second) != std::get<2>(value_timestamp_and_type)) {
+  auto *current = findByName(key);
+  if (current != nullptr) {
+    if (std::get<2>(*current) != std::get<2>(value_timestamp_and_type)) {
       throw std::invalid_argument("value types need to stay the same");
     }
 
-    if (std::get<2>(it->second) == ValueType::kValueStatic) {
-      if (std::get<0>(it->second) == std::get<0>(value_timestamp_and_type)) {
+    if (std::get<2>(*current) == ValueType::kValueStatic) {
+      if (std::get<0>(*current) == std::get<0>(value_timestamp_and_type)) {
         // values didnt change, so its okay
         return true;
       }
       throw std::invalid_argument("static values cannot get updated");
     }
 
-    it->second = value_timestamp_and_type;
+    *current = value_timestamp_and_type;
     return true;
   }
   return false;
 }
 
-void NodeData::remove(Key key) { data_.erase(key); }
+void NodeData::remove(Key key) {
+  if (auto key_id = KeyTable::find(key)) {
+    data_.erase(*key_id);
+  }
+  overflow_data_.erase(key);
+}
+
+bool NodeData::hasKey(const Key &key) { return findByName(key) != nullptr; }
+
+bool NodeData::hasKey(KeyId key_id) const { return data_.find(key_id) != data_.end(); }
 
-bool NodeData::hasKey(const Key &key) { return data_.find(key) != data_.end(); }
+const NodeData::ValueTimestampAndType *NodeData::find(KeyId key_id) const {
+  auto it = data_.find(key_id);
+  return it != data_.end() ? &it->second : nullptr;
+}
 
-NodeData::ValueTimestampAndType NodeData::getValueTimestampAndType(Key key) { return data_[key]; }
+const NodeData::ValueTimestampAndType *NodeData::find(KeyId key_id, const Key &key) const {
+  if (key_id == KeyTable::kUnknownKey) {
+    key_id = KeyTable::find(key).value_or(KeyTable::kUnknownKey);
+  }
+  if (const auto *value_timestamp_and_type = find(key_id)) {
+    return value_timestamp_and_type;
+  }
+  if (overflow_data_.empty()) {
+    return nullptr;
+  }
+
+  auto it = overflow_data_.find(key);
+  return it != overflow_data_.end() ? &it->second : nullptr;
+}
+
+NodeData::ValueTimestampAndType *NodeData::findByName(const Key &key) {
+  if (auto key_id = KeyTable::find(key)) {
+    auto it = data_.find(*key_id);
+    if (it != data_.end()) {
+      return &it->second;
+    }
+  }
+
+  auto it = overflow_data_.find(key);
+  return it != overflow_data_.end() ? &it->second : nullptr;
+}
+
+NodeData::ValueTimestampAndType NodeData::getValueTimestampAndType(Key key) {
+  if (const auto *value_timestamp_and_type = findByName(key)) {
+    return *value_timestamp_and_type;
+  }
+  return {};
+}
 
 NodeData::ValueAndTimestamp NodeData::getValueAndTimestamp(Key key) {
-  auto value_timestamp_and_type = data_[key];
+  auto value_timestamp_and_type = getValueTimestampAndType(key);
   return {std::get<0>(value_timestamp_and_type), std::get<1>(value_timestamp_and_type)};
 }
 
-NodeData::Value NodeData::getValue(Key key) { return std::get<0>(data_.at(key)); }
+NodeData::Value NodeData::getValue(Key key) {
+  const auto *value_timestamp_and_type = findByName(key);
+  if (value_timestamp_and_type == nullptr) {
+    throw std::out_of_range("Unknown key " + key);
+  }
+  return std::get<0>(*value_timestamp_and_type);
+}
 
 std::unordered_map<NodeData::Key, NodeData::ValueTimestampAndType> NodeData::getData() const {
-  return data_;
+  std::unordered_map<Key, ValueTimestampAndType> data = overflow_data_;
+  for (auto const &[key_id, value_timestamp_and_type] : data_) {
+    data.emplace(KeyTable::getName(key_id), value_timestamp_and_type);
+  }
+  return data;
+}
+
+bool NodeData::isValueUpToDate(const NodeData::Key &key, uint64_t validity_threshold_timestamp) {
+  const KeyId key_id = KeyTable::find(key).value_or(KeyTable::kUnknownKey);
+  if (const auto *value_timestamp_and_type = find(key_id, key)) {
+    return isValueUpToDate(key_id, *value_timestamp_and_type, validity_threshold_timestamp);
+  }
+  return isValueUpToDate(key_id, validity_threshold_timestamp);
 }
 
-bool NodeData::isValueUpToDate(const NodeData::Key &key,
+bool NodeData::isValueUpToDate(KeyId key_id,
                                [[maybe_unused]] uint64_t validity_threshold_timestamp) {
-  return hasKey(key);
+  return hasKey(key_id);
+}
+
+bool NodeData::isValueUpToDate(
+    [[maybe_unused]] KeyId key_id,
+    [[maybe_unused]] const ValueTimestampAndType &value_timestamp_and_type,
+    [[maybe_unused]] uint64_t validity_threshold_timestamp) const {
+  return true;
 }
 
 std::vector<NodeData::Key> NodeData::getAllCurrentKeys() {
   std::vector<NodeData::Key> keys;
 
   std::transform(data_.begin(), data_.end(), std::back_inserter(keys),
-                 [](const std::tuple<NodeData::Key, NodeData::ValueTimestampAndType> &tupl) {
-                   return std::get<0>(tupl);
+                 [](const std::pair<const KeyId, NodeData::ValueTimestampAndType> &entry) {
+                   return KeyTable::getName(entry.first);
                  });
+  for (const auto &entry : overflow_data_) {
+    keys.push_back(entry.first);
+  }
 
   return keys;
 }
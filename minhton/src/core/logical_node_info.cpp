@@ -6,6 +6,7 @@
 
 #include "minhton/core/logical_node_info.h"
 
+#include <optional>
 #include <stdexcept>
 
 #include "minhton/core/constants.h"
@@ -19,6 +20,7 @@ LogicalNodeInfo::LogicalNodeInfo(uint16_t fanout) { this->setFanout(fanout); }
 /// When setFanout is executed afterwards (which must happen),
 /// the position will get verified this way.
 /// Therefore we can set the position directly without setPosition
+/// Without a fanout, there is no horizontal key yet.
 LogicalNodeInfo::LogicalNodeInfo(uint32_t p_level, uint32_t p_number)
     : level_(p_level), number_(p_number) {}
 
@@ -34,6 +36,7 @@ void LogicalNodeInfo::setPosition(uint32_t level, uint32_t number) {
     this->number_ = number;
     this->level_ = level;
     this->uuid_ = solanet::generateUUID();  // TODO Make object const
+    this->updateHorizontalKey();
   } else {
     throw std::invalid_argument("Invalid Parameter Level or Number");
   }
@@ -46,6 +49,7 @@ void LogicalNodeInfo::setPosition(LogicalNodeInfo other) {
     this->fanout_ = other.fanout_;
     this->initialized_ = other.initialized_;
     this->uuid_ = other.uuid_;
+    this->horizontal_key_ = other.horizontal_key_;
   } else {
     throw std::invalid_argument("Peer has invalid Position");
   }
@@ -70,6 +74,7 @@ void LogicalNodeInfo::setFanout(uint16_t fanout) {
 
   if (isPositionValid(this->level_, this->number_, fanout)) {
     this->fanout_ = fanout;
+    this->updateHorizontalKey();
   } else {
     throw std::invalid_argument("Position with the given Fanout is not valid");
   }
@@ -128,6 +133,35 @@ double LogicalNodeInfo::getHorizontalValue() const {
   return value;
 }
 
+uint64_t LogicalNodeInfo::getHorizontalKey() const { return this->horizontal_key_; }
+
+void LogicalNodeInfo::updateHorizontalKey() {
+  this->horizontal_key_ = calcHorizontalKey(this->level_, this->number_, this->fanout_);
+}
+
+namespace {
+/// Three-way horizontal comparison for the cases without comparable horizontal keys.
+/// Peers without a fanout are not comparable, like their horizontal value (NaN) was before.
+std::optional<int> compareHorizontally(const LogicalNodeInfo &p1, const LogicalNodeInfo &p2) {
+  if (p1.getFanout() == 0 || p2.getFanout() == 0) return std::nullopt;
+
+  if (p1.getFanout() != p2.getFanout()) {
+    double value_1 = p1.getHorizontalValue();
+    double value_2 = p2.getHorizontalValue();
+    return value_1 < value_2 ? -1 : (value_1 > value_2 ? 1 : 0);
+  }
+
+  if (p1.getHorizontalKey() != 0 && p2.getHorizontalKey() != 0) {
+    return p1.getHorizontalKey() < p2.getHorizontalKey()
+               ? -1
+               : (p1.getHorizontalKey() > p2.getHorizontalKey() ? 1 : 0);
+  }
+
+  return compareHorizontalPositions(p1.getLevel(), p1.getNumber(), p2.getLevel(), p2.getNumber(),
+                                    p1.getFanout());
+}
+}  // namespace
+
 bool operator==(const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2) {
   return (p1.getLevel() == p2.getLevel() && p1.getNumber() == p2.getNumber() &&
           p1.getFanout() == p2.getFanout() && p1.isInitialized() == p2.isInitialized());
@@ -138,11 +172,20 @@ bool operator!=(const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeIn
 }
 
 bool operator<(const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2) {
-  return p1.getHorizontalValue() < p2.getHorizontalValue();
+  // Fast path: both peers have a key for the same fanout
+  if (p1.horizontal_key_ != 0 && p2.horizontal_key_ != 0 && p1.fanout_ == p2.fanout_) {
+    return p1.horizontal_key_ < p2.horizontal_key_;
+  }
+  auto result = compareHorizontally(p1, p2);
+  return result.has_value() && *result < 0;
 }
 
 bool operator<=(const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2) {
-  return p1.getHorizontalValue() <= p2.getHorizontalValue();
+  if (p1.horizontal_key_ != 0 && p2.horizontal_key_ != 0 && p1.fanout_ == p2.fanout_) {
+    return p1.horizontal_key_ <= p2.horizontal_key_;
+  }
+  auto result = compareHorizontally(p1, p2);
+  return result.has_value() && *result <= 0;
 }
 
 bool operator>(const minhton::LogicalNodeInfo &p1, const minhton::LogicalNodeInfo &p2) {
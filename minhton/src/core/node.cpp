@@ -23,7 +23,8 @@
 namespace minhton {
 
 MinhtonNode::MinhtonNode(const ConfigNode &config_node, NeighborCallbackFct fct, bool auto_start)
-    : network_facade_([this](const MessageVariant &msg) { recv(msg); }, config_node.getOwnIP()),
+    : network_facade_([this](const MessageVariant &msg) { recv(msg); }, config_node.getOwnIP(),
+                      config_node.getWireFormat(), config_node.getNetworkOptions()),
       neighbor_update_fct_(std::move(fct)) {
   setConfig(config_node);
 
@@ -17,9 +17,7 @@ namespace minhton {
 bool getFillLevelRightToLeft(uint32_t level) { return (level % 2) == 0; }
 
 bool isNodePartOfPrioSet(uint32_t level, uint32_t number, uint16_t fanout) {
-  std::set<uint32_t> prio_set = calcPrioSet(level, fanout);
-
-  return prio_set.find(number) != prio_set.end();
+  return getPrioSetView(level, fanout).contains(number);
 }
 
 std::tuple<uint32_t, uint32_t> calcParent(uint32_t level, uint32_t number, uint16_t fanout) {
@@ -143,30 +141,8 @@ std::vector<std::tuple<uint32_t, uint32_t>> calcRightRT(uint32_t level, uint32_t
 
 /// returns an ordered set
 std::set<uint32_t> calcPrioSet(uint32_t level, uint16_t fanout) {
-  if (level == 0) {
-    return std::set<uint32_t>{0};
-  }
-  if (level == 1) {
-    return std::set<uint32_t>{(uint32_t)ceil(fanout / 2.0)};  // NOLINT(readability-magic-numbers)
-  }
-
-  uint32_t i = fanout;
-  uint32_t max_num = pow(fanout, level) - 1;
-
-  std::set<uint32_t> prio_set{fanout};
-  while (i <= max_num) {
-    i += 2 * fanout;
-    if (i <= max_num) {
-      prio_set.insert(i);
-    }
-  }
-
-  uint32_t last_prio = *prio_set.rbegin();
-  if (last_prio < max_num - fanout) {
-    prio_set.insert(max_num - fanout);
-  }
-
-  return prio_set;
+  auto prio_set = getPrioSetView(level, fanout);
+  return {prio_set.begin(), prio_set.end()};
 }
 
 // depending on the level, number and fanout this method valides if the computed position is valid
@@ -207,8 +183,8 @@ std::tuple<double, double, double> treeMapperInternal(uint32_t level, uint32_t n
     center = lower +
              ((upper - lower) / fanout) * ceil(fanout / 2.0);  // NOLINT(readability-magic-numbers)
   } else {
-    uint16_t parent_level = level - 1;
-    uint16_t parent_number = (number - (number % fanout)) / fanout;
+    uint32_t parent_level = level - 1;
+    uint32_t parent_number = (number - (number % fanout)) / fanout;
 
     // recursive call to get the parent bounds
     std::tuple<double, double, double> parent_results =
@@ -235,29 +211,8 @@ double treeMapper(uint32_t level, uint32_t number, uint16_t fanout, double K) {
 }
 
 std::vector<uint32_t> getDSNSet(uint32_t level, uint16_t fanout) {
-  std::vector<uint32_t> dsn_set;
-
-  if (level % 2 == 1) {
-    return dsn_set;
-  }
-  if (level == 0) {
-    dsn_set.push_back(0);
-    return dsn_set;
-  }
-
-  uint32_t max_number = pow(fanout, level) - 1;
-  uint32_t i = fanout;
-
-  while (i <= max_number) {
-    dsn_set.push_back(i);
-    i += 2 * fanout;
-  }
-
-  if (dsn_set[dsn_set.size() - 1] < max_number - fanout) {
-    dsn_set.push_back(max_number - fanout);
-  }
-
-  return dsn_set;
+  auto dsn_set = getDSNSetView(level, fanout);
+  return {dsn_set.begin(), dsn_set.end()};
 }
 
 std::vector<std::tuple<uint32_t, uint32_t>> getCoverArea(uint32_t level, uint32_t number,
@@ -271,19 +226,14 @@ std::vector<std::tuple<uint32_t, uint32_t>> getCoverArea(uint32_t level, uint32_
     return area;
   }
 
-  auto dsn_set = getDSNSet(level, fanout);
-  if (dsn_set.empty()) {
-    return area;
-  }
-
-  auto iter = std::find(dsn_set.begin(), dsn_set.end(), number);
-
-  if (iter == dsn_set.end()) {
+  auto dsn_set = getDSNSetView(level, fanout);
+  auto rank = dsn_set.rank(number);
+  if (!rank) {
     return area;
   }
 
   uint32_t max_number = pow(fanout, level) - 1;
-  uint32_t index = std::distance(dsn_set.begin(), iter);
+  uint64_t index = *rank;
 
   bool first = index == 0;
   bool last = index == dsn_set.size() - 1;
@@ -326,35 +276,28 @@ std::vector<std::tuple<uint32_t, uint32_t>> getCoverArea(uint32_t level, uint32_
 }
 
 std::tuple<uint32_t, uint32_t> getCoveringDSN(uint32_t level, uint32_t number, uint16_t fanout) {
-  std::vector<uint32_t> dsn_set;
-
-  if (level % 2 == 0) {
-    dsn_set = getDSNSet(level, fanout);
-  } else {
-    dsn_set = getDSNSet(level - 1, fanout);
-
+  if (level % 2 != 0) {
     auto parent_pos = calcParent(level, number, fanout);
     level = std::get<0>(parent_pos);
     number = std::get<1>(parent_pos);
   }
+  auto dsn_set = getDSNSetView(level, fanout);
 
-  uint32_t last_dsn = dsn_set[dsn_set.size() - 1];
-  auto lower = std::lower_bound(dsn_set.begin(), dsn_set.end(), number);
+  auto lower = dsn_set.lowerBound(number);
+  if (!lower) {
+    // after last dsn
+    return std::make_tuple(level, dsn_set.back());
+  }
 
   bool is_dsn = *lower == number;
-  bool before_first_dsn = lower == dsn_set.begin() && number < *lower;
-  bool after_last_dsn = number > last_dsn;
+  bool before_first_dsn = *lower == dsn_set.front() && number < *lower;
 
   if (is_dsn || before_first_dsn) {
     return std::make_tuple(level, *lower);
   }
 
-  if (after_last_dsn) {
-    return std::make_tuple(level, last_dsn);
-  }
-
   uint32_t after = *lower;
-  uint32_t prior = *--lower;
+  uint32_t prior = *dsn_set.previous(number);
 
   uint32_t lower_dist = number - prior;
   uint32_t upper_dist = after - number;
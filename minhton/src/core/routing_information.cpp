@@ -258,8 +258,7 @@ void RoutingInformation::setAdjacentLeft(const minhton::NodeInfo &adjacent_left,
   }
 
   // node is not to the left of us
-  if (adjacent_left.getLogicalNodeInfo().getHorizontalValue() >=
-      this->self_node_info_.getLogicalNodeInfo().getHorizontalValue()) {
+  if (adjacent_left.getLogicalNodeInfo() >= this->self_node_info_.getLogicalNodeInfo()) {
     throw std::invalid_argument("Adjacent is not to the left of us");
   }
 
@@ -288,8 +287,7 @@ void RoutingInformation::setAdjacentRight(const minhton::NodeInfo &adjacent_righ
   }
 
   // node is not to the right of us
-  if (adjacent_right.getLogicalNodeInfo().getHorizontalValue() <=
-      this->self_node_info_.getLogicalNodeInfo().getHorizontalValue()) {
+  if (adjacent_right.getLogicalNodeInfo() <= this->self_node_info_.getLogicalNodeInfo()) {
     throw std::invalid_argument("Adjacent is not to the right of us");
   }
 
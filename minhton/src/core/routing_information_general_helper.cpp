@@ -560,8 +560,8 @@ minhton::NodeInfo RoutingInformation::getLowestNode() const {
 }
 
 bool RoutingInformation::areWeDSN() const {
-  auto dsn_set = getDSNSet(self_node_info_.getLevel(), self_node_info_.getFanout());
-  return std::find(dsn_set.begin(), dsn_set.end(), self_node_info_.getNumber()) != dsn_set.end();
+  return isDSN(self_node_info_.getLevel(), self_node_info_.getNumber(),
+               self_node_info_.getFanout());
 }
 
 bool RoutingInformation::areWeTempDSN() const {
@@ -570,15 +570,15 @@ bool RoutingInformation::areWeTempDSN() const {
   }
 
   // we are not a proper dsn
-  auto dsn_set_level_below = getDSNSet(self_node_info_.getLevel() + 1, self_node_info_.getFanout());
+  auto dsn_set_level_below =
+      getDSNSetView(self_node_info_.getLevel() + 1, self_node_info_.getFanout());
   if (dsn_set_level_below.empty()) {
     return false;
   }
 
   // a child is dsn and is not initialized
   for (auto const &child : children_) {
-    bool child_is_dsn = std::find(dsn_set_level_below.begin(), dsn_set_level_below.end(),
-                                  child.getNumber()) != dsn_set_level_below.end();
+    bool child_is_dsn = dsn_set_level_below.contains(child.getNumber());
     if (child_is_dsn && !child.isInitialized()) {
       // is there any node on the level below?
       auto lowest_node = this->getLowestNode();
@@ -607,8 +607,8 @@ NodeInfo RoutingInformation::getCoveringDSNOrTempDSN() {
     return {covering_level, covering_number, fanout};
   }
 
-  auto dsn_set = getDSNSet(covering_level, fanout);
-  bool covering_dsn_is_first = *dsn_set.begin() == covering_number;
+  auto dsn_set = getDSNSetView(covering_level, fanout);
+  bool covering_dsn_is_first = dsn_set.front() == covering_number;
 
   // if covering dsn is first dsn on level
   // parent of dsn
@@ -620,8 +620,8 @@ NodeInfo RoutingInformation::getCoveringDSNOrTempDSN() {
   // if covering dsn is not first on level
   // dsn before
 
-  auto it = std::lower_bound(dsn_set.begin(), dsn_set.end(), covering_number - 1);
-  return {covering_level, *it, fanout};
+  auto dsn_before = dsn_set.lowerBound(covering_number - 1);
+  return {covering_level, *dsn_before, fanout};
 }
 
 bool RoutingInformation::nextDSNExists() {
@@ -632,20 +632,20 @@ bool RoutingInformation::nextDSNExists() {
 NodeInfo RoutingInformation::getNextDSN() {
   // precondition: we are a dsn
 
-  auto dsn_set = getDSNSet(self_node_info_.getLevel(), self_node_info_.getFanout());
-  auto it = std::lower_bound(dsn_set.begin(), dsn_set.end(), self_node_info_.getNumber());
+  auto dsn_set = getDSNSetView(self_node_info_.getLevel(), self_node_info_.getFanout());
+  auto dsn_number = dsn_set.lowerBound(self_node_info_.getNumber());
 
-  if (it == dsn_set.end()) {
+  if (!dsn_number) {
     throw std::invalid_argument("We are not a DSN. This method should not be called");
   }
 
-  if (*it == dsn_set[dsn_set.size() - 1]) {
+  auto next_dsn_number = dsn_set.next(*dsn_number);
+  if (!next_dsn_number) {
     // if we are last dsn
     return {};
   }
 
-  auto next_dsn_number = *std::next(it, 1);
-  auto next_dsn = getNodeInfoByPosition(self_node_info_.getLevel(), next_dsn_number);
+  auto next_dsn = getNodeInfoByPosition(self_node_info_.getLevel(), *next_dsn_number);
 
   return next_dsn;
 }
@@ -0,0 +1,278 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "minhton/core/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace minhton::core {
+
+namespace {
+
+uint32_t getShift(uint32_t level) { return level * TimerWheel::kSlotBits; }
+
+uint32_t getSlot(uint64_t tick, uint32_t level) {
+  return static_cast<uint32_t>(tick >> getShift(level)) & (TimerWheel::kSlots - 1);
+}
+
+}  // namespace
+
+TimerWheel::TimerWheel() {
+  for (auto &level : slots_) level.fill(kNone);
+}
+
+TimerHandle TimerWheel::schedule(uint64_t ticks, std::function<void()> function) {
+  uint32_t index = 0;
+  if (!free_nodes_.empty()) {
+    index = free_nodes_.back();
+    free_nodes_.pop_back();
+  } else {
+    index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  }
+
+  Node &node = nodes_[index];
+  node.function = std::move(function);
+  node.expiry = current_tick_ + std::max<uint64_t>(ticks, 1);
+  node.pending = true;
+  link(index);
+  size_++;
+
+  return {index, node.generation};
+}
+
+bool TimerWheel::cancel(const TimerHandle &handle) {
+  if (handle.index >= nodes_.size()) return false;
+
+  const Node &node = nodes_[handle.index];
+  if (!node.pending || node.generation != handle.generation) return false;
+
+  unlink(handle.index);
+  release(handle.index);
+  size_--;
+  return true;
+}
+
+void TimerWheel::advance(uint64_t tick, Expired &expired) {
+  // Jumping from one expiry or cascade to the next, the ticks in between have nothing to do
+  for (auto next_tick = getNextTick(); next_tick && *next_tick <= tick; next_tick = getNextTick()) {
+    current_tick_ = *next_tick;
+
+    // Higher levels first, so that their timers can be cascaded further down in the same tick
+    uint32_t cascade_level = 0;
+    while (cascade_level + 1 < kLevels && getSlot(current_tick_, cascade_level) == 0) {
+      cascade_level++;
+    }
+    for (uint32_t level = cascade_level; level > 0; level--) cascade(level);
+
+    const uint32_t slot = getSlot(current_tick_, 0);
+    uint32_t index = slots_[0][slot];
+    slots_[0][slot] = kNone;
+    occupied_[0] &= ~(uint64_t{1} << slot);
+
+    while (index != kNone) {
+      Node &node = nodes_[index];
+      const uint32_t next = node.next;
+      expired.emplace_back(TimerHandle{index, node.generation}, std::move(node.function));
+      release(index);
+      size_--;
+      index = next;
+    }
+  }
+
+  current_tick_ = std::max(current_tick_, tick);
+}
+
+std::optional<uint64_t> TimerWheel::getNextTick() const {
+  std::optional<uint64_t> next_tick;
+
+  for (uint32_t level = 0; level < kLevels; level++) {
+    if (occupied_[level] == 0) continue;
+
+    // Distance to the next occupied slot after the current one, a full turn for the current one
+    const uint32_t rotation = (getSlot(current_tick_, level) + 1) % kSlots;
+    const uint64_t occupied = rotation == 0 ? occupied_[level]
+                                            : (occupied_[level] >> rotation) |
+                                                  (occupied_[level] << (kSlots - rotation));
+    const auto distance = static_cast<uint64_t>(__builtin_ctzll(occupied)) + 1;
+
+    const uint64_t tick = ((current_tick_ >> getShift(level)) + distance) << getShift(level);
+    if (!next_tick || tick < *next_tick) next_tick = tick;
+  }
+
+  return next_tick;
+}
+
+void TimerWheel::link(uint32_t index) {
+  Node &node = nodes_[index];
+  const uint64_t distance = node.expiry - current_tick_;
+
+  uint32_t level = 0;
+  while (level + 1 < kLevels && distance >= (uint64_t{1} << getShift(level + 1))) level++;
+
+  // Out of range, the timer is cascaded again as late as possible
+  const uint64_t tick = distance < kRange ? node.expiry : current_tick_ + kRange - 1;
+  const uint32_t slot = getSlot(tick, level);
+
+  node.level = static_cast<uint8_t>(level);
+  node.slot = static_cast<uint8_t>(slot);
+  node.next = kNone;
+
+  // Appended to the slot, the previous node of the head is the tail
+  uint32_t &head = slots_[level][slot];
+  if (head == kNone) {
+    head = index;
+    node.previous = index;
+    occupied_[level] |= uint64_t{1} << slot;
+  } else {
+    const uint32_t tail = nodes_[head].previous;
+    nodes_[tail].next = index;
+    node.previous = tail;
+    nodes_[head].previous = index;
+  }
+}
+
+void TimerWheel::unlink(uint32_t index) {
+  Node &node = nodes_[index];
+  uint32_t &head = slots_[node.level][node.slot];
+
+  if (head == index) {
+    head = node.next;
+    if (head != kNone) {
+      nodes_[head].previous = node.previous;
+    } else {
+      occupied_[node.level] &= ~(uint64_t{1} << node.slot);
+    }
+  } else {
+    nodes_[node.previous].next = node.next;
+    if (node.next != kNone) {
+      nodes_[node.next].previous = node.previous;
+    } else {
+      nodes_[head].previous = node.previous;
+    }
+  }
+}
+
+void TimerWheel::release(uint32_t index) {
+  Node &node = nodes_[index];
+  node.function = nullptr;
+  node.pending = false;
+  node.generation++;
+  free_nodes_.push_back(index);
+}
+
+void TimerWheel::cascade(uint32_t level) {
+  const uint32_t slot = getSlot(current_tick_, level);
+  uint32_t index = slots_[level][slot];
+  slots_[level][slot] = kNone;
+  occupied_[level] &= ~(uint64_t{1} << slot);
+
+  while (index != kNone) {
+    const uint32_t next = nodes_[index].next;
+    link(index);
+    index = next;
+  }
+}
+
+TimerService::TimerService() : runner_(&TimerService::run, this) {}
+
+TimerService::~TimerService() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wakeup_.notify_all();
+  if (runner_.joinable()) runner_.join();
+}
+
+TimerService &TimerService::getInstance() {
+  static TimerService service;
+  return service;
+}
+
+TimerHandle TimerService::schedule(uint32_t milliseconds, std::function<void()> function) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // The wheel only advances when the runner wakes up, so it can be behind the current time.
+  // Rounding up, timers never expire early.
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_);
+  const uint64_t expiry = (elapsed.count() + 999) / 1000 + milliseconds;
+
+  auto handle = wheel_.schedule(expiry - wheel_.getCurrentTick(), std::move(function));
+  if (expiry < wakeup_tick_) wakeup_.notify_one();
+  return handle;
+}
+
+bool TimerService::cancel(const TimerHandle &handle) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (wheel_.cancel(handle)) return true;
+
+  // Expired, but not yet executed
+  for (std::size_t i = next_expired_; i < expired_.size(); i++) {
+    if (expired_[i].first == handle) {
+      expired_[i] = {};
+      return true;
+    }
+  }
+
+  if (std::this_thread::get_id() != runner_.get_id()) {
+    finished_.wait(lock, [this, &handle]() { return running_ != handle; });
+  }
+  return false;
+}
+
+bool TimerService::isActive(const TimerHandle &handle) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (wheel_.isPending(handle) || running_ == handle) return true;
+  return std::any_of(expired_.begin() + next_expired_, expired_.end(),
+                     [&handle](const auto &entry) { return entry.first == handle; });
+}
+
+std::size_t TimerService::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return wheel_.size() + std::count_if(expired_.begin() + next_expired_, expired_.end(),
+                                       [](const auto &entry) { return entry.second != nullptr; });
+}
+
+uint64_t TimerService::getTick() const {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_).count();
+}
+
+void TimerService::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (!stop_) {
+    wheel_.advance(getTick(), expired_);
+
+    while (next_expired_ < expired_.size()) {
+      auto &[handle, function] = expired_[next_expired_++];
+      if (!function) continue;  // cancelled
+
+      running_ = handle;
+      auto running_function = std::move(function);
+      lock.unlock();
+      running_function();
+      running_function = nullptr;
+      lock.lock();
+      running_.reset();
+      finished_.notify_all();
+    }
+    expired_.clear();
+    next_expired_ = 0;
+
+    const auto next_tick = wheel_.getNextTick();
+    if (next_tick) {
+      wakeup_tick_ = *next_tick;
+      wakeup_.wait_until(lock, start_ + std::chrono::milliseconds(*next_tick));
+    } else {
+      wakeup_tick_ = std::numeric_limits<uint64_t>::max();
+      wakeup_.wait(lock);
+    }
+  }
+}
+
+}  // namespace minhton::core
@@ -6,68 +6,34 @@
 
 #include "minhton/core/watchdog.h"
 
-#include <event2/event.h>
-#include <event2/thread.h>
-
-#include <atomic>
-#include <cassert>
-#include <stdexcept>
-#include <thread>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include "minhton/core/timer_wheel.h"
+
 namespace minhton::core {
-// Forward declaration
-static void execute(evutil_socket_t socket, short ev_flags, void *entry);
-static int addToList(const struct event_base *base, const struct event *event, void *entry);
 
 /**
- * Wrapper for libevent event
+ * Schedules the jobs on the TimerService of the process and remembers them by their TimeoutType
  */
-class Event {
-public:
-  /**
-   *
-   * @param function function to execute
-   * @param base libevent base
-   */
-  Event(std::function<void()> function, event_base *base)
-      : fct(std::move(function)), event(event_new(base, -1, 0, execute, this)) {}
-
-  ~Event() { event_free(event); }
-
-  Event(const Event &) = delete;
-  Event &operator=(const Event &) = delete;
-  Event(const Event &&) = delete;
-  Event &operator=(const Event &&) = delete;
-
-  std::function<void()> fct;
-  struct event *event;
-};
-
 class WatchDog::Impl {
 public:
-  Impl() {
-    evthread_use_pthreads();
-    base_ = event_base_new();
-    runner_ = std::thread(&WatchDog::Impl::run, this);
-  }
+  Impl() = default;
 
   ~Impl() {
-    [[maybe_unused]] int res = event_base_loopexit(base_, nullptr);
-    assert(res == 0);
-    if (runner_.joinable()) runner_.join();
-
-    // delete all pending events
-    std::vector<const struct event *> events;
-    res = event_base_foreach_event(base_, addToList, &events);
-    assert(res == 0);
-    for (size_t i = 1; i < events.size(); i++) {
-      auto event_arg =
-          reinterpret_cast<Event *>(  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-              event_get_callback_arg(events[i]));
-      delete event_arg;  // NOLINT(cppcoreguidelines-owning-memory)
+    std::vector<TimerHandle> handles;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+      for (const auto &[timeout_type, type_handles] : jobs_) {
+        handles.insert(handles.end(), type_handles.begin(), type_handles.end());
+      }
     }
-    event_base_free(base_);
+
+    // Waits for running jobs, which must not outlive the watchdog
+    for (const auto &handle : handles) service_.cancel(handle);
   }
 
   Impl(const Impl &) = delete;
@@ -75,53 +41,41 @@ public:
   Impl(const Impl &&) = delete;
   Impl &operator=(const Impl &&) = delete;
 
-  void addJob(std::function<void()> function, uint32_t miliseconds,
-              [[maybe_unused]] TimeoutType &timeout_type) {
-    if (running_) {
-      struct timeval tv {};
-      tv.tv_sec = miliseconds /
-                  1000;  // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-      tv.tv_usec =
-          1000 *  // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-          (miliseconds %
-           1000);  // NOLINT(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
-      auto event = new Event(std::move(function), base_);
-      event_add(event->event, &tv);
-    }
-  }
+  void addJob(std::function<void()> function, uint32_t milliseconds,
+              const TimeoutType &timeout_type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) return;
 
-  void cancelJob([[maybe_unused]] const minhton::TimeoutType &timeout_type) {
-    // TODO Implement
-  }
+    // Forgetting jobs which already ran
+    auto &handles = jobs_[timeout_type];
+    handles.erase(std::remove_if(handles.begin(), handles.end(),
+                                 [this](const auto &handle) { return !service_.isActive(handle); }),
+                  handles.end());
 
-private:
-  struct event_base *base_;
-  std::thread runner_;
-  std::atomic_bool running_ = true;
+    handles.push_back(service_.schedule(milliseconds, std::move(function)));
+  }
 
-  void run() {
-    if (base_ == nullptr) {
-      throw std::runtime_error("base not initialized");
+  void cancelJob(const TimeoutType &timeout_type) {
+    // Cancelling without holding the mutex, so that a running job can still add new jobs
+    std::vector<TimerHandle> handles;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = jobs_.find(timeout_type);
+      if (it == jobs_.end()) return;
+      handles.swap(it->second);
     }
-    event_base_loop(base_, EVLOOP_NO_EXIT_ON_EMPTY);
+
+    // Usually there is only one job per type
+    for (const auto &handle : handles) service_.cancel(handle);
   }
-};
 
-static void execute([[maybe_unused]] evutil_socket_t socket, [[maybe_unused]] short ev_flags,
-                    void *entry) {
-  auto event =
-      reinterpret_cast<Event *>(entry);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-  event->fct();
-  delete event;  // NOLINT(cppcoreguidelines-owning-memory)
-}
+private:
+  TimerService &service_ = TimerService::getInstance();
 
-static int addToList([[maybe_unused]] const struct event_base *base, const struct event *event,
-                     void *entry) {
-  auto events = reinterpret_cast<  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-      std::vector<const struct event *> *>(entry);
-  events->push_back(event);
-  return 0;
-}
+  std::mutex mutex_;
+  std::unordered_map<TimeoutType, std::vector<TimerHandle>> jobs_;
+  bool stopped_ = false;
+};
 
 WatchDog::WatchDog() : pimpl_(std::make_unique<Impl>()) {}
 
@@ -129,7 +83,7 @@ WatchDog::~WatchDog() = default;
 
 void WatchDog::addJob(std::function<void()> function, uint32_t milliseconds,
                       TimeoutType &timeout_type) {
-  pimpl_->addJob(function, milliseconds, timeout_type);
+  pimpl_->addJob(std::move(function), milliseconds, timeout_type);
 }
 
 void WatchDog::cancelJob(const TimeoutType &timeout_type) { pimpl_->cancelJob(timeout_type); }
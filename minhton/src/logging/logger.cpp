@@ -6,36 +6,31 @@
 
 #include "minhton/logging/logger.h"
 
+#include <algorithm>
+
 namespace minhton {
 
 void Logger::addLogger(LoggerPtr logger) {
   auto it = std::find_if(logger_list_.begin(), logger_list_.end(),
                          [&](auto logger_) { return logger_.get() == logger.get(); });
   if (it == logger_list_.end()) logger_list_.push_back(std::move(logger));
+  updateEnabledLevels();
 }
 
 void Logger::logCritical(const std::string &msg) const {
-  if (log_level_ >= LogLevel::kCritical) {
-    logCommand([&msg](const LoggerPtr &logger) { logger->logCritical(msg); });
-  }
+  logMessage(LogLevel::kCritical, [&msg](const LoggerPtr &logger) { logger->logCritical(msg); });
 }
 
 void Logger::logWarning(const std::string &msg) const {
-  if (log_level_ >= LogLevel::kWarning) {
-    logCommand([&msg](const LoggerPtr &logger) { logger->logWarning(msg); });
-  }
+  logMessage(LogLevel::kWarning, [&msg](const LoggerPtr &logger) { logger->logWarning(msg); });
 }
 
 void Logger::logInfo(const std::string &msg) const {
-  if (log_level_ >= LogLevel::kInfo) {
-    logCommand([&msg](const LoggerPtr &logger) { logger->logInfo(msg); });
-  }
+  logMessage(LogLevel::kInfo, [&msg](const LoggerPtr &logger) { logger->logInfo(msg); });
 }
 
 void Logger::logDebug(const std::string &msg) const {
-  if (log_level_ >= LogLevel::kDebug) {
-    logCommand([&msg](const LoggerPtr &logger) { logger->logDebug(msg); });
-  }
+  logMessage(LogLevel::kDebug, [&msg](const LoggerPtr &logger) { logger->logDebug(msg); });
 }
 
 void Logger::logPhysicalNodeInfo(const LoggerPhysicalNodeInfo &info) {
@@ -92,9 +87,37 @@ template <typename LogFunction> void Logger::logCommand(LogFunction function) co
   }
 }
 
+template <typename LogFunction>
+void Logger::logMessage(LogLevel level, LogFunction function) const {
+  if (!isEnabled(level)) return;
+
+  const uint32_t level_bit = 1U << static_cast<uint32_t>(level);
+  for (std::size_t i = 0; i < logger_list_.size(); i++) {
+    if ((logger_levels_[i] & level_bit) != 0) function(logger_list_[i]);
+  }
+}
+
+void Logger::updateEnabledLevels() {
+  logger_levels_.assign(logger_list_.size(), 0);
+  enabled_levels_ = 0;
+
+  for (std::size_t i = 0; i < logger_list_.size(); i++) {
+    for (auto level :
+         {LogLevel::kDebug, LogLevel::kInfo, LogLevel::kWarning, LogLevel::kCritical}) {
+      if (level >= log_level_ && logger_list_[i]->isLogLevelEnabled(level)) {
+        logger_levels_[i] |= 1U << static_cast<uint32_t>(level);
+      }
+    }
+    enabled_levels_ |= logger_levels_[i];
+  }
+}
+
 LogLevel Logger::getLogLevel() const { return log_level_; }
 
-void Logger::setLogLevel(LogLevel logLevel) { this->log_level_ = logLevel; }
+void Logger::setLogLevel(LogLevel logLevel) {
+  this->log_level_ = logLevel;
+  updateEnabledLevels();
+}
 
 LogLevel Logger::logLevelFromString(const std::string &level) {
   if (level == "debug") {
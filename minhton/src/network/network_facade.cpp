@@ -8,26 +8,40 @@
 
 #include <utility>
 
+#include "solanet/network_udp/buffer_pool.h"
+
 namespace minhton {
 
 NetworkFacade::NetworkFacade(std::function<void(const MessageVariant &msg)> recv_fct,
-                             const std::string &ip)
-    : network_(
-          ip, [this](auto &&message) { processMessage(std::forward<decltype(message)>(message)); }),
+                             const std::string &ip, WireFormat wire_format,
+                             const solanet::NetworkOptions &network_options)
+    : serializer_(wire_format),
+      network_(
+          ip, [this](auto &&message) { processMessage(std::forward<decltype(message)>(message)); },
+          network_options),
       recv_fct_(std::move(recv_fct)) {}
 
 void NetworkFacade::send(const MessageVariant &msg) {
   MinhtonMessageHeader header =
       std::visit([](const auto &arg) -> MinhtonMessageHeader { return arg.getHeader(); }, msg);
-  network_.send(
-      {header.getTarget().getAddress(), header.getTarget().getPort(), serializer_.serialize(msg)});
+
+  // Serialize into a pooled buffer, which is moved into the network and returned after sending
+  std::string buffer = solanet::BufferPool::global().acquire();
+  serializer_.serializeInto(msg, buffer);
+  network_.send({header.getTarget().getAddress(), header.getTarget().getPort(), std::move(buffer)});
 }
 
 std::string NetworkFacade::getIP() const { return network_.getIP(); }
 
 uint16_t NetworkFacade::getPort() const { return network_.getPort(); }
 
+WireFormat NetworkFacade::getWireFormat() const { return serializer_.getWireFormat(); }
+
 void NetworkFacade::processMessage(const solanet::Message &msg) {
+  if (serializer::SerializerCereal::detectWireFormat(msg.getMessage()) == WireFormat::kCompact) {
+    serializer_.setWireFormat(WireFormat::kCompact);
+  }
+
   auto deserialized_msg = serializer_.deserialize(msg.getMessage());
   recv_fct_(deserialized_msg);
 }
@@ -20,6 +20,14 @@ void ConfigNode::setIsRoot(bool isRoot) { this->root_ = isRoot; }
 void ConfigNode::setVerbose(bool verbose) { this->verbose_ = verbose; }
 bool ConfigNode::getVerbose() const { return this->verbose_; }
 
+WireFormat ConfigNode::getWireFormat() const { return this->wire_format_; }
+void ConfigNode::setWireFormat(WireFormat wire_format) { this->wire_format_ = wire_format; }
+
+solanet::NetworkOptions ConfigNode::getNetworkOptions() const { return network_options_; }
+void ConfigNode::setNetworkOptions(const solanet::NetworkOptions &network_options) {
+  network_options_ = network_options;
+}
+
 uint16_t ConfigNode::getTreemapper() const { return this->treemapper_; }
 void ConfigNode::setTreemapper(uint16_t treemapper) { this->treemapper_ = treemapper; }
 
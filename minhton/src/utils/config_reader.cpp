@@ -50,6 +50,13 @@ minhton::ConfigNode readConfig(std::string path_to_file) {
     config.setTreemapper(config_file["treemapper"].as<uint16_t>(kTreeMapperRootValue));
     config.setIsRoot(config_file["root"].as<bool>(false));
 
+    auto wire_format = config_file["wire_format"].as<std::string>("binary");
+    if (wire_format == "compact") {
+      config.setWireFormat(WireFormat::kCompact);
+    } else if (wire_format != "binary") {
+      throw std::invalid_argument("Unknown wire format " + wire_format);
+    }
+
     auto join_mode = readRequired<std::string>("join_mode", config_file);
     if (join_mode == "none") {
       config.setJoinInfo({JoinInfo::kNone, ""});
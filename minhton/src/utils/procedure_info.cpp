@@ -19,40 +19,35 @@ bool ProcedureInfo::hasNodeInfo(ProcedureKey key) const {
   return this->map_.find(key) != this->map_.end();
 };
 bool ProcedureInfo::hasFindQueryEvent(uint64_t ref_event_id) const {
-  return this->find_query_requests_.find(ref_event_id) != this->find_query_requests_.end();
+  return hasPart(ref_event_id, &FindQueryState::query);
 };
 
 bool ProcedureInfo::hasFindQueryUndecidedNodes(uint64_t ref_event_id) const {
-  return this->find_query_undecided_nodes_.find(ref_event_id) !=
-         this->find_query_undecided_nodes_.end();
+  return hasPart(ref_event_id, &FindQueryState::undecided_nodes);
 }
 
 bool ProcedureInfo::hasFindQueryPreliminaryResults(uint64_t ref_event_id) const {
-  return this->find_query_preliminary_results_.find(ref_event_id) !=
-         this->find_query_preliminary_results_.end();
+  return hasPart(ref_event_id, &FindQueryState::preliminary_results);
 }
 
 bool ProcedureInfo::hasDSNAggregationStartTimestamp(uint64_t ref_event_id) const {
-  return this->dsn_aggregation_start_timestamp_.find(ref_event_id) !=
-         this->dsn_aggregation_start_timestamp_.end();
+  return hasPart(ref_event_id, &FindQueryState::dsn_aggregation_start_timestamp);
 }
 
 bool ProcedureInfo::hasInquiryAggregationStartTimestamp(uint64_t ref_event_id) const {
-  return this->inquiry_aggregation_start_timestamp_.find(ref_event_id) !=
-         this->inquiry_aggregation_start_timestamp_.end();
+  return hasPart(ref_event_id, &FindQueryState::inquiry_aggregation_start_timestamp);
 }
 
 bool ProcedureInfo::hasNumberOfAddressedDSNs(uint64_t ref_event_id) const {
-  return this->number_of_addressed_dsns_.find(ref_event_id) !=
-         this->number_of_addressed_dsns_.end();
+  return hasPart(ref_event_id, &FindQueryState::number_of_addressed_dsns);
 }
 
 bool ProcedureInfo::hasNumberOfAnsweredDSNs(uint64_t ref_event_id) const {
-  return this->number_of_answered_dsns_.find(ref_event_id) != this->number_of_answered_dsns_.end();
+  return hasPart(ref_event_id, &FindQueryState::number_of_answered_dsns);
 }
 
 bool ProcedureInfo::hasFindResultFuture(uint64_t ref_event_id) const {
-  return this->find_result_promises_.find(ref_event_id) != this->find_result_promises_.end();
+  return hasPart(ref_event_id, &FindQueryState::find_result_promise);
 }
 
 bool ProcedureInfo::hasKey(ProcedureKey key) const { return hasEvent(key) || hasNodeInfo(key); }
@@ -115,275 +110,250 @@ void ProcedureInfo::removeEventId(ProcedureKey key) noexcept(false) {
   this->event_ids_.erase(key);
 }
 
-void ProcedureInfo::saveFindQuery(uint64_t ref_event_id, const FindQuery &value) noexcept(false) {
-  if (this->hasFindQueryEvent(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
+bool ProcedureInfo::FindQueryState::empty() const {
+  return !query && !undecided_nodes && !preliminary_results && !dsn_aggregation_start_timestamp &&
+         !inquiry_aggregation_start_timestamp && !number_of_addressed_dsns &&
+         !number_of_answered_dsns && !find_result_promise;
+}
 
-  this->find_query_requests_[ref_event_id] = value;
+const ProcedureInfo::FindQueryState *ProcedureInfo::findState(uint64_t ref_event_id) const {
+  auto it = find_query_slots_.find(ref_event_id);
+  if (it == find_query_slots_.end()) {
+    return nullptr;
+  }
+  return &find_query_states_[it->second];
 }
 
-FindQuery ProcedureInfo::loadFindQuery(uint64_t ref_event_id) noexcept(false) {
-  if (!this->hasFindQueryEvent(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
+ProcedureInfo::FindQueryState *ProcedureInfo::findState(uint64_t ref_event_id) {
+  auto it = find_query_slots_.find(ref_event_id);
+  if (it == find_query_slots_.end()) {
+    return nullptr;
   }
+  return &find_query_states_[it->second];
+}
 
-  return this->find_query_requests_[ref_event_id];
+template <typename T>
+bool ProcedureInfo::hasPart(uint64_t ref_event_id, FindQueryStatePart<T> part) const {
+  const FindQueryState *state = findState(ref_event_id);
+  return state != nullptr && (state->*part).has_value();
 }
 
-void ProcedureInfo::updateFindQuery(uint64_t ref_event_id, const FindQuery &value) noexcept(false) {
-  if (!this->hasFindQueryEvent(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot update a non-existent entry.");
+template <typename T>
+void ProcedureInfo::savePart(uint64_t ref_event_id, FindQueryStatePart<T> part,
+                             T &&value) noexcept(false) {
+  auto [it, inserted] = find_query_slots_.try_emplace(ref_event_id, 0);
+  if (inserted) {
+    if (free_find_query_slots_.empty()) {
+      it->second = static_cast<uint32_t>(find_query_states_.size());
+      find_query_states_.emplace_back();
+    } else {
+      it->second = free_find_query_slots_.back();
+      free_find_query_slots_.pop_back();
+    }
   }
 
-  this->find_query_requests_[ref_event_id] = value;
+  auto &stored = find_query_states_[it->second].*part;
+  if (stored) {
+    throw AlgorithmException("Event already exists. Extremely unlikely.");
+  }
+  stored = std::move(value);
 }
 
-void ProcedureInfo::removeFindQuery(uint64_t ref_event_id) noexcept(false) {
-  if (!this->hasFindQueryEvent(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
+template <typename T>
+T &ProcedureInfo::loadPart(uint64_t ref_event_id, FindQueryStatePart<T> part,
+                           const char *action) noexcept(false) {
+  FindQueryState *state = findState(ref_event_id);
+  if (state == nullptr || !(state->*part)) {
+    throw AlgorithmException(std::string("Event does not exist. You cannot ") + action +
+                             " a non-existent entry.");
   }
+  return *(state->*part);
+}
+
+template <typename T>
+void ProcedureInfo::removePart(uint64_t ref_event_id, FindQueryStatePart<T> part) noexcept(false) {
+  loadPart(ref_event_id, part, "remove");
 
-  this->find_query_requests_.erase(ref_event_id);
+  FindQueryState &state = find_query_states_[find_query_slots_[ref_event_id]];
+  (state.*part).reset();
+  if (state.empty()) {
+    removeFindQueryState(ref_event_id);
+  }
+}
+
+void ProcedureInfo::saveFindQuery(uint64_t ref_event_id, const FindQuery &value) noexcept(false) {
+  savePart(ref_event_id, &FindQueryState::query, FindQuery(value));
+}
+
+FindQuery &ProcedureInfo::loadFindQuery(uint64_t ref_event_id) noexcept(false) {
+  return loadPart(ref_event_id, &FindQueryState::query, "load");
+}
+
+void ProcedureInfo::updateFindQuery(uint64_t ref_event_id, const FindQuery &value) noexcept(false) {
+  loadPart(ref_event_id, &FindQueryState::query, "update") = value;
+}
+
+void ProcedureInfo::removeFindQuery(uint64_t ref_event_id) noexcept(false) {
+  removePart(ref_event_id, &FindQueryState::query);
 }
 
 void ProcedureInfo::saveFindQueryUndecidedNodes(
     uint64_t ref_event_id, const std::vector<NodeInfo> &value) noexcept(false) {
-  if (this->hasFindQueryUndecidedNodes(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
-
-  this->find_query_undecided_nodes_[ref_event_id] = value;
+  savePart(ref_event_id, &FindQueryState::undecided_nodes, std::vector<NodeInfo>(value));
 }
 
-std::vector<NodeInfo> ProcedureInfo::loadFindQueryUndecidedNodes(uint64_t ref_event_id) noexcept(
+std::vector<NodeInfo> &ProcedureInfo::loadFindQueryUndecidedNodes(uint64_t ref_event_id) noexcept(
     false) {
-  if (!this->hasFindQueryUndecidedNodes(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
-  }
-
-  return this->find_query_undecided_nodes_[ref_event_id];
+  return loadPart(ref_event_id, &FindQueryState::undecided_nodes, "load");
 }
 
 void ProcedureInfo::updateFindQueryUndecidedNodes(
     uint64_t ref_event_id, const std::vector<NodeInfo> &value) noexcept(false) {
-  if (!this->hasFindQueryUndecidedNodes(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot update a non-existent entry.");
-  }
-
-  this->find_query_undecided_nodes_[ref_event_id] = value;
+  loadPart(ref_event_id, &FindQueryState::undecided_nodes, "update") = value;
 }
 
 void ProcedureInfo::removeFindQueryUndecidedNodes(uint64_t ref_event_id) noexcept(false) {
-  if (!this->hasFindQueryUndecidedNodes(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
-  }
-
-  this->find_query_undecided_nodes_.erase(ref_event_id);
+  removePart(ref_event_id, &FindQueryState::undecided_nodes);
 }
 
 void ProcedureInfo::saveFindQueryPreliminaryResults(
     uint64_t ref_event_id, const NodeData::NodesWithAttributes &value) noexcept(false) {
-  if (this->hasFindQueryPreliminaryResults(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
-
-  this->find_query_preliminary_results_[ref_event_id] = value;
+  savePart(ref_event_id, &FindQueryState::preliminary_results,
+           NodeData::NodesWithAttributes(value));
 }
 
-NodeData::NodesWithAttributes ProcedureInfo::loadFindQueryPreliminaryResults(
+NodeData::NodesWithAttributes &ProcedureInfo::loadFindQueryPreliminaryResults(
     uint64_t ref_event_id) noexcept(false) {
-  if (!this->hasFindQueryPreliminaryResults(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
-  }
-
-  return this->find_query_preliminary_results_[ref_event_id];
+  return loadPart(ref_event_id, &FindQueryState::preliminary_results, "load");
 }
 
 void ProcedureInfo::addFindQueryPreliminaryResults(uint64_t ref_event_id, const NodeInfo &node,
                                                    NodeData::Attributes value) noexcept(false) {
-  if (!this->hasFindQueryPreliminaryResults(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot update a non-existent entry.");
-  }
+  auto &results = loadPart(ref_event_id, &FindQueryState::preliminary_results, "update");
 
-  if (this->find_query_preliminary_results_[ref_event_id].find(node) ==
-      this->find_query_preliminary_results_[ref_event_id].end()) {
-    this->find_query_preliminary_results_[ref_event_id][node] = value;
-  } else {
-    this->find_query_preliminary_results_[ref_event_id][node].insert(
-        this->find_query_preliminary_results_[ref_event_id][node].end(), value.begin(),
-        value.end());
+  auto [it, inserted] = results.try_emplace(node, std::move(value));
+  if (!inserted) {
+    it->second.insert(it->second.end(), value.begin(), value.end());
   }
 }
 
 void ProcedureInfo::removeFindQueryPreliminaryResults(uint64_t ref_event_id) noexcept(false) {
-  if (!this->hasFindQueryPreliminaryResults(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
-  }
-
-  this->find_query_preliminary_results_.erase(ref_event_id);
+  removePart(ref_event_id, &FindQueryState::preliminary_results);
 }
 
 void ProcedureInfo::saveDSNAggregationStartTimestamp(uint64_t ref_event_id, uint64_t value) {
-  if (this->hasDSNAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
-
-  this->dsn_aggregation_start_timestamp_[ref_event_id] = value;
+  savePart(ref_event_id, &FindQueryState::dsn_aggregation_start_timestamp, std::move(value));
 }
 
 uint64_t ProcedureInfo::loadDSNAggregationStartTimestamp(uint64_t ref_event_id) {
-  if (!this->hasDSNAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
-  }
-
-  return this->dsn_aggregation_start_timestamp_[ref_event_id];
+  return loadPart(ref_event_id, &FindQueryState::dsn_aggregation_start_timestamp, "load");
 }
 
 void ProcedureInfo::updateDSNAggregationStartTimestamp(uint64_t ref_event_id, uint64_t value) {
-  if (!this->hasDSNAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot update a non-existent entry.");
-  }
-
-  this->dsn_aggregation_start_timestamp_[ref_event_id] = value;
+  loadPart(ref_event_id, &FindQueryState::dsn_aggregation_start_timestamp, "update") = value;
 }
 
 void ProcedureInfo::removeDSNAggregationStartTimestamp(uint64_t ref_event_id) {
-  if (!this->hasDSNAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
-  }
-
-  this->dsn_aggregation_start_timestamp_.erase(ref_event_id);
+  removePart(ref_event_id, &FindQueryState::dsn_aggregation_start_timestamp);
 }
 
 std::unordered_map<uint64_t, uint64_t> ProcedureInfo::getDSNAggregationStartTimestampMap() const {
-  return dsn_aggregation_start_timestamp_;
+  std::unordered_map<uint64_t, uint64_t> timestamps;
+  for (auto const &[ref_event_id, slot] : find_query_slots_) {
+    if (auto const &timestamp = find_query_states_[slot].dsn_aggregation_start_timestamp) {
+      timestamps.emplace(ref_event_id, *timestamp);
+    }
+  }
+  return timestamps;
 }
 
 void ProcedureInfo::saveInquiryAggregationStartTimestamp(uint64_t ref_event_id, uint64_t value) {
-  if (this->hasInquiryAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
-
-  this->inquiry_aggregation_start_timestamp_[ref_event_id] = value;
+  savePart(ref_event_id, &FindQueryState::inquiry_aggregation_start_timestamp, std::move(value));
 }
 
 uint64_t ProcedureInfo::loadInquiryAggregationStartTimestamp(uint64_t ref_event_id) {
-  if (!this->hasInquiryAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
-  }
-
-  return this->inquiry_aggregation_start_timestamp_[ref_event_id];
+  return loadPart(ref_event_id, &FindQueryState::inquiry_aggregation_start_timestamp, "load");
 }
 
 void ProcedureInfo::updateInquiryAggregationStartTimestamp(uint64_t ref_event_id, uint64_t value) {
-  if (!this->hasInquiryAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot update a non-existent entry.");
-  }
-
-  this->inquiry_aggregation_start_timestamp_[ref_event_id] = value;
+  loadPart(ref_event_id, &FindQueryState::inquiry_aggregation_start_timestamp, "update") = value;
 }
 
 void ProcedureInfo::removeInquiryAggregationStartTimestamp(uint64_t ref_event_id) {
-  if (!this->hasInquiryAggregationStartTimestamp(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
-  }
-
-  this->inquiry_aggregation_start_timestamp_.erase(ref_event_id);
+  removePart(ref_event_id, &FindQueryState::inquiry_aggregation_start_timestamp);
 }
 
 std::unordered_map<uint64_t, uint64_t> ProcedureInfo::getInquiryAggregationStartTimestampMap()
     const {
-  return inquiry_aggregation_start_timestamp_;
+  std::unordered_map<uint64_t, uint64_t> timestamps;
+  for (auto const &[ref_event_id, slot] : find_query_slots_) {
+    if (auto const &timestamp = find_query_states_[slot].inquiry_aggregation_start_timestamp) {
+      timestamps.emplace(ref_event_id, *timestamp);
+    }
+  }
+  return timestamps;
 }
 
 void ProcedureInfo::saveNumberOfAddressedDSNs(uint64_t ref_event_id, uint16_t value) {
-  if (this->hasNumberOfAddressedDSNs(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
-
-  this->number_of_addressed_dsns_[ref_event_id] = value;
+  savePart(ref_event_id, &FindQueryState::number_of_addressed_dsns, std::move(value));
 }
 
 uint16_t ProcedureInfo::loadNumberOfAddressedDSNs(uint64_t ref_event_id) {
-  if (!this->hasNumberOfAddressedDSNs(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
-  }
-
-  return this->number_of_addressed_dsns_[ref_event_id];
+  return loadPart(ref_event_id, &FindQueryState::number_of_addressed_dsns, "load");
 }
 
 void ProcedureInfo::updateNumberOfAddressedDSNs(uint64_t ref_event_id, uint16_t value) {
-  if (!this->hasNumberOfAddressedDSNs(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot update a non-existent entry.");
-  }
-
-  this->number_of_addressed_dsns_[ref_event_id] = value;
+  loadPart(ref_event_id, &FindQueryState::number_of_addressed_dsns, "update") = value;
 }
 
 void ProcedureInfo::removeNumberOfAddressedDSNs(uint64_t ref_event_id) {
-  if (!this->hasNumberOfAddressedDSNs(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
-  }
-
-  this->number_of_addressed_dsns_.erase(ref_event_id);
+  removePart(ref_event_id, &FindQueryState::number_of_addressed_dsns);
 }
 
 void ProcedureInfo::saveNumberOfAnsweredDSNs(uint64_t ref_event_id, uint16_t value) {
-  if (this->hasNumberOfAnsweredDSNs(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
-
-  this->number_of_answered_dsns_[ref_event_id] = value;
+  savePart(ref_event_id, &FindQueryState::number_of_answered_dsns, std::move(value));
 }
 
 uint16_t ProcedureInfo::loadNumberOfAnsweredDSNs(uint64_t ref_event_id) {
-  if (!this->hasNumberOfAnsweredDSNs(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
-  }
-
-  return this->number_of_answered_dsns_[ref_event_id];
+  return loadPart(ref_event_id, &FindQueryState::number_of_answered_dsns, "load");
 }
 
 void ProcedureInfo::updateNumberOfAnsweredDSNs(uint64_t ref_event_id, uint16_t value) {
-  if (!this->hasNumberOfAnsweredDSNs(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot update a non-existent entry.");
-  }
-
-  this->number_of_answered_dsns_[ref_event_id] = value;
+  loadPart(ref_event_id, &FindQueryState::number_of_answered_dsns, "update") = value;
 }
 
 void ProcedureInfo::removeNumberOfAnsweredDSNs(uint64_t ref_event_id) {
-  if (!this->hasNumberOfAnsweredDSNs(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
-  }
-
-  this->number_of_answered_dsns_.erase(ref_event_id);
+  removePart(ref_event_id, &FindQueryState::number_of_answered_dsns);
 }
 
 void ProcedureInfo::saveFindResultPromise(uint64_t ref_event_id,
                                           std::promise<FindResult> &&promise) {
-  if (this->hasFindResultFuture(ref_event_id)) {
-    throw AlgorithmException("Event already exists. Extremely unlikely.");
-  }
-
-  this->find_result_promises_[ref_event_id] = std::move(promise);
+  savePart(ref_event_id, &FindQueryState::find_result_promise, std::move(promise));
 }
 
 std::promise<FindResult> &ProcedureInfo::loadFindResultPromise(uint64_t ref_event_id) {
-  if (!this->hasFindResultFuture(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot load a non-existent entry.");
-  }
-
-  return this->find_result_promises_[ref_event_id];
+  return loadPart(ref_event_id, &FindQueryState::find_result_promise, "load");
 }
 
 void ProcedureInfo::removeFindResultPromise(uint64_t ref_event_id) {
-  if (!this->hasFindResultFuture(ref_event_id)) {
-    throw AlgorithmException("Event does not exist. You cannot remove a non-existent entry.");
+  removePart(ref_event_id, &FindQueryState::find_result_promise);
+}
+
+void ProcedureInfo::removeFindQueryState(uint64_t ref_event_id) {
+  auto it = find_query_slots_.find(ref_event_id);
+  if (it == find_query_slots_.end()) {
+    return;
   }
 
-  this->find_result_promises_.erase(ref_event_id);
+  find_query_states_[it->second] = FindQueryState{};
+  free_find_query_slots_.push_back(it->second);
+  find_query_slots_.erase(it);
 }
 
+bool ProcedureInfo::hasFindQueryState(uint64_t ref_event_id) const {
+  return find_query_slots_.find(ref_event_id) != find_query_slots_.end();
+}
+
+std::size_t ProcedureInfo::getNumberOfFindQueryStates() const { return find_query_slots_.size(); }
+
 }  // namespace minhton
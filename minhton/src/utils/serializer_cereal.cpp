@@ -24,21 +24,56 @@
 #endif
 
 #include "minhton/message/types_all.h"
+#include "minhton/utils/compact_archive.h"
+#include "solanet/serializer/buffer_archive.h"
 
 namespace minhton::serializer {
 
+SerializerCereal::SerializerCereal(WireFormat wire_format) : wire_format_(wire_format) {}
+
 std::string SerializerCereal::serialize(const minhton::MessageVariant &msg) {
-  std::stringstream ss;
-  cereal::BinaryOutputArchive archive(ss);
-  archive(msg);
-  return ss.str();
+  std::string buffer;
+  serializeInto(msg, buffer);
+  return buffer;
+}
+
+void SerializerCereal::serializeInto(const minhton::MessageVariant &msg, std::string &buffer) {
+  // Same wire format as cereal::BinaryOutputArchive, but without a stream and intermediate copies
+  buffer.clear();
+  if (getWireFormat() == WireFormat::kCompact) {
+    buffer.push_back(static_cast<char>(kCompactWireFormatMarker));
+    CompactOutputArchive archive(buffer);
+    archive(msg);
+  } else {
+    solanet::serializer::BufferOutputArchive archive(buffer);
+    archive(msg);
+  }
 }
 
-minhton::MessageVariant SerializerCereal::deserialize(const std::string &str) {
+minhton::MessageVariant SerializerCereal::deserialize(std::string_view str) {
   minhton::MessageVariant msg;
-  std::istringstream iss(str);
-  cereal::BinaryInputArchive archive(iss);
-  archive(msg);
+  if (detectWireFormat(str) == WireFormat::kCompact) {
+    CompactInputArchive archive(str.substr(1));
+    archive(msg);
+  } else {
+    solanet::serializer::BufferInputArchive archive(str);
+    archive(msg);
+  }
   return msg;
 }
+
+WireFormat SerializerCereal::getWireFormat() const {
+  return wire_format_.load(std::memory_order_relaxed);
+}
+
+void SerializerCereal::setWireFormat(WireFormat wire_format) {
+  wire_format_.store(wire_format, std::memory_order_relaxed);
+}
+
+WireFormat SerializerCereal::detectWireFormat(std::string_view str) {
+  if (!str.empty() && static_cast<uint8_t>(str.front()) == kCompactWireFormatMarker) {
+    return WireFormat::kCompact;
+  }
+  return WireFormat::kBinary;
+}
 }  // namespace minhton::serializer
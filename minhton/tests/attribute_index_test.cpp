@@ -0,0 +1,226 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "algorithms/esearch/attribute_index.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithms/esearch/compiled_expression.h"
+#include "algorithms/esearch/distributed_data.h"
+#include "algorithms/esearch/key_table.h"
+
+using namespace minhton;
+
+namespace {
+
+std::vector<AttributeIndex::Slot> toVector(const SlotBitset &slots) {
+  std::vector<AttributeIndex::Slot> result;
+  slots.forEach([&](AttributeIndex::Slot slot) { result.push_back(slot); });
+  return result;
+}
+
+NodeData::ValueTimestampAndType staticValue(const NodeData::Value &value) {
+  return {value, 0, NodeData::ValueType::kValueStatic};
+}
+
+const std::vector<NodeData::Key> kKeys{"index_a", "index_b", "index_c"};
+
+std::shared_ptr<BooleanExpression> createRandomExpression(std::mt19937 &rng, uint32_t depth) {
+  const auto &key = kKeys[rng() % kKeys.size()];
+  const auto comparison_type = static_cast<ComparisonTypes>(rng() % 6);
+
+  switch (depth == 0 ? 3 + rng() % 4 : rng() % 7) {
+    case 0:
+      return std::make_shared<OrExpression>(createRandomExpression(rng, depth - 1),
+                                            createRandomExpression(rng, depth - 1));
+    case 1:
+      return std::make_shared<AndExpression>(createRandomExpression(rng, depth - 1),
+                                             createRandomExpression(rng, depth - 1));
+    case 2:
+      return std::make_shared<NotExpression>(createRandomExpression(rng, depth - 1));
+    case 3:
+      return std::make_shared<PresenceExpression>(key);
+    case 4:
+      return std::make_shared<StringEqualityExpression>(key, rng() % 2 ? "x" : "y");
+    case 5:
+      return std::make_shared<NumericComparisonExpression<int>>(key, comparison_type,
+                                                                static_cast<int>(rng() % 3));
+    default:
+      return std::make_shared<NumericComparisonExpression<float>>(key, comparison_type, 1.0F);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("AttributeIndex Slots", "[AttributeIndex]") {
+  AttributeIndex index;
+  const auto key_id = KeyTable::intern("index_slots");
+
+  auto slot0 = index.addSlot();
+  auto slot1 = index.addSlot();
+  auto slot2 = index.addSlot();
+  REQUIRE(toVector(index.getSlots()) == std::vector<AttributeIndex::Slot>{0, 1, 2});
+
+  index.setValue(slot0, key_id, staticValue(true));
+  index.setValue(slot1, key_id, staticValue(false));
+  index.setValue(slot2, key_id, staticValue(std::string("x")));
+  REQUIRE(toVector(index.getPresent(key_id)) == std::vector<AttributeIndex::Slot>{0, 1, 2});
+  REQUIRE(toVector(index.getPresenceMatches(key_id)) == std::vector<AttributeIndex::Slot>{0, 2});
+  REQUIRE(toVector(index.getStringMatches(key_id, "x")) == std::vector<AttributeIndex::Slot>{2});
+  REQUIRE(index.getStringMatches(key_id, "y").none());
+
+  // Replacing values
+  index.setValue(slot1, key_id, staticValue(std::string("x")));
+  index.setValue(slot2, key_id, staticValue(5));
+  REQUIRE(toVector(index.getStringMatches(key_id, "x")) == std::vector<AttributeIndex::Slot>{1});
+  REQUIRE(toVector(index.getPresenceMatches(key_id)) == std::vector<AttributeIndex::Slot>{0, 1, 2});
+
+  index.removeValue(slot0, key_id);
+  REQUIRE(toVector(index.getPresent(key_id)) == std::vector<AttributeIndex::Slot>{1, 2});
+
+  // Removed slots are reused without their values
+  index.removeSlot(slot1);
+  REQUIRE(toVector(index.getSlots()) == std::vector<AttributeIndex::Slot>{0, 2});
+  REQUIRE(index.addSlot() == slot1);
+  REQUIRE(toVector(index.getPresent(key_id)) == std::vector<AttributeIndex::Slot>{2});
+
+  // Dynamic values are outdated if older than the threshold and not subscribed
+  index.setValue(slot0, key_id, {1, 100, NodeData::ValueType::kValueDynamic});
+  index.setValue(slot1, key_id, {1, 200, NodeData::ValueType::kValueDynamic});
+  REQUIRE(toVector(index.getOutdated(key_id, 150)) == std::vector<AttributeIndex::Slot>{0});
+  REQUIRE(toVector(index.getOutdated(key_id, 300)) == std::vector<AttributeIndex::Slot>{0, 1});
+  index.setSubscribed(slot1, key_id, true);
+  REQUIRE(toVector(index.getOutdated(key_id, 300)) == std::vector<AttributeIndex::Slot>{0});
+  index.setValue(slot0, key_id, {1, 100, NodeData::ValueType::kValueStatic});
+  REQUIRE(index.getOutdated(key_id, 300).none());
+
+  index.clearSlot(slot2);
+  index.clearSlot(slot0);
+  index.clearSlot(slot1);
+  REQUIRE(index.getPresent(key_id).none());
+  REQUIRE(index.getSlots().count() == 3);
+
+  index.clear();
+  REQUIRE(index.getSlots().none());
+  REQUIRE(index.addSlot() == 0);
+}
+
+TEST_CASE("AttributeIndex Comparisons", "[AttributeIndex]") {
+  AttributeIndex index;
+  const auto key_id = KeyTable::intern("index_comparisons");
+
+  // 16777217 cannot be represented as float and is converted to 16777216 for float comparisons
+  const std::vector<NodeData::Value> values{1,         2.5F,     -3, 2, std::string("2"),
+                                            16777217,  16777216, 2.0F,
+                                            std::numeric_limits<float>::quiet_NaN()};
+  for (const auto &value : values) {
+    index.setValue(index.addSlot(), key_id, staticValue(value));
+  }
+
+  for (int type = 0; type < 6; type++) {
+    const auto comparison_type = static_cast<ComparisonTypes>(type);
+    for (const NodeData::Value &operand :
+         std::vector<NodeData::Value>{2, 2.0F, 2.4F, -5, 16777216, 16777216.0F,
+                                      std::numeric_limits<float>::quiet_NaN()}) {
+      // Same results as the expressions for each single value
+      std::shared_ptr<AtomicBooleanExpression> expr;
+      if (const auto *int_operand = std::get_if<int>(&operand)) {
+        expr = std::make_shared<NumericComparisonExpression<int>>("index_comparisons",
+                                                                  comparison_type, *int_operand);
+      } else {
+        expr = std::make_shared<NumericComparisonExpression<float>>(
+            "index_comparisons", comparison_type, std::get<float>(operand));
+      }
+
+      SlotBitset expected;
+      for (AttributeIndex::Slot slot = 0; slot < values.size(); slot++) {
+        if (std::holds_alternative<std::string>(values[slot])) continue;
+        DistributedData data;
+        data.insert("index_comparisons", {values[slot], 0, NodeData::ValueType::kValueStatic});
+        if (expr->evaluateExisting(data, {}).isTrue()) expected.set(slot);
+      }
+
+      INFO(expr->serialize());
+      REQUIRE(toVector(index.getComparisonMatches(key_id, comparison_type, operand)) ==
+              toVector(expected));
+    }
+  }
+}
+
+TEST_CASE("AttributeIndex Candidates", "[AttributeIndex]") {
+  std::mt19937 rng(11);
+
+  for (uint32_t round = 0; round < 100; round++) {
+    AttributeIndex index;
+    std::vector<DistributedData> entries(32);
+    CompiledExpression::Batch batch;
+
+    for (auto &data : entries) {
+      auto slot = index.addSlot();
+      REQUIRE(slot == batch.size());
+      batch.push_back(&data);
+
+      for (const auto &key : kKeys) {
+        NodeData::Value value;
+        switch (rng() % 5) {
+          case 0:
+            continue;
+          case 1:
+            value = rng() % 2 == 0;
+            break;
+          case 2:
+            value = std::string(rng() % 2 ? "x" : "y");
+            break;
+          case 3:
+            value = static_cast<float>(rng() % 6) / 2;
+            break;
+          default:
+            value = static_cast<int>(rng() % 3);
+            break;
+        }
+        const auto type =
+            rng() % 8 ? NodeData::ValueType::kValueDynamic : NodeData::ValueType::kValueStatic;
+        data.insert(key, {value, 900 + rng() % 200, type});
+        index.setValue(slot, KeyTable::intern(key), data.getValueTimestampAndType(key));
+        if (rng() % 4 == 0) {
+          data.addSubscriptionOrderKey(key);
+          index.setSubscribed(slot, KeyTable::intern(key), true);
+        }
+      }
+    }
+
+    auto expr = createRandomExpression(rng, 1 + round % 4);
+    CompiledExpression program(*expr);
+
+    for (uint32_t flags = 0; flags < 16; flags++) {
+      EvaluationInformation eval_info{1000, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0,
+                                      (flags & 8) != 0};
+
+      std::vector<FuzzyValue> values;
+      try {
+        values = program.evaluate(batch, eval_info);
+      } catch (const std::invalid_argument &) {
+        continue;  // values which cannot be compared
+      }
+
+      for (auto value : {FuzzyValue::createFalse(), FuzzyValue::createUndecided(),
+                         FuzzyValue::createTrue()}) {
+        const auto candidates = program.getCandidates(index, value, eval_info);
+        for (std::size_t slot = 0; slot < batch.size(); slot++) {
+          INFO(expr->serialize() << " flags " << flags << " slot " << slot);
+          CHECK(candidates.test(slot) == (values[slot] == value));
+        }
+      }
+    }
+  }
+}
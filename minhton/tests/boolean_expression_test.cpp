@@ -8,6 +8,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "algorithms/esearch/distributed_data.h"
 #include "algorithms/esearch/local_data.h"
@@ -1503,3 +1506,103 @@ TEST_CASE("BooleanExpression OrExpression, Different Inquiries",
   REQUIRE(expr_2_4.evaluateMissingAttributes(data1, eval_info_2_2_none).empty());
   REQUIRE(expr_2_4.evaluateMissingAttributes(data1, eval_info_3_2_none).empty());
 }
+
+TEST_CASE("BooleanExpression Binary Encoding", "[BooleanExpression][Encoding]") {
+  auto expr = std::make_shared<OrExpression>(
+      std::make_shared<AndExpression>(
+          std::make_shared<PresenceExpression>("topic/robot"),
+          std::make_shared<NotExpression>(
+              std::make_shared<StringEqualityExpression>("color", "red"))),
+      std::make_shared<AndExpression>(
+          std::make_shared<NumericComparisonExpression<int>>("load", ComparisonTypes::kLessThan,
+                                                             -3),
+          std::make_shared<AndExpression>(
+              std::make_shared<NumericComparisonExpression<float>>(
+                  "battery", ComparisonTypes::kGreaterThanOrEqualTo, 0.25f),
+              std::make_shared<EmptyExpression>())));
+
+  std::string encoded = encodeBooleanExpression(*expr);
+  auto decoded = decodeBooleanExpression(encoded);
+  REQUIRE(decoded->serialize() == expr->serialize());
+  REQUIRE(encodeBooleanExpression(*decoded) == encoded);
+  REQUIRE(decoded->getRelevantKeys() == expr->getRelevantKeys());
+
+  EvaluationInformation eval_info{900, true, true, true};
+  DistributedData data;
+  REQUIRE(data.insert("color", {std::string("blue"), 1000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE(data.insert("load", {-5, 1000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE(data.insert("battery", {0.5f, 1000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE(expr->evaluate(data, eval_info).isTrue());
+  REQUIRE(decoded->evaluate(data, eval_info).isTrue());
+
+  // Malformed encodings
+  REQUIRE_THROWS_AS(decodeBooleanExpression(""), std::invalid_argument);
+  REQUIRE_THROWS_AS(decodeBooleanExpression(std::string(1, '\x7F') + encoded.substr(1)),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(decodeBooleanExpression(encoded.substr(0, encoded.size() - 1)),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(decodeBooleanExpression(encoded + '\0'), std::invalid_argument);
+  REQUIRE_THROWS_AS(decodeBooleanExpression(encoded.substr(0, 1) + std::string(1000, '\x03')),
+                    std::invalid_argument);
+}
+
+TEST_CASE("BooleanExpression Interned Keys", "[BooleanExpression][KeyTable]") {
+  auto key_id = KeyTable::intern("interned-key");
+  REQUIRE(KeyTable::intern("interned-key") == key_id);
+  REQUIRE(KeyTable::find("interned-key") == key_id);
+  REQUIRE(KeyTable::getName(key_id) == "interned-key");
+  REQUIRE_FALSE(KeyTable::find("never-interned-key").has_value());
+
+  LocalData data;
+  REQUIRE_FALSE(data.hasKey("never-interned-key"));
+  REQUIRE_FALSE(KeyTable::find("never-interned-key").has_value());
+  REQUIRE(data.insert("interned-key", {3, 1000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE(data.hasKey(key_id));
+  REQUIRE(std::get<int>(std::get<0>(*data.find(key_id))) == 3);
+  REQUIRE(data.getAllCurrentKeys() == std::vector<NodeData::Key>{"interned-key"});
+  data.remove("interned-key");
+  REQUIRE(data.find(key_id) == nullptr);
+}
+
+TEST_CASE("BooleanExpression Received Keys", "[BooleanExpression][KeyTable]") {
+  // Expressions may be received from other nodes, therefore their keys are only looked up
+  PresenceExpression expr("received-key");
+  EvaluationInformation eval_info{0, true, false, false};
+  LocalData data;
+  REQUIRE(expr.evaluate(data, eval_info).isFalse());
+  REQUIRE_FALSE(KeyTable::find("received-key").has_value());
+
+  REQUIRE(data.insert("received-key", {3, 1000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE(expr.evaluate(data, eval_info).isTrue());
+
+  // Keys received from other nodes are only added until the table is full
+  const auto key_id = KeyTable::find("received-key");
+  REQUIRE(KeyTable::tryIntern("received-key") == key_id);
+  for (std::size_t i = 0; i < KeyTable::kMaxKeys; i++) {
+    KeyTable::tryIntern("filling-key-" + std::to_string(i));
+  }
+  REQUIRE_FALSE(KeyTable::tryIntern("rejected-key").has_value());
+  REQUIRE_FALSE(KeyTable::find("rejected-key").has_value());
+  REQUIRE(KeyTable::tryIntern("received-key") == key_id);
+  REQUIRE(KeyTable::tryIntern("filling-key-0").has_value());
+
+  // Values of keys which did not fit into the table are still stored and matched
+  NumericComparisonExpression<int> weight_expr("rejected-key", ComparisonTypes::kEqualTo, 100);
+  PresenceExpression presence_expr("rejected-key");
+  REQUIRE(weight_expr.evaluate(data, eval_info).isFalse());
+  REQUIRE(data.insert("rejected-key", {100, 1000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE_FALSE(data.insert("rejected-key", {100, 1000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE(data.hasKey("rejected-key"));
+  REQUIRE(weight_expr.evaluate(data, eval_info).isTrue());
+  REQUIRE(presence_expr.evaluate(data, eval_info).isTrue());
+  REQUIRE(data.getData().count("rejected-key") == 1);
+
+  REQUIRE(data.update("rejected-key", {50, 2000, NodeData::ValueType::kValueDynamic}));
+  REQUIRE(weight_expr.evaluate(data, eval_info).isFalse());
+  REQUIRE(std::get<int>(data.getValue("rejected-key")) == 50);
+
+  data.remove("rejected-key");
+  REQUIRE_FALSE(data.hasKey("rejected-key"));
+  REQUIRE(presence_expr.evaluate(data, eval_info).isFalse());
+  REQUIRE_FALSE(KeyTable::find("rejected-key").has_value());
+}
@@ -0,0 +1,169 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "algorithms/esearch/compiled_expression.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithms/esearch/distributed_data.h"
+#include "algorithms/esearch/local_data.h"
+
+using namespace minhton;
+
+namespace {
+
+const std::vector<NodeData::Key> kKeys{"a", "b", "c", "d"};
+
+std::shared_ptr<BooleanExpression> createRandomExpression(std::mt19937 &rng, uint32_t depth) {
+  const auto &key = kKeys[rng() % kKeys.size()];
+  const auto comparison_type = static_cast<ComparisonTypes>(rng() % 6);
+
+  switch (depth == 0 ? 3 + rng() % 5 : rng() % 8) {
+    case 0:
+      return std::make_shared<OrExpression>(createRandomExpression(rng, depth - 1),
+                                            createRandomExpression(rng, depth - 1));
+    case 1:
+      return std::make_shared<AndExpression>(createRandomExpression(rng, depth - 1),
+                                             createRandomExpression(rng, depth - 1));
+    case 2:
+      return std::make_shared<NotExpression>(createRandomExpression(rng, depth - 1));
+    case 3:
+      return std::make_shared<PresenceExpression>(key);
+    case 4:
+      return std::make_shared<StringEqualityExpression>(key, rng() % 2 ? "x" : "y");
+    case 5:
+      return std::make_shared<NumericComparisonExpression<int>>(key, comparison_type,
+                                                                static_cast<int>(rng() % 3));
+    case 6:
+      return std::make_shared<NumericComparisonExpression<float>>(key, comparison_type, 1.5F);
+    default:
+      return std::make_shared<EmptyExpression>();
+  }
+}
+
+// Numeric values most of the time, so that comparisons rarely throw
+void fillRandomData(std::mt19937 &rng, NodeData &data, bool subscribe) {
+  for (const auto &key : kKeys) {
+    const uint64_t timestamp = 900 + rng() % 200;
+    NodeData::Value value;
+    switch (rng() % 8) {
+      case 0:
+        continue;
+      case 1:
+        value = rng() % 2 == 0;
+        break;
+      case 2:
+        value = std::string(rng() % 2 ? "x" : "y");
+        break;
+      case 3:
+      case 4:
+        value = static_cast<float>(rng() % 6) / 2;
+        break;
+      default:
+        value = static_cast<int>(rng() % 3);
+        break;
+    }
+    data.insert(key, {value, timestamp, NodeData::ValueType::kValueDynamic});
+
+    auto *distr_data = dynamic_cast<DistributedData *>(&data);
+    if (distr_data != nullptr && subscribe && rng() % 2) {
+      distr_data->addSubscriptionOrderKey(key);
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("CompiledExpression Program", "[CompiledExpression]") {
+  auto expr = std::make_shared<AndExpression>(
+      std::make_shared<OrExpression>(std::make_shared<PresenceExpression>("a"),
+                                     std::make_shared<NotExpression>(
+                                         std::make_shared<PresenceExpression>("b"))),
+      std::make_shared<NumericComparisonExpression<float>>("a", ComparisonTypes::kGreater, 1.0F));
+
+  CompiledExpression program(*expr);
+  REQUIRE(program.getInstructionCount() == 6);
+
+  DistributedData known;
+  REQUIRE(known.insert("a", {2.5F, 1000, NodeData::ValueType::kValueDynamic}));
+  DistributedData outdated;
+  REQUIRE(outdated.insert("a", {0.5F, 800, NodeData::ValueType::kValueDynamic}));
+  DistributedData unknown;
+  LocalData local;
+  REQUIRE(local.insert("a", {0.5F, 800, NodeData::ValueType::kValueDynamic}));
+
+  EvaluationInformation eval_info{900, false, true, true};
+  CompiledExpression::Batch batch{&known, &outdated, &unknown, &local};
+
+  auto values = program.evaluate(batch, eval_info);
+  REQUIRE(values.size() == 4);
+  REQUIRE(values[0].isTrue());
+  REQUIRE(values[1].isUndecided());
+  REQUIRE(values[2].isUndecided());
+  REQUIRE(values[3].isFalse());
+
+  auto missing = program.evaluateMissingAttributes(batch, eval_info);
+  REQUIRE(missing[0].empty());
+  REQUIRE(missing[1] == std::vector<NodeData::Key>{"a", "b", "a"});
+  REQUIRE(missing[2] == std::vector<NodeData::Key>{"a", "b", "a"});
+  REQUIRE(missing[3].empty());
+
+  REQUIRE(program.evaluate({}, eval_info).empty());
+}
+
+TEST_CASE("CompiledExpression Same Results As BooleanExpression", "[CompiledExpression]") {
+  std::mt19937 rng(7);
+
+  for (uint32_t round = 0; round < 300; round++) {
+    auto expr = createRandomExpression(rng, 1 + round % 4);
+    CompiledExpression program(*expr);
+
+    std::vector<std::unique_ptr<NodeData>> entries;
+    CompiledExpression::Batch batch;
+    for (uint32_t i = 0; i < 16; i++) {
+      if (i % 4 == 0) {
+        entries.push_back(std::make_unique<LocalData>());
+      } else {
+        entries.push_back(std::make_unique<DistributedData>());
+      }
+      fillRandomData(rng, *entries.back(), i % 2 == 1);
+      batch.push_back(entries.back().get());
+    }
+
+    for (uint32_t flags = 0; flags < 16; flags++) {
+      EvaluationInformation eval_info{1000, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0,
+                                      (flags & 8) != 0};
+
+      // Values of types which cannot be compared throw for the whole batch
+      bool tree_throws = false;
+      for (auto *data : batch) {
+        try {
+          expr->evaluate(*data, eval_info);
+          expr->evaluateMissingAttributes(*data, eval_info);
+        } catch (const std::invalid_argument &) {
+          tree_throws = true;
+        }
+      }
+      if (tree_throws) {
+        CHECK_THROWS_AS(program.evaluate(batch, eval_info), std::invalid_argument);
+        continue;
+      }
+
+      auto values = program.evaluate(batch, eval_info);
+      auto missing = program.evaluateMissingAttributes(batch, eval_info);
+      for (std::size_t i = 0; i < batch.size(); i++) {
+        INFO(expr->serialize() << " flags " << flags << " entry " << i);
+        CHECK(values[i] == expr->evaluate(*batch[i], eval_info));
+        CHECK(missing[i] == expr->evaluateMissingAttributes(*batch[i], eval_info));
+      }
+    }
+  }
+}
@@ -29,3 +29,18 @@ TEST_CASE("FindQuery Constructor", "[FindQuery][Init]") {
   REQUIRE(keys1.size() == 1);
   REQUIRE(keys1[0] == "huhu");
 }
+
+TEST_CASE("FindQuery Expression Encoding", "[FindQuery][Encoding]") {
+  FindQuery q1("(( HAS topic/robot ) AND (( color == red ) OR ( battery >= 0.5 )))", "all");
+  REQUIRE(q1.getBooleanExpression() != nullptr);
+
+  // Parsing again uses the same parser
+  FindQuery q2(q1.serializeBooleanExpression(), "some");
+  REQUIRE(q2.serializeBooleanExpression() == q1.serializeBooleanExpression());
+  REQUIRE(q2.getScope() == FindQuery::FindQueryScope::kSome);
+
+  FindQuery q3;
+  q3.decodeBooleanExpression(q1.encodeBooleanExpression());
+  REQUIRE(q3.serializeBooleanExpression() == q1.serializeBooleanExpression());
+  REQUIRE(q3.getRelevantAttributes() == q1.getRelevantAttributes());
+}
@@ -0,0 +1,177 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+// Debug messages are not compiled in this file
+#undef MINHTON_LOG_LEVEL
+#define MINHTON_LOG_LEVEL 1
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "logging/logging.h"
+
+using namespace minhton;
+
+namespace {
+
+class CountingLogger : public LoggerInterface {
+public:
+  CountingLogger()
+      : CountingLogger(
+            {LogLevel::kDebug, LogLevel::kInfo, LogLevel::kWarning, LogLevel::kCritical}) {}
+  explicit CountingLogger(std::vector<LogLevel> enabled_levels)
+      : LoggerInterface("counting"), enabled_levels_(std::move(enabled_levels)) {}
+
+  void logCritical(const std::string &msg) const override { log(LogLevel::kCritical, msg); }
+  void logWarning(const std::string &msg) const override { log(LogLevel::kWarning, msg); }
+  void logInfo(const std::string &msg) const override { log(LogLevel::kInfo, msg); }
+  void logDebug(const std::string &msg) const override { log(LogLevel::kDebug, msg); }
+
+  bool isLogLevelEnabled(LogLevel level) const override {
+    return std::find(enabled_levels_.begin(), enabled_levels_.end(), level) !=
+           enabled_levels_.end();
+  }
+
+  void setApplicationUUID(const solanet::UUID & /*app_uuid*/) override {}
+  void logNodeUninit(const LoggerInfoNodeState & /*info*/) override {}
+  void logNodeRunning(const LoggerInfoNodeState & /*info*/) override {}
+  void logNodeLeft(const LoggerInfoNodeState & /*info*/) override {}
+  void logPhysicalNodeInfo(const LoggerPhysicalNodeInfo & /*info*/) override {}
+  void logNode(const LoggerInfoAddNode & /*info*/) override {}
+  void logNeighbor(const LoggerInfoAddNeighbor & /*info*/) override {}
+  void logEvent(const LoggerInfoAddEvent & /*info*/) override { records++; }
+  void logSearchExactTest(const LoggerInfoSearchExact & /*info*/) override {}
+  void logTraffic(const MessageLoggingInfo & /*info*/) override {}
+  void logContent(const LoggerInfoAddContent & /*info*/) override {}
+  void logFindQuery(const LoggerInfoAddFindQuery & /*info*/) override {}
+  void logFindQueryResult(const LoggerInfoAddFindQueryResult & /*info*/) override {}
+
+  mutable std::vector<std::pair<LogLevel, std::string>> messages;
+  uint32_t records = 0;
+
+private:
+  void log(LogLevel level, const std::string &msg) const { messages.emplace_back(level, msg); }
+
+  std::vector<LogLevel> enabled_levels_;
+};
+
+// Like the AccessContainer of the algorithms, which the logging macros use
+struct LoggerAccess {
+  Logger logger;
+};
+
+}  // namespace
+
+TEST_CASE("Logger Levels", "[Logger]") {
+  Logger logger;
+  REQUIRE_FALSE(logger.hasLoggers());
+  REQUIRE_FALSE(logger.isEnabled(LogLevel::kCritical));
+
+  auto all = std::make_shared<CountingLogger>();
+  auto warnings = std::make_shared<CountingLogger>(
+      std::vector<LogLevel>{LogLevel::kWarning, LogLevel::kCritical});
+  logger.addLogger(all);
+  logger.addLogger(warnings);
+  REQUIRE(logger.hasLoggers());
+  REQUIRE(logger.isEnabled(LogLevel::kDebug));
+
+  logger.logDebug("debug");
+  logger.logWarning("warning");
+  REQUIRE(all->messages.size() == 2);
+  REQUIRE(warnings->messages.size() == 1);
+  REQUIRE(warnings->messages[0].first == LogLevel::kWarning);
+
+  // Only levels at or above the log level are passed on
+  logger.setLogLevel(LogLevel::kWarning);
+  REQUIRE_FALSE(logger.isEnabled(LogLevel::kDebug));
+  REQUIRE_FALSE(logger.isEnabled(LogLevel::kInfo));
+  REQUIRE(logger.isEnabled(LogLevel::kWarning));
+  REQUIRE(logger.isEnabled(LogLevel::kCritical));
+
+  logger.logInfo("info");
+  logger.logCritical("critical");
+  REQUIRE(all->messages.size() == 3);
+  REQUIRE(all->messages.back().second == "critical");
+  REQUIRE(warnings->messages.size() == 2);
+
+  // No logger wants anything
+  Logger no_strings;
+  no_strings.addLogger(std::make_shared<CountingLogger>(std::vector<LogLevel>{}));
+  REQUIRE(no_strings.hasLoggers());
+  REQUIRE_FALSE(no_strings.isEnabled(LogLevel::kCritical));
+
+  REQUIRE(Logger::logLevelFromString("warning") == LogLevel::kWarning);
+  REQUIRE(Logger::logLevelFromString("unknown") == LogLevel::kDebug);
+}
+
+TEST_CASE("Logger Macros Build Messages Lazily", "[Logger]") {
+  auto access = std::make_shared<LoggerAccess>();
+  auto *access_ = access.get();
+
+  uint32_t built = 0;
+  auto build_message = [&built](const std::string &msg) {
+    built++;
+    return msg;
+  };
+
+  // Without loggers, neither messages nor records are built
+  LOG_INFO(build_message("info"));
+  LOG_EVENT(EventType::kJoinEvent, static_cast<uint64_t>(build_message("event").size()));
+  REQUIRE(built == 0);
+
+  auto counting = std::make_shared<CountingLogger>(
+      std::vector<LogLevel>{LogLevel::kDebug, LogLevel::kInfo, LogLevel::kCritical});
+  access_->logger.addLogger(counting);
+
+  LOG_INFO(build_message("info"));
+  LOG_EVENT(EventType::kJoinEvent, static_cast<uint64_t>(build_message("event").size()));
+  REQUIRE(built == 2);
+  REQUIRE(counting->messages.size() == 1);
+  REQUIRE(counting->records == 1);
+
+  // The logger does not want warnings
+  LOG_WARNING(build_message("warning"));
+  REQUIRE(built == 2);
+
+  // Below MINHTON_LOG_LEVEL, even though the logger wants debug messages
+  LOG_DEBUG(build_message("debug"));
+  REQUIRE(built == 2);
+
+  access_->logger.setLogLevel(LogLevel::kCritical);
+  LOG_INFO(build_message("info"));
+  LOG_CRITICAL(build_message("critical"));
+  REQUIRE(built == 3);
+  REQUIRE(counting->messages.back().first == LogLevel::kCritical);
+  REQUIRE(counting->messages.back().second == "critical");
+
+  // Usable as a single statement
+  if (built == 0)
+    LOG_CRITICAL(build_message("never"));
+  else
+    built = 0;
+  REQUIRE(built == 0);
+}
+
+TEST_CASE("Logger Message Overhead", "[.][Logger][benchmark]") {
+  auto access = std::make_shared<LoggerAccess>();
+  auto *access_ = access.get();
+  access_->logger.addLogger(std::make_shared<CountingLogger>(std::vector<LogLevel>{}));
+
+  const std::string type = "JOIN";
+  const std::string target = "( 3:5 | 127.0.0.1:2000 )";
+
+  // The message is built before the logger can reject it, like the macros did before
+  BENCHMARK("eager info message") { access_->logger.logInfo("send " + type + " to " + target); };
+
+  BENCHMARK("lazy info message") { LOG_INFO("send " + type + " to " + target); };
+
+  BENCHMARK("stripped debug message") { LOG_DEBUG("send " + type + " to " + target); };
+}
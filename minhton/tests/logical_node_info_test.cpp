@@ -9,8 +9,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/constants.h"
+#include "core/routing_calculations.h"
 using namespace minhton;
 
 TEST_CASE("LogicalNodeInfo Constructors", "[LogicalNodeInfo][Init]") {
@@ -472,3 +474,60 @@ TEST_CASE("LogicalNodeInfo Equal Unequal", "[LogicalNodeInfo][Method][Equal, Une
   REQUIRE(p8 != p10);
   REQUIRE(p9 != p10);
 }
+
+TEST_CASE("LogicalNodeInfo Horizontal Order", "[LogicalNodeInfo][Method][Less, Greater]") {
+  // The exact keys order all positions of small trees like the TreeMapper
+  for (uint16_t fanout = 2; fanout <= 5; fanout++) {
+    std::vector<minhton::LogicalNodeInfo> positions;
+    for (uint32_t level = 0; level <= 3; level++) {
+      for (uint32_t number = 0; number < calcNodesOnLevel(level, fanout); number++) {
+        positions.emplace_back(level, number, fanout);
+      }
+    }
+
+    for (const auto &p1 : positions) {
+      REQUIRE(p1.getHorizontalKey() != 0);
+      for (const auto &p2 : positions) {
+        double value_1 = p1.getHorizontalValue();
+        double value_2 = p2.getHorizontalValue();
+        REQUIRE((p1 < p2) == (value_1 < value_2));
+        REQUIRE((p1 <= p2) == (value_1 <= value_2));
+        REQUIRE((p1 > p2) == (value_1 > value_2));
+        REQUIRE((p1 >= p2) == (value_1 >= value_2));
+      }
+    }
+  }
+
+  // Setting the position or fanout updates the key
+  minhton::LogicalNodeInfo p1(1, 1);
+  REQUIRE(p1.getHorizontalKey() == 0);
+  p1.setFanout(2);
+  REQUIRE(p1.getHorizontalKey() == calcHorizontalKey(1, 1, 2));
+  p1.setPosition(2, 0);
+  REQUIRE(p1.getHorizontalKey() == calcHorizontalKey(2, 0, 2));
+  minhton::LogicalNodeInfo p2(1, 0, 2);
+  REQUIRE(p1 < p2);
+  p2.setPosition(p1);
+  REQUIRE(p2.getHorizontalKey() == p1.getHorizontalKey());
+
+  // Peers without fanout cannot be compared
+  minhton::LogicalNodeInfo p3(1, 0);
+  REQUIRE_FALSE(p3 < p2);
+  REQUIRE_FALSE(p2 < p3);
+  REQUIRE_FALSE(p3 <= p3);
+
+  // Positions deeper than the deepest level with a key are still compared exactly
+  const uint16_t fanout = kFanoutMaximum;
+  const uint32_t deep_level = calcHorizontalKeyMaxLevel(fanout) + 1;
+  minhton::LogicalNodeInfo deep_left(deep_level, 127, fanout);
+  minhton::LogicalNodeInfo deep_right(deep_level, 128, fanout);
+  minhton::LogicalNodeInfo root(0, 0, fanout);
+  minhton::LogicalNodeInfo leftmost(1, 0, fanout);
+  REQUIRE(deep_left.getHorizontalKey() == 0);
+  REQUIRE(deep_left < deep_right);
+  REQUIRE(deep_left < leftmost);
+  REQUIRE(leftmost < root);
+  REQUIRE(deep_right < root);
+  REQUIRE(deep_right >= deep_right);
+  REQUIRE_FALSE(deep_right < deep_right);
+}
@@ -44,3 +44,105 @@ TEST_CASE("ProcedureInfo", "[ProcedureInfo]") {
   REQUIRE_FALSE(info.hasKey(ProcedureKey::kAcceptChildProcedure));
   REQUIRE_FALSE(info.hasKey(ProcedureKey::kFindReplacementProcedure));
 }
+
+TEST_CASE("ProcedureInfo FindQueryState", "[ProcedureInfo]") {
+  uint16_t fanout = 5;
+  ProcedureInfo info;
+
+  minhton::NodeInfo node_a(1, 2, fanout);
+  minhton::NodeInfo node_b(1, 3, fanout);
+  uint64_t ref_event_id = 123;
+
+  REQUIRE_FALSE(info.hasFindQueryState(ref_event_id));
+  REQUIRE_THROWS_AS(info.loadFindQuery(ref_event_id), AlgorithmException);
+  REQUIRE_THROWS_AS(info.removeFindQuery(ref_event_id), AlgorithmException);
+
+  info.saveFindQuery(ref_event_id, FindQuery());
+  info.saveFindQueryPreliminaryResults(ref_event_id, {});
+  info.saveDSNAggregationStartTimestamp(ref_event_id, 1000);
+  REQUIRE(info.hasFindQueryState(ref_event_id));
+  REQUIRE(info.hasFindQueryEvent(ref_event_id));
+  REQUIRE_FALSE(info.hasInquiryAggregationStartTimestamp(ref_event_id));
+  REQUIRE_THROWS_AS(info.saveFindQuery(ref_event_id, FindQuery()), AlgorithmException);
+
+  SECTION("Accessing parts") {
+    info.addFindQueryPreliminaryResults(ref_event_id, node_a, {{"key1", 1}});
+    info.addFindQueryPreliminaryResults(ref_event_id, node_a, {{"key2", 2}});
+    info.addFindQueryPreliminaryResults(ref_event_id, node_b, {{"key1", 3}});
+
+    auto &results = info.loadFindQueryPreliminaryResults(ref_event_id);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[node_a].size() == 2);
+
+    // loaded parts are references to the saved state
+    results.erase(node_b);
+    REQUIRE(info.loadFindQueryPreliminaryResults(ref_event_id).size() == 1);
+
+    info.updateDSNAggregationStartTimestamp(ref_event_id, 2000);
+    REQUIRE(info.loadDSNAggregationStartTimestamp(ref_event_id) == 2000);
+    REQUIRE(info.getDSNAggregationStartTimestampMap().at(ref_event_id) == 2000);
+    REQUIRE(info.getInquiryAggregationStartTimestampMap().empty());
+  }
+
+  SECTION("Removing parts") {
+    info.removeFindQuery(ref_event_id);
+    info.removeFindQueryPreliminaryResults(ref_event_id);
+    REQUIRE_FALSE(info.hasFindQueryEvent(ref_event_id));
+    REQUIRE(info.hasFindQueryState(ref_event_id));
+
+    // the state is removed with its last part
+    info.removeDSNAggregationStartTimestamp(ref_event_id);
+    REQUIRE_FALSE(info.hasFindQueryState(ref_event_id));
+    REQUIRE(info.getNumberOfFindQueryStates() == 0);
+  }
+
+  SECTION("Removing the whole state") {
+    std::promise<FindResult> promise;
+    auto future = promise.get_future();
+    info.saveFindResultPromise(ref_event_id, std::move(promise));
+    info.loadFindResultPromise(ref_event_id).set_value({});
+
+    info.removeFindQueryState(ref_event_id);
+    REQUIRE_FALSE(info.hasFindQueryState(ref_event_id));
+    REQUIRE_FALSE(info.hasFindQueryEvent(ref_event_id));
+    REQUIRE_FALSE(info.hasFindResultFuture(ref_event_id));
+    REQUIRE(future.get().empty());
+
+    // saving again starts with an empty state
+    info.saveInquiryAggregationStartTimestamp(ref_event_id, 3000);
+    REQUIRE_FALSE(info.hasFindQueryEvent(ref_event_id));
+    REQUIRE(info.loadInquiryAggregationStartTimestamp(ref_event_id) == 3000);
+  }
+}
+
+TEST_CASE("ProcedureInfo many FindQueryStates", "[ProcedureInfo]") {
+  ProcedureInfo info;
+
+  for (uint64_t ref_event_id = 0; ref_event_id < 100; ref_event_id++) {
+    info.saveFindQuery(ref_event_id, FindQuery());
+    info.saveDSNAggregationStartTimestamp(ref_event_id, ref_event_id);
+  }
+  REQUIRE(info.getNumberOfFindQueryStates() == 100);
+
+  // references stay valid while further states are saved
+  auto &query = info.loadFindQuery(0);
+  for (uint64_t ref_event_id = 100; ref_event_id < 1000; ref_event_id++) {
+    info.saveFindQuery(ref_event_id, FindQuery());
+  }
+  REQUIRE(&query == &info.loadFindQuery(0));
+
+  for (uint64_t ref_event_id = 0; ref_event_id < 1000; ref_event_id += 2) {
+    info.removeFindQueryState(ref_event_id);
+  }
+  REQUIRE(info.getNumberOfFindQueryStates() == 500);
+  REQUIRE(info.getDSNAggregationStartTimestampMap().size() == 50);
+
+  for (uint64_t ref_event_id = 1; ref_event_id < 1000; ref_event_id += 2) {
+    REQUIRE(info.hasFindQueryEvent(ref_event_id));
+    if (ref_event_id < 100) {
+      REQUIRE(info.loadDSNAggregationStartTimestamp(ref_event_id) == ref_event_id);
+    } else {
+      REQUIRE_FALSE(info.hasDSNAggregationStartTimestamp(ref_event_id));
+    }
+  }
+}
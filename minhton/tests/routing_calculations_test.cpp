@@ -799,6 +799,50 @@ TEST_CASE("RoutingCalculations TreeMapper Invalid Levels/Numbers",
   // TODO
 }
 
+TEST_CASE("RoutingCalculations calcHorizontalKey", "[RoutingCalculations][HorizontalKey]") {
+  REQUIRE(calcHorizontalKeyMaxLevel(0) == 0);
+  REQUIRE(calcHorizontalKeyMaxLevel(2) == 62);
+  REQUIRE(calcHorizontalKeyMaxLevel(4) == 30);
+  REQUIRE(calcHorizontalKeyMaxLevel(255) == 7);
+  REQUIRE(calcHorizontalKey(0, 0, 0) == 0);
+  REQUIRE(calcHorizontalKey(63, 0, 2) == 0);
+  REQUIRE(calcHorizontalKey(62, UINT32_MAX, 2) == (2ULL * UINT32_MAX) + 1);
+
+  // The keys of the levels 3 and 4 of fanout 3 follow the order of the TreeMapper Fanout 3 case
+  uint16_t fanout = 3;
+  REQUIRE(calcHorizontalKey(3, 0, fanout) < calcHorizontalKey(3, 1, fanout));
+  REQUIRE(calcHorizontalKey(3, 1, fanout) < calcHorizontalKey(2, 0, fanout));
+  REQUIRE(calcHorizontalKey(2, 0, fanout) < calcHorizontalKey(3, 2, fanout));
+  REQUIRE(calcHorizontalKey(2, 8, fanout) < calcHorizontalKey(3, 26, fanout));
+
+  // Adjacent keys of the positions sorted by the TreeMapper
+  for (fanout = 2; fanout <= 6; fanout++) {
+    for (uint32_t level = 1; level <= 5; level++) {
+      for (uint32_t number = 0; number < calcNodesOnLevel(level, fanout); number++) {
+        uint64_t key = calcHorizontalKey(level, number, fanout);
+        double value = treeMapper(level, number, fanout, kTreeMapperRootValue);
+        auto parent = calcParent(level, number, fanout);
+        uint64_t parent_key =
+            calcHorizontalKey(std::get<0>(parent), std::get<1>(parent), fanout);
+        double parent_value =
+            treeMapper(std::get<0>(parent), std::get<1>(parent), fanout, kTreeMapperRootValue);
+        REQUIRE((key < parent_key) == (value < parent_value));
+        REQUIRE(compareHorizontalPositions(level, number, std::get<0>(parent),
+                                           std::get<1>(parent), fanout) ==
+                (key < parent_key ? -1 : 1));
+        if (number > 0) REQUIRE(calcHorizontalKey(level, number - 1, fanout) < key);
+      }
+    }
+  }
+
+  // Comparing positions beyond the deepest level with a key
+  REQUIRE(compareHorizontalPositions(10, 5, 10, 5, 255) == 0);
+  REQUIRE(compareHorizontalPositions(10, 4, 10, 5, 255) < 0);
+  REQUIRE(compareHorizontalPositions(10, 0, 0, 0, 255) < 0);
+  REQUIRE(compareHorizontalPositions(0, 0, 10, 0, 255) > 0);
+  REQUIRE(compareHorizontalPositions(9, 0, 10, 200, 255) < 0);
+}
+
 TEST_CASE("RoutingCalculations isPositionValid", "[RoutingCalculations][isPositionValid]") {
   // valid positions
   REQUIRE(isPositionValid(0, 0, kFanoutMinimum));
@@ -995,3 +1039,101 @@ TEST_CASE("RoutingCalculations getCoverArea, getCoveringDSN",
     REQUIRE(*dsn_set.rbegin() < max_num_this_level);
   }
 }
+
+// Materializes the DSN set like getDSNSet did before it was calculated arithmetically
+static std::vector<uint32_t> materializeDSNSet(uint32_t level, uint16_t fanout) {
+  if (level % 2 == 1) return {};
+  if (level == 0) return {0};
+
+  uint32_t max_number = pow(fanout, level) - 1;
+  std::vector<uint32_t> dsn_set;
+  for (uint32_t i = fanout; i <= max_number; i += 2 * fanout) {
+    dsn_set.push_back(i);
+  }
+  if (dsn_set.back() < max_number - fanout) {
+    dsn_set.push_back(max_number - fanout);
+  }
+  return dsn_set;
+}
+
+TEST_CASE("RoutingCalculations NumberSetView", "[RoutingCalculations][NumberSetView]") {
+  static_assert(isDSN(4, 6, 2));
+  static_assert(!isDSN(3, 2, 2));
+  static_assert(getDSNSetView(4, 2).back() == 14);
+  static_assert(getDSNSetView(2, 3).back() == 5);
+  static_assert(getPrioSetView(1, 3).front() == 2);
+
+  for (uint16_t fanout = 2; fanout <= 7; fanout++) {
+    for (uint32_t level = 0; pow(fanout, level) <= 20000; level++) {
+      auto expected = materializeDSNSet(level, fanout);
+      auto dsn_set = getDSNSetView(level, fanout);
+      auto prio_set = calcPrioSet(level, fanout);
+
+      REQUIRE(dsn_set.size() == expected.size());
+      REQUIRE(std::vector<uint32_t>(dsn_set.begin(), dsn_set.end()) == expected);
+
+      uint32_t max_number = pow(fanout, level) - 1;
+      for (uint32_t number = 0; number <= max_number; number++) {
+        auto it = std::lower_bound(expected.begin(), expected.end(), number);
+        bool contained = it != expected.end() && *it == number;
+
+        REQUIRE(dsn_set.contains(number) == contained);
+        REQUIRE(isDSN(level, number, fanout) == contained);
+        if (contained) {
+          REQUIRE(dsn_set.rank(number) == static_cast<uint64_t>(it - expected.begin()));
+        } else {
+          REQUIRE_FALSE(dsn_set.rank(number).has_value());
+        }
+
+        if (it == expected.end()) {
+          REQUIRE_FALSE(dsn_set.lowerBound(number).has_value());
+        } else {
+          REQUIRE(dsn_set.lowerBound(number) == *it);
+        }
+
+        auto next = std::upper_bound(expected.begin(), expected.end(), number);
+        if (next == expected.end()) {
+          REQUIRE_FALSE(dsn_set.next(number).has_value());
+        } else {
+          REQUIRE(dsn_set.next(number) == *next);
+        }
+
+        if (it == expected.begin()) {
+          REQUIRE_FALSE(dsn_set.previous(number).has_value());
+        } else {
+          REQUIRE(dsn_set.previous(number) == *std::prev(it));
+        }
+
+        REQUIRE(isNodePartOfPrioSet(level, number, fanout) == (prio_set.count(number) == 1));
+      }
+    }
+  }
+}
+
+TEST_CASE("RoutingCalculations NumberSetView deep levels",
+          "[RoutingCalculations][NumberSetView]") {
+  // 2^30 nodes on the level
+  auto binary_dsn_set = getDSNSetView(30, 2);
+  REQUIRE(binary_dsn_set.size() == 1U << 28);
+  REQUIRE(binary_dsn_set.back() == (1U << 30) - 2);
+  REQUIRE_FALSE(binary_dsn_set.contains((1U << 30) - 4));
+  REQUIRE(binary_dsn_set.rank((1U << 20) + 2) == 1U << 18);
+  REQUIRE(binary_dsn_set.previous(1U << 20) == (1U << 20) - 2);
+
+  // 3^20 nodes on the level, the last DSN is not part of the progression
+  auto dsn_set = getDSNSetView(20, 3);
+  REQUIRE(dsn_set.size() == 581130734);
+  REQUIRE(dsn_set.back() == 3486784397U);
+  REQUIRE(dsn_set[dsn_set.size() - 2] == 3486784395U);
+  REQUIRE(dsn_set.rank(3486784397U) == 581130733);
+  REQUIRE(dsn_set.previous(3486784397U) == 3486784395U);
+  REQUIRE(dsn_set.lowerBound(3486784396U) == 3486784397U);
+  REQUIRE_FALSE(dsn_set.next(3486784397U).has_value());
+
+  // Numbers of the level exceed uint32_t, but the view can still be queried
+  auto wide_dsn_set = getDSNSetView(30, 16);
+  REQUIRE(wide_dsn_set.contains(16));
+  REQUIRE(wide_dsn_set.contains(48));
+  REQUIRE_FALSE(wide_dsn_set.contains(32));
+  REQUIRE(wide_dsn_set.lowerBound(4000000000U) == 4000000016U);
+}
@@ -313,3 +313,79 @@ TEST_CASE("JsonSerializer Serialize/Deserialize", "[JsonSerializer][Serialize/De
     REQUIRE(deserialized_msg.getInterval().second == msg.getInterval().second);
   }
 }
+
+TEST_CASE("SerializerCereal Serialize into reused buffer", "[SerializerCereal][Buffer]") {
+  serializer::SerializerCereal serializer;
+
+  MinhtonMessageHeader header;
+  header.setSender(NodeInfo(1, 1, 2, "127.0.0.1", 2000));
+  header.setTarget(NodeInfo(2, 1, 2, "127.0.0.2", 2001));
+  MessageJoin msg(header, NodeInfo(2, 2, 2, "127.0.0.3", 2002));
+
+  std::string buffer = "previous content of a reused buffer which is longer than the message";
+  serializer.serializeInto(msg, buffer);
+  REQUIRE(buffer == serializer.serialize(msg));
+
+  // Deserialize from a view into a larger buffer
+  std::string padded = buffer + "trailing data";
+  auto deserialized_msg = std::get<MessageJoin>(
+      serializer.deserialize(std::string_view(padded.data(), buffer.size())));
+  compare_node_info(deserialized_msg.getEnteringNode(), msg.getEnteringNode());
+  compare_node_info(deserialized_msg.getSender(), msg.getSender());
+
+  // Truncated input must not be read beyond its end
+  REQUIRE_THROWS(serializer.deserialize(std::string_view(buffer.data(), buffer.size() / 2)));
+}
+
+TEST_CASE("SerializerCereal Compact wire format", "[SerializerCereal][Compact]") {
+  serializer::SerializerCereal binary;
+  serializer::SerializerCereal compact(WireFormat::kCompact);
+
+  MinhtonMessageHeader header;
+  header.setSender(NodeInfo(3, 4, 2, "10.0.3.4", 2004));
+  header.setTarget(NodeInfo(4, 8, 2, "10.0.4.8", 2008));
+  header.setEventId(1234567890123);
+
+  std::vector<NodeInfo> neighbors = {NodeInfo(3, 3, 2, "10.0.3.3", 2003),
+                                     NodeInfo(4, 9, 2, "node-4-9.local", 2009),
+                                     NodeInfo(4, 10, 2, "010.0.4.10", 2010), NodeInfo(3, 5, 2),
+                                     header.getSender()};
+  MessageInformAboutNeighbors msg(header, neighbors);
+
+  std::string binary_serialized = binary.serialize(msg);
+  std::string compact_serialized = compact.serialize(msg);
+  REQUIRE(serializer::SerializerCereal::detectWireFormat(binary_serialized) == WireFormat::kBinary);
+  REQUIRE(serializer::SerializerCereal::detectWireFormat(compact_serialized) ==
+          WireFormat::kCompact);
+  REQUIRE(compact_serialized.size() < binary_serialized.size());
+
+  SECTION("Both formats are deserialized by any serializer without losing information") {
+    REQUIRE(binary.serialize(binary.deserialize(compact_serialized)) == binary_serialized);
+    REQUIRE(compact.serialize(compact.deserialize(binary_serialized)) == compact_serialized);
+    REQUIRE(compact.serialize(binary.deserialize(compact_serialized)) == compact_serialized);
+  }
+
+  SECTION("Repeated peers are encoded as references") {
+    MessageInformAboutNeighbors distinct(header, {NodeInfo(3, 3, 2, "10.0.3.3", 2003),
+                                                  NodeInfo(3, 5, 2, "10.0.3.5", 2005),
+                                                  NodeInfo(3, 7, 2, "10.0.3.7", 2007)});
+    MessageInformAboutNeighbors repeated(header, {neighbors[0], neighbors[0], neighbors[0]});
+    // At least the UUIDs of the two repetitions are saved
+    REQUIRE(compact.serialize(repeated).size() + 2 * 16 <= compact.serialize(distinct).size());
+
+    auto deserialized_msg =
+        std::get<MessageInformAboutNeighbors>(compact.deserialize(compact.serialize(repeated)));
+    REQUIRE(deserialized_msg.getRequestedNeighbors().size() == 3);
+    for (const auto &neighbor : deserialized_msg.getRequestedNeighbors()) {
+      compare_node_info(neighbor, neighbors[0]);
+      REQUIRE(neighbor.getLogicalNodeInfo().getUuid() ==
+              neighbors[0].getLogicalNodeInfo().getUuid());
+    }
+  }
+
+  SECTION("Truncated input throws") {
+    for (std::size_t size = 0; size < compact_serialized.size(); size++) {
+      REQUIRE_THROWS(compact.deserialize(std::string_view(compact_serialized.data(), size)));
+    }
+  }
+}
@@ -0,0 +1,180 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "core/timer_wheel.h"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <future>
+#include <map>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/watchdog.h"
+
+using namespace minhton;
+using namespace minhton::core;
+
+TEST_CASE("TimerWheel Expiry", "[TimerWheel]") {
+  TimerWheel wheel;
+  REQUIRE_FALSE(wheel.getNextTick());
+
+  // Ticks at the borders of the levels and beyond the range of the wheel
+  const std::vector<uint64_t> ticks{1,     2,      63,      64,      65,     4095,
+                                    4096,  4097,   262143,  262144,  300000, TimerWheel::kRange - 1,
+                                    TimerWheel::kRange, TimerWheel::kRange + 4711};
+
+  std::vector<uint64_t> fired;
+  for (auto tick : ticks) {
+    wheel.schedule(tick, [&fired, &wheel]() { fired.push_back(wheel.getCurrentTick()); });
+  }
+  REQUIRE(wheel.size() == ticks.size());
+
+  TimerWheel::Expired expired;
+  for (auto tick : ticks) {
+    wheel.advance(tick - 1, expired);
+    REQUIRE(expired.empty());
+
+    wheel.advance(tick, expired);
+    REQUIRE(expired.size() == 1);
+    expired.front().second();
+    expired.clear();
+    REQUIRE(fired.back() == tick);
+  }
+  REQUIRE(wheel.size() == 0);
+  REQUIRE_FALSE(wheel.getNextTick());
+}
+
+TEST_CASE("TimerWheel Cancel", "[TimerWheel]") {
+  TimerWheel wheel;
+  TimerWheel::Expired expired;
+
+  auto first = wheel.schedule(10, []() {});
+  auto second = wheel.schedule(10, []() {});
+  auto third = wheel.schedule(5000, []() {});
+  REQUIRE(wheel.isPending(second));
+
+  REQUIRE(wheel.cancel(second));
+  REQUIRE_FALSE(wheel.cancel(second));
+  REQUIRE_FALSE(wheel.isPending(second));
+  REQUIRE(wheel.cancel(third));
+  REQUIRE(wheel.size() == 1);
+
+  // The node of the third timer is reused, but its handle stays invalid
+  auto fourth = wheel.schedule(20, []() {});
+  REQUIRE(fourth.index == third.index);
+  REQUIRE(fourth != third);
+  REQUIRE_FALSE(wheel.cancel(third));
+
+  wheel.advance(10, expired);
+  REQUIRE(expired.size() == 1);
+  REQUIRE(expired[0].first == first);
+  REQUIRE_FALSE(wheel.cancel(first));
+
+  wheel.advance(20, expired);
+  REQUIRE(expired.size() == 2);
+  REQUIRE(expired[1].first == fourth);
+}
+
+TEST_CASE("TimerWheel Same Expiries As Sorted Timers", "[TimerWheel]") {
+  std::mt19937 rng(5);
+  TimerWheel wheel;
+  TimerWheel::Expired expired;
+
+  // Expiry tick of each pending timer by its handle
+  std::map<std::pair<uint32_t, uint32_t>, uint64_t> pending;
+
+  for (uint32_t round = 0; round < 2000; round++) {
+    for (uint32_t i = rng() % 8; i > 0; i--) {
+      const uint64_t ticks = 1 + (rng() % 2 ? rng() % 100 : rng() % 500000);
+      auto handle = wheel.schedule(ticks, []() {});
+      pending[{handle.index, handle.generation}] = wheel.getCurrentTick() + ticks;
+    }
+
+    if (rng() % 4 == 0 && !pending.empty()) {
+      auto it = std::next(pending.begin(), rng() % pending.size());
+      REQUIRE(wheel.cancel({it->first.first, it->first.second}));
+      pending.erase(it);
+    }
+
+    const uint64_t target = wheel.getCurrentTick() + (rng() % 3 ? rng() % 50 : rng() % 100000);
+    wheel.advance(target, expired);
+
+    // Exactly the timers up to the target, in the order of their expiry
+    uint64_t previous_expiry = 0;
+    for (const auto &[handle, function] : expired) {
+      auto it = pending.find({handle.index, handle.generation});
+      REQUIRE(it != pending.end());
+      REQUIRE(it->second <= target);
+      REQUIRE(it->second >= previous_expiry);
+      previous_expiry = it->second;
+      pending.erase(it);
+    }
+    for (const auto &[handle, expiry] : pending) REQUIRE(expiry > target);
+
+    expired.clear();
+    REQUIRE(wheel.size() == pending.size());
+  }
+}
+
+TEST_CASE("TimerService", "[TimerWheel]") {
+  TimerService service;
+  std::atomic<uint32_t> fired = 0;
+
+  std::promise<void> last_fired;
+  service.schedule(5, [&fired]() { fired++; });
+  auto cancelled = service.schedule(5, [&fired]() { fired += 100; });
+  service.schedule(20, [&fired, &last_fired]() {
+    fired++;
+    last_fired.set_value();
+  });
+
+  REQUIRE(service.cancel(cancelled));
+  REQUIRE_FALSE(service.isActive(cancelled));
+  REQUIRE(last_fired.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+  REQUIRE(fired == 2);
+
+  // Cancelling a running timer waits until it returns
+  std::promise<void> started;
+  std::atomic_bool returned = false;
+  auto running = service.schedule(1, [&started, &returned]() {
+    started.set_value();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    returned = true;
+  });
+  started.get_future().wait();
+  REQUIRE(service.isActive(running));
+  REQUIRE_FALSE(service.cancel(running));
+  REQUIRE(returned);
+  REQUIRE(service.size() == 0);
+}
+
+TEST_CASE("WatchDog CancelJob", "[TimerWheel]") {
+  std::atomic<uint32_t> fired = 0;
+
+  {
+    WatchDog watchdog;
+    TimeoutType type = TimeoutType::kDsnAggregationTimeout;
+    TimeoutType other_type = TimeoutType::kJoinRetry;
+
+    watchdog.addJob([&fired]() { fired += 100; }, 10, type);
+    watchdog.addJob([&fired]() { fired += 100; }, 10, type);
+    watchdog.addJob([&fired]() { fired++; }, 10, other_type);
+    watchdog.cancelJob(type);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(fired == 1);
+
+    // Pending jobs are cancelled with the watchdog
+    watchdog.addJob([&fired]() { fired += 100; }, 10, type);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  REQUIRE(fired == 1);
+}
@@ -0,0 +1,242 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "minhcast/minhcast_forwarding.h"
+#include "solanet/uuid_generator.h"
+#include "utils/tree_helper.h"
+
+/**
+ * Replays Minhcast broadcasts through a simulated tree in-process, i.e. without network.
+ * Every node knows the same peers as in the static natter scenarios of daisi (parent, children,
+ * routing table neighbors and their children, adjacents). Compares calculating the receivers for
+ * every received message with the cached forwarding plans, and checks that every node receives
+ * each broadcast exactly once.
+ */
+
+using namespace natter::minhcast;
+
+using Clock = std::chrono::steady_clock;
+
+struct SimulatedNode {
+  LevelNumber position;
+  solanet::UUID uuid;
+  MinhcastForwarding forwarding;
+};
+
+struct Delivery {
+  uint32_t receiver;
+  uint32_t sender;
+  ForwardingLimit limit;
+  bool inner_forward;
+};
+
+class SimulatedTree {
+public:
+  SimulatedTree(uint32_t number_of_nodes, uint32_t fanout) : fanout_(fanout) {
+    for (uint32_t i = 0; i < number_of_nodes; i++) {
+      nodes_.push_back({positionOf(i), solanet::generateUUID(), {}});
+    }
+    for (uint32_t i = 0; i < number_of_nodes; i++) connect(i);
+  }
+
+  std::size_t size() const { return nodes_.size(); }
+
+  /// Broadcasts from the initial node and returns the number of sent messages.
+  /// Throws if a node did not receive the message exactly once.
+  template <bool kCached> uint64_t broadcast(uint32_t initial) {
+    const std::string topic = "topic";
+    const solanet::UUID msg_id = solanet::generateUUID();
+    const std::tuple<solanet::UUID, LevelNumber> initial_node{nodes_[initial].uuid,
+                                                              nodes_[initial].position};
+
+    std::vector<uint32_t> received(nodes_.size(), 0);
+    std::deque<Delivery> queue{{initial, initial, {}, false}};
+    uint64_t messages = 0;
+
+    while (!queue.empty()) {
+      const Delivery delivery = queue.front();
+      queue.pop_front();
+      received[delivery.receiver]++;
+      if (delivery.inner_forward) continue;
+
+      SimulatedNode &node = nodes_[delivery.receiver];
+      const SimulatedNode &sender = nodes_[delivery.sender];
+      BroadcastInfo bc{{node.uuid, node.position},
+                       {sender.uuid, sender.position},
+                       initial_node,
+                       delivery.limit,
+                       topic,
+                       msg_id,
+                       "",
+                       0};
+
+      auto enqueue = [&](const ForwardingPlan &plan) {
+        for (const Forward &forward : plan) {
+          queue.push_back({indexOf(forward.peer.position), delivery.receiver,
+                           {forward.up_limit, forward.down_limit}, forward.inner_forward});
+        }
+        messages += plan.size();
+      };
+      if constexpr (kCached) {
+        enqueue(node.forwarding.getForwards(bc));
+      } else {
+        enqueue(node.forwarding.calculateForwards(bc));
+      }
+    }
+
+    for (uint32_t i = 0; i < received.size(); i++) {
+      if (received[i] != 1) {
+        throw std::runtime_error("Node " + toLevelNumberPair(nodes_[i].position) + " received " +
+                                 std::to_string(received[i]) + " messages");
+      }
+    }
+    return messages;
+  }
+
+  std::size_t cachedPlans() const {
+    std::size_t plans = 0;
+    for (const auto &node : nodes_) plans += node.forwarding.getCachedPlanCount();
+    return plans;
+  }
+
+private:
+  uint32_t nodesAbove(uint32_t level) const {
+    uint32_t nodes = 0;
+    uint32_t on_level = 1;
+    for (uint32_t l = 0; l < level; l++) {
+      nodes += on_level;
+      on_level *= fanout_;
+    }
+    return nodes;
+  }
+
+  LevelNumber positionOf(uint32_t index) const {
+    uint32_t level = 0;
+    for (uint32_t i = index; i != 0; i = (i - 1) / fanout_) level++;
+    return {level, index - nodesAbove(level), fanout_};
+  }
+
+  uint32_t indexOf(const LevelNumber &position) const {
+    return nodesAbove(std::get<0>(position)) + std::get<1>(position);
+  }
+
+  bool exists(const LevelNumber &position) const { return indexOf(position) < nodes_.size(); }
+
+  // Peer receiver gets to know node
+  void addPeer(uint32_t receiver, uint32_t node) {
+    nodes_[receiver].forwarding.addPeer(
+        {nodes_[node].position, {"127.0.0.1", static_cast<uint16_t>(node)}, nodes_[node].uuid});
+  }
+
+  std::vector<uint32_t> children(uint32_t index) const {
+    std::vector<uint32_t> result;
+    for (uint32_t j = 1; j <= fanout_; j++) {
+      uint64_t child = static_cast<uint64_t>(index) * fanout_ + j;
+      if (child < nodes_.size()) result.push_back(static_cast<uint32_t>(child));
+    }
+    return result;
+  }
+
+  // In-order traversal, where the first half of the children is left of its parent
+  void linearProjection(uint32_t index, std::vector<uint32_t> &projection) const {
+    auto child_nodes = children(index);
+    const std::size_t left_children = (fanout_ + 1) / 2;
+    for (std::size_t i = 0; i < child_nodes.size() && i < left_children; i++) {
+      linearProjection(child_nodes[i], projection);
+    }
+    projection.push_back(index);
+    for (std::size_t i = left_children; i < child_nodes.size(); i++) {
+      linearProjection(child_nodes[i], projection);
+    }
+  }
+
+  void connect(uint32_t index) {
+    if (index != 0) addPeer((index - 1) / fanout_, index);
+
+    const auto child_nodes = children(index);
+    for (uint32_t child : child_nodes) addPeer(child, index);
+
+    std::vector<uint32_t> neighbors;
+    for (const auto &rt : {calculateLRT(nodes_[index].position),
+                           calculateRRT(nodes_[index].position)}) {
+      for (const auto &neighbor : rt) {
+        if (exists(neighbor)) neighbors.push_back(indexOf(neighbor));
+      }
+    }
+    for (uint32_t neighbor : neighbors) {
+      addPeer(neighbor, index);
+      for (uint32_t child : child_nodes) addPeer(neighbor, child);
+    }
+
+    if (projection_.empty()) linearProjection(0, projection_);
+    auto it = std::find(projection_.begin(), projection_.end(), index);
+    if (it != projection_.begin()) addPeer(*std::prev(it), index);
+    if (std::next(it) != projection_.end()) addPeer(*std::next(it), index);
+  }
+
+  uint32_t fanout_;
+  std::vector<SimulatedNode> nodes_;
+  std::vector<uint32_t> projection_;
+};
+
+template <bool kCached>
+double measure(SimulatedTree &tree, const std::vector<uint32_t> &initial_nodes) {
+  auto start = Clock::now();
+  for (uint32_t initial : initial_nodes) tree.broadcast<kCached>(initial);
+  auto end = Clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / initial_nodes.size();
+}
+
+int main(int argc, char *argv[]) {
+  const uint32_t number_of_nodes = argc > 1 ? std::stoul(argv[1]) : 10000;
+  const uint32_t number_of_broadcasts = argc > 2 ? std::stoul(argv[2]) : 200;
+
+  std::cout << std::setw(7) << "fanout" << std::setw(8) << "nodes" << std::setw(10) << "msgs/bc"
+            << std::setw(16) << "uncached us/bc" << std::setw(14) << "cold us/bc" << std::setw(14)
+            << "warm us/bc" << std::setw(10) << "speedup" << std::setw(10) << "plans"
+            << std::endl
+            << std::fixed;
+
+  for (uint32_t fanout : {2, 3, 4, 8}) {
+    SimulatedTree tree(number_of_nodes, fanout);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> dist(0, number_of_nodes - 1);
+    std::vector<uint32_t> initial_nodes(number_of_broadcasts);
+    for (auto &initial : initial_nodes) initial = dist(rng);
+
+    uint64_t messages = 0;
+    try {
+      messages = tree.broadcast<false>(initial_nodes.front());
+    } catch (const std::exception &e) {
+      std::cerr << "Broadcast failed with fanout " << fanout << ": " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const double uncached = measure<false>(tree, initial_nodes);
+    const double cold = measure<true>(tree, initial_nodes);  // Fills the caches
+    const double warm = measure<true>(tree, initial_nodes);
+
+    std::cout << std::setw(7) << fanout << std::setw(8) << tree.size() << std::setw(10)
+              << messages << std::setw(16) << std::setprecision(1) << uncached << std::setw(14)
+              << cold << std::setw(14) << warm << std::setw(9) << uncached / warm << "x"
+              << std::setw(10) << tree.cachedPlans() << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -13,6 +13,7 @@
 #include "natter/minhcast_level_number.h"
 #include "natter/natter.h"
 #include "natter/network_info_ipv4.h"
+#include "solanet/network_udp/network_udp.h"
 #include "solanet/uuid.h"
 
 namespace natter::minhcast {
@@ -57,6 +58,17 @@ public:
   NatterMinhcast(MsgReceiveFct recv_callback, MsgMissingFct missing_callback,
                  const std::vector<logging::LoggerPtr> &logger);
 
+  /**
+   * Create natter instance with random uuid and non-default network options
+   * @param recv_callback function will be called when message arrives for this instance
+   * @param missing_callback NOT YET USED FOR MINHCAST
+   * @param logger logger
+   * @param network_options options of the network interface, e.g. a shared NetworkContext
+   */
+  NatterMinhcast(MsgReceiveFct recv_callback, MsgMissingFct missing_callback,
+                 const std::vector<logging::LoggerPtr> &logger,
+                 const solanet::NetworkOptions &network_options);
+
   // Disallow copy/move
   NatterMinhcast(const NatterMinhcast &) = delete;
   NatterMinhcast &operator=(const NatterMinhcast &) = delete;
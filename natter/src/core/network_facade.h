@@ -8,6 +8,7 @@
 #define NATTER_CORE_NETWORK_FACADE_H_
 
 #include "natter/network_info_ipv4.h"
+#include "solanet/network_udp/buffer_pool.h"
 #include "solanet/network_udp/network_udp.h"
 #include "solanet/serializer/serializer.h"
 
@@ -17,13 +18,19 @@ namespace natter::core {
  */
 template <typename T> class NetworkFacade {
 public:
-  explicit NetworkFacade(std::function<void(const T &)> recv_fct)
+  explicit NetworkFacade(std::function<void(const T &)> recv_fct,
+                         const solanet::NetworkOptions &network_options = {})
       : network_(
-            [this](auto &&message) { processMessage(std::forward<decltype(message)>(message)); }),
+            "",
+            [this](auto &&message) { processMessage(std::forward<decltype(message)>(message)); },
+            network_options),
         recv_fct_(std::move(recv_fct)) {}
 
   void send(const NetworkInfoIPv4 &net_info, const T &message) {
-    network_.send({net_info.ip, net_info.port, solanet::serializer::serialize<T>(message)});
+    // Serialize into a pooled buffer, which is moved into the network and returned after sending
+    std::string buffer = solanet::BufferPool::global().acquire();
+    solanet::serializer::serializeInto<T>(message, buffer);
+    network_.send({net_info.ip, net_info.port, std::move(buffer)});
   }
 
   NetworkInfoIPv4 getNetworkInfo() const { return {network_.getIP(), network_.getPort()}; }
@@ -0,0 +1,535 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "minhcast_forwarding.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "core/natter_check.h"
+#include "utils/tree_helper.h"
+
+namespace natter::minhcast {
+
+static constexpr Level maxLevelNumber() { return std::numeric_limits<Level>::max(); }
+
+bool MinhcastForwarding::addPeer(const NodeInfo &info) {
+  if (!peers_.insert(info)) return false;
+  plans_.clear();
+  return true;
+}
+
+bool MinhcastForwarding::removePeer(const NetworkInfoIPv4 &network) {
+  if (!peers_.erase(network)) return false;
+  plans_.clear();
+  return true;
+}
+
+const ForwardingPlan &MinhcastForwarding::getForwards(const BroadcastInfo &bc) {
+  PlanKey key{bc.getOwnNodePos(), bc.getLastNodePos(), bc.forwarding_limit.up(),
+              bc.forwarding_limit.down(), bc.isInitialSender()};
+
+  auto it = plans_.find(key);
+  if (it != plans_.end()) return it->second;
+
+  ForwardingPlan plan = calculateForwards(bc);
+  if (plans_.size() >= kMaxCachedPlans) plans_.clear();
+  return plans_.emplace(key, std::move(plan)).first->second;
+}
+
+ForwardingPlan MinhcastForwarding::calculateForwards(const BroadcastInfo &bc) const {
+  ForwardingPlan plan;
+  auto [parent_up_border, child_down_border] = addAdjacents(bc, plan);
+  addParent(bc, parent_up_border, plan);
+  const auto [other_sending_down, send_to_children] = addChildren(bc, child_down_border, plan);
+  addInlevel(bc, other_sending_down, send_to_children, plan);
+  return plan;
+}
+
+bool MinhcastForwarding::hasChildren(LevelNumber node) const {
+  // As MINHTON trees are complete, if a node has children it leftmost child must exist.
+  const auto [level, number, fanout] = node;
+  const uint32_t child_level = level + 1;
+  const uint32_t first_child_number = number * fanout;
+  return peers_.contains({child_level, first_child_number, fanout});
+}
+
+void MinhcastForwarding::addRoutingTableToReceiver(LevelNumber own_node,
+                                                   std::vector<NodeInfo> &receiver) const {
+  addRRT(own_node, receiver);
+  addLRT(own_node, receiver);
+}
+
+void MinhcastForwarding::addLRT(LevelNumber own_node, std::vector<NodeInfo> &receiver) const {
+  auto lrt = calculateLRT(own_node);
+  for (auto &node : lrt) {
+    const NodeInfo *peer = peers_.find(node);
+    NATTER_CHECK(peer != nullptr,
+                 "Do not know node in LRT. Nodes in LRT should always be known (complete tree).");
+    receiver.emplace_back(*peer);
+  }
+}
+
+void MinhcastForwarding::addRRT(LevelNumber own_node, std::vector<NodeInfo> &receiver) const {
+  auto rrt = calculateRRT(own_node);
+  for (const auto &node : rrt) {
+    const NodeInfo *peer = peers_.find(node);
+    // Only add node if it is known
+    if (peer != nullptr) {
+      receiver.emplace_back(*peer);
+    } else {
+      // There can no more nodes be right of this
+      return;
+    }
+  }
+}
+
+void MinhcastForwarding::addLeftForwardNodes(LevelNumber own_node, LevelNumber last_node,
+                                             std::vector<NodeInfo> &receiver) const {
+  std::set<LevelNumber> our_lrt = calculateLRT(own_node);
+  if (our_lrt.empty()) return;  // No nodes to forward to
+
+  // Calculate lower boundary
+  std::set<LevelNumber> last_sender_lrt;
+  auto lower_boundary = last_sender_lrt.end();
+  if (std::get<0>(last_node) == std::get<0>(own_node)) {
+    last_sender_lrt = calculateLRT(last_node);
+    auto it = last_sender_lrt.find(own_node);
+    NATTER_CHECK(it != last_sender_lrt.end(), "Cannot find ourselves in LRT from last node");
+    lower_boundary = --it;  // Lower boundary is the next left node
+  }
+
+  // First node on level or no other peers left of us that already received the message
+  // -> Send to all nodes in LRT
+  if (lower_boundary == last_sender_lrt.end()) {
+    for (auto &node : our_lrt) {
+      const NodeInfo *peer = peers_.find(node);
+      NATTER_CHECK(peer != nullptr, "Do not known node in our LRT");
+      receiver.emplace_back(*peer);
+    }
+  } else {
+    assert(lower_boundary != last_sender_lrt.end());
+    uint32_t lower_boundary_number = std::get<1>(*lower_boundary);
+    for (auto &node : our_lrt) {
+      // Forward to all nodes in our LRT which have a greater number than lower_boundary
+      if (std::get<1>(node) > lower_boundary_number) {
+        const NodeInfo *peer = peers_.find(node);
+        NATTER_CHECK(peer != nullptr, "Do not know node in our LRT");
+        receiver.emplace_back(*peer);
+      }
+    }
+  }
+}
+
+void MinhcastForwarding::addRightForwardNodes(LevelNumber own_node, LevelNumber last_node,
+                                              std::vector<NodeInfo> &receiver) const {
+  std::set<LevelNumber> our_rrt = calculateRRT(own_node);
+  if (our_rrt.empty()) return;
+
+  // Calculate upper boundary
+  std::set<LevelNumber> last_sender_rrt;
+  auto upper_boundary = last_sender_rrt.end();
+  if (std::get<0>(last_node) == std::get<0>(own_node)) {
+    last_sender_rrt = calculateRRT(last_node);
+    auto it = last_sender_rrt.find(own_node);
+    NATTER_CHECK(it != last_sender_rrt.end(), "Cannot find ourselves in RRT from last node");
+    upper_boundary = ++it;  // upper boundary is the next right node
+  }
+
+  // First node on level or no other peers right of us that already received the message
+  // -> Send to all nodes in RRT
+  if (upper_boundary == last_sender_rrt.end()) {
+    for (auto &node : our_rrt) {
+      const NodeInfo *peer = peers_.find(node);
+      // Can only send nodes in RRT which exists and are known to us
+      if (peer != nullptr) {
+        receiver.emplace_back(*peer);
+      }
+    }
+  } else {
+    assert(upper_boundary != last_sender_rrt.end());
+    uint32_t upper_boundary_number = std::get<1>(*upper_boundary);
+    for (auto &node : our_rrt) {
+      // Forward to all nodes in our RRT which have a smaller number
+      // than lower_boundary and are existing
+      if (std::get<1>(node) < upper_boundary_number) {
+        const NodeInfo *peer = peers_.find(node);
+        // Can only send nodes in RRT which exists and are known to us
+        if (peer != nullptr) {
+          receiver.emplace_back(*peer);
+        }
+      }
+    }
+  }
+}
+
+void MinhcastForwarding::addInnerForwardNodes(const BroadcastInfo &bc,
+                                              std::vector<NodeInfo> &receiver) const {
+  const auto [own_level, own_number, fanout] = bc.getOwnNodePos();
+  const auto [last_level, last_number, last_fanout] = bc.getLastNodePos();
+
+  // Previous node should be our parent
+  assert(last_level == own_level - 1 &&
+         last_number == std::floor(static_cast<float>(own_number) / fanout));
+
+  const uint32_t right_child_number = last_number * fanout + (fanout - 1);
+
+  const bool left_child = (own_number == last_number * fanout);
+  const bool right_child = (own_number == right_child_number);
+
+  NATTER_CHECK(left_child != right_child,
+               "addInnerForwardNodes() called without being outer child");
+
+  const uint32_t nodes_between = fanout - 2;
+
+  if (nodes_between == 0) {
+    // no nodes in between to forward to. Can only happen with m=2
+    assert(fanout == 2);
+    return;
+  }
+
+  if (left_child && !peers_.contains({own_level, right_child_number, fanout})) {
+    // We are leftmost child and rightmost child does not exist
+    // Forward to all our siblings (entire RRT)
+    addRRT(bc.getOwnNodePos(), receiver);
+  } else if (left_child) {
+    // We are the leftmost child and the rightmost child exists
+    // Forward to adjacent half of our siblings (right of us)
+    const auto upper_number = static_cast<uint32_t>(std::ceil(nodes_between / 2.0)) + own_number;
+    addFromRoutingTable(calculateRRT(bc.getOwnNodePos()), receiver, upper_number,
+                        std::less_equal<>());
+  } else if (right_child) {
+    // We are the rightmost child and therefore the leftmost child must exist
+    // Forward to adjacent half of our siblings (left of us)
+    const auto lower_number = own_number - static_cast<uint32_t>(std::floor(nodes_between / 2.0));
+    addFromRoutingTable(calculateLRT(bc.getOwnNodePos()), receiver, lower_number,
+                        std::greater_equal<>());
+  }
+}
+
+bool MinhcastForwarding::centeredNodeAddChildren(const BroadcastInfo &bc,
+                                                 std::vector<NodeInfo> &receiver) const {
+  bool other_forwarding_down = false;
+
+  // Get other node who received the message
+  bool left_child = bc.ownNumber() == bc.lastNumber() * bc.ownFanout();
+  bool right_child = bc.ownNumber() == bc.lastNumber() * bc.ownFanout() + (bc.ownFanout() - 1);
+  uint32_t others_number = left_child ? bc.lastNumber() * bc.ownFanout() + (bc.ownFanout() - 1)
+                                      : bc.lastNumber() * bc.ownFanout();
+  NATTER_CHECK(left_child != right_child,
+               "Received message directly from above but we are not an outer child");
+
+  if (left_child && !peers_.contains({bc.ownLevel(), others_number, bc.ownFanout()})) {
+    // We are the only child received the message
+    addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+  } else {
+    // Calculate center nodes
+    auto nodes_on_level = static_cast<uint32_t>(std::pow(bc.ownFanout(), bc.ownLevel()));
+
+    // Thanks to https://stackoverflow.com/a/27833306
+    float center_number = (nodes_on_level - 1) / 2.0F;
+    float own_dist = std::max(static_cast<float>(bc.ownNumber()), center_number) -
+                     std::min(static_cast<float>(bc.ownNumber()), center_number);
+    float other_dist = std::max(static_cast<float>(others_number), center_number) -
+                       std::min(static_cast<float>(others_number), center_number);
+
+    if (other_dist < own_dist) {
+      // Our sibling is nearer to center
+      LevelNumber sibling{bc.ownLevel(), others_number, bc.ownFanout()};
+      if (!hasChildren(sibling)) {
+        // Our sibling has no children but we might have
+        addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+      } else {
+        // Our sibling is forwarding down, nothing to do for us
+        other_forwarding_down = true;
+      }
+    } else if (other_dist == own_dist) {
+      // Both nodes have same distance, tie situation
+      // In this case the left child is forwarding to children
+      if (left_child) {
+        addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+      }
+    } else {
+      // We are nearest to center: Send to children (if they exist)
+      addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+    }
+  }
+
+  return other_forwarding_down;
+}
+
+std::vector<LevelNumber> MinhcastForwarding::calculateRRTIntersection(const BroadcastInfo &bc) {
+  std::vector<LevelNumber> intersection;
+  auto last_lrt = calculateLRT(bc.getLastNodePos());
+  auto our_rrt = calculateRRT(bc.getOwnNodePos());
+  std::set_intersection(last_lrt.begin(), last_lrt.end(), our_rrt.begin(), our_rrt.end(),
+                        std::back_inserter(intersection));
+  assert(std::is_sorted(intersection.begin(), intersection.end()));
+  return intersection;
+}
+
+bool MinhcastForwarding::imperfectTreeAddChildren(const BroadcastInfo &bc,
+                                                  std::vector<NodeInfo> &receiver) const {
+  bool other_forwarding_down = false;
+
+  // Special case with imperfect tree: Received message inlevel from right and should forward
+  // to children because the last node has no children
+  assert(!hasChildren(bc.getLastNodePos()));  // Info available through routing table neighbors
+
+  if (hasChildren(bc.getOwnNodePos())) {
+    // We have children. Check if we are the rightmost neighbor of last sender. If so send to
+    // children.
+    std::vector<LevelNumber> intersection = calculateRRTIntersection(bc);
+
+    // If no nodes are in common or the leftmost common node (which due to construction of
+    // neighbor links must be the leftmost neighbor of last_node before own_node) has no children
+    // (known with RT neighbor links) we are the leftmost node that received the message on this
+    // level already and have children
+    if (intersection.empty() || !hasChildren(intersection[0])) {
+      addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+    } else {
+      other_forwarding_down = true;
+    }
+  } else {
+    // We should eventually forward down but do not have any children.
+    // Iff we are the leftmost neighbor of last_sender, delegate the down_forward request to our
+    // left neighbors
+    auto last_lrt = calculateLRT(bc.getLastNodePos());
+    assert(!last_lrt.empty());
+    auto leftmost = *last_lrt.begin();
+
+    // If we are not the leftmost neighbor of last_sender, therefore our LRT intervals
+    // neighbors aren't responsible for down_forward. One of our left neighbors will do it
+    // otherwise we must delegate down forwarding to our LRT intervals neighbors
+    other_forwarding_down = (leftmost != bc.getOwnNodePos());
+  }
+  return other_forwarding_down;
+}
+
+std::tuple<bool, bool> MinhcastForwarding::addChildren(const BroadcastInfo &bc,
+                                                       const Level child_down_border,
+                                                       ForwardingPlan &plan) const {
+  std::vector<NodeInfo> receiver;
+
+  bool other_forwarding_down = false;
+  bool received_from_right = bc.ownLevel() == bc.lastLevel() && bc.ownNumber() < bc.lastNumber();
+
+  // Send to children
+  if (bc.isInitialSender()) {
+    addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+  } else if (bc.receivedFromLowerAdjacent() && bc.allowedDownForward()) {
+    // First node on level received form
+    addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+  } else if (bc.receivedDirectlyFromAbove() && bc.allowedDownForward()) {
+    // Directly received from parent: The most centered and existing of the two children
+    // should forward the message
+    other_forwarding_down = centeredNodeAddChildren(bc, receiver);
+  } else if (!bc.receivedDirectlyFromAbove() && bc.receivedFromAbove() && bc.allowedDownForward()) {
+    // Received from adjacent above, therefore we are this first node on this level
+    // and should send to our children
+    addLeftAndRightmostChildren(bc.getOwnNodePos(), receiver);
+  } else if (bc.allowedDownForward() && received_from_right) {
+    other_forwarding_down = imperfectTreeAddChildren(bc, receiver);
+  }
+
+  for (const auto &peer : receiver) {
+    plan.push_back({peer, bc.ownLevel() + 1, child_down_border, false});
+  }
+
+  return {other_forwarding_down, !receiver.empty()};
+}
+
+const MinhcastForwarding::NodeInfo *MinhcastForwarding::getDeeperAdjacent(
+    const BroadcastInfo &bc) const {
+  if (!bc.allowedDownForward()) return nullptr;
+
+  // More than one level below us and within the forward down limit
+  return peers_.findLeftmostOnDeepestLevel(bc.ownLevel() + 2, bc.forwarding_limit.down());
+}
+
+void MinhcastForwarding::addParent(const BroadcastInfo &bc, const Level parent_up_border,
+                                   ForwardingPlan &plan) const {
+  if (bc.ownLevel() == 0) return;  // Parent does not exist
+
+  if (bc.ownLevel() - 1 >= bc.forwarding_limit.up()) {
+    const uint32_t parent_level = bc.ownLevel() - 1;
+    const uint32_t parent_number = std::floor(bc.ownNumber() / bc.ownFanout());
+
+    const NodeInfo *parent = peers_.find({parent_level, parent_number, bc.ownFanout()});
+    NATTER_CHECK(parent != nullptr, "Parent must exist but is not known");
+
+    plan.push_back({*parent, parent_up_border, bc.ownLevel() - 1, false});
+  }
+}
+
+std::tuple<std::vector<MinhcastForwarding::NodeInfo>, std::vector<MinhcastForwarding::NodeInfo>>
+MinhcastForwarding::getInlevel(const BroadcastInfo &bc) const {
+  std::vector<NodeInfo> receiver_inlevel;
+  std::vector<NodeInfo> receiver_inner;
+
+  bool single_first_on_level = bc.isInitialSender() || bc.ownLevel() < bc.lastLevel() ||
+                               (bc.receivedFromAbove() && !bc.receivedDirectlyFromAbove());
+
+  if (single_first_on_level) {
+    addRoutingTableToReceiver(bc.getOwnNodePos(), receiver_inlevel);
+  } else if (bc.receivedDirectlyFromAbove()) {
+    // Max two nodes (including us) received the message
+    // Determine if we are left or right child and forward accordingly
+    bool left_child = (bc.ownNumber() == bc.lastNumber() * bc.ownFanout());
+    bool right_child = (bc.ownNumber() == bc.lastNumber() * bc.ownFanout() + (bc.ownFanout() - 1));
+    NATTER_CHECK(left_child != right_child, "Cannot be left and right child simultaneous");
+    if (left_child) {
+      addLeftForwardNodes(bc.getOwnNodePos(), bc.getLastNodePos(), receiver_inlevel);
+    } else {
+      addRightForwardNodes(bc.getOwnNodePos(), bc.getLastNodePos(), receiver_inlevel);
+    }
+    addInnerForwardNodes(bc, receiver_inner);
+  } else {
+    if (bc.ownNumber() < bc.lastNumber()) {
+      // Left forward direction
+      addLeftForwardNodes(bc.getOwnNodePos(), bc.getLastNodePos(), receiver_inlevel);
+    } else {
+      // Right forward direction
+      addRightForwardNodes(bc.getOwnNodePos(), bc.getLastNodePos(), receiver_inlevel);
+    }
+  }
+
+  return {receiver_inlevel, receiver_inner};
+}
+
+void MinhcastForwarding::addInlevel(const BroadcastInfo &bc, bool other_forwarding_down,
+                                    bool send_to_children, ForwardingPlan &plan) const {
+  const auto [receiver_inlevel, receiver_inner] = getInlevel(bc);
+
+  // Calculate down border for
+  auto get_down_border = [&bc = std::as_const(bc), other_forwarding_down,
+                          send_to_children]() -> uint32_t {
+    uint32_t down_border = std::min(bc.forwarding_limit.down(), maxLevelNumber());
+    if (other_forwarding_down || send_to_children) {
+      // Other node is forwarding down to its children, or we are forwarding to our children.
+      // Therefore, our neighbors should not
+      down_border = bc.ownLevel();
+    }
+    return down_border;
+  };
+
+  const uint32_t down_border = get_down_border();
+
+  // Inlevel messages
+  for (auto &peer : receiver_inlevel) {
+    assert(std::get<0>(peer.position) == bc.ownLevel());
+
+    // Only allow our left neighbors to forward down
+    const bool peer_left_of_us = (std::get<1>(peer.position) < bc.ownNumber());
+    const uint32_t down_border_specific = peer_left_of_us ? down_border : bc.ownLevel();
+
+    plan.push_back({peer, bc.ownLevel(), down_border_specific, false});
+  }
+
+  // Inner messages
+  for (const auto &peer : receiver_inner) {
+    plan.push_back({peer, bc.ownLevel(), bc.ownLevel(), true});
+  }
+}
+
+std::tuple<uint32_t, uint32_t> MinhcastForwarding::addAdjacents(const BroadcastInfo &bc,
+                                                                ForwardingPlan &plan) const {
+  const NodeInfo *highest_adjacent = getHigherAdjacent(bc);
+  const NodeInfo *deepest_adjacent = getDeeperAdjacent(bc);
+
+  // For debugging
+  NATTER_CHECK(!(highest_adjacent != nullptr && deepest_adjacent != nullptr),
+               "SENDING TO 2 ADJACENTS!");
+  if (deepest_adjacent != nullptr) {
+    uint32_t deepest_adjacent_level = std::get<0>(deepest_adjacent->position);
+    NATTER_CHECK(deepest_adjacent_level > bc.ownLevel() + 1,
+                 "Deepest adjacent not at least one level below own level");
+  }
+  if (highest_adjacent != nullptr) {
+    uint32_t highest_adjacent_level = std::get<0>(highest_adjacent->position);
+    NATTER_CHECK(highest_adjacent_level < bc.ownLevel() - 1,
+                 "Highest adjacent not at least one level above own level");
+  }
+
+  uint32_t child_down_border = bc.forwarding_limit.down();
+  uint32_t parent_up_border = bc.forwarding_limit.up();
+
+  // If number of level difference is odd, the node on higher levels (more up in tree) should
+  // forward to more than the half of levels
+
+  if (highest_adjacent != nullptr) {
+    NATTER_CHECK(bc.ownLevel() != 0, "Cannot send to higher adjacent if we are root");
+    const uint32_t peer_level = std::get<0>(highest_adjacent->position);
+    const uint32_t parent_level = bc.ownLevel() - 1;
+    const uint32_t level_diff_adj_parent = parent_level - peer_level - 1;
+    const auto level_reached_from_adj =
+        static_cast<uint32_t>(std::ceil(level_diff_adj_parent / 2.0));
+    const uint32_t down_border = level_reached_from_adj + peer_level;
+    const auto level_reached_from_parent =
+        static_cast<uint32_t>(std::floor(level_diff_adj_parent / 2.0));
+    parent_up_border = parent_level - level_reached_from_parent;
+    NATTER_CHECK(parent_up_border - 1 == down_border, "failure in middle calculation");
+    plan.push_back({*highest_adjacent, 0, down_border, false});
+  }
+
+  if (deepest_adjacent != nullptr) {
+    const uint32_t peer_level = std::get<0>(deepest_adjacent->position);
+    const uint32_t child_level = bc.ownLevel() + 1;
+    const uint32_t level_diff_adj_child = peer_level - child_level - 1;
+
+    const auto level_reached_from_adj =
+        static_cast<uint32_t>(std::floor(level_diff_adj_child / 2.0));
+    const uint32_t up_border = peer_level - level_reached_from_adj;
+    const auto level_reached_from_child =
+        static_cast<uint32_t>(std::ceil(level_diff_adj_child / 2.0));
+    child_down_border = child_level + level_reached_from_child;
+    NATTER_CHECK(child_down_border + 1 == up_border, "failure in middle calculation");
+    plan.push_back({*deepest_adjacent, up_border, maxLevelNumber(), false});
+  }
+
+  return {parent_up_border, child_down_border};
+}
+
+const MinhcastForwarding::NodeInfo *MinhcastForwarding::getHigherAdjacent(
+    const BroadcastInfo &bc) const {
+  if (!bc.allowedUpForward() || bc.ownLevel() < 2) return nullptr;
+
+  // More than one level above us and within the forward up limit
+  return peers_.findLeftmostOnHighestLevel(bc.forwarding_limit.up(), bc.ownLevel() - 2);
+}
+
+void MinhcastForwarding::addLeftAndRightmostChildren(LevelNumber node_info,
+                                                     std::vector<NodeInfo> &receiver) const {
+  const auto [level, number, fanout] = node_info;
+  const uint32_t child_level = level + 1;
+
+  for (auto offset : {0U, fanout - 1}) {
+    const uint32_t child_number = number * fanout + offset;
+    const NodeInfo *peer = peers_.find({child_level, child_number, fanout});
+    if (peer == nullptr) return;
+    receiver.emplace_back(*peer);
+  }
+}
+
+template <typename Compare>
+void MinhcastForwarding::addFromRoutingTable(const std::set<LevelNumber> &rt,
+                                             std::vector<NodeInfo> &receiver, uint32_t boundary,
+                                             Compare comp) const {
+  for (const auto &node : rt) {
+    const auto [level, number, _] = node;
+    const NodeInfo *peer = peers_.find(node);
+    if (peer != nullptr && comp(number, boundary)) {
+      receiver.emplace_back(*peer);
+    }
+  }
+}
+
+}  // namespace natter::minhcast
@@ -0,0 +1,142 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef NATTER_MINHCAST_MINHCAST_FORWARDING_H_
+#define NATTER_MINHCAST_MINHCAST_FORWARDING_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "broadcast_info.h"
+#include "natter/minhcast_level_number.h"
+#include "natter/natter_minhcast.h"
+#include "natter/network_info_ipv4.h"
+#include "peer_index.h"
+
+namespace natter::minhcast {
+
+// Receiver of a broadcast message together with the forwarding limits it gets
+struct Forward {
+  MinhcastNodeInfo peer;
+  Level up_limit;
+  Level down_limit;
+  bool inner_forward;
+};
+
+// Receivers in the order the message is sent to them
+using ForwardingPlan = std::vector<Forward>;
+
+/**
+ * Calculates the receivers of a Minhcast broadcast from the known peers of one topic.
+ *
+ * The receivers only depend on the own and last position, the forwarding limit and whether we
+ * are the initial sender, but not on the message itself. Plans are therefore cached by these
+ * values and reused for all following messages until the known peers change.
+ */
+class MinhcastForwarding {
+public:
+  using NodeInfo = MinhcastNodeInfo;
+
+  // Returns false if a peer with the same position is already known
+  bool addPeer(const NodeInfo &info);
+
+  // Returns false if no peer with the network info is known
+  bool removePeer(const NetworkInfoIPv4 &network);
+
+  const PeerIndex &getPeers() const { return peers_; }
+
+  // Returns the (cached) receivers of the broadcast
+  const ForwardingPlan &getForwards(const BroadcastInfo &bc);
+
+  // Calculates the receivers of the broadcast without using the cache
+  ForwardingPlan calculateForwards(const BroadcastInfo &bc) const;
+
+  std::size_t getCachedPlanCount() const { return plans_.size(); }
+
+private:
+  /**
+   * Add children if required
+   * @return (true if other node needs to forward down instead of us), (true if we sent to our
+   * children)
+   */
+  std::tuple<bool, bool> addChildren(const BroadcastInfo &bc, Level child_down_border,
+                                     ForwardingPlan &plan) const;
+
+  // Helper methods to add the receivers in each direction
+  void addInlevel(const BroadcastInfo &bc, bool other_forwarding_down, bool send_to_children,
+                  ForwardingPlan &plan) const;
+  void addParent(const BroadcastInfo &bc, Level parent_up_border, ForwardingPlan &plan) const;
+  std::tuple<uint32_t, uint32_t> addAdjacents(const BroadcastInfo &bc, ForwardingPlan &plan) const;
+
+  // Return nodes for inlevel forward for given broadcast info
+  std::tuple<std::vector<NodeInfo>, std::vector<NodeInfo>> getInlevel(
+      const BroadcastInfo &bc) const;
+
+  /**
+   * Add left/rightmost children to receiver if this node is the most centered one of
+   * the previous two children received a message on the current level.
+   * @return true if the other child node is forwarding down
+   */
+  bool centeredNodeAddChildren(const BroadcastInfo &bc, std::vector<NodeInfo> &receiver) const;
+
+  /**
+   * Add left/rightmost children to receiver if this node is the most centered one of
+   * the previous two children received a message on the current level.
+   * @return true if the other child node is forwarding down
+   */
+  bool imperfectTreeAddChildren(const BroadcastInfo &bc, std::vector<NodeInfo> &receiver) const;
+
+  // Calculate intersection between lastNode LRT and ownNode RRT
+  static std::vector<LevelNumber> calculateRRTIntersection(const BroadcastInfo &bc);
+
+  // Get leftmost adjacent on deepest level and within BroadcastInfos forwarding limits
+  const NodeInfo *getDeeperAdjacent(const BroadcastInfo &bc) const;
+
+  // Get leftmost adjacent on highest level and within BroadcastInfos forwarding limits
+  const NodeInfo *getHigherAdjacent(const BroadcastInfo &bc) const;
+
+  // Check if node has children
+  bool hasChildren(LevelNumber node) const;
+
+  // Add all nodes from LRT and RRT of own_node to receiver
+  void addRoutingTableToReceiver(LevelNumber own_node, std::vector<NodeInfo> &receiver) const;
+  void addLRT(LevelNumber own_node, std::vector<NodeInfo> &receiver) const;
+  void addRRT(LevelNumber own_node, std::vector<NodeInfo> &receiver) const;
+
+  // Add all nodes in given direction to receiver which are in the remaining interval of nodes
+  // next to us which haven't received the message yet and are known by us
+  void addLeftForwardNodes(LevelNumber own_node, LevelNumber last_node,
+                           std::vector<NodeInfo> &receiver) const;
+  void addRightForwardNodes(LevelNumber own_node, LevelNumber last_node,
+                            std::vector<NodeInfo> &receiver) const;
+
+  // Add inner nodes (of two outer children with m > 2) to receiver
+  void addInnerForwardNodes(const BroadcastInfo &bc, std::vector<NodeInfo> &receiver) const;
+
+  void addLeftAndRightmostChildren(LevelNumber node_info, std::vector<NodeInfo> &receiver) const;
+
+  // Helper function to add nodes in given interval by passing a comparison function object
+  template <typename Compare>
+  void addFromRoutingTable(const std::set<LevelNumber> &rt, std::vector<NodeInfo> &receiver,
+                           uint32_t boundary, Compare comp) const;
+
+  // Own position, last position, forwarding limit (up, down), initial sender
+  using PlanKey = std::tuple<LevelNumber, LevelNumber, Level, Level, bool>;
+
+  // Upper bound of cached plans. The number of distinct keys is small in practice, as only few
+  // peers send to us, but forwarding limits are chosen by the sender.
+  static constexpr std::size_t kMaxCachedPlans = 4096;
+
+  PeerIndex peers_;
+  std::map<PlanKey, ForwardingPlan> plans_;
+};
+
+}  // namespace natter::minhcast
+
+#endif  // NATTER_MINHCAST_MINHCAST_FORWARDING_H_
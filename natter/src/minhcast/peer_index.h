@@ -0,0 +1,94 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef NATTER_MINHCAST_PEER_INDEX_H_
+#define NATTER_MINHCAST_PEER_INDEX_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "natter/minhcast_level_number.h"
+#include "natter/natter_minhcast.h"
+#include "natter/network_info_ipv4.h"
+
+namespace natter::minhcast {
+
+/**
+ * Known peers of a topic, stored in a flat vector sorted by position (level, number, fanout).
+ * Lookups are binary searches, and the peers on a level are stored contiguously from left to right.
+ */
+class PeerIndex {
+public:
+  using NodeInfo = MinhcastNodeInfo;
+  using const_iterator = std::vector<NodeInfo>::const_iterator;
+
+  /// Inserts the peer. Returns false if a peer with the same position is already known.
+  bool insert(const NodeInfo &info) {
+    auto it = lowerBound(info.position);
+    if (it != peers_.end() && it->position == info.position) return false;
+    peers_.insert(it, info);
+    return true;
+  }
+
+  /// Removes the peer with the given network info. Returns false if no such peer is known.
+  bool erase(const NetworkInfoIPv4 &network) {
+    auto it = std::find_if(peers_.begin(), peers_.end(), [&network](const NodeInfo &info) {
+      return info.network_info == network;
+    });
+    if (it == peers_.end()) return false;
+    peers_.erase(it);
+    return true;
+  }
+
+  /// Returns the peer at the position or nullptr if it is not known
+  const NodeInfo *find(const LevelNumber &position) const {
+    auto it = lowerBound(position);
+    if (it == peers_.end() || it->position != position) return nullptr;
+    return &*it;
+  }
+
+  bool contains(const LevelNumber &position) const { return find(position) != nullptr; }
+
+  /// Returns the leftmost peer on the deepest level within [min_level, max_level]
+  const NodeInfo *findLeftmostOnDeepestLevel(Level min_level, Level max_level) const {
+    if (min_level > max_level) return nullptr;
+
+    auto it = std::upper_bound(
+        peers_.begin(), peers_.end(), max_level,
+        [](Level level, const NodeInfo &info) { return level < std::get<0>(info.position); });
+    if (it == peers_.begin()) return nullptr;
+
+    const Level deepest_level = std::get<0>((--it)->position);
+    if (deepest_level < min_level) return nullptr;
+    return &*lowerBound({deepest_level, 0, 0});
+  }
+
+  /// Returns the leftmost peer on the highest level within [min_level, max_level]
+  const NodeInfo *findLeftmostOnHighestLevel(Level min_level, Level max_level) const {
+    if (min_level > max_level) return nullptr;
+
+    auto it = lowerBound({min_level, 0, 0});
+    if (it == peers_.end() || std::get<0>(it->position) > max_level) return nullptr;
+    return &*it;
+  }
+
+  const_iterator begin() const { return peers_.begin(); }
+  const_iterator end() const { return peers_.end(); }
+  std::size_t size() const { return peers_.size(); }
+
+private:
+  const_iterator lowerBound(const LevelNumber &position) const {
+    return std::lower_bound(
+        peers_.begin(), peers_.end(), position,
+        [](const NodeInfo &info, const LevelNumber &other) { return info.position < other; });
+  }
+
+  std::vector<NodeInfo> peers_;
+};
+
+}  // namespace natter::minhcast
+
+#endif  // NATTER_MINHCAST_PEER_INDEX_H_
@@ -0,0 +1,133 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "minhcast/minhcast_forwarding.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "solanet/uuid_generator.h"
+
+using namespace natter::minhcast;
+
+static MinhcastNodeInfo createPeer(LevelNumber position, uint16_t port) {
+  return {position, {"127.0.0.1", port}, solanet::generateUUID()};
+}
+
+static bool samePlan(const ForwardingPlan &lhs, const ForwardingPlan &rhs) {
+  if (lhs.size() != rhs.size()) return false;
+  for (std::size_t i = 0; i < lhs.size(); i++) {
+    if (lhs[i].peer.position != rhs[i].peer.position || lhs[i].up_limit != rhs[i].up_limit ||
+        lhs[i].down_limit != rhs[i].down_limit || lhs[i].inner_forward != rhs[i].inner_forward) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST_CASE("[MINHCAST] PeerIndex", "MINHCAST") {
+  PeerIndex index;
+  REQUIRE(index.insert(createPeer({2, 1, 2}, 1)));
+  REQUIRE(index.insert(createPeer({0, 0, 2}, 2)));
+  REQUIRE(index.insert(createPeer({3, 5, 2}, 3)));
+  REQUIRE(index.insert(createPeer({2, 0, 2}, 4)));
+  REQUIRE(index.insert(createPeer({3, 2, 2}, 5)));
+  REQUIRE_FALSE(index.insert(createPeer({2, 1, 2}, 6)));
+  REQUIRE(index.size() == 5);
+
+  REQUIRE(index.contains({2, 0, 2}));
+  REQUIRE_FALSE(index.contains({1, 0, 2}));
+  REQUIRE(index.find({3, 5, 2})->network_info.port == 3);
+
+  // Leftmost peer on the deepest/highest level within the given levels
+  REQUIRE(index.findLeftmostOnDeepestLevel(2, 3)->position == LevelNumber{3, 2, 2});
+  REQUIRE(index.findLeftmostOnDeepestLevel(1, 2)->position == LevelNumber{2, 0, 2});
+  REQUIRE(index.findLeftmostOnDeepestLevel(4, 10) == nullptr);
+  REQUIRE(index.findLeftmostOnHighestLevel(1, 3)->position == LevelNumber{2, 0, 2});
+  REQUIRE(index.findLeftmostOnHighestLevel(0, 3)->position == LevelNumber{0, 0, 2});
+  REQUIRE(index.findLeftmostOnHighestLevel(1, 1) == nullptr);
+
+  REQUIRE(index.erase({"127.0.0.1", 4}));
+  REQUIRE_FALSE(index.erase({"127.0.0.1", 4}));
+  REQUIRE(index.findLeftmostOnHighestLevel(1, 3)->position == LevelNumber{2, 1, 2});
+}
+
+TEST_CASE("[MINHCAST] MinhcastForwarding InitialSender", "MINHCAST") {
+  // Perfect tree with fanout 2 and 7 nodes, seen from the root: children and adjacents
+  MinhcastForwarding forwarding;
+  REQUIRE(forwarding.addPeer(createPeer({1, 0, 2}, 1)));
+  REQUIRE(forwarding.addPeer(createPeer({1, 1, 2}, 2)));
+  REQUIRE(forwarding.addPeer(createPeer({2, 1, 2}, 3)));
+  REQUIRE(forwarding.addPeer(createPeer({2, 2, 2}, 4)));
+  REQUIRE_FALSE(forwarding.addPeer(createPeer({2, 2, 2}, 4)));
+
+  const solanet::UUID uuid = solanet::generateUUID();
+  BroadcastInfo bc{{uuid, {0, 0, 2}}, {uuid, {0, 0, 2}}, {uuid, {0, 0, 2}}, {}, "topic",
+                   solanet::generateUUID(), "", 1};
+
+  const ForwardingPlan plan = forwarding.calculateForwards(bc);
+
+  // Leftmost deeper adjacent covers level 2, the children only their own level
+  REQUIRE(plan.size() == 3);
+  REQUIRE(plan[0].peer.position == LevelNumber{2, 1, 2});
+  REQUIRE(plan[0].up_limit == 2);
+  REQUIRE(plan[1].peer.position == LevelNumber{1, 0, 2});
+  REQUIRE(plan[2].peer.position == LevelNumber{1, 1, 2});
+  REQUIRE(plan[1].up_limit == 1);
+  REQUIRE(plan[1].down_limit == 1);
+  REQUIRE_FALSE(plan[1].inner_forward);
+}
+
+TEST_CASE("[MINHCAST] MinhcastForwarding Cache", "MINHCAST") {
+  MinhcastForwarding forwarding;
+  forwarding.addPeer(createPeer({0, 0, 3}, 1));
+  forwarding.addPeer(createPeer({1, 0, 3}, 2));
+  forwarding.addPeer(createPeer({1, 2, 3}, 3));
+  forwarding.addPeer(createPeer({2, 3, 3}, 4));
+
+  // Center child of the root, which received the message from the left child
+  BroadcastInfo bc{{solanet::generateUUID(), {1, 1, 3}},
+                   {solanet::generateUUID(), {1, 0, 3}},
+                   {solanet::generateUUID(), {0, 0, 3}},
+                   {},
+                   "topic",
+                   solanet::generateUUID(),
+                   "",
+                   2};
+  REQUIRE(forwarding.getCachedPlanCount() == 0);
+
+  const ForwardingPlan &cached = forwarding.getForwards(bc);
+  REQUIRE(samePlan(cached, forwarding.calculateForwards(bc)));
+  REQUIRE(forwarding.getCachedPlanCount() == 1);
+
+  // Same positions and forwarding limit, but another message
+  BroadcastInfo other_message{bc.own_node,
+                              bc.last_node,
+                              bc.initial_node,
+                              bc.forwarding_limit,
+                              "topic",
+                              solanet::generateUUID(),
+                              "other",
+                              bc.current_round + 1};
+  REQUIRE(&forwarding.getForwards(other_message) == &cached);
+  REQUIRE(forwarding.getCachedPlanCount() == 1);
+
+  // Another forwarding limit results in another plan
+  BroadcastInfo limited{
+      bc.own_node, bc.last_node, bc.initial_node, {1, 1}, "topic", bc.msg_id, "", 2};
+  forwarding.getForwards(limited);
+  REQUIRE(forwarding.getCachedPlanCount() == 2);
+
+  // Changing the peers invalidates all plans
+  REQUIRE(forwarding.addPeer(createPeer({2, 5, 3}, 5)));
+  REQUIRE(forwarding.getCachedPlanCount() == 0);
+  REQUIRE(samePlan(forwarding.getForwards(bc), forwarding.calculateForwards(bc)));
+
+  forwarding.getForwards(limited);
+  REQUIRE(forwarding.getCachedPlanCount() == 2);
+  REQUIRE(forwarding.removePeer({"127.0.0.1", 5}));
+  REQUIRE(forwarding.getCachedPlanCount() == 0);
+  REQUIRE_FALSE(forwarding.removePeer({"127.0.0.1", 5}));
+}
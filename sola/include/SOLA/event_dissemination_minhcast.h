@@ -38,6 +38,18 @@ struct EventDisseminationMinhcastConfig {
   /// Function that is called to instantiate a MINHTON logger for a topic tree.
   /// The topic name is passed into this function.
   std::function<minhton::Logger::LoggerPtr(std::string)> topic_tree_logger_create_fct;
+
+  /// Event loop shared by natter and all topic trees, which otherwise run network threads of their
+  /// own. Can be shared with the storage as well, see minhton::ConfigNode::setNetworkOptions.
+  std::shared_ptr<solanet::NetworkContext> network_context;
+
+  /// Whether the topic trees share one UDP socket of the network context, with a channel per topic
+  bool multiplex_topic_trees = false;
+
+  /// Channels of topics on the multiplexed socket, which have to be the same in every process.
+  /// Other topics use a hash of their name. Subscribing to a topic whose channel is already used
+  /// by another topic throws, which can be resolved by assigning a channel here.
+  std::unordered_map<std::string, uint32_t> topic_channels;
 };
 
 class EventDisseminationMinhcast final : public EventDissemination {
@@ -64,6 +76,8 @@ private:
   void getResult(const std::string &topic, const std::function<void()> &on_result);
   void checkTopicJoin(const std::string &topic, bool should_exist);
 
+  uint32_t getTopicChannel(const std::string &topic) const;
+
   const Config config_;
 
   std::unique_ptr<natter::minhcast::NatterMinhcast> minhcast_;
@@ -82,6 +96,7 @@ private:
   std::vector<MinhtonTopicLogger> minhton_loggers_;
 
   std::unordered_map<Topic, Minhton> topic_trees_;
+  std::unordered_map<uint32_t, Topic> channel_topics_;  // Only with multiplexed topic trees
   std::unordered_map<Info, uint32_t> peers_added_natter_;
   std::shared_ptr<Storage> storage_;
 
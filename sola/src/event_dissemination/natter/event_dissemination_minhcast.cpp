@@ -8,6 +8,8 @@
 
 #include <algorithm>
 #include <map>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 
 #include "solanet/serializer/serializer.h"
@@ -18,6 +20,28 @@ namespace sola {
 // TODO See #89
 static constexpr uint16_t kNatterPort = 2001;
 
+// Default channel of a topic tree on a multiplexed socket
+static uint32_t hashTopic(const std::string &topic) {
+  // 32 bit FNV-1a
+  uint32_t hash = 2166136261U;
+  for (char c : topic) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+uint32_t EventDisseminationMinhcast::getTopicChannel(const std::string &topic) const {
+  auto it = config_.topic_channels.find(topic);
+  return it != config_.topic_channels.end() ? it->second : hashTopic(topic);
+}
+
+static solanet::NetworkOptions getNetworkOptions(const EventDisseminationMinhcastConfig &config) {
+  solanet::NetworkOptions options;
+  options.context = config.network_context;
+  return options;
+}
+
 EventDisseminationMinhcast::EventDisseminationMinhcast(TopicMessageReceiveFct msgRecvFct,
                                                        std::shared_ptr<Storage> storage,
                                                        const Config &config, LoggerPtr logger)
@@ -26,7 +50,8 @@ EventDisseminationMinhcast::EventDisseminationMinhcast(TopicMessageReceiveFct ms
           [msgRecvFct](const natter::Message &m) {
             msgRecvFct(solanet::serializer::deserialize<sola::TopicMessage>(m.content));
           },
-          [](const std::string & /*unused*/) { /* not passed to user */ }, config.logger)),
+          [](const std::string & /*unused*/) { /* not passed to user */ }, config.logger,
+          getNetworkOptions(config))),
       storage_(std::move(storage)),
       logger_(std::move(logger)) {}
 
@@ -56,6 +81,15 @@ void EventDisseminationMinhcast::subscribe(const std::string &topic) {
     throw std::runtime_error("joining topic already in progress");
   }
 
+  if (config_.network_context && config_.multiplex_topic_trees) {
+    const auto [it, inserted] = channel_topics_.emplace(getTopicChannel(topic), topic);
+    if (!inserted) {
+      throw std::invalid_argument("Topics " + it->second + " and " + topic +
+                                  " share the channel " + std::to_string(it->first) +
+                                  ", assign another one in the config");
+    }
+  }
+
   sola::Request req;
   req.all = false;
   req.permissive = true;
@@ -163,6 +197,12 @@ void EventDisseminationMinhcast::joinMinhton(
   config.setFanout(2);
   config.setOwnIP(minhcast_->getNetworkInfo().ip);
 
+  solanet::NetworkOptions network_options = getNetworkOptions(config_);
+  if (config_.network_context && config_.multiplex_topic_trees) {
+    network_options.channel = getTopicChannel(topic);  // Reserved in subscribe()
+  }
+  config.setNetworkOptions(network_options);
+
   std::string connection_string;
 
   if (!result.empty()) {
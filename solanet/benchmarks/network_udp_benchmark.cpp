@@ -0,0 +1,120 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "solanet/network_udp/message.h"
+#include "solanet/network_udp/network_udp.h"
+
+/**
+ * Loopback throughput/latency benchmark comparing the default I/O path with batched I/O.
+ * Each payload carries its send timestamp, so latency is measured from send() until the receive
+ * callback is called.
+ */
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+  uint64_t sent = 0;
+  uint64_t received = 0;
+  double seconds = 0;
+  double mean_latency_us = 0;
+  double p99_latency_us = 0;
+};
+
+Result run(const solanet::NetworkOptions &options, uint64_t message_count,
+           std::size_t payload_size) {
+  std::mutex mutex;
+  std::vector<int64_t> latencies_ns;
+  latencies_ns.reserve(message_count);
+  std::atomic<uint64_t> received = 0;
+
+  solanet::Network receiver(
+      "127.0.0.1",
+      [&](const solanet::Message &msg) {
+        int64_t send_time = 0;
+        std::memcpy(&send_time, msg.getMessage().data(), sizeof(send_time));
+        int64_t now = Clock::now().time_since_epoch().count();
+        {
+          std::scoped_lock lock(mutex);
+          latencies_ns.push_back(now - send_time);
+        }
+        received++;
+      },
+      options);
+  solanet::Network sender("127.0.0.1", [](const solanet::Message &) {}, options);
+
+  std::string payload(std::max(payload_size, sizeof(int64_t)), 'x');
+
+  auto start = Clock::now();
+  for (uint64_t i = 0; i < message_count; i++) {
+    int64_t send_time = Clock::now().time_since_epoch().count();
+    std::memcpy(payload.data(), &send_time, sizeof(send_time));
+    sender.send({"127.0.0.1", receiver.getPort(), payload});
+  }
+
+  // Wait until everything arrived or nothing arrived for some time (UDP may drop)
+  uint64_t last_received = 0;
+  auto last_progress = Clock::now();
+  while (received < message_count && Clock::now() - last_progress < 1s) {
+    std::this_thread::sleep_for(1ms);
+    if (received != last_received) {
+      last_received = received;
+      last_progress = Clock::now();
+    }
+  }
+  auto end = last_progress;
+
+  Result result;
+  result.sent = message_count;
+  result.received = received;
+  result.seconds = std::chrono::duration<double>(end - start).count();
+
+  std::scoped_lock lock(mutex);
+  if (!latencies_ns.empty()) {
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    double sum = 0;
+    for (auto latency : latencies_ns) sum += latency;
+    result.mean_latency_us = sum / latencies_ns.size() / 1000.0;
+    result.p99_latency_us = latencies_ns[latencies_ns.size() * 99 / 100] / 1000.0;
+  }
+  return result;
+}
+
+void print(const std::string &mode, std::size_t payload_size, const Result &result) {
+  std::cout << std::left << std::setw(10) << mode << std::right << std::setw(8) << payload_size
+            << std::setw(10) << result.sent << std::setw(10) << result.received << std::setw(14)
+            << std::fixed << std::setprecision(0) << result.received / result.seconds
+            << std::setw(14) << std::setprecision(1) << result.mean_latency_us << std::setw(14)
+            << result.p99_latency_us << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  uint64_t message_count = argc > 1 ? std::stoull(argv[1]) : 100000;
+
+  std::cout << std::left << std::setw(10) << "mode" << std::right << std::setw(8) << "bytes"
+            << std::setw(10) << "sent" << std::setw(10) << "received" << std::setw(14) << "msg/s"
+            << std::setw(14) << "mean [us]" << std::setw(14) << "p99 [us]" << std::endl;
+
+  for (std::size_t payload_size : {64, 512, 4096}) {
+    solanet::NetworkOptions default_io;
+    print("default", payload_size, run(default_io, message_count, payload_size));
+
+    solanet::NetworkOptions batched_io;
+    batched_io.batched_io = true;
+    print("batched", payload_size, run(batched_io, message_count, payload_size));
+  }
+}
@@ -0,0 +1,68 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "queue.h"
+#include "ring_buffer.h"
+#include "solanet/network_udp/message.h"
+
+/**
+ * Microbenchmark of the mutex-based Queue against the lock-free RingBuffer with 1-16 producer
+ * threads and a single consumer, as in the network threads.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+template <typename QueueType>
+double run(QueueType &queue, uint32_t producer_count, uint64_t messages_per_producer) {
+  const solanet::Message message("127.0.0.1", 2000, std::string(128, 'x'));
+
+  auto start = Clock::now();
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < producer_count; p++) {
+    producers.emplace_back([&queue, &message, messages_per_producer] {
+      for (uint64_t i = 0; i < messages_per_producer; i++) {
+        queue.push(message);
+      }
+    });
+  }
+
+  for (uint64_t i = 0; i < producer_count * messages_per_producer; i++) {
+    solanet::Message received = queue.pop();
+  }
+
+  auto end = Clock::now();
+  for (auto &producer : producers) producer.join();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  return static_cast<double>(producer_count * messages_per_producer) / seconds;
+}
+
+int main(int argc, char *argv[]) {
+  uint64_t messages_per_producer = argc > 1 ? std::stoull(argv[1]) : 200000;
+
+  std::cout << std::setw(10) << "producers" << std::setw(16) << "Queue [msg/s]" << std::setw(20)
+            << "RingBuffer [msg/s]" << std::setw(14) << "high-water" << std::endl;
+
+  for (uint32_t producer_count : {1, 2, 4, 8, 16}) {
+    solanet::Queue<solanet::Message> queue;
+    double queue_rate = run(queue, producer_count, messages_per_producer);
+
+    solanet::RingBuffer<solanet::Message> ring_buffer;
+    double ring_buffer_rate = run(ring_buffer, producer_count, messages_per_producer);
+
+    std::cout << std::setw(10) << producer_count << std::fixed << std::setprecision(0)
+              << std::setw(16) << queue_rate << std::setw(20) << ring_buffer_rate << std::setw(14)
+              << ring_buffer.getHighWaterMark() << std::endl;
+  }
+}
@@ -0,0 +1,164 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "solanet/network_udp/network_context.h"
+#include "solanet/network_udp/network_udp.h"
+
+/**
+ * Many overlays in one process, like a SOLA instance subscribed to many topics with one MINHTON
+ * tree per topic. Two such instances are simulated in this process, each with one network
+ * interface per topic, and every topic exchanges pings between both instances.
+ * Compares network interfaces with threads of their own, on a shared NetworkContext with a socket
+ * per topic, and on a shared NetworkContext with one multiplexed socket per instance.
+ * Reports the threads and the resident memory of the process, and the round trip latency.
+ * Each mode runs in its own process, so that the numbers are not influenced by the other modes.
+ */
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+enum class Mode { kDedicated, kShared, kMultiplexed };
+
+// Reads a value of /proc/self/status, e.g. the number of threads or the resident memory in kB
+uint64_t readStatus(const std::string &key) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind(key + ":", 0) == 0) return std::stoull(line.substr(key.size() + 1));
+  }
+  return 0;
+}
+
+void run(Mode mode, uint32_t topic_count, uint32_t round_count, uint32_t thread_count) {
+  const uint64_t base_rss_kb = readStatus("VmRSS");
+
+  solanet::NetworkOptions options_a, options_b;
+  if (mode != Mode::kDedicated) {
+    options_a.context = std::make_shared<solanet::NetworkContext>(thread_count);
+    options_b.context = std::make_shared<solanet::NetworkContext>(thread_count);
+  }
+
+  std::mutex mutex;
+  std::condition_variable round_done;
+  uint32_t answered = 0;
+  std::vector<int64_t> latencies_ns;
+  latencies_ns.reserve(static_cast<std::size_t>(topic_count) * round_count);
+
+  // Instance a sends pings, instance b answers them with the same payload
+  std::vector<std::unique_ptr<solanet::Network>> instance_a, instance_b;
+  for (uint32_t topic = 0; topic < topic_count; topic++) {
+    if (mode == Mode::kMultiplexed) {
+      options_a.channel = topic;
+      options_b.channel = topic;
+    }
+
+    instance_a.push_back(std::make_unique<solanet::Network>(
+        "127.0.0.1",
+        [&](const solanet::Message &msg) {
+          int64_t send_time = 0;
+          std::memcpy(&send_time, msg.getMessage().data(), sizeof(send_time));
+          int64_t now = Clock::now().time_since_epoch().count();
+
+          std::scoped_lock lock(mutex);
+          latencies_ns.push_back(now - send_time);
+          if (++answered == topic_count) round_done.notify_one();
+        },
+        options_a));
+
+    instance_b.push_back(std::make_unique<solanet::Network>(
+        "127.0.0.1",
+        [&instance_a, &instance_b, topic](const solanet::Message &msg) {
+          // Answering to the listening port, the sending port can differ
+          instance_b[topic]->send({msg.getIp(), instance_a[topic]->getPort(), msg.getMessage()});
+        },
+        options_b));
+  }
+
+  const uint64_t threads = readStatus("Threads");
+  const uint64_t rss_kb = readStatus("VmRSS") - base_rss_kb;
+
+  uint32_t lost_rounds = 0;
+  std::string payload(64, 'x');
+  for (uint32_t round = 0; round < round_count; round++) {
+    {
+      std::scoped_lock lock(mutex);
+      answered = 0;
+    }
+    for (uint32_t topic = 0; topic < topic_count; topic++) {
+      int64_t send_time = Clock::now().time_since_epoch().count();
+      std::memcpy(payload.data(), &send_time, sizeof(send_time));
+      instance_a[topic]->send({"127.0.0.1", instance_b[topic]->getPort(), payload});
+    }
+
+    // UDP may drop, so a round ends after some time without all answers
+    std::unique_lock lock(mutex);
+    if (!round_done.wait_for(lock, 1s, [&]() { return answered == topic_count; })) {
+      lost_rounds++;
+    }
+  }
+
+  // Answers of a lost round can arrive during the destruction, which takes the lock
+  instance_a.clear();
+  instance_b.clear();
+
+  std::sort(latencies_ns.begin(), latencies_ns.end());
+  double mean_us = 0;
+  double p99_us = 0;
+  if (!latencies_ns.empty()) {
+    for (auto latency : latencies_ns) mean_us += latency;
+    mean_us /= latencies_ns.size() * 1000.0;
+    p99_us = latencies_ns[latencies_ns.size() * 99 / 100] / 1000.0;
+  }
+
+  const char *name = mode == Mode::kDedicated ? "dedicated"
+                     : mode == Mode::kShared  ? "shared"
+                                              : "multiplexed";
+  std::cout << std::left << std::setw(12) << name << std::right << std::setw(9) << threads
+            << std::setw(12) << rss_kb / 1024.0 << std::setw(13) << mean_us << std::setw(13)
+            << p99_us << std::setw(13) << lost_rounds << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const uint32_t topic_count = argc > 1 ? std::stoul(argv[1]) : 500;
+  const uint32_t round_count = argc > 2 ? std::stoul(argv[2]) : 20;
+  const uint32_t thread_count = argc > 3 ? std::stoul(argv[3]) : 2;
+
+  std::cout << topic_count << " topics, two instances in one process, " << thread_count
+            << " I/O threads per shared context" << std::endl
+            << std::left << std::setw(12) << "mode" << std::right << std::setw(9) << "threads"
+            << std::setw(12) << "RSS [MiB]" << std::setw(13) << "mean [us]" << std::setw(13)
+            << "p99 [us]" << std::setw(13) << "lost rounds" << std::endl
+            << std::fixed << std::setprecision(1);
+
+  for (Mode mode : {Mode::kDedicated, Mode::kShared, Mode::kMultiplexed}) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      run(mode, topic_count, round_count, thread_count);
+      return 0;
+    }
+    waitpid(pid, nullptr, 0);
+  }
+}
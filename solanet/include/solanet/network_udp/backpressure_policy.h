@@ -0,0 +1,23 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef SOLANET_NETWORK_UDP_BACKPRESSURE_POLICY_H_
+#define SOLANET_NETWORK_UDP_BACKPRESSURE_POLICY_H_
+
+#include <cstdint>
+
+namespace solanet {
+/**
+ * Behavior of a bounded queue if an element is pushed while the queue is full
+ */
+enum class BackpressurePolicy : uint8_t {
+  kBlock,       ///< Block the producer until space is available
+  kDropOldest,  ///< Discard the oldest element in the queue to make space
+  kFail         ///< Reject the new element
+};
+}  // namespace solanet
+
+#endif  // SOLANET_NETWORK_UDP_BACKPRESSURE_POLICY_H_
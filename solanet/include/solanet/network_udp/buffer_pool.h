@@ -0,0 +1,63 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef SOLANET_NETWORK_UDP_BUFFER_POOL_H_
+#define SOLANET_NETWORK_UDP_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace solanet {
+/**
+ * Thread-safe pool of message buffers. Serialized messages are written into acquired buffers,
+ * moved into a Message and returned to the pool by the network after sending/receiving, so that
+ * buffers keep their capacity and messages do not allocate in steady state.
+ */
+class BufferPool {
+public:
+  /**
+   * Process-wide pool shared by all network instances
+   */
+  static BufferPool &global() {
+    static BufferPool pool;
+    return pool;
+  }
+
+  /**
+   * Take an empty buffer from the pool, or a new one if the pool is empty
+   */
+  std::string acquire() {
+    std::scoped_lock lock(mutex_);
+    if (buffers_.empty()) return {};
+
+    std::string buffer = std::move(buffers_.back());
+    buffers_.pop_back();
+    return buffer;
+  }
+
+  /**
+   * Return buffer to the pool. Buffers are dropped if the pool is full or they are too large.
+   */
+  void release(std::string &&buffer) {
+    if (buffer.capacity() == 0 || buffer.capacity() > kMaxBufferCapacity) return;
+
+    buffer.clear();
+    std::scoped_lock lock(mutex_);
+    if (buffers_.size() < kMaxPooledBuffers) buffers_.push_back(std::move(buffer));
+  }
+
+private:
+  static constexpr std::size_t kMaxPooledBuffers = 1024;
+  static constexpr std::size_t kMaxBufferCapacity = 65536;
+
+  std::mutex mutex_;
+  std::vector<std::string> buffers_;
+};
+}  // namespace solanet
+
+#endif  // SOLANET_NETWORK_UDP_BUFFER_POOL_H_
@@ -34,13 +34,19 @@ public:
    * Returns message content
    * @return message content
    */
-  std::string getMessage() const { return message_; }
+  const std::string &getMessage() const { return message_; }
+
+  /**
+   * Moves the message content out, leaving the message empty
+   * @return message content
+   */
+  std::string takeMessage() { return std::move(message_); }
 
   /**
    * Returns IPv4 destination address
    * @return IPv4 destination address
    */
-  std::string getIp() const { return ip_; }
+  const std::string &getIp() const { return ip_; }
 
   /**
    * Returns UDP destination port
@@ -0,0 +1,68 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef SOLANET_NETWORK_UDP_NETWORK_CONTEXT_H_
+#define SOLANET_NETWORK_UDP_NETWORK_CONTEXT_H_
+
+#include <cstdint>
+#include <memory>
+
+namespace solanet {
+
+/**
+ * Event loop with a small pool of I/O threads, which is shared by many network interfaces of one
+ * process (see NetworkOptions::context). Without a context, every network interface runs three
+ * threads of its own.
+ *
+ * Network interfaces on a shared context receive and send on the I/O threads. The callbacks of
+ * one network interface never run concurrently, but callbacks of different interfaces may.
+ * A callback must not destroy its own network interface.
+ *
+ * Network interfaces with a channel (see NetworkOptions::channel) additionally share one UDP
+ * socket per IP. Each datagram carries a small header with the channel, by which received
+ * datagrams are passed to the network interface of the channel. Therefore all network interfaces
+ * of one logical overlay have to use the same channel, and only one interface per channel can be
+ * bound to an IP.
+ *
+ * The context has to outlive its network interfaces, which is ensured by the network interfaces
+ * sharing ownership. It must not be destroyed on one of its own threads.
+ *
+ * Typical usage:
+ * \code
+ *     solanet::NetworkOptions options;
+ *     options.context = std::make_shared<solanet::NetworkContext>(2);
+ *     options.channel = 1;
+ *     solanet::Network network("127.0.0.1", [](const solanet::Message &msg) { ... }, options);
+ * \endcode
+ */
+class NetworkContext {
+public:
+  /**
+   * Starts the I/O threads
+   * @param thread_count number of I/O threads, at least one
+   */
+  explicit NetworkContext(uint32_t thread_count = 1);
+
+  ~NetworkContext();
+
+  // Forbid copy/move operations
+  NetworkContext(const NetworkContext &) = delete;
+  NetworkContext &operator=(const NetworkContext &) = delete;
+  NetworkContext(NetworkContext &&) = delete;
+  NetworkContext &operator=(NetworkContext &&) = delete;
+
+  uint32_t getThreadCount() const;
+
+  class Impl;
+
+private:
+  friend class Network;
+  std::unique_ptr<Impl> pimpl_;
+};
+
+}  // namespace solanet
+
+#endif  // SOLANET_NETWORK_UDP_NETWORK_CONTEXT_H_
@@ -7,14 +7,49 @@
 #ifndef SOLANET_NETWORK_UDP_NETWORK_H_
 #define SOLANET_NETWORK_UDP_NETWORK_H_
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "backpressure_policy.h"
 #include "message.h"
 
 namespace solanet {
+class NetworkContext;
+
+/**
+ * Options to tune the I/O path of the network interface
+ */
+struct NetworkOptions {
+  /// Receive and send multiple datagrams per syscall (recvmmsg/sendmmsg) into pooled buffers
+  bool batched_io = false;
+
+  /// Maximum number of datagrams handled per batch if batched_io is enabled
+  uint32_t batch_size = 32;
+
+  /// Capacity of the lock-free sending and receiving queues (rounded up to a power of two)
+  uint32_t queue_capacity = 8192;
+
+  /// Behavior if the sending or receiving queue is full
+  BackpressurePolicy backpressure_policy = BackpressurePolicy::kBlock;
+
+  /// Maximum time a full queue blocks with BackpressurePolicy::kBlock, blocks without a limit by
+  /// default. With a limit, the message is dropped afterwards as a datagram lost on the way, so
+  /// that a stalled receiver or socket cannot hang the application.
+  std::chrono::milliseconds max_block_time = std::chrono::milliseconds::max();
+
+  /// Event loop shared with other network interfaces instead of running three threads per
+  /// interface, see NetworkContext. Batched I/O and the queue options do not apply then.
+  std::shared_ptr<NetworkContext> context;
+
+  /// Logical overlay of the network interface, which shares the UDP socket of its IP with the
+  /// other overlays of the context. Requires a context.
+  std::optional<uint32_t> channel;
+};
+
 class Network {
 public:
   /**
@@ -26,6 +61,15 @@ public:
 
   Network(const std::string &ip, const std::function<void(const Message &)> &callback);
 
+  /**
+   * Create network interface with non-default I/O options
+   * @param ip IPv4 address to listen on. Selected automatically if empty
+   * @param callback function, which is called asynchronously when a new message is received
+   * @param options I/O options
+   */
+  Network(const std::string &ip, const std::function<void(const Message &)> &callback,
+          const NetworkOptions &options);
+
   ~Network();
 
   // Forbid copy/move operations
@@ -40,6 +84,12 @@ public:
    */
   void send(const Message &msg);
 
+  /**
+   * Send message without copying its content
+   * @param msg message to send
+   */
+  void send(Message &&msg);
+
   uint16_t getPort() const;
 
   std::string getIP() const;
@@ -0,0 +1,119 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef SOLANET_SERIALIZER_BUFFER_ARCHIVE_H_
+#define SOLANET_SERIALIZER_BUFFER_ARCHIVE_H_
+
+#ifndef CPPCHECK_IGNORE
+#include <cereal/cereal.hpp>
+#endif
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace solanet::serializer {
+
+/**
+ * Binary output archive appending directly to a caller-provided buffer instead of a std::ostream.
+ * Produces exactly the same bytes as cereal::BinaryOutputArchive, but avoids the stream layer.
+ * The buffer is not cleared, so that its capacity can be reused for subsequent messages.
+ */
+class BufferOutputArchive
+    : public cereal::OutputArchive<BufferOutputArchive, cereal::AllowEmptyClassElision> {
+public:
+  explicit BufferOutputArchive(std::string &buffer)
+      : cereal::OutputArchive<BufferOutputArchive, cereal::AllowEmptyClassElision>(this),
+        buffer_(buffer) {}
+
+  ~BufferOutputArchive() CEREAL_NOEXCEPT = default;
+
+  void saveBinary(const void *data, std::streamsize size) {
+    buffer_.append(static_cast<const char *>(data), static_cast<std::size_t>(size));
+  }
+
+private:
+  std::string &buffer_;
+};
+
+/**
+ * Binary input archive reading from a non-owning view, compatible with
+ * cereal::BinaryOutputArchive and BufferOutputArchive.
+ * The viewed data must outlive the archive.
+ */
+class BufferInputArchive
+    : public cereal::InputArchive<BufferInputArchive, cereal::AllowEmptyClassElision> {
+public:
+  explicit BufferInputArchive(std::string_view buffer)
+      : cereal::InputArchive<BufferInputArchive, cereal::AllowEmptyClassElision>(this),
+        buffer_(buffer) {}
+
+  ~BufferInputArchive() CEREAL_NOEXCEPT = default;
+
+  void loadBinary(void *const data, std::streamsize size) {
+    auto length = static_cast<std::size_t>(size);
+    if (length > buffer_.size() - position_) {
+      throw cereal::Exception("Failed to read " + std::to_string(size) +
+                              " bytes from input buffer! Read " +
+                              std::to_string(buffer_.size() - position_));
+    }
+
+    std::memcpy(data, buffer_.data() + position_, length);
+    position_ += length;
+  }
+
+private:
+  std::string_view buffer_;
+  std::size_t position_ = 0;
+};
+
+// Serialization functions matching those of cereal's binary archives
+
+template <class T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, void>::type CEREAL_SAVE_FUNCTION_NAME(
+    BufferOutputArchive &ar, T const &t) {
+  ar.saveBinary(std::addressof(t), sizeof(t));
+}
+
+template <class T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, void>::type CEREAL_LOAD_FUNCTION_NAME(
+    BufferInputArchive &ar, T &t) {
+  ar.loadBinary(std::addressof(t), sizeof(t));
+}
+
+template <class Archive, class T>
+inline CEREAL_ARCHIVE_RESTRICT(BufferInputArchive, BufferOutputArchive)
+    CEREAL_SERIALIZE_FUNCTION_NAME(Archive &ar, cereal::NameValuePair<T> &t) {
+  ar(t.value);
+}
+
+template <class Archive, class T>
+inline CEREAL_ARCHIVE_RESTRICT(BufferInputArchive, BufferOutputArchive)
+    CEREAL_SERIALIZE_FUNCTION_NAME(Archive &ar, cereal::SizeTag<T> &t) {
+  ar(t.size);
+}
+
+template <class T>
+inline void CEREAL_SAVE_FUNCTION_NAME(BufferOutputArchive &ar, cereal::BinaryData<T> const &bd) {
+  ar.saveBinary(bd.data, static_cast<std::streamsize>(bd.size));
+}
+
+template <class T>
+inline void CEREAL_LOAD_FUNCTION_NAME(BufferInputArchive &ar, cereal::BinaryData<T> &bd) {
+  ar.loadBinary(bd.data, static_cast<std::streamsize>(bd.size));
+}
+
+}  // namespace solanet::serializer
+
+CEREAL_REGISTER_ARCHIVE(solanet::serializer::BufferOutputArchive)
+CEREAL_REGISTER_ARCHIVE(solanet::serializer::BufferInputArchive)
+
+// Tie input and output archives together
+CEREAL_SETUP_ARCHIVE_TRAITS(solanet::serializer::BufferInputArchive,
+                            solanet::serializer::BufferOutputArchive)
+
+#endif  // SOLANET_SERIALIZER_BUFFER_ARCHIVE_H_
@@ -20,37 +20,48 @@
 #include <cereal/types/vector.hpp>
 #endif
 
-#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "solanet/serializer/buffer_archive.h"
 
 namespace solanet::serializer {
 
 struct BinarySerializer {};
 
+/**
+ * Serialize msg into buffer. The buffer is cleared first, but keeps its capacity, so that a
+ * reused buffer does not allocate once it has grown to the message size.
+ */
 template <typename T, typename SerializerType = BinarySerializer>
-std::string serialize(const T &msg) {
+void serializeInto(const T &msg, std::string &buffer) {
   static_assert(std::is_class_v<SerializerType>);
 
-  std::stringstream ss;
+  buffer.clear();
 
   if constexpr (std::is_same_v<SerializerType, BinarySerializer>) {
-    cereal::BinaryOutputArchive archive(ss);
+    BufferOutputArchive archive(buffer);
     archive(msg);
   } else {
     static_assert(std::is_void_v<SerializerType>);  // No valid serializer type selected
   }
+}
 
-  return ss.str();
+template <typename T, typename SerializerType = BinarySerializer>
+std::string serialize(const T &msg) {
+  std::string buffer;
+  serializeInto<T, SerializerType>(msg, buffer);
+  return buffer;
 }
 
 template <typename T, typename SerializerType = BinarySerializer>
-T deserialize(const std::string &msg) {
+T deserialize(std::string_view msg) {
   static_assert(std::is_class_v<SerializerType>);
 
   T m;
-  std::istringstream iss(msg);
 
   if constexpr (std::is_same_v<SerializerType, BinarySerializer>) {
-    cereal::BinaryInputArchive a(iss);
+    BufferInputArchive a(msg);
     a(m);
   } else {
     static_assert(std::is_void_v<SerializerType>);  // No valid serializer type selected
@@ -0,0 +1,153 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "solanet/network_udp/network_context.h"
+
+#include <arpa/inet.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "network_context_impl.h"
+#include "solanet/network_udp/buffer_pool.h"
+
+namespace solanet {
+
+MultiplexedSocket::MultiplexedSocket(asio::io_context &io_context, const std::string &ip)
+    : socket_(io_context, {asio::ip::address::from_string(ip), 0}),
+      port_(socket_.local_endpoint().port()),
+      strand_(io_context) {
+  socket_.set_option(asio::socket_base::receive_buffer_size(kReceiveBufferSize));
+  buffer_.resize(kMaxDatagramSize);
+}
+
+void MultiplexedSocket::start() {
+  asio::post(strand_, [this, self = shared_from_this()]() { readFromSocket(); });
+}
+
+void MultiplexedSocket::close() {
+  // Aborts the pending receive operation, whose handler then drops its ownership
+  asio::post(strand_, [this, self = shared_from_this()]() {
+    asio::error_code ec;
+    socket_.close(ec);
+  });
+}
+
+void MultiplexedSocket::add(uint32_t channel, DeliverFct deliver) {
+  std::scoped_lock lock(mutex_);
+  if (!receivers_.emplace(channel, std::move(deliver)).second) {
+    throw std::invalid_argument("Channel " + std::to_string(channel) + " is already in use");
+  }
+}
+
+void MultiplexedSocket::remove(uint32_t channel) {
+  std::scoped_lock lock(mutex_);
+  receivers_.erase(channel);
+}
+
+void MultiplexedSocket::send(uint32_t channel, Message msg) {
+  std::array<uint32_t, 2> header{htonl(kMagic), htonl(channel)};
+
+  asio::post(strand_, [this, self = shared_from_this(), header, msg = std::move(msg)]() mutable {
+    asio::ip::udp::endpoint receiver(asio::ip::address::from_string(msg.getIp()), msg.getPort());
+    std::array<asio::const_buffer, 2> buffers{
+        asio::buffer(header.data(), kHeaderSize),
+        asio::buffer(msg.getMessage().data(), msg.getMessage().size())};
+
+    std::size_t transferred = socket_.send_to(buffers, receiver);
+    if (transferred != kHeaderSize + msg.getMessage().size()) {
+      throw std::runtime_error("Failed on message send!");
+    }
+    BufferPool::global().release(msg.takeMessage());
+  });
+}
+
+void MultiplexedSocket::readFromSocket() {
+  socket_.async_receive_from(
+      asio::buffer(buffer_.data(), buffer_.size()), endpoint_,
+      asio::bind_executor(strand_, [this, self = shared_from_this()](asio::error_code ec,
+                                                                     std::size_t size) {
+        if (ec == asio::error::operation_aborted) return;
+        if (ec) throw std::runtime_error("Failed to receive message");
+
+        std::array<uint32_t, 2> header{};
+        if (size >= kHeaderSize) std::memcpy(header.data(), buffer_.data(), kHeaderSize);
+
+        if (ntohl(header[0]) == kMagic) {
+          std::scoped_lock lock(mutex_);
+          auto it = receivers_.find(ntohl(header[1]));
+          if (it != receivers_.end()) {
+            std::string payload = BufferPool::global().acquire();
+            payload.assign(buffer_.data() + kHeaderSize, size - kHeaderSize);
+            it->second(Message(addressToString(endpoint_.address().to_v4()), endpoint_.port(),
+                               std::move(payload)));
+          }
+        }
+
+        readFromSocket();
+      }));
+}
+
+const std::string &MultiplexedSocket::addressToString(const asio::ip::address_v4 &address) {
+  const uint32_t key = address.to_uint();
+  auto it = address_strings_.find(key);
+  if (it != address_strings_.end()) return it->second;
+
+  return address_strings_.emplace(key, address.to_string()).first->second;
+}
+
+NetworkContext::Impl::Impl(uint32_t thread_count) : work_(asio::make_work_guard(io_context_)) {
+  if (thread_count == 0) throw std::invalid_argument("Thread count must be greater than 0");
+
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads_.emplace_back([this]() { io_context_.run(); });
+  }
+}
+
+NetworkContext::Impl::~Impl() {
+  work_.reset();
+  io_context_.stop();
+  for (auto &thread : threads_) thread.join();
+
+  // Closing the sockets only after the threads terminated, as pending handlers refer to them
+  sockets_.clear();
+}
+
+std::shared_ptr<MultiplexedSocket> NetworkContext::Impl::getMultiplexedSocket(
+    const std::string &ip) {
+  std::scoped_lock lock(mutex_);
+  auto &shared = sockets_[ip];
+  if (!shared.socket) {
+    shared.socket = std::make_shared<MultiplexedSocket>(io_context_, ip);
+    shared.socket->start();
+  }
+  shared.users++;
+  return shared.socket;
+}
+
+void NetworkContext::Impl::releaseMultiplexedSocket(const std::string &ip) {
+  std::scoped_lock lock(mutex_);
+  auto it = sockets_.find(ip);
+  if (it == sockets_.end() || --it->second.users > 0) return;
+
+  it->second.socket->close();
+  sockets_.erase(it);
+}
+
+////////////////////////////////////
+////// PIMP IMPLEMENTATION /////////
+////////////////////////////////////
+
+NetworkContext::NetworkContext(uint32_t thread_count)
+    : pimpl_(std::make_unique<Impl>(thread_count)) {}
+
+NetworkContext::~NetworkContext() = default;
+
+uint32_t NetworkContext::getThreadCount() const { return pimpl_->getThreadCount(); }
+
+}  // namespace solanet
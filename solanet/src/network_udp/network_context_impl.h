@@ -0,0 +1,122 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef SOLANET_NETWORK_UDP_NETWORK_CONTEXT_IMPL_H_
+#define SOLANET_NETWORK_UDP_NETWORK_CONTEXT_IMPL_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef CPPCHECK_IGNORE
+#include "asio.hpp"
+#endif
+
+#include "solanet/network_udp/message.h"
+#include "solanet/network_udp/network_context.h"
+
+namespace solanet {
+
+static constexpr uint32_t kMaxDatagramSize = 65535;
+
+/**
+ * UDP socket shared by the network interfaces of one IP, which are identified by their channel.
+ *
+ * Each datagram starts with a header of a magic number and the channel, both in network byte
+ * order. Datagrams without a valid header or for an unknown channel are dropped.
+ *
+ * Pending handlers share ownership of the socket, so that it stays alive until it is closed.
+ */
+class MultiplexedSocket : public std::enable_shared_from_this<MultiplexedSocket> {
+public:
+  static constexpr uint32_t kMagic = 0x534f4c41;  // "SOLA"
+  static constexpr std::size_t kHeaderSize = 2 * sizeof(uint32_t);
+
+  // The socket receives the datagrams of all overlays, so its receive buffer is enlarged to
+  // absorb bursts (the kernel caps it at net.core.rmem_max)
+  static constexpr int kReceiveBufferSize = 4 * 1024 * 1024;
+
+  /// Called on the receiving thread with the registry locked, so it should only hand over
+  using DeliverFct = std::function<void(Message &&)>;
+
+  MultiplexedSocket(asio::io_context &io_context, const std::string &ip);
+
+  /// Starts receiving, must be called once after the socket is owned by a shared pointer
+  void start();
+
+  /// Closes the socket after the pending sends, which releases the ownership of its handlers
+  void close();
+
+  /// Registers the receiver of the channel, throws if the channel is already in use
+  void add(uint32_t channel, DeliverFct deliver);
+
+  /// Once returned, the receiver of the channel is not called anymore
+  void remove(uint32_t channel);
+
+  /// Sends asynchronously, prepending the header of the channel
+  void send(uint32_t channel, Message msg);
+
+  uint16_t getPort() const { return port_; }
+
+private:
+  void readFromSocket();
+
+  // Convert IPv4 address only once per sender, as formatting is costly on the receive path
+  const std::string &addressToString(const asio::ip::address_v4 &address);
+
+  asio::ip::udp::socket socket_;
+  uint16_t port_;
+
+  // Serializes receiving and sending, as the socket is used by all I/O threads
+  asio::io_context::strand strand_;
+
+  std::string buffer_;
+  asio::ip::udp::endpoint endpoint_;
+  std::unordered_map<uint32_t, std::string> address_strings_;  // Only used in strand
+
+  std::mutex mutex_;
+  std::unordered_map<uint32_t, DeliverFct> receivers_;
+};
+
+class NetworkContext::Impl {
+public:
+  explicit Impl(uint32_t thread_count);
+  ~Impl();
+
+  asio::io_context &getIOContext() { return io_context_; }
+
+  /// @return socket shared by all multiplexed network interfaces of the IP. Each call has to be
+  /// matched by a call of releaseMultiplexedSocket().
+  std::shared_ptr<MultiplexedSocket> getMultiplexedSocket(const std::string &ip);
+
+  /// Closes the socket of the IP once all of its network interfaces released it
+  void releaseMultiplexedSocket(const std::string &ip);
+
+  uint32_t getThreadCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+private:
+  asio::io_context io_context_;
+  asio::executor_work_guard<asio::io_context::executor_type> work_;
+  std::vector<std::thread> threads_;
+
+  struct SharedSocket {
+    std::shared_ptr<MultiplexedSocket> socket;
+    uint32_t users = 0;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, SharedSocket> sockets_;
+};
+
+}  // namespace solanet
+
+#endif  // SOLANET_NETWORK_UDP_NETWORK_CONTEXT_IMPL_H_
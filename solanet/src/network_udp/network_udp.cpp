@@ -6,30 +6,35 @@
 
 #include "solanet/network_udp/network_udp.h"
 
+#include <arpa/inet.h>
 #include <ifaddrs.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
 
 #include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
-#ifndef CPPCHECK_IGNORE
-#include "asio.hpp"
-#endif
-
-#include "queue.h"
+#include "network_context_impl.h"
+#include "ring_buffer.h"
+#include "solanet/network_udp/buffer_pool.h"
 #include "solanet/network_udp/message.h"
 
-static constexpr uint32_t kMaxDatagramSize = 65535;
-
 namespace solanet {
 
 class Network::Impl {
 public:
-  Impl(const std::string &ip, std::function<void(const Message &)> callback);
+  Impl(const std::string &ip, std::function<void(const Message &)> callback,
+       const NetworkOptions &options, NetworkContext::Impl *context);
 
   ~Impl();
 
-  void send(const Message &msg);
+  void send(Message msg);
 
   uint16_t getPort() const;
   std::string getIP() const;
@@ -37,26 +42,70 @@ public:
 private:
   void readFromSocket();
 
+  // Batched counterpart of readFromSocket(), draining the socket with recvmmsg
+  void readBatchFromSocket();
+
   void receiveFunction();
 
+  void receiveBatchedFunction();
+
   void networkFunction();
 
   void sendFunction();
 
+  void sendBatchedFunction();
+
+  // Counterpart of readFromSocket() on a shared context, calling back directly in the strand
+  void readSharedFromSocket();
+
+  // Runs the function in the strand, unless the network interface is closing. Within the strand,
+  // e.g. when answering in the receive callback, the function runs immediately.
+  template <typename F> void runInStrand(F &&function);
+  void finishPending();
+
+  // Resolve IPv4 address only once per destination, as parsing is costly on the send path
+  const in_addr &resolveAddress(const std::string &ip);
+
+  // Convert IPv4 address only once per sender, as formatting is costly on the receive path
+  const std::string &addressToString(const in_addr &address);
+
   // Some basic heuristics to find own IP, only picking the first one
   static std::string readIPFromInterfaces();
 
+  // Returns the payload of a message dropped by a queue to the buffer pool
+  static void releaseMessage(Message &&message);
+
+  NetworkOptions options_;
   std::thread receiver_thread_;
   std::thread sender_thread_;
   std::thread network_thread_;
-  Queue<Message> receiving_queue_, sending_queue_;
-  asio::io_service io_service_;
+  RingBuffer<Message> receiving_queue_, sending_queue_;
+  asio::io_service io_service_;  // Only runs without a shared context
+  asio::io_context &io_context_;
   std::string ip_;
+
+  // Shared context: the strand serializes callbacks and sending of this network interface.
+  // Handlers posted to the strand are counted, so that the destructor can wait for them.
+  std::optional<asio::io_context::strand> strand_;
+  std::shared_ptr<MultiplexedSocket> multiplexed_socket_;
+  NetworkContext::Impl *context_ = nullptr;  // Only set with a multiplexed socket
+  std::mutex pending_mutex_;
+  std::condition_variable pending_done_;
+  uint32_t pending_ = 0;
+  bool closing_ = false;
+
   asio::ip::udp::socket receiver_socket_;
   asio::ip::udp::socket sender_socket_;
   std::function<void(const Message &)> receive_callback_;
   std::string buffer_;
   asio::ip::udp::endpoint endpoint_;
+
+  // Batched I/O: receive buffers and headers are allocated once and reused for every batch
+  std::vector<mmsghdr> receive_headers_;
+  std::vector<iovec> receive_iovecs_;
+  std::vector<sockaddr_in> receive_addresses_;
+  std::unordered_map<in_addr_t, std::string> address_strings_;  // Only used by network thread
+  std::unordered_map<std::string, in_addr> resolved_addresses_;  // Only used by sender thread
 };
 
 void Network::Impl::receiveFunction() {
@@ -66,6 +115,19 @@ void Network::Impl::receiveFunction() {
       break;
     }
     receive_callback_(message);  // Callback to application
+    BufferPool::global().release(message.takeMessage());
+  }
+}
+
+void Network::Impl::receiveBatchedFunction() {
+  std::vector<Message> messages;
+  messages.reserve(options_.batch_size);
+
+  while (receiving_queue_.popBatch(messages, options_.batch_size)) {
+    for (Message &message : messages) {
+      receive_callback_(message);  // Callback to application
+      BufferPool::global().release(message.takeMessage());
+    }
   }
 }
 
@@ -85,41 +147,278 @@ void Network::Impl::sendFunction() {
     if (message.getMessage().size() != transferred) {
       throw std::runtime_error("Failed on message send!");
     }
+    BufferPool::global().release(message.takeMessage());
+  }
+}
+
+void Network::Impl::sendBatchedFunction() {
+  std::vector<Message> messages;
+  messages.reserve(options_.batch_size);
+  std::vector<mmsghdr> headers(options_.batch_size);
+  std::vector<iovec> iovecs(options_.batch_size);
+  std::vector<sockaddr_in> receivers(options_.batch_size);
+
+  while (sending_queue_.popBatch(messages, options_.batch_size)) {
+    for (std::size_t i = 0; i < messages.size(); i++) {
+      const Message &message = messages[i];
+
+      receivers[i] = {};
+      receivers[i].sin_family = AF_INET;
+      receivers[i].sin_port = htons(message.getPort());
+      receivers[i].sin_addr = resolveAddress(message.getIp());
+
+      // sendmmsg does not modify the payload, but iovec only provides a non-const pointer
+      iovecs[i].iov_base = const_cast<char *>(message.getMessage().data());
+      iovecs[i].iov_len = message.getMessage().size();
+
+      headers[i] = {};
+      headers[i].msg_hdr.msg_name = &receivers[i];
+      headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      headers[i].msg_hdr.msg_iov = &iovecs[i];
+      headers[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    std::size_t sent = 0;
+    while (sent < messages.size()) {
+      int res = sendmmsg(sender_socket_.native_handle(), headers.data() + sent,
+                         static_cast<unsigned int>(messages.size() - sent), 0);
+      if (res < 0) {
+        if (errno == EINTR) continue;
+        throw std::runtime_error("Failed on message send!");
+      }
+
+      for (std::size_t i = sent; i < sent + res; i++) {
+        if (headers[i].msg_len != iovecs[i].iov_len) {
+          throw std::runtime_error("Failed on message send!");
+        }
+      }
+      sent += res;
+    }
+
+    for (Message &message : messages) {
+      BufferPool::global().release(message.takeMessage());
+    }
+  }
+}
+
+void Network::Impl::releaseMessage(Message &&message) {
+  BufferPool::global().release(message.takeMessage());
+}
+
+const in_addr &Network::Impl::resolveAddress(const std::string &ip) {
+  auto it = resolved_addresses_.find(ip);
+  if (it != resolved_addresses_.end()) return it->second;
+
+  in_addr address{};
+  if (inet_pton(AF_INET, ip.c_str(), &address) != 1) {
+    throw std::runtime_error("Invalid IPv4 address: " + ip);
+  }
+  return resolved_addresses_.emplace(ip, address).first->second;
+}
+
+const std::string &Network::Impl::addressToString(const in_addr &address) {
+  auto it = address_strings_.find(address.s_addr);
+  if (it != address_strings_.end()) return it->second;
+
+  std::array<char, INET_ADDRSTRLEN> ip{};
+  if (inet_ntop(AF_INET, &address, ip.data(), ip.size()) == nullptr) {
+    throw std::runtime_error("unable to convert IP address");
   }
+  return address_strings_.emplace(address.s_addr, ip.data()).first->second;
 }
 
 void Network::Impl::networkFunction() { io_service_.run(); }
 
+template <typename F> void Network::Impl::runInStrand(F &&function) {
+  {
+    std::scoped_lock lock(pending_mutex_);
+    if (closing_) return;
+    pending_++;
+  }
+  asio::dispatch(*strand_, [this, function = std::forward<F>(function)]() mutable {
+    function();
+    finishPending();
+  });
+}
+
+void Network::Impl::finishPending() {
+  std::scoped_lock lock(pending_mutex_);
+  if (--pending_ == 0) pending_done_.notify_all();
+}
+
+void Network::Impl::readSharedFromSocket() {
+  // The pending receive operation is counted until the socket is closed
+  receiver_socket_.async_receive_from(
+      asio::buffer(buffer_.data(), buffer_.size()), endpoint_,
+      asio::bind_executor(*strand_, [this](asio::error_code ec, std::size_t size) {
+        // Datagrams received shortly before closing are dropped
+        if (ec == asio::error::operation_aborted || !receiver_socket_.is_open()) {
+          finishPending();
+          return;
+        }
+        if (ec) throw std::runtime_error("Failed to receive message");
+
+        std::string payload = BufferPool::global().acquire();
+        payload.assign(buffer_.data(), size);
+        Message msg(endpoint_.address().to_string(), endpoint_.port(), std::move(payload));
+        receive_callback_(msg);  // Callback to application
+        BufferPool::global().release(msg.takeMessage());
+        readSharedFromSocket();
+      }));
+}
+
 void Network::Impl::readFromSocket() {
   receiver_socket_.async_receive_from(asio::buffer(buffer_.data(), buffer_.size()), endpoint_,
                                       [this](asio::error_code ec, std::size_t size) {
                                         if (ec)
                                           throw std::runtime_error("Failed to receive message");
 
+                                        std::string payload = BufferPool::global().acquire();
+                                        payload.assign(buffer_.data(), size);
                                         Message msg(endpoint_.address().to_string(),
-                                                    endpoint_.port(), buffer_.substr(0, size));
-                                        receiving_queue_.push(msg);
+                                                    endpoint_.port(), std::move(payload));
+                                        receiving_queue_.push(std::move(msg));
                                         readFromSocket();
                                       });
 }
 
-Network::Impl::Impl(const std::string &ip, std::function<void(const Message &)> callback)
-    : ip_(ip.empty() ? readIPFromInterfaces() : ip),
-      receiver_socket_(io_service_, {asio::ip::address::from_string(ip_), 0}),
-      sender_socket_(io_service_),
+void Network::Impl::readBatchFromSocket() {
+  receiver_socket_.async_wait(asio::ip::udp::socket::wait_read, [this](asio::error_code ec) {
+    if (ec) throw std::runtime_error("Failed to receive message");
+
+    std::vector<Message> messages;
+    while (true) {
+      for (auto &header : receive_headers_) {
+        header.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      }
+
+      int res = recvmmsg(receiver_socket_.native_handle(), receive_headers_.data(),
+                         static_cast<unsigned int>(receive_headers_.size()), MSG_DONTWAIT,
+                         nullptr);
+      if (res < 0) {
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;  // Socket drained
+        throw std::runtime_error("Failed to receive message");
+      }
+
+      messages.reserve(messages.size() + res);
+      for (int i = 0; i < res; i++) {
+        std::string payload = BufferPool::global().acquire();
+        payload.assign(static_cast<const char *>(receive_iovecs_[i].iov_base),
+                       receive_headers_[i].msg_len);
+        messages.emplace_back(addressToString(receive_addresses_[i].sin_addr),
+                              ntohs(receive_addresses_[i].sin_port), std::move(payload));
+      }
+
+      if (static_cast<std::size_t>(res) < receive_headers_.size()) break;  // Socket drained
+    }
+
+    receiving_queue_.pushAll(messages);
+    readBatchFromSocket();
+  });
+}
+
+Network::Impl::Impl(const std::string &ip, std::function<void(const Message &)> callback,
+                    const NetworkOptions &options, NetworkContext::Impl *context)
+    : options_(options),
+      // The queues are not used on a shared context
+      receiving_queue_(context ? 1 : options_.queue_capacity, options_.backpressure_policy,
+                       options_.max_block_time, &Impl::releaseMessage),
+      sending_queue_(context ? 1 : options_.queue_capacity, options_.backpressure_policy,
+                     options_.max_block_time, &Impl::releaseMessage),
+      io_context_(context ? context->getIOContext() : io_service_),
+      ip_(ip.empty() ? readIPFromInterfaces() : ip),
+      receiver_socket_(io_context_),
+      sender_socket_(io_context_),
       receive_callback_(std::move(callback)) {
+  if (options_.batched_io && options_.batch_size == 0) {
+    throw std::invalid_argument("Batch size must be greater than 0");
+  }
+
+  if (context) {
+    if (options_.batched_io) {
+      throw std::invalid_argument("Batched I/O is not supported on a shared context");
+    }
+    strand_.emplace(io_context_);
+
+    if (options_.channel) {
+      multiplexed_socket_ = context->getMultiplexedSocket(ip_);
+      try {
+        multiplexed_socket_->add(*options_.channel, [this](Message &&msg) {
+          runInStrand([this, msg = std::move(msg)]() mutable {
+            receive_callback_(msg);  // Callback to application
+            BufferPool::global().release(msg.takeMessage());
+          });
+        });
+      } catch (...) {
+        context->releaseMultiplexedSocket(ip_);
+        throw;
+      }
+      context_ = context;
+    } else {
+      receiver_socket_.open(asio::ip::udp::v4());
+      receiver_socket_.bind({asio::ip::address::from_string(ip_), 0});
+      sender_socket_.open(asio::ip::udp::v4());
+      buffer_.resize(kMaxDatagramSize);
+
+      pending_++;
+      asio::post(*strand_, [this]() { readSharedFromSocket(); });
+    }
+    return;
+  }
+
+  if (options_.channel) throw std::invalid_argument("Channels require a shared context");
+
+  receiver_socket_.open(asio::ip::udp::v4());
+  receiver_socket_.bind({asio::ip::address::from_string(ip_), 0});
   sender_socket_.open(asio::ip::udp::v4());
-  buffer_.resize(kMaxDatagramSize);
 
-  // Start threads
-  receiver_thread_ = std::thread(&Network::Impl::receiveFunction, this);
-  sender_thread_ = std::thread(&Network::Impl::sendFunction, this);
+  if (options_.batched_io) {
+    // One contiguous pool of datagram buffers, reused for every recvmmsg call
+    buffer_.resize(static_cast<std::size_t>(kMaxDatagramSize) * options_.batch_size);
+    receive_headers_.resize(options_.batch_size);
+    receive_iovecs_.resize(options_.batch_size);
+    receive_addresses_.resize(options_.batch_size);
+    for (std::size_t i = 0; i < options_.batch_size; i++) {
+      receive_iovecs_[i].iov_base = buffer_.data() + i * kMaxDatagramSize;
+      receive_iovecs_[i].iov_len = kMaxDatagramSize;
+      receive_headers_[i].msg_hdr.msg_name = &receive_addresses_[i];
+      receive_headers_[i].msg_hdr.msg_iov = &receive_iovecs_[i];
+      receive_headers_[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    receiver_thread_ = std::thread(&Network::Impl::receiveBatchedFunction, this);
+    sender_thread_ = std::thread(&Network::Impl::sendBatchedFunction, this);
+
+    readBatchFromSocket();
+  } else {
+    buffer_.resize(kMaxDatagramSize);
+
+    // Start threads
+    receiver_thread_ = std::thread(&Network::Impl::receiveFunction, this);
+    sender_thread_ = std::thread(&Network::Impl::sendFunction, this);
+
+    readFromSocket();
+  }
 
-  readFromSocket();
   network_thread_ = std::thread(&Network::Impl::networkFunction, this);
 }
 
 Network::Impl::~Impl() {
+  if (strand_) {
+    if (multiplexed_socket_) {
+      multiplexed_socket_->remove(*options_.channel);
+      context_->releaseMultiplexedSocket(ip_);
+    }
+
+    // Closing in the strand aborts the pending receive operation, which is then finished as well
+    runInStrand([this]() { receiver_socket_.close(); });
+    std::unique_lock lock(pending_mutex_);
+    closing_ = true;
+    pending_done_.wait(lock, [this]() { return pending_ == 0; });
+    return;
+  }
+
   // Stop all
   io_service_.stop();
   receiving_queue_.stop();
@@ -131,11 +430,27 @@ Network::Impl::~Impl() {
   network_thread_.join();
 }
 
-void Network::Impl::send(const Message &msg) {
-  if (msg.getMessage().size() > kMaxDatagramSize)
+void Network::Impl::send(Message msg) {
+  if (msg.getMessage().size() >
+      kMaxDatagramSize - (multiplexed_socket_ ? MultiplexedSocket::kHeaderSize : 0))
     throw std::runtime_error("Cannot send message. Message too large!");
 
-  sending_queue_.push(msg);
+  if (multiplexed_socket_) {
+    multiplexed_socket_->send(*options_.channel, std::move(msg));
+  } else if (strand_) {
+    runInStrand([this, msg = std::move(msg)]() mutable {
+      asio::ip::udp::endpoint receiver(asio::ip::address::from_string(msg.getIp()),
+                                       msg.getPort());
+      std::size_t transferred = sender_socket_.send_to(
+          asio::buffer(msg.getMessage().data(), msg.getMessage().size()), receiver);
+      if (msg.getMessage().size() != transferred) {
+        throw std::runtime_error("Failed on message send!");
+      }
+      BufferPool::global().release(msg.takeMessage());
+    });
+  } else {
+    sending_queue_.push(std::move(msg));
+  }
 }
 
 std::string Network::Impl::readIPFromInterfaces() {
@@ -163,7 +478,10 @@ std::string Network::Impl::readIPFromInterfaces() {
   return ip_addr;
 }
 
-uint16_t Network::Impl::getPort() const { return receiver_socket_.local_endpoint().port(); }
+uint16_t Network::Impl::getPort() const {
+  if (multiplexed_socket_) return multiplexed_socket_->getPort();
+  return receiver_socket_.local_endpoint().port();
+}
 
 std::string Network::Impl::getIP() const { return ip_; }
 
@@ -172,16 +490,23 @@ std::string Network::Impl::getIP() const { return ip_; }
 ////////////////////////////////////
 
 Network::Network(const std::function<void(const Message &)> &callback)
-    : pimpl_(std::make_unique<Impl>("", callback)) {}
+    : pimpl_(std::make_unique<Impl>("", callback, NetworkOptions{}, nullptr)) {}
 
 Network::Network(const std::string &ip, const std::function<void(const Message &)> &callback)
-    : pimpl_(std::make_unique<Impl>(ip, callback)) {}
+    : pimpl_(std::make_unique<Impl>(ip, callback, NetworkOptions{}, nullptr)) {}
+
+Network::Network(const std::string &ip, const std::function<void(const Message &)> &callback,
+                 const NetworkOptions &options)
+    : pimpl_(std::make_unique<Impl>(ip, callback, options,
+                                    options.context ? options.context->pimpl_.get() : nullptr)) {}
 
 Network::~Network() = default;  // Declared as default here (and not in header) because otherwise
                                 // class Impl has incomplete type
 
 void solanet::Network::send(const Message &msg) { pimpl_->send(msg); }
 
+void solanet::Network::send(Message &&msg) { pimpl_->send(std::move(msg)); }
+
 uint16_t solanet::Network::getPort() const { return pimpl_->getPort(); }
 
 std::string solanet::Network::getIP() const { return pimpl_->getIP(); }
@@ -0,0 +1,364 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#ifndef SOLANET_NETWORK_UDP_RING_BUFFER_H_
+#define SOLANET_NETWORK_UDP_RING_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "solanet/network_udp/backpressure_policy.h"
+
+namespace solanet {
+/**
+ * Bounded lock-free multi-producer/multi-consumer ring buffer (sequence-numbered slots, based on
+ * Dmitry Vyukov's bounded MPMC queue). Producers and consumers only synchronize on atomics; the
+ * mutex is solely used to park threads if the buffer is empty (or full with
+ * BackpressurePolicy::kBlock) and is only touched if another thread is actually waiting.
+ *
+ * Can be used as a drop-in replacement of Queue and additionally pushes and pops batches.
+ * T must be default constructible and move assignable.
+ */
+template <typename T> class RingBuffer {
+public:
+  /// Receives elements which were moved into the buffer but are never handed to a consumer
+  using DiscardFunction = std::function<void(T &&)>;
+
+  /// Producers wait without a time limit if the buffer is full with BackpressurePolicy::kBlock
+  static constexpr std::chrono::milliseconds kWaitForever = std::chrono::milliseconds::max();
+
+  /**
+   * @param capacity maximum number of elements, rounded up to the next power of two
+   * @param policy behavior if an element is pushed while the buffer is full
+   * @param max_block_time time after which a blocked producer gives up and the element is
+   * rejected, only used with BackpressurePolicy::kBlock
+   * @param discard called with elements that are dropped (kDropOldest) or rejected while they
+   * are moved into the buffer, e.g. to recycle their resources
+   */
+  explicit RingBuffer(std::size_t capacity = 8192,
+                      BackpressurePolicy policy = BackpressurePolicy::kBlock,
+                      std::chrono::milliseconds max_block_time = kWaitForever,
+                      DiscardFunction discard = {})
+      : policy_(policy), max_block_time_(max_block_time), discard_(std::move(discard)) {
+    if (capacity == 0) throw std::invalid_argument("Ring buffer capacity must be greater than 0");
+
+    std::size_t size = 1;
+    while (size < capacity) size <<= 1;
+
+    mask_ = size - 1;
+    cells_ = std::make_unique<Cell[]>(size);
+    for (std::size_t i = 0; i < size; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~RingBuffer() { stop(); }
+
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+  RingBuffer(RingBuffer &&) = delete;
+  RingBuffer &operator=(RingBuffer &&) = delete;
+
+  /**
+   * Push element to the buffer, applying the backpressure policy if the buffer is full
+   * @param value new element, passed to the discard function if it is moved in and rejected
+   * @return false if the element was rejected (kFail, timed out with kBlock) or the buffer was
+   * stopped
+   */
+  bool push(const T &value) { return pushInternal(value); }
+
+  bool push(T &&value) { return pushInternal(std::move(value)); }
+
+  /**
+   * Push multiple elements, waking up waiting consumers only once.
+   * Rejected elements are passed to the discard function.
+   * @param values new elements, left in a valid but unspecified state
+   */
+  void pushAll(std::vector<T> &values) {
+    for (auto &value : values) {
+      insert(std::move(value));
+    }
+    notifyConsumers(true);
+  }
+
+  /**
+   * Unblock all blocking calls.
+   * Every call to pop() after calling stop() will directly return an empty element.
+   */
+  void stop() {
+    running_.store(false);
+    std::scoped_lock lock(wait_mutex_);
+    cv_not_empty_.notify_all();
+    cv_not_full_.notify_all();
+  }
+
+  /**
+   * Moves the first element out of the buffer. Blocks as long the buffer is empty.
+   * @return first element or empty element if the buffer was stopped
+   */
+  T pop() {
+    T item{};
+    while (running_.load(std::memory_order_relaxed)) {
+      if (tryPop(item)) return item;
+      waitNotEmpty();
+    }
+    return T{};
+  }
+
+  /**
+   * Moves the first element out of the buffer if there is one, without blocking
+   * @param item moved-to element
+   * @return true if an element was taken
+   */
+  bool tryPop(T &item) {
+    if (!dequeue(item)) return false;
+    notifyProducers(false);
+    return true;
+  }
+
+  /**
+   * Moves up to max_items elements into items. Blocks as long the buffer is empty.
+   * @param items vector to fill, cleared before inserting
+   * @param max_items maximum number of elements to take
+   * @return false if the buffer was stopped, true otherwise
+   */
+  bool popBatch(std::vector<T> &items, std::size_t max_items) {
+    items.clear();
+
+    T item{};
+    while (running_.load(std::memory_order_relaxed)) {
+      while (items.size() < max_items && dequeue(item)) {
+        items.push_back(std::move(item));
+      }
+
+      if (!items.empty()) {
+        notifyProducers(items.size() > 1);
+        return true;
+      }
+      waitNotEmpty();
+    }
+    return false;
+  }
+
+  /**
+   * Maximum number of elements that were stored at the same time
+   */
+  std::size_t getHighWaterMark() const { return high_water_mark_.load(std::memory_order_relaxed); }
+
+  /**
+   * Number of elements that were discarded (kDropOldest) or rejected (kFail, timed out with
+   * kBlock)
+   */
+  uint64_t getDropCount() const { return drops_.load(std::memory_order_relaxed); }
+
+  std::size_t getCapacity() const { return mask_ + 1; }
+
+private:
+  struct alignas(64) Cell {
+    std::atomic<std::size_t> sequence;
+    T data;
+  };
+
+  template <typename U> bool pushInternal(U &&value) {
+    bool inserted = insert(std::forward<U>(value));
+    if (inserted) notifyConsumers(false);
+    return inserted;
+  }
+
+  template <typename U> bool insert(U &&value) {
+    if (insertOrReject(std::forward<U>(value))) return true;
+
+    // The caller keeps elements which are passed by reference
+    if constexpr (!std::is_lvalue_reference_v<U>) discard(std::move(value));
+    return false;
+  }
+
+  template <typename U> bool insertOrReject(U &&value) {
+    uint32_t attempts = 0;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    while (!enqueue(std::forward<U>(value))) {
+      if (!running_.load(std::memory_order_relaxed)) return false;
+
+      switch (policy_) {
+        case BackpressurePolicy::kBlock:
+          // Consumers usually free a slot shortly, so only park after yielding a few times
+          if (++attempts < kYieldsBeforeWait) {
+            std::this_thread::yield();
+            break;
+          }
+          if (max_block_time_ == kWaitForever) {
+            waitNotFull();
+            break;
+          }
+          if (!deadline) deadline = std::chrono::steady_clock::now() + max_block_time_;
+          if (!waitNotFull(*deadline)) {
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+          }
+          break;
+        case BackpressurePolicy::kDropOldest: {
+          T oldest{};
+          if (dequeue(oldest)) {
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            discard(std::move(oldest));
+          }
+          break;
+        }
+        case BackpressurePolicy::kFail:
+          drops_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+      }
+    }
+    return true;
+  }
+
+  void discard(T &&value) {
+    if (discard_) discard_(std::move(value));
+  }
+
+  // Value is only moved from if the element was inserted
+  template <typename U> bool enqueue(U &&value) {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;  // Full
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->data = std::forward<U>(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    // Dequeue position may be outdated, so the size is only an estimate bounded by the capacity
+    std::size_t size =
+        std::min(pos + 1 - dequeue_pos_.load(std::memory_order_relaxed), mask_ + 1);
+    std::size_t high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+    while (size > high_water_mark &&
+           !high_water_mark_.compare_exchange_weak(high_water_mark, size,
+                                                   std::memory_order_relaxed)) {
+    }
+    return true;
+  }
+
+  bool dequeue(T &item) {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;  // Empty
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    item = std::move(cell->data);
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool hasReadableCell() const {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    return cells_[pos & mask_].sequence.load(std::memory_order_acquire) == pos + 1;
+  }
+
+  bool hasWritableCell() const {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    return cells_[pos & mask_].sequence.load(std::memory_order_acquire) == pos;
+  }
+
+  // The waiter counter and the cell sequence are checked in opposite order by waiting and
+  // notifying threads, separated by full fences, so that no wakeup can be lost.
+  void waitNotEmpty() {
+    std::unique_lock lk(wait_mutex_);
+    waiting_consumers_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cv_not_empty_.wait(lk, [this] { return !running_.load() || hasReadableCell(); });
+    waiting_consumers_.fetch_sub(1);
+  }
+
+  void waitNotFull() {
+    std::unique_lock lk(wait_mutex_);
+    waiting_producers_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cv_not_full_.wait(lk, [this] { return !running_.load() || hasWritableCell(); });
+    waiting_producers_.fetch_sub(1);
+  }
+
+  // Returns false if the deadline passed while the buffer is still full
+  bool waitNotFull(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock lk(wait_mutex_);
+    waiting_producers_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool woken = cv_not_full_.wait_until(
+        lk, deadline, [this] { return !running_.load() || hasWritableCell(); });
+    waiting_producers_.fetch_sub(1);
+    return woken;
+  }
+
+  void notifyConsumers(bool all) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_consumers_.load(std::memory_order_relaxed) == 0) return;
+
+    { std::scoped_lock lock(wait_mutex_); }
+    all ? cv_not_empty_.notify_all() : cv_not_empty_.notify_one();
+  }
+
+  void notifyProducers(bool all) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_producers_.load(std::memory_order_relaxed) == 0) return;
+
+    { std::scoped_lock lock(wait_mutex_); }
+    all ? cv_not_full_.notify_all() : cv_not_full_.notify_one();
+  }
+
+  static constexpr uint32_t kYieldsBeforeWait = 16;
+
+  std::unique_ptr<Cell[]> cells_;
+  std::size_t mask_ = 0;
+  BackpressurePolicy policy_;
+  std::chrono::milliseconds max_block_time_;
+  DiscardFunction discard_;
+
+  alignas(64) std::atomic<std::size_t> enqueue_pos_ = 0;
+  alignas(64) std::atomic<std::size_t> dequeue_pos_ = 0;
+
+  alignas(64) std::atomic<bool> running_ = true;
+  std::atomic<uint32_t> waiting_consumers_ = 0;
+  std::atomic<uint32_t> waiting_producers_ = 0;
+  std::mutex wait_mutex_;
+  std::condition_variable cv_not_empty_;
+  std::condition_variable cv_not_full_;
+
+  std::atomic<std::size_t> high_water_mark_ = 0;
+  std::atomic<uint64_t> drops_ = 0;
+};
+}  // namespace solanet
+
+#endif  // SOLANET_NETWORK_UDP_RING_BUFFER_H_
@@ -6,10 +6,19 @@
 
 #include "solanet/network_udp/network_udp.h"
 
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
 #include <chrono>
+#include <memory>
+#include <stdexcept>
 #include <thread>
 
+#include "solanet/network_udp/network_context.h"
+
 /**
  * System test for "real" network interface (no mocking)
  */
@@ -92,3 +101,175 @@ TEST_CASE("[NETWORK_UDP] Multiple send/receive", "Multiple send/receive") {
     checkMessage("127.0.0.1", std::to_string(i), received_msgs1[i]);
   }
 }
+
+TEST_CASE("[NETWORK_UDP] Multiple send/receive batched", "Multiple send/receive batched") {
+  NetworkOptions options;
+  options.batched_io = true;
+  options.batch_size = 8;
+
+  std::vector<Message> received_msgs1;
+  Network network1(
+      "127.0.0.1", [&received_msgs1](const Message &msg) { received_msgs1.push_back(msg); },
+      options);
+  Network network2(
+      "127.0.0.1", [](const Message &) { /* intentionally not implemented */ }, options);
+
+  // Send from network2 to network 1
+  constexpr int message_count = 50;
+  for (int i = 0; i < message_count; i++) {
+    Message m("127.0.0.1", network1.getPort(), std::to_string(i));
+    network2.send(m);
+  }
+
+  std::this_thread::sleep_for(2s);
+  REQUIRE(received_msgs1.size() == message_count);
+  for (int i = 0; i < message_count; i++) {
+    checkMessage("127.0.0.1", std::to_string(i), received_msgs1[i]);
+  }
+}
+
+TEST_CASE("[NETWORK_UDP] Shared context send/receive", "Shared context send/receive") {
+  NetworkOptions options;
+  options.context = std::make_shared<NetworkContext>(2);
+  REQUIRE(options.context->getThreadCount() == 2);
+
+  // Callbacks of one network interface never run concurrently
+  std::vector<Message> received_msgs1;
+  std::atomic<uint32_t> received2 = 0;
+  Network network1(
+      "127.0.0.1", [&received_msgs1](const Message &msg) { received_msgs1.push_back(msg); },
+      options);
+  Network network2(
+      "127.0.0.1", [&received2](const Message &) { received2++; }, options);
+  REQUIRE(network1.getPort() != network2.getPort());
+
+  constexpr int message_count = 50;
+  for (int i = 0; i < message_count; i++) {
+    network2.send(Message("127.0.0.1", network1.getPort(), std::to_string(i)));
+  }
+  network1.send(Message("127.0.0.1", network2.getPort(), "From network1 to network2"));
+
+  std::this_thread::sleep_for(1s);
+  REQUIRE(received2 == 1);
+  REQUIRE(received_msgs1.size() == message_count);
+  for (int i = 0; i < message_count; i++) {
+    checkMessage("127.0.0.1", std::to_string(i), received_msgs1[i]);
+  }
+}
+
+TEST_CASE("[NETWORK_UDP] Multiplexed send/receive", "Multiplexed send/receive") {
+  // Two processes with two overlays each
+  NetworkOptions options_a;
+  options_a.context = std::make_shared<NetworkContext>();
+  NetworkOptions options_b;
+  options_b.context = std::make_shared<NetworkContext>();
+
+  std::vector<Message> received_a1, received_a2, received_b1, received_b2;
+  auto create = [](NetworkOptions options, uint32_t channel, std::vector<Message> &received) {
+    options.channel = channel;
+    return std::make_unique<Network>(
+        "127.0.0.1", [&received](const Message &msg) { received.push_back(msg); }, options);
+  };
+  auto network_a1 = create(options_a, 1, received_a1);
+  auto network_a2 = create(options_a, 2, received_a2);
+  auto network_b1 = create(options_b, 1, received_b1);
+  auto network_b2 = create(options_b, 2, received_b2);
+
+  // Overlays of one process share the socket
+  REQUIRE(network_a1->getPort() == network_a2->getPort());
+  REQUIRE(network_b1->getPort() == network_b2->getPort());
+  REQUIRE(network_a1->getPort() != network_b1->getPort());
+
+  network_a1->send(Message("127.0.0.1", network_b1->getPort(), "From a1 to b1"));
+  network_a2->send(Message("127.0.0.1", network_b2->getPort(), "From a2 to b2"));
+  network_b2->send(Message("127.0.0.1", network_a2->getPort(), "From b2 to a2"));
+
+  std::this_thread::sleep_for(1s);
+  REQUIRE(received_a1.empty());
+  REQUIRE(received_a2.size() == 1);
+  checkMessage("127.0.0.1", "From b2 to a2", received_a2[0]);
+  REQUIRE(received_a2[0].getPort() == network_b2->getPort());
+  REQUIRE(received_b1.size() == 1);
+  checkMessage("127.0.0.1", "From a1 to b1", received_b1[0]);
+  REQUIRE(received_b2.size() == 1);
+  checkMessage("127.0.0.1", "From a2 to b2", received_b2[0]);
+
+  // Messages of removed overlays are dropped
+  network_b2.reset();
+  network_a2->send(Message("127.0.0.1", network_b1->getPort(), "From a2 to b2"));
+  std::this_thread::sleep_for(200ms);
+  REQUIRE(received_b1.size() == 1);
+
+  // Only one network interface per channel and IP, and channels require a context
+  REQUIRE_THROWS_AS(create(options_a, 1, received_a1), std::invalid_argument);
+  NetworkOptions without_context;
+  without_context.channel = 1;
+  REQUIRE_THROWS_AS(create(without_context, 1, received_a1), std::invalid_argument);
+}
+
+TEST_CASE("[NETWORK_UDP] Shared context destruction", "Shared context destruction") {
+  NetworkOptions options;
+  options.context = std::make_shared<NetworkContext>(4);
+
+  // No callback runs after the destruction of its network interface, even under load
+  std::atomic_bool destroyed = false;
+  std::atomic<uint32_t> late_callbacks = 0;
+  auto receiver = std::make_unique<Network>(
+      "127.0.0.1",
+      [&destroyed, &late_callbacks](const Message &) {
+        std::this_thread::sleep_for(1ms);
+        if (destroyed) late_callbacks++;
+      },
+      options);
+  Network sender("127.0.0.1", [](const Message &) {}, options);
+
+  for (int i = 0; i < 200; i++) sender.send(Message("127.0.0.1", receiver->getPort(), "load"));
+  std::this_thread::sleep_for(20ms);
+  receiver.reset();
+  destroyed = true;
+
+  // The context is kept alive by the remaining network interface
+  options.context.reset();
+  std::this_thread::sleep_for(200ms);
+  REQUIRE(late_callbacks == 0);
+}
+
+TEST_CASE("[NETWORK_UDP] Multiplexed socket release", "Multiplexed socket release") {
+  NetworkOptions options;
+  options.context = std::make_shared<NetworkContext>();
+
+  auto create = [&options](uint32_t channel) {
+    options.channel = channel;
+    return std::make_unique<Network>("127.0.0.1", [](const Message &) {}, options);
+  };
+  auto network_1 = create(1);
+  auto network_2 = create(2);
+  const uint16_t port = network_1->getPort();
+
+  auto port_in_use = [port]() {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    const bool in_use = bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0;
+    close(fd);
+    return in_use;
+  };
+
+  // The socket is kept open while any overlay uses it
+  network_1.reset();
+  std::this_thread::sleep_for(100ms);
+  REQUIRE(port_in_use());
+
+  // A failed creation does not keep the socket either
+  REQUIRE_THROWS_AS(create(2), std::invalid_argument);
+  network_2.reset();
+  std::this_thread::sleep_for(100ms);
+  REQUIRE_FALSE(port_in_use());
+
+  // A new overlay gets a new socket
+  auto network_3 = create(3);
+  REQUIRE(network_3->getPort() != 0);
+}
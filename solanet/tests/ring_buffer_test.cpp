@@ -0,0 +1,159 @@
+// Copyright The SOLA Contributors
+//
+// Licensed under the MIT License.
+// For details on the licensing terms, see the LICENSE file.
+// SPDX-License-Identifier: MIT
+
+#include "ring_buffer.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace solanet;
+
+TEST_CASE("[RING_BUFFER] Capacity rounded to power of two", "Capacity") {
+  RingBuffer<int> buffer(5);
+  REQUIRE(buffer.getCapacity() == 8);
+}
+
+TEST_CASE("[RING_BUFFER] FIFO order and high-water mark", "FIFO") {
+  RingBuffer<int> buffer(8);
+  for (int i = 1; i <= 5; i++) {
+    REQUIRE(buffer.push(i));
+  }
+  REQUIRE(buffer.getHighWaterMark() == 5);
+
+  for (int i = 1; i <= 5; i++) {
+    REQUIRE(buffer.pop() == i);
+  }
+
+  int item = 0;
+  REQUIRE_FALSE(buffer.tryPop(item));
+  REQUIRE(buffer.getHighWaterMark() == 5);
+  REQUIRE(buffer.getDropCount() == 0);
+}
+
+TEST_CASE("[RING_BUFFER] Move-only pop", "Move-only") {
+  RingBuffer<std::unique_ptr<int>> buffer(4);
+  REQUIRE(buffer.push(std::make_unique<int>(42)));
+
+  std::unique_ptr<int> item = buffer.pop();
+  REQUIRE(item);
+  REQUIRE(*item == 42);
+}
+
+TEST_CASE("[RING_BUFFER] Backpressure fail", "Fail") {
+  RingBuffer<int> buffer(2, BackpressurePolicy::kFail);
+  REQUIRE(buffer.push(1));
+  REQUIRE(buffer.push(2));
+  REQUIRE_FALSE(buffer.push(3));
+  REQUIRE(buffer.getDropCount() == 1);
+
+  REQUIRE(buffer.pop() == 1);
+  REQUIRE(buffer.pop() == 2);
+}
+
+TEST_CASE("[RING_BUFFER] Backpressure drop oldest", "Drop oldest") {
+  std::vector<int> discarded;
+  RingBuffer<int> buffer(2, BackpressurePolicy::kDropOldest, RingBuffer<int>::kWaitForever,
+                         [&discarded](int &&item) { discarded.push_back(item); });
+  REQUIRE(buffer.push(1));
+  REQUIRE(buffer.push(2));
+  REQUIRE(buffer.push(3));
+  REQUIRE(buffer.getDropCount() == 1);
+  REQUIRE(discarded == std::vector<int>{1});
+
+  REQUIRE(buffer.pop() == 2);
+  REQUIRE(buffer.pop() == 3);
+}
+
+TEST_CASE("[RING_BUFFER] Rejected elements are discarded", "Discard") {
+  std::vector<int> discarded;
+  RingBuffer<int> buffer(2, BackpressurePolicy::kFail, RingBuffer<int>::kWaitForever,
+                         [&discarded](int &&item) { discarded.push_back(item); });
+  std::vector<int> items{1, 2, 3};
+  buffer.pushAll(items);
+
+  // The caller keeps elements which are pushed by reference
+  const int item = 4;
+  REQUIRE_FALSE(buffer.push(item));
+
+  REQUIRE(buffer.getDropCount() == 2);
+  REQUIRE(discarded == std::vector<int>{3});
+}
+
+TEST_CASE("[RING_BUFFER] Backpressure block", "Block") {
+  RingBuffer<int> buffer(2, BackpressurePolicy::kBlock);
+  REQUIRE(buffer.push(1));
+  REQUIRE(buffer.push(2));
+
+  std::thread producer([&buffer] { buffer.push(3); });
+  REQUIRE(buffer.pop() == 1);
+  producer.join();
+
+  REQUIRE(buffer.pop() == 2);
+  REQUIRE(buffer.pop() == 3);
+  REQUIRE(buffer.getDropCount() == 0);
+}
+
+TEST_CASE("[RING_BUFFER] Backpressure block times out", "Block timeout") {
+  std::vector<int> discarded;
+  RingBuffer<int> buffer(2, BackpressurePolicy::kBlock, std::chrono::milliseconds(10),
+                         [&discarded](int &&item) { discarded.push_back(item); });
+  REQUIRE(buffer.push(1));
+  REQUIRE(buffer.push(2));
+  REQUIRE_FALSE(buffer.push(3));
+
+  REQUIRE(buffer.getDropCount() == 1);
+  REQUIRE(discarded == std::vector<int>{3});
+  REQUIRE(buffer.pop() == 1);
+  REQUIRE(buffer.pop() == 2);
+}
+
+TEST_CASE("[RING_BUFFER] Stop unblocks pop", "Stop") {
+  RingBuffer<int> buffer(2);
+  std::future<int> consumer = std::async(std::launch::async, [&buffer] { return buffer.pop(); });
+  buffer.stop();
+  REQUIRE(consumer.get() == 0);
+
+  std::vector<int> items;
+  REQUIRE_FALSE(buffer.popBatch(items, 4));
+}
+
+TEST_CASE("[RING_BUFFER] Multiple producers", "MPSC") {
+  constexpr int kProducers = 4;
+  constexpr int kItemsPerProducer = 10000;
+  RingBuffer<int> buffer(64);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; p++) {
+    producers.emplace_back([&buffer, p] {
+      for (int i = 0; i < kItemsPerProducer; i++) {
+        buffer.push(p * kItemsPerProducer + i + 1);
+      }
+    });
+  }
+
+  std::set<int> received;
+  std::vector<int> last_per_producer(kProducers, 0);
+  std::vector<int> items;
+  while (received.size() < kProducers * kItemsPerProducer) {
+    REQUIRE(buffer.popBatch(items, 16));
+    for (int item : items) {
+      // Elements of a single producer keep their order
+      int producer = (item - 1) / kItemsPerProducer;
+      REQUIRE(item > last_per_producer[producer]);
+      last_per_producer[producer] = item;
+      received.insert(item);
+    }
+  }
+
+  for (auto &producer : producers) producer.join();
+  REQUIRE(buffer.getDropCount() == 0);
+  REQUIRE(buffer.getHighWaterMark() <= buffer.getCapacity());
+}